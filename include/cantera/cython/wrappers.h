@@ -16,6 +16,15 @@ int get_sundials_version()
     return SUNDIALS_VERSION;
 }
 
+int has_sundials_adjoint()
+{
+#ifdef CT_SUNDIALS_ADJOINT
+    return 1;
+#else
+    return 0;
+#endif
+}
+
 class PythonLogger : public Cantera::Logger
 {
 public:
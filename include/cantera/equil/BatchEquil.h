@@ -0,0 +1,171 @@
+/**
+ *  @file BatchEquil.h
+ *  Equilibrium calculations for large numbers of states of a single phase.
+ */
+
+#ifndef CT_BATCHEQUIL_H
+#define CT_BATCHEQUIL_H
+
+#include "ChemEquil.h"
+#include "vcs_MultiPhaseEquil.h"
+
+namespace Cantera
+{
+
+//! Computes the equilibrium states of a phase for a batch of input states,
+//! for example to generate equilibrium tables for tabulated chemistry.
+/*!
+ *  Each point of the batch is specified by the mass fractions of the
+ *  species, which determine the elemental composition, and by the values of
+ *  the two properties which are held constant. The points are divided into
+ *  blocks of consecutive points, which are distributed dynamically among a
+ *  pool of worker threads. Each thread uses its own copy of the phase and
+ *  its own solver objects, which are kept between calls to equilibrate().
+ *
+ *  Within a block, the element potentials and temperature of each solution
+ *  are used as the initial estimate for the next point (see
+ *  EquilOpt::contin), so the points should be ordered so
+ *  that neighbouring points have similar states, e.g. by varying the
+ *  mixture fraction along each row of a table. If the element potential
+ *  solver (ChemEquil) fails from this estimate, it is retried from its own
+ *  initial estimate and then, depending on the solver option, the VCS
+ *  solver is used. The VCS solver of each thread is warm started from the
+ *  previous point, see vcs_MultiPhaseEquil::setWarmStart().
+ *
+ *  If Cantera was built without thread safety, the points are processed
+ *  sequentially.
+ *
+ *  @ingroup equilfunctions
+ */
+class BatchEquil
+{
+public:
+    //! Create a solver for states of the phase *thermo*. The phase is
+    //! duplicated for each thread and is not modified.
+    BatchEquil(const ThermoPhase& thermo);
+    virtual ~BatchEquil();
+
+    //! Number of species in the phase
+    size_t nSpecies() const {
+        return m_nsp;
+    }
+
+    //! Set the number of worker threads. The default is the number of
+    //! hardware threads available.
+    void setNumThreads(size_t n);
+
+    //! Number of worker threads used by equilibrate()
+    size_t numThreads() const {
+        return m_nthreads;
+    }
+
+    //! Set the number of consecutive points which are handed to a thread at
+    //! a time. The default is 64.
+    void setBlockSize(size_t n);
+
+    //! Set the equilibrium solver to use:
+    //!   - -1 (default): the element potential solver, followed by the VCS
+    //!     solver for points where it fails
+    //!   - 0: the element potential solver only
+    //!   - 2: the VCS solver only
+    void setSolver(int solver);
+
+    //! Set the relative tolerance (default 1e-9) and the maximum number of
+    //! steps (default 1000) used by the solvers.
+    void setOptions(double rtol, int maxsteps);
+
+    //! Compute the equilibrium states for a batch of points.
+    /*!
+     *  @param XY  Property pair held constant: "TP", "HP", "SP", "UV", "SV"
+     *      or "TV".
+     *  @param npoints  Number of points
+     *  @param Y  Mass fractions of the species for each point; array of
+     *      size npoints by nSpecies(), with the mass fractions of each point
+     *      stored contiguously.
+     *  @param prop1  Value of the first property of *XY* for each point, in
+     *      SI units per unit mass, e.g. the specific enthalpy [J/kg] for "HP"
+     *  @param prop2  Value of the second property of *XY* for each point,
+     *      e.g. the pressure [Pa] for "HP" or the specific volume [m^3/kg]
+     *      for "UV"
+     *  @param[out] out  Equilibrium states: for each point, the temperature
+     *      [K] and pressure [Pa], followed by the mass fractions of the
+     *      species. Array of size npoints by (nSpecies() + 2). The rows
+     *      for points which fail are not modified.
+     *  @param[out] converged  Set to 1 for points which were equilibrated
+     *      successfully and 0 for points which failed. Array of size
+     *      npoints.
+     *  @return The number of points which failed
+     */
+    size_t equilibrate(const std::string& XY, size_t npoints, const double* Y,
+                       const double* prop1, const double* prop2, double* out,
+                       int* converged);
+
+    //! Error message for the first point which failed in the most recent
+    //! call to equilibrate(), or an empty string if all points succeeded
+    const std::string& errorMessage() const {
+        return m_error;
+    }
+
+protected:
+    //! Per-thread copies of the phase and the solver objects
+    struct Worker {
+        ThermoPhase* thermo;
+        ChemEquil* chemEquil;
+        MultiPhase* mix;
+        VCSnonideal::vcs_MultiPhaseEquil* vcs;
+        //! True if the most recent solution of the solvers is from a point
+        //! in the current block
+        bool seeded;
+    };
+
+    //! Process blocks of points taken from the shared work list until it is
+    //! empty. Executed by each worker thread, or by the calling thread if
+    //! only one thread is used.
+    void work(size_t iworker, bool workerThread);
+
+    //! Compute the equilibrium state of point *i* using worker *w*.
+    //! Returns true if successful.
+    bool solvePoint(Worker& w, size_t i);
+
+    //! Set the state of the phase to the input state of point *i*
+    void setInputState(ThermoPhase& thermo, size_t i);
+
+    //! Create the phase and solver objects of a worker
+    void initWorker(Worker& w);
+
+    ThermoPhase* m_thermo; //!< Phase which is duplicated for each worker
+    size_t m_nsp; //!< Number of species
+    std::vector<Worker> m_workers;
+    size_t m_nthreads; //!< Number of worker threads
+    size_t m_blockSize; //!< Number of points in each block
+
+    int m_solver;
+    double m_rtol;
+    int m_maxsteps;
+
+    // Arguments of the current call to equilibrate()
+    int m_XY;
+    size_t m_npoints;
+    const double* m_Y;
+    const double* m_prop1;
+    const double* m_prop2;
+    double* m_out;
+    int* m_converged;
+
+    //! Index of the first point of the next block to be processed
+    size_t m_next;
+
+    //! Index of the first point which failed
+    size_t m_firstFailed;
+
+    //! Error message for the first point which failed
+    std::string m_error;
+
+private:
+    BatchEquil(const BatchEquil&);
+    BatchEquil& operator=(const BatchEquil&);
+};
+
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include "cantera/base/ct_defs.h"
 #include "cantera/base/ctexceptions.h"
 #include "cantera/thermo/ThermoPhase.h"
+#include "EquilStats.h"
 
 #include <memory>
 
@@ -51,7 +52,8 @@ public:
 
     /**
      * Continuation flag. Set true if the calculation should be
-     * initialized from the last calculation. Otherwise, the
+     * initialized from the last calculation, i.e. from its element
+     * potentials and temperature. Otherwise, the
      * calculation will be started from scratch and the initial
      * composition and element potentials estimated.
      */
@@ -136,10 +138,74 @@ public:
      */
     int equilibrate(thermo_t& s, const char* XY, vector_fp& elMoles,
                     bool useThermoPhaseElementPotentials = false, int loglevel = 0);
+
+    //! Dimensional element potentials [J/kmol] of the most recent solution
     const vector_fp& elementPotentials() const {
         return m_lambda;
     }
 
+    //! Non-dimensional element potentials \f$ \lambda_m/RT \f$ of the most
+    //! recent solution
+    const vector_fp& elementPotentials_RT() const {
+        return m_last.lambda_RT;
+    }
+
+    //! Set the initial estimate for the next call to equilibrate().
+    /*!
+     *  The estimate replaces the initial estimate of the composition and of
+     *  the element potentials computed by the solver, which accounts for
+     *  most of the cost of solving problems which are close to the
+     *  estimate. If the Newton iteration fails from this estimate, the
+     *  problem is solved again from the solver's own estimate. The estimate
+     *  is used by one call to equilibrate() only.
+     *
+     *  @param lambda_RT non-dimensional element potentials
+     *      \f$ \lambda_m/RT \f$, e.g. from elementPotentials_RT()
+     *  @param T temperature [K]. Used as the initial estimate if the
+     *      temperature is not held fixed.
+     */
+    void setInitialEstimate(const vector_fp& lambda_RT, doublereal T);
+
+    //! Keep a cache of the *n* most recent solutions. If the cache is
+    //! enabled, each problem is started from the cached solution nearest to
+    //! it, if any is within the cache tolerance. A size of 0 (the default)
+    //! disables the cache.
+    void setCacheSize(size_t n);
+
+    //! Set the tolerance for using a cached solution. The distance between
+    //! two problems is the largest of the absolute differences in the
+    //! element mole fractions and the relative differences in the two fixed
+    //! properties, where differences in enthalpy, internal energy and
+    //! entropy are scaled by the heat capacity of the cached solution. The
+    //! default is 0.05.
+    void setCacheTolerance(doublereal tol) {
+        m_cacheTol = tol;
+    }
+
+    //! Remove all solutions from the cache
+    void clearCache();
+
+    //! Number of problems which were started from a cached solution
+    size_t cacheHits() const {
+        return m_cacheHits;
+    }
+
+    //! Number of problems which were started from a previous solution (from
+    //! the cache, setInitialEstimate() or EquilOpt::contin) but had to be
+    //! solved again from the solver's own estimate
+    size_t warmStartFailures() const {
+        return m_warmFailures;
+    }
+
+    //! Statistics for the last call to equilibrate(). The time spent in the
+    //! inner loop is the time spent in the Newton iteration, and the number
+    //! of thermodynamic property evaluations is the number of times the
+    //! phase was set to the equilibrium state for a set of element
+    //! potentials.
+    const EquilStats& stats() const {
+        return m_stats;
+    }
+
     /**
      * Options controlling how the calculation is carried out.
      * @see EquilOptions
@@ -249,10 +315,55 @@ protected:
                        const vector_fp& elmtotal, vector_fp& resid,
                        double xval, double yval, int loglevel = 0);
 
+    //! Evaluates the Jacobian of the residual vector with respect to the
+    //! element potentials and log(T). The Jacobian is computed analytically
+    //! for ideal gas phases and by finite differences for other phases.
     void equilJacobian(thermo_t& s, vector_fp& x,
                        const vector_fp& elmols, DenseMatrix& jac,
                        double xval, double yval, int loglevel = 0);
 
+    //! Evaluates the Jacobian of the residual vector by finite differences
+    void numericalJacobian(thermo_t& s, vector_fp& x,
+                           const vector_fp& elmols, DenseMatrix& jac,
+                           double xval, double yval, int loglevel = 0);
+
+    //! Newton iteration for the element potentials and log(T), starting
+    //! from the estimate in *x* and the state of *s*. Returns 0 if
+    //! successful, and throws an exception otherwise, after restoring the
+    //! state *state* of *s*.
+    int solveNewton(thermo_t& s, vector_fp& x, vector_fp& elMolesGoal,
+                    double xval, double yval, const vector_fp& state);
+
+    //! A solution which can be used as the initial estimate for other
+    //! problems
+    struct Estimate {
+        vector_fp lambda_RT; //!< element potentials, lambda/RT
+        doublereal T; //!< temperature [K]
+        //! Number of components and element order of the solution
+        size_t nComponents;
+        std::vector<size_t> orderVectorElements;
+    };
+
+    //! A cached solution, with the problem it solved
+    struct CacheEntry {
+        Estimate est;
+        std::string XY; //!< symbols of the fixed properties
+        vector_fp elMolesGoal; //!< element mole fractions
+        doublereal xval, yval; //!< values of the fixed properties
+        doublereal cp; //!< specific heat capacity [J/kg/K] of the solution
+    };
+
+    //! Save the solution *x* of a problem as the most recent solution, and
+    //! add it to the cache if *addToCache* is true and the cache is enabled.
+    void storeSolution(thermo_t& s, const vector_fp& x,
+                       const vector_fp& elMolesGoal, doublereal xval,
+                       doublereal yval, bool addToCache);
+
+    //! Find the cached solution nearest to a problem, or return npos if none
+    //! is within the cache tolerance.
+    size_t findCached(const vector_fp& elMolesGoal, doublereal xval,
+                      doublereal yval) const;
+
     void adjustEloc(thermo_t& s, vector_fp& elMolesGoal);
 
     //! Update internally stored state information.
@@ -339,6 +450,25 @@ protected:
 
     std::vector<size_t> m_orderVectorElements;
     std::vector<size_t> m_orderVectorSpecies;
+
+    //! Most recent solution
+    Estimate m_last;
+    bool m_haveLast;
+
+    //! Estimate set by setInitialEstimate()
+    Estimate m_initial;
+    bool m_haveInitial;
+
+    //! Solution cache, used as a ring buffer of size #m_cacheSize
+    std::vector<CacheEntry> m_cache;
+    size_t m_cacheSize;
+    size_t m_cacheNext; //!< index of the entry to be replaced next
+    doublereal m_cacheTol;
+    size_t m_cacheHits;
+    size_t m_warmFailures;
+
+    //! Statistics for the last call to equilibrate(). See stats().
+    EquilStats m_stats;
 };
 
 extern int ChemEquil_print_lvl;
@@ -0,0 +1,106 @@
+/**
+ *  @file EquilStats.h
+ *  Statistics collected by the equilibrium solvers.
+ */
+
+#ifndef CT_EQUILSTATS_H
+#define CT_EQUILSTATS_H
+
+#include "cantera/base/ct_defs.h"
+
+namespace Cantera
+{
+
+//! Statistics describing the work done by the equilibrium solvers.
+/*!
+ *  An EquilStats object is filled in by the equilibrium solvers for the most
+ *  recent call to their equilibrate() methods (see ChemEquil::stats() and
+ *  vcs_MultiPhaseEquil::stats()), and can be passed to the functions
+ *  equilibrate() and vcs_equilibrate() to accumulate the statistics of
+ *  several calls. Times are wall-clock times in seconds.
+ *
+ *  Not all of the quantities apply to both solvers. The element potential
+ *  solver (ChemEquil) does not carry out phase stability tests, evaluate
+ *  reaction free energies or delete species, so these are zero for it.
+ *
+ *  @ingroup equilfunctions
+ */
+class EquilStats
+{
+public:
+    EquilStats() {
+        clear();
+    }
+
+    //! Reset all counters and times to zero
+    void clear();
+
+    //! Add the statistics of *other* to this object
+    EquilStats& operator+=(const EquilStats& other);
+
+    //! Get the statistics as a map from the names used by the clib and
+    //! Python interfaces to their values. The names are the same as those
+    //! of the members, converted to lower case with underscores, e.g.
+    //! "time_basis_opt" for #timeBasisOpt.
+    void getStats(std::map<std::string, double>& stats) const;
+
+    //! Value of the statistic with the given name. See getStats().
+    double get(const std::string& name) const;
+
+    //! Number of calls to the equilibrium solvers
+    size_t calls;
+
+    //! Total time spent in the equilibrium solvers
+    double time;
+
+    //! Time spent optimizing the basis of component species
+    double timeBasisOpt;
+
+    //! Time spent in the main iteration of the solver, which includes the
+    //! time spent in the other parts of the algorithm called from it
+    double timeInnerLoop;
+
+    //! Time spent determining whether phases which are not present should
+    //! be added to the mixture (VCS solver only)
+    double timePhaseStability;
+
+    //! Time spent evaluating the free energy changes of the formation
+    //! reactions for the tentative solution of each iteration (VCS solver
+    //! only)
+    double timeDeltaG;
+
+    //! Number of iterations of the inner solver: iterations of the main
+    //! loop of the VCS solver, or Newton iterations of ChemEquil
+    size_t iterations;
+
+    //! Number of constant temperature and pressure problems solved by the
+    //! VCS solver, i.e. the number of outer iterations for problems where T
+    //! and P are not both held constant (VCS solver only)
+    size_t outerIterations;
+
+    //! Number of optimizations of the basis of component species
+    size_t basisOpts;
+
+    //! Number of stability tests for phases with more than one species
+    //! (VCS solver only)
+    size_t phaseStabilityTests;
+
+    //! Number of species deleted from the set of active species (VCS solver
+    //! only)
+    size_t speciesDeleted;
+
+    //! Number of deleted species added back to the set of active species
+    //! (VCS solver only)
+    size_t speciesReinserted;
+
+    //! Number of evaluations of the thermodynamic properties of the phases
+    size_t thermoEvals;
+
+    //! Number of times the composition of a phase was changed in order to
+    //! evaluate its properties (VCS solver only)
+    size_t thermoStateUpdates;
+};
+
+}
+
+#endif
@@ -10,6 +10,7 @@
 #define CT_KERNEL_EQUIL_H
 
 #include "MultiPhase.h"
+#include "EquilStats.h"
 #include "vcs_defs.h"
 
 namespace Cantera
@@ -45,6 +46,9 @@ namespace Cantera
  *  @param loglevel  loglevel Controls amount of diagnostic output. loglevel
  *                   = 0 suppresses diagnostics, and increasingly-verbose messages
  *                   are written as loglevel increases.
+ *  @param stats     If not null, the statistics of the element potential
+ *                   and VCS solvers for each attempt which does not end
+ *                   with an exception are added to this object.
  *
  * @return The number of iterations it took to equilibrate the system.
  *
@@ -52,7 +56,7 @@ namespace Cantera
  */
 int equilibrate(thermo_t& s, const char* XY,
                 int solver = -1, doublereal rtol = 1.0e-9, int maxsteps = VCS_MAXSTEPS,
-                int maxiter = 100, int loglevel = -99);
+                int maxiter = 100, int loglevel = -99, EquilStats* stats = 0);
 
 //! Equilibrate a MultiPhase object
 /*!
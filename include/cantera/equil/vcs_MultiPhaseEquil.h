@@ -6,6 +6,7 @@
 #define VCS_MULTIPHASEEQUIL_H
 
 #include "MultiPhase.h"
+#include "EquilStats.h"
 #include "vcs_solve.h"
 #include "vcs_prob.h"
 
@@ -46,6 +47,8 @@ namespace Cantera
  *  @param loglevel Controls amount of diagnostic output. loglevel
  *                  = 0 suppresses diagnostics, and increasingly-verbose
  *                  messages are written as loglevel increases.
+ *  @param stats    If not null, the statistics of the solver are added to
+ *                  this object, unless the solver throws an exception.
  *
  *  @ingroup equilfunctions
  */
@@ -53,7 +56,8 @@ int vcs_equilibrate(thermo_t& s, const char* XY,
                     int estimateEquil = 0, int printLvl = 0,
                     int solver = -1, doublereal rtol = 1.0e-9,
                     int maxsteps = VCS_MAXSTEPS,
-                    int maxiter = 100, int loglevel = -99);
+                    int maxiter = 100, int loglevel = -99,
+                    EquilStats* stats = 0);
 
 //!  Set a multi-phase chemical solution to chemical equilibrium.
 /*!
@@ -87,6 +91,8 @@ int vcs_equilibrate(thermo_t& s, const char* XY,
  *  @param loglevel Controls amount of diagnostic output. loglevel
  *                  = 0 suppresses diagnostics, and increasingly-verbose
  *                  messages are written as loglevel increases.
+ *  @param stats    If not null, the statistics of the solver are added to
+ *                  this object, unless the solver throws an exception.
  *
  *  @ingroup equilfunctions
  */
@@ -94,7 +100,8 @@ int vcs_equilibrate(MultiPhase& s, const char* XY,
                     int estimateEquil = 0, int printLvl = 0,
                     int solver = 2,
                     doublereal rtol = 1.0e-9, int maxsteps = VCS_MAXSTEPS,
-                    int maxiter = 100, int loglevel = -99);
+                    int maxiter = 100, int loglevel = -99,
+                    EquilStats* stats = 0);
 
 //!  Set a multi-phase chemical solution to chemical equilibrium.
 /*!
@@ -129,6 +136,8 @@ int vcs_equilibrate(MultiPhase& s, const char* XY,
  *  @param loglevel Controls amount of diagnostic output. loglevel
  *                  = 0 suppresses diagnostics, and increasingly-verbose
  *                  messages are written as loglevel increases.
+ *  @param stats    If not null, the statistics of the solver are added to
+ *                  this object, unless the solver throws an exception.
  *
  *  @ingroup equilfunctions
  */
@@ -136,7 +145,8 @@ int vcs_equilibrate_1(MultiPhase& s, int ixy,
                       int estimateEquil = 0, int printLvl = 0,
                       int solver = 2,
                       doublereal rtol = 1.0e-9, int maxsteps = VCS_MAXSTEPS,
-                      int maxiter = 100, int loglevel = -99);
+                      int maxiter = 100, int loglevel = -99,
+                      EquilStats* stats = 0);
 
 //! Determine the phase stability of a single phase given the current conditions
 //! in a MultiPhase object
@@ -253,11 +263,45 @@ public:
      */
     void getStoichVector(size_t rxn, Cantera::vector_fp& nu);
 
-    //! return the number of iterations
+    //! Return the number of constant T and P solves carried out by the
+    //! VCS solver since the object was created or since the start of the
+    //! last call to equilibrate(). For problems where T and P are not both
+    //! held constant, this is the number of outer iterations.
     int iterations() const {
         return m_iter;
     }
 
+    //! Statistics for the last call to equilibrate(). The times and counters
+    //! are the sums over all of the constant T and P solves.
+    const Cantera::EquilStats& stats() const {
+        return m_stats;
+    }
+
+    //! Enable or disable warm starts of the constant T and P solves.
+    /*!
+     *  When warm starts are enabled (the default), each constant T and P
+     *  solve which uses the current composition of the mixture as its initial
+     *  estimate (estimateEquil = 0) and which follows a successful solve by
+     *  the same object reuses the workspace of the VCS solver, including the
+     *  optimized choice of components and the set of species and phases
+     *  which are present. This makes sweeps along a path of nearby states
+     *  (e.g. in temperature, pressure or composition) much cheaper than
+     *  solving each state from scratch, as long as one object is used for
+     *  the whole sweep. If a warm-started solve fails, the problem is set up
+     *  again from scratch and solved.
+     */
+    void setWarmStart(bool warmStart) {
+        m_warmStart = warmStart;
+        m_solverReady = false;
+    }
+
+    //! Number of constant T and P solves since the object was created for
+    //! which the VCS solver was set up from scratch, i.e. which were not
+    //! warm started. See setWarmStart().
+    int nFullSetups() const {
+        return m_nFullSetups;
+    }
+
     //! Equilibrate the solution using the current element abundances
     //! stored in the MultiPhase object
     /*!
@@ -461,6 +505,51 @@ public:
                                          VCSnonideal::VCS_PROB* vprob);
 
 protected:
+    //! Equilibrate the solution at constant pressure and constant enthalpy,
+    //! internal energy or entropy.
+    /*!
+     *  Implements equilibrate_HP() and equilibrate_SP(). The temperature is
+     *  found by a Newton iteration, where each iteration solves for the
+     *  equilibrium composition at constant T and P, starting from the
+     *  composition found by the previous iteration. The derivative of the
+     *  equilibrium value of the constrained property with respect to T is
+     *  given by equilibriumDerivative(), and the iteration falls back to
+     *  bisection if a step leaves the temperature interval known to contain
+     *  the solution.
+     *
+     *  @param xtarget Value of the total enthalpy, internal energy or
+     *                 entropy to be held constant
+     *  @param XY      Integer flag indicating what is held constant. Must be
+     *                 HP, UP or SP.
+     *
+     *  The other arguments are as for equilibrate_HP().
+     */
+    int equilibrate_XP(doublereal xtarget, int XY, double Tlow, double Thigh,
+                       int estimateEquil, int printLvl, doublereal err,
+                       int maxsteps, int loglevel);
+
+    //! The total enthalpy (XY = HP), internal energy (XY = UP) or entropy
+    //! (XY = SP) of the mixture
+    double mixtureProperty(int XY) const;
+
+    //! Derivative with respect to temperature of the enthalpy, internal
+    //! energy or entropy of the mixture, allowing the composition to remain
+    //! at equilibrium at constant pressure.
+    /*!
+     *  The mixture must be at the equilibrium state found by the last call
+     *  to equilibrate_TP(). The change in the extents of the formation
+     *  reactions of the noncomponent species is found by differentiating the
+     *  equilibrium conditions with respect to temperature, using the
+     *  chemical potentials of ideal solutions for the composition dependence.
+     *
+     *  @param XY HP, UP or SP
+     */
+    double equilibriumDerivative(int XY);
+
+    //! Add the counters of the VCS solver for the last call to
+    //! VCS_SOLVE::vcs() to #m_stats
+    void addSolveStats();
+
     //! Vector that takes into account of the current sorting of the species
     /*!
      *  The index of m_order is the original k value of the species in the
@@ -506,9 +595,23 @@ protected:
     //! Stoichiometric matrix
     Cantera::DenseMatrix m_N;
 
-    //! Iteration Count
+    //! Number of calls to equilibrate_TP(). See iterations().
     int m_iter;
 
+    //! Statistics for the last call to equilibrate(). See stats().
+    Cantera::EquilStats m_stats;
+
+    //! Reuse the workspace of the VCS solver between solves.
+    //! See setWarmStart().
+    bool m_warmStart;
+
+    //! True if the workspace of the VCS solver holds the solution of the last
+    //! solve, so that the next solve can be warm started
+    bool m_solverReady;
+
+    //! Number of solves which set up the VCS solver from scratch
+    int m_nFullSetups;
+
     //! Vector of indices for species that are included in the calculation.
     /*!
      *   This is used to exclude pure-phase species with invalid thermo data
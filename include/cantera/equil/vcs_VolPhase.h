@@ -521,6 +521,36 @@ public:
     //! Return the number of species in the phase
     size_t nSpecies() const;
 
+    //! Number of evaluations of the thermodynamic properties of the
+    //! underlying ThermoPhase object since this object was created
+    /*!
+     *  Each call which computes the activity coefficients, the standard
+     *  state or reference state properties, the partial molar volumes or the
+     *  derivatives of the activity coefficients counts as one evaluation.
+     */
+    int numThermoEvals() const {
+        return m_numThermoEvals;
+    }
+
+    //! Number of times the composition of the phase has been sent to the
+    //! underlying ThermoPhase object since this object was created
+    int numStateUpdates() const {
+        return m_numStateUpdates;
+    }
+
+    //! Indicate that the state of the underlying ThermoPhase object may have
+    //! been changed by another object, e.g. by a MultiPhase object which
+    //! shares it.
+    /*!
+     *  Normally, the composition is only sent to the ThermoPhase object when
+     *  it differs from the one sent most recently, and the activity
+     *  coefficients and partial molar volumes are kept until the composition
+     *  changes. After this call, the next update of the mole fractions sends
+     *  the composition again and the activity coefficients and partial molar
+     *  volumes are recomputed.
+     */
+    void invalidateThermoState();
+
 private:
     //! Evaluate the activity coefficients at the current conditions
     /*!
@@ -572,6 +602,13 @@ private:
     //! Updates the mole fraction dependencies
     /*!
      *  Whenever the mole fractions change, this routine should be called.
+     *  The mole fractions are sent to the ThermoPhase object, and the
+     *  activity coefficients and partial molar volumes are marked as out of
+     *  date, only if they differ from the mole fractions sent most recently.
+     *  In the VCS algorithm, many phases keep the same composition from one
+     *  iteration to the next, or between the "old" and "new" states of an
+     *  iteration, so this avoids many evaluations of expensive
+     *  activity coefficient models.
      */
     void _updateMoleFractionDependencies();
 
@@ -772,6 +809,10 @@ private:
     //! Vector of the current mole fractions for species in the phase
     std::vector<double> Xmol_;
 
+    //! Mole fractions most recently sent to the ThermoPhase object. Only
+    //! meaningful if #m_UpToDate_Thermo is true.
+    std::vector<double> m_XmolThermo;
+
     //! Vector of current creationMoleNumbers_
     /*!
      *  These are the actual unknowns in the phase stability problem
@@ -899,6 +940,18 @@ private:
      */
     mutable bool m_UpToDate_G0;
 
+    //! Boolean indicating whether the ThermoPhase object is known to be at
+    //! the temperature and pressure of this object and the mole fractions
+    //! #m_XmolThermo. See _updateMoleFractionDependencies().
+    bool m_UpToDate_Thermo;
+
+    //! Number of thermodynamic property evaluations. See numThermoEvals().
+    mutable int m_numThermoEvals;
+
+    //! Number of compositions sent to the ThermoPhase object. See
+    //! numStateUpdates().
+    int m_numStateUpdates;
+
     //! Current value of the temperature for this object, and underlying objects
     double Temp_;
 
@@ -90,6 +90,32 @@ public:
 
     //! Time spent in the vcs suite of programs
     double T_Time_vcs;
+
+    //! Current time spent in vcs_deltag() evaluating the tentative solution
+    //! of each iteration of solve_tp_inner()
+    double Time_deltag;
+
+    //! Current time spent determining whether phases pop into existence
+    double Time_phaseStability;
+
+    //! Current number of phase stability tests for multispecies phases
+    int Phase_Stability_Tests;
+
+    //! Current number of minor species deleted from the active set of
+    //! species because their mole numbers became negligible
+    int Deletions;
+
+    //! Current number of deleted species added back to the active set
+    int Reinsertions;
+
+    //! Number of evaluations of the thermodynamic properties of the phases
+    //! during the current call to VCS_SOLVE::vcs(), including those made by
+    //! the initial estimator. See vcs_VolPhase::numThermoEvals().
+    int Thermo_Evals;
+
+    //! Number of compositions sent to the ThermoPhase objects during the
+    //! current call to VCS_SOLVE::vcs(). See vcs_VolPhase::numStateUpdates().
+    int Thermo_State_Updates;
 };
 
 //! Returns the value of the gas constant in the units specified by parameter
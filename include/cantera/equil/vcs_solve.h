@@ -196,6 +196,8 @@ public:
      *   matrix for the reaction mechanism expressed in Reduced Canonical
      *   Form. jcomp refers to the component number, and irxn refers to the
      *   irxn_th non-component species.
+     * - #m_rxnComponents[irxn]: Components with nonzero stoichiometric
+     *   coefficients in the formation reaction irxn.
      * - #m_deltaMolNumPhase(iphase,irxn): Change in the number of moles in
      *   phase, iphase, due to the noncomponent formation reaction, irxn.
      * - #m_phaseParticipation(iphase,irxn): This is 1 if the phase, iphase,
@@ -1551,6 +1553,18 @@ public:
      */
     Cantera::Array2D m_stoichCoeffRxnMatrix;
 
+    //! Sparsity pattern of the stoichiometric coefficient matrix
+    /*!
+     *  m_rxnComponents[irxn] contains the indices of the components with
+     *  nonzero coefficients in column irxn of m_stoichCoeffRxnMatrix, in
+     *  increasing order. In large multiphase problems, most species contain
+     *  only a few of the elements, so each formation reaction involves only a
+     *  few of the components. Computed by vcs_basopt().
+     *
+     *  length = nspecies0
+     */
+    std::vector<std::vector<size_t> > m_rxnComponents;
+
     //! Absolute size of the stoichiometric coefficients
     /*!
      *  scSize[irxn] = abs(Size) of the stoichiometric
@@ -6,9 +6,11 @@
 #ifndef CT_EQUIL_INCL
 #define CT_EQUIL_INCL
 #include "equil/equil.h"
+#include "equil/EquilStats.h"
 #include "equil/ChemEquil.h"
 #include "equil/MultiPhaseEquil.h"
 #include "equil/vcs_MultiPhaseEquil.h"
+#include "equil/BatchEquil.h"
 #endif
 
 
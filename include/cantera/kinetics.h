@@ -5,6 +5,7 @@
 
 #include "kinetics/Kinetics.h"
 #include "kinetics/InterfaceKinetics.h"
+#include "kinetics/BatchInterfaceKinetics.h"
 #include "kinetics/GasKinetics.h"
 #include "kinetics/KineticsFactory.h"
 #include "kinetics/importKinetics.h"
@@ -0,0 +1,184 @@
+/**
+ *  @file BatchInterfaceKinetics.h
+ *  Evaluation of surface reaction rates for large numbers of surface states.
+ */
+
+#ifndef CT_BATCHINTERFACEKINETICS_H
+#define CT_BATCHINTERFACEKINETICS_H
+
+#include "InterfaceKinetics.h"
+
+namespace Cantera
+{
+
+//! Evaluates the species production rates of an interface reaction mechanism
+//! for a batch of surface states, e.g. for all of the wall faces of a CFD
+//! mesh.
+/*!
+ *  Each face of the batch is specified by its temperature and pressure, the
+ *  mass fractions of the species in the gas phase adjacent to the surface,
+ *  and the coverages of the surface species. The states of any other bulk
+ *  phases of the mechanism are taken from the phases of the kinetics object
+ *  used to create the batch evaluator, at the temperature and pressure of
+ *  each face.
+ *
+ *  The faces are divided into blocks of consecutive faces, which are
+ *  distributed dynamically among a pool of worker threads. Each thread uses
+ *  its own copies of the phases and of the kinetics object, which are
+ *  created by the first call to eval() and are kept between calls, so the
+ *  reaction mechanism is only processed once. Within a block, the rate
+ *  constants and equilibrium constants are only reevaluated when the
+ *  temperature or pressure differs from that of the previous face (see
+ *  InterfaceKinetics::_update_rates_T()), so faces with equal temperatures
+ *  should be stored next to each other where possible.
+ *
+ *  If Cantera was built without thread safety, the faces are processed
+ *  sequentially.
+ *
+ *  @ingroup chemkinetics
+ */
+class BatchInterfaceKinetics
+{
+public:
+    //! Create an evaluator for the mechanism of *kin*, which must already
+    //! have been finalized. The phases and the kinetics object are
+    //! duplicated for each thread and are not modified.
+    /*!
+     *  @param kin  Kinetics object for the interface mechanism
+     *  @param gasPhase  Index in *kin* of the phase whose composition is
+     *      given for each face. The default is the first phase of *kin*
+     *      which is not the surface phase.
+     */
+    BatchInterfaceKinetics(const InterfaceKinetics& kin,
+                           size_t gasPhase = npos);
+    virtual ~BatchInterfaceKinetics();
+
+    //! Number of species in the gas phase
+    size_t nGasSpecies() const {
+        return m_ngas;
+    }
+
+    //! Number of species in the surface phase
+    size_t nSurfSpecies() const {
+        return m_nsurf;
+    }
+
+    //! Number of species in all phases of the mechanism, i.e. the number of
+    //! net production rates computed for each face
+    size_t nTotalSpecies() const {
+        return m_kk;
+    }
+
+    //! Index in the kinetics object of the gas phase
+    size_t gasPhaseIndex() const {
+        return m_gasPhase;
+    }
+
+    //! Set the number of worker threads. The default is the number of
+    //! hardware threads available.
+    void setNumThreads(size_t n);
+
+    //! Number of worker threads used by eval()
+    size_t numThreads() const {
+        return m_nthreads;
+    }
+
+    //! Set the number of consecutive faces which are handed to a thread at
+    //! a time. The default is 256.
+    void setBlockSize(size_t n);
+
+    //! Evaluate the species production rates for a batch of faces.
+    /*!
+     *  The per-face arrays store the values of each face contiguously. Any
+     *  of the output arrays may be null if the corresponding results are
+     *  not needed.
+     *
+     *  @param nfaces  Number of faces
+     *  @param T  Temperature [K] of each face
+     *  @param P  Pressure [Pa] of each face
+     *  @param Y  Mass fractions of the gas phase species; array of size
+     *      nfaces by nGasSpecies()
+     *  @param theta  Coverages of the surface species; array of size nfaces
+     *      by nSurfSpecies(). The coverages are not normalized.
+     *  @param[out] wdot  Net production rates [kmol/m^2/s] of all species
+     *      of the mechanism, in the order used by the kinetics object;
+     *      array of size nfaces by nTotalSpecies()
+     *  @param[out] dthetadt  Time derivatives [1/s] of the coverages of the
+     *      surface species, i.e. the right-hand sides of the coverage
+     *      equations integrated by ImplicitSurfChem; array of size nfaces
+     *      by nSurfSpecies()
+     */
+    void eval(size_t nfaces, const double* T, const double* P,
+              const double* Y, const double* theta, double* wdot,
+              double* dthetadt);
+
+protected:
+    //! Per-thread copies of the phases and the kinetics object
+    struct Worker {
+        std::vector<ThermoPhase*> phases;
+        InterfaceKinetics* kin;
+        //! Net production rates of one face, used if the caller does not
+        //! request them
+        vector_fp wdot;
+    };
+
+    //! Process blocks of faces taken from the shared work list until it is
+    //! empty. Executed by each worker thread, or by the calling thread if
+    //! only one thread is used.
+    void work(size_t iworker, bool workerThread);
+
+    //! Evaluate the rates for face *i* using worker *w*
+    void evalFace(Worker& w, size_t i);
+
+    //! Record that the evaluation of face *i* failed with the message *msg*,
+    //! unless a failure has already been recorded for an earlier face.
+    //! Exceptions are not allowed to leave the worker threads, so all of
+    //! them are reported this way and rethrown by eval().
+    void recordFailure(size_t i, const std::string& msg);
+
+    //! Create the phases and the kinetics object of a worker
+    void initWorker(Worker& w);
+
+    //! Kinetics object and phases which are duplicated for each worker
+    InterfaceKinetics* m_kin;
+    std::vector<ThermoPhase*> m_phases;
+
+    size_t m_gasPhase; //!< Index of the gas phase in the kinetics object
+    size_t m_surfPhase; //!< Index of the surface phase
+    size_t m_ngas; //!< Number of gas phase species
+    size_t m_nsurf; //!< Number of surface species
+    size_t m_kk; //!< Total number of species
+    size_t m_surfStart; //!< Kinetics species index of the first surface species
+
+    //! Sizes of the surface species divided by the site density
+    vector_fp m_sizeOverSiteDensity;
+
+    std::vector<Worker> m_workers;
+    size_t m_nthreads; //!< Number of worker threads
+    size_t m_blockSize; //!< Number of faces in each block
+
+    // Arguments of the current call to eval()
+    size_t m_nfaces;
+    const double* m_T;
+    const double* m_P;
+    const double* m_Y;
+    const double* m_theta;
+    double* m_wdot;
+    double* m_dthetadt;
+
+    //! Index of the first face of the next block to be processed
+    size_t m_next;
+
+    //! Index of the first face for which the evaluation failed, and the
+    //! corresponding error message
+    size_t m_firstFailed;
+    std::string m_error;
+
+private:
+    BatchInterfaceKinetics(const BatchInterfaceKinetics&);
+    BatchInterfaceKinetics& operator=(const BatchInterfaceKinetics&);
+};
+
+}
+
+#endif
@@ -37,6 +37,7 @@ public:
 
     virtual Kinetics* duplMyselfAsKinetics(const std::vector<thermo_t*> & tpVector) const {
         EdgeKinetics* iK = new EdgeKinetics(*this);
+        iK->m_integrator = 0;
         iK->assignShallowPointers(tpVector);
         return iK;
     }
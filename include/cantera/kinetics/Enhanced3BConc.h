@@ -52,6 +52,11 @@ public:
         return m_deflt * ctot  + sum;
     }
 
+    //! Efficiency of species which are not listed explicitly
+    doublereal defaultEfficiency() const {
+        return m_deflt;
+    }
+
     void getEfficiencies(vector_fp& eff) const {
         for (size_t i = 0; i < m_n; i++) {
             eff[m_index[i]] = m_eff[i] + m_deflt;
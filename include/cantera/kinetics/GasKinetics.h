@@ -80,6 +80,8 @@ public:
     }
 
     virtual void getEquilibriumConstants(doublereal* kc);
+    virtual void getReactionDelta(const doublereal* property,
+                                  doublereal* deltaProperty);
     virtual void getDeltaGibbs(doublereal* deltaG);
     virtual void getDeltaEnthalpy(doublereal* deltaH);
     virtual void getDeltaEntropy(doublereal* deltaS);
@@ -135,6 +137,9 @@ public:
     //! @{
     virtual void init();
     virtual void addReaction(ReactionData& r);
+    virtual void invalidateCache() {
+        m_ROP_ok = false;
+    }
     virtual void finalize();
     virtual bool ready() const;
     //@}
@@ -148,6 +153,19 @@ public:
         return m_pgroups[i];
     }
 
+    //! Derivatives of the species net production rates with respect to the
+    //! species concentrations, at constant temperature.
+    /*!
+     *  In addition to the mass-action terms computed by
+     *  Kinetics::getNetProductionRates_ddC(), this includes the dependence
+     *  of the rate constants of three-body and falloff reactions on the
+     *  enhanced third-body concentrations. The derivatives of the falloff
+     *  functions are evaluated by finite differences in the reduced
+     *  pressure. The pressure dependence of P-log and Chebyshev reactions
+     *  is still neglected.
+     */
+    virtual void getNetProductionRates_ddC(doublereal* ddC);
+
     //! Update temperature-dependent portions of reaction rates and falloff
     //! functions.
     virtual void update_rates_T();
@@ -221,6 +239,12 @@ protected:
 
     doublereal m_temp;
     doublereal m_pres; //!< Last pressure at which rates were evaluated
+
+    //! Phase::stateMFNumber(), temperature and density at which the
+    //! concentration-dependent terms were last evaluated
+    int m_conc_stateNum;
+    doublereal m_conc_temp;
+    doublereal m_conc_dens;
     vector_fp m_rfn;
     vector_fp falloff_work;
     vector_fp concm_3b_values;
@@ -230,6 +254,22 @@ protected:
 
     vector_fp m_conc;
     void processFalloffReactions();
+
+    //! Add the derivatives of the net production rates due to the
+    //! dependence of the rate of progress of reaction *i* on the enhanced
+    //! third-body concentration [M] to *ddC*
+    /*!
+     *  @param i  reaction index
+     *  @param dqdM  derivative of the net rate of progress with respect to
+     *      [M]
+     *  @param eff  third-body efficiency of each species
+     *  @param ddC  see getNetProductionRates_ddC()
+     */
+    void addThirdBodyDerivatives(size_t i, double dqdM, const vector_fp& eff,
+                                 doublereal* ddC);
+
+    //! Work arrays for getNetProductionRates_ddC()
+    vector_fp m_ddC_eff, m_ddC_pr;
     vector_fp m_grt;
 
 private:
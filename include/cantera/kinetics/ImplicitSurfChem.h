@@ -118,6 +118,22 @@ public:
     void solvePseudoSteadyStateProblem(int ifuncOverride = -1,
                                        doublereal timeScaleOverride = 1.0);
 
+    //! Set the method used to evaluate the Jacobian in
+    //! solvePseudoSteadyStateProblem(): "analytic" (the default) or
+    //! "finite-difference". See solveSP::setJacobianType().
+    void setSteadyStateJacobianType(const std::string& type);
+
+    //! Enable or disable reuse of the factored Jacobian between the Newton
+    //! iterations and calls of solvePseudoSteadyStateProblem(). See
+    //! solveSP::setReuseJacobian().
+    void setSteadyStateReuseJacobian(bool reuse);
+
+    //! Get statistics on the work done by solvePseudoSteadyStateProblem().
+    //! See solveSP::getSolverStats(). Nothing is added to *stats* if the
+    //! problem has not been solved yet.
+    void getSteadyStateSolverStats(std::map<std::string, long int>& stats)
+        const;
+
     // overloaded methods of class FuncEval
 
     //! Return the number of equations
@@ -284,6 +300,12 @@ protected:
      */
     solveSP* m_surfSolver;
 
+    //! Method used to evaluate the Jacobian in #m_surfSolver
+    std::string m_surfJacobianType;
+
+    //! Reuse the factored Jacobian in #m_surfSolver
+    bool m_surfReuseJacobian;
+
     //! If true, a common temperature and pressure for all
     //! surface and bulk phases associated with the surface problem
     //! is imposed
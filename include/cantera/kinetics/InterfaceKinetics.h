@@ -109,8 +109,13 @@ public:
     //! Assignment operator
     InterfaceKinetics& operator=(const InterfaceKinetics& right);
 
+    //! Duplication routine. The copy uses the phases in *tpVector*,
+    //! including its surface phase, and does not share the coverage
+    //! integrator of this object.
     virtual Kinetics* duplMyselfAsKinetics(const std::vector<thermo_t*> & tpVector) const;
 
+    virtual void assignShallowPointers(const std::vector<thermo_t*> & tpVector);
+
     virtual int type() const;
 
     //! Set the electric potential in the nth phase
@@ -161,6 +166,31 @@ public:
     virtual void getDestructionRates(doublereal* ddot);
     virtual void getNetProductionRates(doublereal* net);
 
+    //! Derivatives of the species net production rates with respect to the
+    //! coverages of the species in the surface phase
+    /*!
+     *  The derivatives are evaluated at constant temperature, electric
+     *  potentials and concentrations of the species in the other phases.
+     *  They include the mass-action dependence of the rates of progress on
+     *  the surface concentrations and the dependence of the forward rate
+     *  constants on the coverages (see SurfaceArrhenius). The forward rates
+     *  of progress are differentiated using the reaction orders, while the
+     *  reverse rates use the lists of products given by products(), so
+     *  reversible reactions with non-integer product stoichiometric
+     *  coefficients are approximated. The adjustments made for phases which
+     *  do not exist (see setPhaseExistence()) are neglected.
+     *
+     *  These derivatives give the Jacobian used by solveSP to solve for the
+     *  pseudo steady-state coverages.
+     *
+     *  @param ddCov  Output array of size nTotalSpecies() by the number of
+     *      species in the surface phase, stored in column-major order, so
+     *      that the derivative of the net production rate of kinetics
+     *      species `k` with respect to the coverage of surface species `j`
+     *      is `ddCov[k + j*nTotalSpecies()]`.
+     */
+    void getNetProductionRates_ddCov(doublereal* ddCov);
+
     //! @}
     //! @name Reaction Mechanism Informational Query Routines
     //! @{
@@ -264,6 +294,13 @@ public:
      *       m_kdata->m_rfn
      *       m_rates.
      *       updateKc();
+     *
+     *  The rate constants and equilibrium constants are only reevaluated if
+     *  the temperature or pressure of one of the phases or an electric
+     *  potential has changed since the last call. For mechanisms with
+     *  coverage-dependent rate constants, the rate constants are
+     *  reevaluated on every call, but the equilibrium constants are not.
+     *  Mechanisms with electrochemical reactions are always reevaluated.
      */
     void _update_rates_T();
 
@@ -754,6 +791,10 @@ protected:
     //! Current temperature of the data
     doublereal m_temp;
 
+    //! Temperatures and pressures of the phases for which the rate
+    //! constants and equilibrium constants were last evaluated
+    vector_fp m_phaseT, m_phaseP;
+
     //! Current log of the temperature
     doublereal m_logtemp;
 
@@ -779,6 +820,18 @@ protected:
      */
     bool m_has_coverage_dependence;
 
+    //! Work arrays for getNetProductionRates_ddCov(), which hold the
+    //! derivatives of the net rates of progress with respect to the
+    //! coverages and the coverages themselves
+    vector_fp m_ddCov_rop, m_ddCov_theta;
+
+    //! Species and reaction orders of the forward rate of progress of each
+    //! reaction, used by getNetProductionRates_ddCov(). These follow the
+    //! rules used by ReactionStoichMgr::add() to compute the rates of
+    //! progress.
+    std::vector<std::vector<size_t> > m_fwdOrderSpecies;
+    std::vector<vector_fp> m_fwdOrders;
+
     //! Boolean flag indicating whether any reaction in the mechanism
     //! has a beta electrochemical parameter.
     /*!
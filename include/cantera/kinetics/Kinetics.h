@@ -594,6 +594,25 @@ public:
         throw NotImplementedError("Kinetics::getNetProductionRates");
     }
 
+    /**
+     * Derivatives of the species net production rates with respect to the
+     * species activity concentrations, at constant temperature.
+     *
+     * The rate of progress of each reaction is differentiated as a
+     * mass-action rate, using the forward and reverse rate constants and
+     * the lists of reactants and products given by reactants() and
+     * products(). The dependence of the rate constants on composition
+     * (through third body efficiencies and falloff functions) is
+     * neglected, as are non-integer stoichiometric coefficients. The result
+     * is suitable as an approximate Jacobian for implicit integrators.
+     *
+     * @param ddC  Output array of size nTotalSpecies() by nTotalSpecies(),
+     *     stored in column-major order, so that the derivative of the net
+     *     production rate of species `k` with respect to the concentration
+     *     of species `j` is `ddC[k + j*nTotalSpecies()]`.
+     */
+    virtual void getNetProductionRates_ddC(doublereal* ddC);
+
     //! @}
     //! @name Reaction Mechanism Informational Query Routines
     //! @{
@@ -830,8 +849,13 @@ public:
      */
     void setMultiplier(size_t i, doublereal f) {
         m_perturb[i] = f;
+        invalidateCache();
     }
 
+    //! Discard any cached reaction rates, so that they are recomputed the
+    //! next time they are needed. Called when the rate multipliers change.
+    virtual void invalidateCache() {}
+
     //@}
 
     /**
@@ -949,6 +973,10 @@ protected:
     //! number of spatial dimensions of lowest-dimensional phase.
     size_t m_mindim;
 
+    //! Work array for getNetProductionRates_ddC(), which holds the
+    //! concentrations and the forward and reverse rate constants
+    vector_fp m_ddC_work;
+
 private:
     //! Vector of group lists
     std::vector<grouplist_t> m_dummygroups;
@@ -85,6 +85,166 @@ protected:
     std::vector<size_t>           m_rxn;
 };
 
+/**
+ * Rate coefficient manager for coverage-dependent surface reactions.
+ *
+ * The coverage dependencies of all reactions are stored as two sparse
+ * matrices in compressed row format, with one row for each rate
+ * coefficient: one holding the parameters \f$ a_k \f$ and \f$ E_k \f$ of
+ * the terms which are linear in the coverages, and one holding the
+ * parameters \f$ m_k \f$ of the terms which depend on the logarithms of the
+ * coverages (see SurfaceArrhenius). update_C() evaluates the logarithms of
+ * the coverages once, and then computes the coverage-dependent terms of all
+ * reactions as products of these matrices with the coverage vector and its
+ * logarithm.
+ */
+template<>
+class Rate1<SurfaceArrhenius>
+{
+
+public:
+
+    Rate1() : m_nLogSpecies(0) {
+        m_covStart.push_back(0);
+        m_mcovStart.push_back(0);
+    }
+    virtual ~Rate1() {}
+
+    /**
+     * Install a rate coefficient calculator.
+     * @param rxnNumber the reaction number
+     * @param rdata rate coefficient specification for the reaction
+     */
+    size_t install(size_t rxnNumber, const ReactionData& rdata) {
+        if (rdata.rateCoeffType != SurfaceArrhenius::type())
+            throw CanteraError("Rate1::install",
+                               "incorrect rate coefficient type: "+int2str(rdata.rateCoeffType) + ". Was Expecting type: "+ int2str(SurfaceArrhenius::type()));
+
+        m_rxn.push_back(rxnNumber);
+        m_rates.push_back(SurfaceArrhenius(rdata));
+        m_rates.back().getCoverageDependencies(m_covSpecies, m_covA, m_covE,
+                                               m_mcovSpecies, m_mcovM);
+        m_covStart.push_back(m_covSpecies.size());
+        m_mcovStart.push_back(m_mcovSpecies.size());
+        for (size_t n = m_mcovStart[m_rates.size()-1];
+             n < m_mcovSpecies.size(); n++) {
+            m_nLogSpecies = std::max(m_nLogSpecies, m_mcovSpecies[n] + 1);
+        }
+        m_acov.push_back(0.0);
+        m_ecov.push_back(0.0);
+        m_mcov.push_back(0.0);
+        return m_rates.size() - 1;
+    }
+
+    /**
+     * Update the coverage-dependent parts of the rate coefficients. The
+     * array c contains the coverages of the surface species. To get the
+     * updated rates, method update must be called after the call to
+     * update_C.
+     */
+    void update_C(const doublereal* c) {
+        m_logCov.resize(m_nLogSpecies);
+        for (size_t k = 0; k < m_nLogSpecies; k++) {
+            m_logCov[k] = std::log(std::max(c[k], Tiny));
+        }
+        for (size_t i = 0; i != m_rates.size(); i++) {
+            doublereal acov = 0.0, ecov = 0.0, mcov = 0.0;
+            for (size_t n = m_covStart[i]; n < m_covStart[i+1]; n++) {
+                doublereal theta = c[m_covSpecies[n]];
+                acov += m_covA[n] * theta;
+                ecov += m_covE[n] * theta;
+            }
+            for (size_t n = m_mcovStart[i]; n < m_mcovStart[i+1]; n++) {
+                mcov += m_mcovM[n] * m_logCov[m_mcovSpecies[n]];
+            }
+            m_acov[i] = acov;
+            m_ecov[i] = ecov;
+            m_mcov[i] = mcov;
+        }
+    }
+
+    /**
+     * Add the derivatives of the logarithms of the rate coefficients with
+     * respect to the surface coverages to the array *dlnk*. Coverages below
+     * the cutoff used by update_C() do not contribute to the
+     * coverage-dependent reaction orders.
+     *
+     * @param T      temperature
+     * @param c      coverages passed to the last call to update_C()
+     * @param scale  factors multiplying the derivatives for each reaction,
+     *               indexed by reaction number. Reactions with a factor of
+     *               zero are skipped.
+     * @param ld     leading dimension of *dlnk*
+     * @param dlnk   column-major output array. The scaled derivative for
+     *               reaction `i` with respect to `c[k]` is added to
+     *               `dlnk[i + k*ld]`.
+     */
+    void addLogDerivatives_C(doublereal T, const doublereal* c,
+                             const doublereal* scale, size_t ld,
+                             doublereal* dlnk) const {
+        doublereal recipT = 1.0/T;
+        doublereal ln10 = std::log(10.0);
+        for (size_t i = 0; i != m_rates.size(); i++) {
+            size_t irxn = m_rxn[i];
+            if (scale[irxn] == 0.0) {
+                continue;
+            }
+            for (size_t n = m_covStart[i]; n < m_covStart[i+1]; n++) {
+                dlnk[irxn + m_covSpecies[n]*ld] +=
+                    scale[irxn] * (ln10*m_covA[n] - m_covE[n]*recipT);
+            }
+            for (size_t n = m_mcovStart[i]; n < m_mcovStart[i+1]; n++) {
+                size_t k = m_mcovSpecies[n];
+                if (c[k] > Tiny) {
+                    dlnk[irxn + k*ld] += scale[irxn] * m_mcovM[n] / c[k];
+                }
+            }
+        }
+    }
+
+    /**
+     * Write the rate coefficients into array values, using the
+     * coverage-dependent terms computed by the last call to update_C().
+     */
+    void update(doublereal T, doublereal logT, doublereal* values) {
+        doublereal recipT = 1.0/T;
+        for (size_t i = 0; i != m_rates.size(); i++) {
+            values[m_rxn[i]] = m_rates[i].updateRC(logT, recipT, m_acov[i],
+                                                   m_ecov[i], m_mcov[i]);
+        }
+    }
+
+    size_t nReactions() const {
+        return m_rates.size();
+    }
+
+protected:
+    std::vector<SurfaceArrhenius> m_rates;
+    std::vector<size_t> m_rxn;
+
+    //! Sparse matrix of the terms which are linear in the coverages. The
+    //! entries for rate coefficient `i` are `m_covStart[i]` to
+    //! `m_covStart[i+1]-1` of `m_covSpecies`, `m_covA` and `m_covE`.
+    std::vector<size_t> m_covStart, m_covSpecies;
+    vector_fp m_covA, m_covE;
+
+    //! Sparse matrix of the terms which depend on the logarithms of the
+    //! coverages, stored in the same way as the linear terms
+    std::vector<size_t> m_mcovStart, m_mcovSpecies;
+    vector_fp m_mcovM;
+
+    //! Number of coverages for which logarithms are needed, i.e. one more
+    //! than the largest species index in #m_mcovSpecies
+    size_t m_nLogSpecies;
+
+    //! Logarithms of the coverages, evaluated once by each call to update_C()
+    vector_fp m_logCov;
+
+    //! Coverage-dependent terms of each rate coefficient computed by
+    //! update_C()
+    vector_fp m_acov, m_ecov, m_mcov;
+};
+
 }
 
 #endif
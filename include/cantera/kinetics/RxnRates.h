@@ -220,6 +220,25 @@ public:
         }
     }
 
+    /**
+     * Append the coverage dependencies of the rate constant to the given
+     * arrays. The species indices and the parameters \f$ a_k \f$ and
+     * \f$ E_k \f$ of all coverage dependencies are appended to *sp*, *a*
+     * and *e*, and the species indices and parameters \f$ m_k \f$ of the
+     * dependencies with nonzero \f$ m_k \f$ are appended to *msp* and *m*.
+     * Used by Rate1<SurfaceArrhenius> to assemble the coverage dependencies
+     * of all reactions.
+     */
+    void getCoverageDependencies(std::vector<size_t>& sp, vector_fp& a,
+                                 vector_fp& e, std::vector<size_t>& msp,
+                                 vector_fp& m) const {
+        sp.insert(sp.end(), m_sp.begin(), m_sp.end());
+        a.insert(a.end(), m_ac.begin(), m_ac.end());
+        e.insert(e.end(), m_ec.begin(), m_ec.end());
+        msp.insert(msp.end(), m_msp.begin(), m_msp.end());
+        m.insert(m.end(), m_mc.begin(), m_mc.end());
+    }
+
     /**
      * Update the value of the logarithm of the rate constant.
      *
@@ -240,8 +259,19 @@ public:
      * factor.
      */
     doublereal updateRC(doublereal logT, doublereal recipT) const {
-        return m_A * std::exp(std::log(10.0)*m_acov + m_b*logT -
-                              (m_E + m_ecov)*recipT + m_mcov);
+        return updateRC(logT, recipT, m_acov, m_ecov, m_mcov);
+    }
+
+    /**
+     * Evaluate the rate constant for the given values of the sums
+     * \f$ \sum a_k \theta_k \f$, \f$ \sum E_k \theta_k \f$ and
+     * \f$ \sum m_k \ln \theta_k \f$, instead of those computed by
+     * update_C().
+     */
+    doublereal updateRC(doublereal logT, doublereal recipT, doublereal acov,
+                        doublereal ecov, doublereal mcov) const {
+        return m_A * std::exp(std::log(10.0)*acov + m_b*logT -
+                              (m_E + ecov)*recipT + mcov);
     }
 
     //! @deprecated. To be removed after Cantera 2.2
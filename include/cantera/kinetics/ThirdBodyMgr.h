@@ -47,6 +47,20 @@ public:
     size_t workSize() {
         return m_concm.size();
     }
+
+    //! Index of the *n*-th reaction handled by this manager
+    size_t reactionIndex(size_t n) const {
+        return m_reaction_index[n];
+    }
+
+    //! Get the third-body efficiency of each species for the *n*-th
+    //! reaction handled by this manager, which are the derivatives of the
+    //! enhanced third-body concentration with respect to the species
+    //! concentrations.
+    void getEfficiencies(size_t n, vector_fp& eff) const {
+        std::fill(eff.begin(), eff.end(), m_concm[n].defaultEfficiency());
+        m_concm[n].getEfficiencies(eff);
+    }
     bool contains(int rxnNumber) {
         return (find(m_reaction_index.begin(),
                      m_reaction_index.end(), rxnNumber)
@@ -134,6 +134,24 @@ namespace Cantera
  *  in this Newton iteration compared to that in the nonlinear solver. A value
  *  of 0.1 is used so surface species are safely  overconverged.
  *
+ *  ### Jacobian:
+ *  By default, the Jacobian is evaluated from the derivatives of the net
+ *  production rates with respect to the coverages provided by
+ *  InterfaceKinetics::getNetProductionRates_ddCov(), which requires one
+ *  evaluation of the rates of progress rather than one for each unknown.
+ *  Finite differences are used if requested with setJacobianType(), for
+ *  BULK_DEPOSITION problems, and if an InterfaceKinetics object contains a
+ *  surface phase solved for by another InterfaceKinetics object.
+ *
+ *  When the problem is solved repeatedly for similar conditions, e.g. for
+ *  the surface at each wall face of a flow simulation, setReuseJacobian()
+ *  allows the factored Jacobian from the previous iterations and previous
+ *  calls to be reused for the steady-state Newton iterations. The Jacobian
+ *  is only reevaluated if the residual does not decrease quickly enough.
+ *  Combined with an initial guess given by the coverages from the previous
+ *  solution, this typically reduces the work for each call to a few
+ *  residual evaluations and back substitutions.
+ *
  *  Functions called:
  *  - `ct_dgetrf` -- First half of LAPACK direct solve of a full Matrix
  *  - `ct_dgetrs` -- Second half of LAPACK direct solve of a full matrix.
@@ -195,6 +213,33 @@ public:
     int solveSurfProb(int ifunc, doublereal time_scale, doublereal TKelvin,
                       doublereal PGas, doublereal reltol, doublereal abstol);
 
+    //! Set the method used to evaluate the Jacobian
+    /*!
+     *  @param type  "analytic" (the default) to use the derivatives given by
+     *      InterfaceKinetics::getNetProductionRates_ddCov(), or
+     *      "finite-difference"
+     */
+    void setJacobianType(const std::string& type);
+
+    //! Enable or disable reuse of the factored Jacobian
+    /*!
+     *  If enabled, the factored Jacobian from previous iterations, including
+     *  those of previous calls to solveSurfProb(), is used for the
+     *  steady-state Newton iterations until the weighted norm of the
+     *  residual fails to decrease by a factor of 2 in an iteration.
+     *  Iterations which include a pseudo time step always evaluate the
+     *  Jacobian. Disabled by default.
+     */
+    void setReuseJacobian(bool reuse) {
+        m_reuseJac = reuse;
+    }
+
+    //! Get statistics on the work done since this object was created: the
+    //! number of Newton iterations (`iterations`), residual evaluations,
+    //! including those used for finite difference Jacobians
+    //! (`resid_evals`), and Jacobian evaluations (`jac_evals`).
+    void getSolverStats(std::map<std::string, long int>& stats) const;
+
 private:
     //! Printing routine that optionally gets called at the start of every
     //! invocation
@@ -314,6 +359,15 @@ private:
                      const doublereal* CSolnSPOld,  const bool do_time,
                      const doublereal deltaT);
 
+    //! Evaluate the Jacobian for the surface species from the derivatives
+    //! of the net production rates given by the InterfaceKinetics objects
+    /*!
+     *  Called by resjac_eval() after the residual has been evaluated. See
+     *  resjac_eval() for the parameters.
+     */
+    void analyticJacobian(SquareMatrix& jac, const bool do_time,
+                          const doublereal deltaT);
+
     //!   Pointer to the manager of the implicit surface chemistry problem
     /*!
      *    This object actually calls the current object. Thus, we are
@@ -519,6 +573,35 @@ private:
     //! Newton's method.
     SquareMatrix m_Jac;
 
+    //! True if the Jacobian is evaluated analytically. @see setJacobianType()
+    bool m_analyticJac;
+
+    //! False if the Jacobian can't be evaluated analytically because an
+    //! InterfaceKinetics object contains a surface phase that is solved for
+    //! by another InterfaceKinetics object
+    bool m_analyticJacOK;
+
+    //! Work array holding the derivatives of the net production rates with
+    //! respect to the coverages. Length m_maxTotSpecies times the largest
+    //! number of species in a surface phase.
+    vector_fp m_ddCov;
+
+    //! True if the factored Jacobian may be reused. @see setReuseJacobian()
+    bool m_reuseJac;
+
+    //! True if #m_Jac holds a factored steady-state Jacobian which may be
+    //! reused for later steady-state iterations
+    bool m_JacFactored;
+
+    //! Number of Newton iterations
+    long int m_nIterations;
+
+    //! Number of residual evaluations
+    long int m_nResidEvals;
+
+    //! Number of Jacobian evaluations
+    long int m_nJacEvals;
+
 public:
     int m_ioflag;
 };
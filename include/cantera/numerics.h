@@ -3,6 +3,7 @@
 
 #include "numerics/DenseMatrix.h"
 #include "numerics/BandMatrix.h"
+#include "numerics/SparseMatrix.h"
 #include "numerics/SquareMatrix.h"
 #include "numerics/NonlinearSolver.h"
 
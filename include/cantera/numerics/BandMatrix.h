@@ -191,6 +191,22 @@ public:
      */
     int solve(doublereal* b, size_t nrhs=1, size_t ldb=0);
 
+    //! Solve the transposed matrix problem A^T x = b
+    /*!
+     *  The LU factorization of A is used, so no additional factorization is
+     *  required if the matrix has already been factored.
+     *
+     *  @param b     INPUT rhs of the problem
+     *               OUTPUT solution to the problem
+     *  @param nrhs  Number of right hand sides to solve
+     *  @param ldb   Leading dimension of `b`. Default is nColumns()
+     *
+     * @return Return a success flag
+     *          0 indicates a success
+     *         ~0  Some error occurred, see the LAPACK documentation
+     */
+    virtual int solveTranspose(doublereal* b, size_t nrhs=1, size_t ldb=0);
+
     //! Returns an iterator for the start of the band storage data
     /*!
      *  Iterator points to the beginning of the data, and it is changeable.
@@ -73,6 +73,21 @@ public:
         return m_np;
     }
     virtual double sensitivity(size_t k, size_t p);
+    virtual void setAdjointCheckpointSteps(int nsteps);
+    virtual void solveAdjoint(const double* lambda, double* dgdp,
+                              double* lambda0=0);
+    virtual doublereal currentTime() const {
+        return m_time;
+    }
+    virtual doublereal internalTime() const;
+    virtual bool rootFound() const {
+        return m_rootFound;
+    }
+    virtual void getRootInfo(std::vector<int>& info) const {
+        info = m_rootInfo;
+    }
+    virtual void getDky(double t, int k, double* dky);
+    virtual void getSolverStats(std::map<std::string, long int>& stats) const;
 
     //! Returns a string listing the weighted error estimates associated
     //! with each solution component.
@@ -88,6 +103,20 @@ protected:
     //! during integrator initialization or reinitialization.
     void applyOptions();
 
+    //! Check whether the integrator stopped at a root of one of the root
+    //! functions, based on the return value *flag* of CVode.
+    void checkRoots(int flag);
+
+    //! Take steps with CVode, or with CVodeF if adjoint sensitivity analysis
+    //! is enabled, using the CVODES task *itask*.
+    int advanceForward(double tout, int itask);
+
+#ifdef CT_SUNDIALS_ADJOINT
+    //! Create the backward problem used by solveAdjoint(), or reinitialize
+    //! it at the current time.
+    void initBackward();
+#endif
+
 private:
     void sensInit(double t0, FuncEval& func);
 
@@ -117,6 +146,18 @@ private:
     //! for at the current integrator time.
     bool m_sens_ok;
 
+    size_t m_nroots; //!< Number of root functions
+    bool m_rootFound; //!< True if the last step stopped at a root
+    std::vector<int> m_rootInfo; //!< Root information returned by CVodes
+    N_Vector m_dky; //!< Work space for getDky()
+
+    //! Number of steps between checkpoints for adjoint sensitivity analysis,
+    //! or 0 if adjoint sensitivity analysis is disabled
+    int m_adjointSteps;
+    int m_indexB; //!< Identifier of the backward problem, or -1
+    N_Vector m_yB; //!< Adjoint variables
+    N_Vector m_qB; //!< Sensitivities of the adjoint objective
+
 };
 
 }    // namespace
@@ -8,9 +8,13 @@
 #define CT_FUNCEVAL_H
 
 #include "cantera/base/ct_defs.h"
+#include "cantera/base/ctexceptions.h"
 
 namespace Cantera
 {
+
+class Array2D;
+
 /**
  *  Virtual base class for ODE right-hand-side function evaluators.
  *  Classes derived from FuncEval evaluate the right-hand-side function
@@ -48,6 +52,127 @@ public:
     virtual size_t nparams() {
         return 0;
     }
+
+    //! Number of root functions. If this is positive, the integrator stops
+    //! at each time where one of the root functions changes sign.
+    //! @see evalRootFunctions()
+    virtual size_t nRootFunctions() {
+        return 0;
+    }
+
+    /**
+     * Evaluate the root functions \f$ g_i(t, \vec{y}) \f$. Called by the
+     * integrator, which locates the times at which any of the root functions
+     * changes sign.
+     * @param[in] t time.
+     * @param[in] y solution vector, length neq()
+     * @param[out] g values of the root functions, length nRootFunctions()
+     */
+    virtual void evalRootFunctions(double t, double* y, double* g) {
+        throw NotImplementedError("FuncEval::evalRootFunctions");
+    }
+
+    //! Returns true if this object can evaluate the Jacobian of the
+    //! right-hand-side function. @see getJacobian()
+    virtual bool hasJacobian() {
+        return false;
+    }
+
+    /**
+     * Evaluate the Jacobian \f$ J = \partial \vec{F} / \partial \vec{y} \f$
+     * of the right-hand-side function. Called by the integrator instead of
+     * computing a finite difference approximation, if hasJacobian() returns
+     * true. An approximation to the Jacobian is acceptable, since it is
+     * only used in the Newton iteration.
+     * @param[in] t time.
+     * @param[in] y solution vector, length neq()
+     * @param[in] ydot right-hand-side function evaluated at `t` and `y`
+     * @param[in] p sensitivity parameter vector, length nparams()
+     * @param[out] jac Jacobian matrix, size neq() by neq()
+     */
+    virtual void getJacobian(double t, double* y, double* ydot, double* p,
+                             Array2D& jac) {
+        throw NotImplementedError("FuncEval::getJacobian");
+    }
+
+    //! Returns true if this object provides a preconditioner for use with
+    //! iterative linear solvers. @see preconditionerSetup()
+    virtual bool hasPreconditioner() {
+        return false;
+    }
+
+    /**
+     * Prepare a preconditioner for the Newton matrix \f$ M = I - \gamma J \f$,
+     * where \f$ J \f$ is the Jacobian of the right-hand-side function.
+     * Called by the integrator only if hasPreconditioner() returns true.
+     * @param[in] t time.
+     * @param[in] y solution vector, length neq()
+     * @param[in] ydot right-hand-side function evaluated at `t` and `y`
+     * @param[in] gamma coefficient of the Jacobian in the Newton matrix
+     * @param[in] reuseJacobian if true, a previously evaluated Jacobian may be
+     *     used with the new value of `gamma`.
+     * @returns true if the Jacobian was re-evaluated
+     */
+    virtual bool preconditionerSetup(double t, double* y, double* ydot,
+                                     double gamma, bool reuseJacobian) {
+        throw NotImplementedError("FuncEval::preconditionerSetup");
+    }
+
+    /**
+     * Solve the system \f$ P z = r \f$, where \f$ P \f$ is the
+     * preconditioner prepared by the last call to preconditionerSetup().
+     * @param[in] rhs the vector `r`, length neq()
+     * @param[out] z the solution, length neq()
+     */
+    virtual void preconditionerSolve(double* rhs, double* z) {
+        throw NotImplementedError("FuncEval::preconditionerSolve");
+    }
+
+    /**
+     * Solve the system \f$ P^T z = r \f$, where \f$ P \f$ is the
+     * preconditioner prepared by the last call to preconditionerSetup().
+     * Used for the backward problem of the adjoint sensitivity analysis,
+     * whose Newton matrix is \f$ I + \gamma J^T \f$.
+     * @param[in] rhs the vector `r`, length neq()
+     * @param[out] z the solution, length neq()
+     */
+    virtual void preconditionerSolveTranspose(double* rhs, double* z) {
+        throw NotImplementedError("FuncEval::preconditionerSolveTranspose");
+    }
+
+    /**
+     * Evaluate the right-hand side of the adjoint equations,
+     * \f$ \dot{\vec{\lambda}} = -J^T \vec{\lambda} \f$, where \f$ J \f$ is
+     * the Jacobian of the right-hand-side function. Called by the integrator
+     * when solving the adjoint problem backward in time.
+     * @param[in] t time.
+     * @param[in] y solution vector of the forward problem at `t`, length
+     *     neq()
+     * @param[in] lambda adjoint variables, length neq()
+     * @param[out] lambdaDot rate of change of the adjoint variables, length
+     *     neq()
+     */
+    virtual void evalAdjoint(double t, double* y, double* lambda,
+                             double* lambdaDot) {
+        throw NotImplementedError("FuncEval::evalAdjoint");
+    }
+
+    /**
+     * Evaluate the derivatives of the right-hand-side function with respect
+     * to the sensitivity parameters, weighted by the adjoint variables,
+     * \f$ \vec{\lambda}^T \partial \vec{F} / \partial p_i \f$. The
+     * integral of this quantity over the solution interval gives the
+     * sensitivities of the objective of the adjoint problem.
+     * @param[in] t time.
+     * @param[in] y solution vector of the forward problem at `t`, length
+     *     neq()
+     * @param[in] lambda adjoint variables, length neq()
+     * @param[out] dfdp weighted derivatives, length nparams()
+     */
+    virtual void evalAdjointParams(double t, double* y, double* lambda,
+                                   double* dfdp) {
+        throw NotImplementedError("FuncEval::evalAdjointParams");
+    }
 };
 
 }
@@ -29,6 +29,7 @@ public:
      *  @param matType  Matrix type
      *       0 full
      *       1 banded
+     *       2 sparse
      */
     GeneralMatrix(int matType);
 
@@ -143,6 +144,20 @@ public:
      */
     virtual int solve(doublereal* b, size_t nrhs=1, size_t ldb=0) = 0;
 
+    //! Solves the transposed linear problem A^T * x = b
+    /*!
+     * @param b  INPUT rhs of the problem
+     *           OUTPUT solution to the problem
+     * @param nrhs  Number of right hand sides to solve
+     * @param ldb   Leading dimension of `b`. Default is nRows()
+     *
+     * @return If successful, returns 0. The base class version throws an
+     *     exception, since not all derived classes implement this method.
+     */
+    virtual int solveTranspose(doublereal* b, size_t nrhs=1, size_t ldb=0) {
+        throw NotImplementedError("GeneralMatrix::solveTranspose");
+    }
+
     //! true if the current factorization is up to date with the matrix
     virtual bool factored() const {
         return (m_factored != 0);
@@ -229,6 +244,7 @@ public:
     /*!
      *      0 Square
      *      1 Banded
+     *      2 Sparse
      */
     int matrixType_;
 
@@ -132,6 +132,54 @@ public:
         return 0.0;
     }
 
+    //! The time corresponding to the current value of the solution. This is
+    //! the time at which the last call to integrate() or step() stopped.
+    virtual doublereal currentTime() const {
+        warn("currentTime");
+        return 0.0;
+    }
+
+    //! The time reached by the last internal step of the integrator. This
+    //! may be later than currentTime(), e.g. after a call to integrate()
+    //! which interpolated the solution within the last step. getDky() can
+    //! be used for times within the last step, which ends at this time.
+    virtual doublereal internalTime() const {
+        warn("internalTime");
+        return 0.0;
+    }
+
+    //! Returns true if the last call to integrate() or step() stopped at a
+    //! root of one of the root functions provided by the FuncEval object.
+    //! @see FuncEval::evalRootFunctions()
+    virtual bool rootFound() const {
+        return false;
+    }
+
+    //! Get the root functions which have a root at currentTime().
+    /*!
+     *  @param[out] info  For each root function, +1 if the function changed
+     *      sign from negative to positive, -1 if it changed from positive to
+     *      negative, or 0 if it does not have a root at currentTime().
+     */
+    virtual void getRootInfo(std::vector<int>& info) const {
+        warn("getRootInfo");
+    }
+
+    //! Get the *k*-th derivative of the solution at time *t*.
+    /*!
+     *  The solution is evaluated using the interpolating polynomial of the
+     *  integrator, so *t* must lie within the last internal step, which ends
+     *  at or after currentTime(). This allows the solution to be sampled at
+     *  many output times without limiting the step size.
+     *
+     *  @param[in] t  time at which to evaluate the solution
+     *  @param[in] k  order of the derivative (0 for the solution itself)
+     *  @param[out] dky  the derivative, length nEquations()
+     */
+    virtual void getDky(double t, int k, double* dky) {
+        warn("getDky");
+    }
+
     /** The current value of the solution of equation k. */
     virtual doublereal& solution(size_t k) {
         warn("solution");
@@ -204,6 +252,57 @@ public:
         return 0.0;
     }
 
+    //! Enable adjoint sensitivity analysis with respect to the parameters of
+    //! the FuncEval object, which replaces forward sensitivity analysis.
+    /*!
+     *  The forward solution is stored at a checkpoint every *nsteps* steps.
+     *  The solution between checkpoints is recomputed during the backward
+     *  integration, so a larger value reduces the memory required at the
+     *  cost of additional forward integration. A value of zero disables
+     *  adjoint sensitivity analysis. Takes effect when the integrator is
+     *  next initialized.
+     */
+    virtual void setAdjointCheckpointSteps(int nsteps) {
+        if (nsteps > 0) {
+            throw NotImplementedError("Integrator::setAdjointCheckpointSteps");
+        }
+    }
+
+    //! Solve the adjoint problem backward from currentTime() to the initial
+    //! time, to obtain the sensitivities of an objective
+    //! \f$ G = \vec{\lambda}_f^T \vec{y}(t_f) \f$, where \f$ t_f \f$ is
+    //! currentTime().
+    /*!
+     *  Requires that adjoint sensitivity analysis was enabled with
+     *  setAdjointCheckpointSteps() before the forward integration. The cost
+     *  is independent of the number of parameters, apart from the
+     *  evaluation of FuncEval::evalAdjointParams(). Further forward
+     *  integration requires the integrator to be reinitialized.
+     *
+     *  @param[in] lambda  the weights \f$ \vec{\lambda}_f \f$, i.e.
+     *      \f$ \partial G / \partial \vec{y}(t_f) \f$, length
+     *      nEquations()
+     *  @param[out] dgdp  \f$ dG/dp_i \f$ for each parameter of the FuncEval
+     *      object, length FuncEval::nparams()
+     *  @param[out] lambda0  If not NULL, set to
+     *      \f$ \partial G / \partial \vec{y}(t_0) \f$, the sensitivities
+     *      with respect to the initial conditions, length nEquations()
+     */
+    virtual void solveAdjoint(const double* lambda, double* dgdp,
+                              double* lambda0=0) {
+        throw NotImplementedError("Integrator::solveAdjoint");
+    }
+
+    //! Get statistics on the work done by the integrator, such as the number
+    //! of steps and function evaluations, and for the GMRES linear solver,
+    //! the number of linear iterations and preconditioner evaluations.
+    /*!
+     *  @param[out] stats  Map from the name of each statistic to its value
+     */
+    virtual void getSolverStats(std::map<std::string, long int>& stats) const {
+        warn("getSolverStats");
+    }
+
 private:
 
     doublereal m_dummy;
@@ -0,0 +1,346 @@
+/**
+ *  @file SparseMatrix.h
+ *   Declarations for the class SparseMatrix
+ *   which is a child class of GeneralMatrix for sparse matrices handled by solvers
+ *    (see class \ref numerics and \link Cantera::SparseMatrix SparseMatrix\endlink).
+ */
+
+#ifndef CT_SPARSEMATRIX_H
+#define CT_SPARSEMATRIX_H
+
+#include "GeneralMatrix.h"
+
+namespace Cantera
+{
+
+//! A class for square sparse matrices stored in compressed-column format,
+//! with a direct (LU) solver.
+/*!
+ *  The nonzero structure of the matrix is fixed when the matrix is created or
+ *  when setStructure() is called. Only elements within this structure may be
+ *  set; all other elements are zero.
+ *
+ *  The LU factorization uses a left-looking algorithm with threshold partial
+ *  pivoting, where columns are processed in their natural order. The first
+ *  factorization determines the pivot sequence and the nonzero structure of
+ *  the factors (the symbolic factorization). Subsequent factorizations reuse
+ *  the pivot sequence and structure, and only repeat the numerical work, as
+ *  long as the pivots remain acceptable. If a pivot fails the threshold test,
+ *  a complete factorization with a new pivot sequence is carried out.
+ *
+ *  Only the nonzero elements of the matrix and its factors are stored, so
+ *  this class is useful for matrices that have a wide band but are not dense
+ *  within the band.
+ */
+class SparseMatrix : public GeneralMatrix
+{
+public:
+    //! Base Constructor. Create an \c 0 by \c 0 matrix.
+    SparseMatrix();
+
+    //! Create a sparse matrix with the given structure, with all elements set
+    //! to zero
+    /*!
+     * @param n         size of the square matrix
+     * @param colStart  Position in `rowIndex` of the first nonzero element
+     *                  of each column. Length `n+1`, where the last element
+     *                  is the total number of nonzero elements.
+     * @param rowIndex  Row indices of the nonzero elements of each column.
+     *                  Within each column, the row indices must be in
+     *                  increasing order.
+     */
+    SparseMatrix(size_t n, const std::vector<size_t>& colStart,
+                 const std::vector<size_t>& rowIndex);
+
+    //! Copy constructor
+    SparseMatrix(const SparseMatrix& y);
+
+    //! Assignment operator
+    SparseMatrix& operator=(const SparseMatrix& y);
+
+    //! Set the nonzero structure of the matrix
+    /*!
+     *  All data and any previous factorization are lost. See the
+     *  constructor for a description of the arguments.
+     */
+    void setStructure(size_t n, const std::vector<size_t>& colStart,
+                      const std::vector<size_t>& rowIndex);
+
+    doublereal& operator()(size_t i, size_t j);
+    doublereal operator()(size_t i, size_t j) const;
+
+    //! Return a changeable reference to element (i,j).
+    /*!
+     *  Since this method may alter the element value, it may need to be
+     *  refactored, so the flag m_factored is set to false. An exception is
+     *  thrown if (i,j) is not part of the structure of the matrix.
+     *
+     *  @param i  row
+     *  @param j  column
+     */
+    doublereal& value(size_t i, size_t j);
+
+    //! Return the value of element (i,j), which is zero for elements that are
+    //! not part of the structure of the matrix.
+    /*!
+     *  @param i  row
+     *  @param j  column
+     */
+    doublereal value(size_t i, size_t j) const;
+
+    //! Returns the location in the internal array of nonzero elements
+    //! corresponding to element (i,j), or `npos` if (i,j) is not part of
+    //! the structure of the matrix.
+    size_t index(size_t i, size_t j) const;
+
+    virtual size_t nRows() const;
+
+    //! Return the size and structure of the matrix
+    /*!
+     * @param iStruct OUTPUT Pointer to a vector of ints that describe the
+     *    structure of the matrix.
+     *    istruct[0] = number of nonzero elements of the matrix
+     *    istruct[1] = number of nonzero elements of the LU factors
+     *
+     * @return  returns the number of rows and columns in the matrix.
+     */
+    virtual size_t nRowsAndStruct(size_t* const iStruct = 0) const;
+
+    //! Number of columns
+    size_t nColumns() const {
+        return m_n;
+    }
+
+    //! Number of nonzero elements in the structure of the matrix
+    size_t nNonzeros() const {
+        return m_rowIndex.size();
+    }
+
+    //! Number of nonzero elements in the L and U factors, including fill-in.
+    //! Zero if the matrix has never been factored.
+    size_t nFactorNonzeros() const {
+        return m_Lx.size() + m_Ux.size();
+    }
+
+    //! Approximate memory used to store the matrix and its LU factors,
+    //! including the index arrays, in bytes
+    size_t memoryUsage() const;
+
+    //! Number of complete (symbolic and numeric) factorizations
+    int nFactorizations() const {
+        return m_nfactor;
+    }
+
+    //! Number of factorizations which reused the pivot sequence and
+    //! structure of a previous factorization
+    int nRefactorizations() const {
+        return m_nrefactor;
+    }
+
+    //! Set the threshold used for partial pivoting.
+    /*!
+     *  A diagonal element is accepted as the pivot if its magnitude is at
+     *  least `tol` times the largest candidate in its column. When the pivot
+     *  sequence is reused, the same test determines whether a new complete
+     *  factorization is needed. `tol` = 1 corresponds to conventional
+     *  partial pivoting.
+     */
+    void setPivotThreshold(doublereal tol);
+
+    //! Set the drop tolerance for an incomplete LU factorization.
+    /*!
+     *  If `tol` is positive, elements of the L and U factors whose magnitude
+     *  is smaller than `tol` times the largest element in the same column of
+     *  the matrix are discarded during the factorization, which limits the
+     *  fill-in. The result is only an approximate factorization, suitable
+     *  for use as a preconditioner. The default, `tol` = 0, gives a complete
+     *  factorization.
+     */
+    void setDropTolerance(doublereal tol);
+
+    //! Discard the pivot sequence and structure of the factors, so that
+    //! they are determined again by the next factorization. Useful with
+    //! incomplete factorization, where the structure of the factors depends
+    //! on the values of the matrix elements.
+    void clearSymbolicFactorization() {
+        m_symbolic = false;
+        m_factored = false;
+    }
+
+    //! The drop tolerance for incomplete LU factorization.
+    //! @see setDropTolerance()
+    doublereal dropTolerance() const {
+        return m_droptol;
+    }
+
+    virtual void mult(const doublereal* b, doublereal* prod) const;
+    virtual void leftMult(const doublereal* const b, doublereal* const prod) const;
+
+    //! Perform an LU decomposition.
+    /*!
+     * @return Return a success flag.
+     *         0 indicates a success
+     *         > 0 The matrix is singular. The value is one plus the index of
+     *             the column where no nonzero pivot could be found.
+     */
+    int factor();
+
+    //! Solve the matrix problem Ax = b
+    /*!
+     *  @param b  INPUT rhs of the problem
+     *  @param x  OUTPUT solution to the problem
+     *
+     * @return Return a success flag, as for factor().
+     */
+    int solve(const doublereal* const b, doublereal* const x);
+
+    //! Solve the matrix problem Ax = b
+    /*!
+     *  @param b     INPUT rhs of the problem
+     *               OUTPUT solution to the problem
+     *  @param nrhs  Number of right hand sides to solve
+     *  @param ldb   Leading dimension of `b`. Default is nColumns()
+     *
+     * @return Return a success flag, as for factor().
+     */
+    int solve(doublereal* b, size_t nrhs=1, size_t ldb=0);
+
+    //! Solve the transposed matrix problem A^T x = b
+    /*!
+     *  The LU factorization of A is used, so no additional factorization is
+     *  required if the matrix has already been factored.
+     *
+     *  @param b     INPUT rhs of the problem
+     *               OUTPUT solution to the problem
+     *  @param nrhs  Number of right hand sides to solve
+     *  @param ldb   Leading dimension of `b`. Default is nColumns()
+     *
+     * @return Return a success flag, as for factor().
+     */
+    virtual int solveTranspose(doublereal* b, size_t nrhs=1, size_t ldb=0);
+
+    //! Returns an iterator for the start of the nonzero elements, stored
+    //! column by column.
+    virtual vector_fp::iterator begin();
+
+    //! Returns an iterator for the end of the nonzero elements
+    vector_fp::iterator end();
+
+    //! Returns a const iterator for the start of the nonzero elements
+    vector_fp::const_iterator begin() const;
+
+    //! Returns a const iterator for the end of the nonzero elements
+    vector_fp::const_iterator end() const;
+
+    virtual void zero();
+
+    //! Not implemented for sparse matrices.
+    virtual doublereal rcond(doublereal a1norm);
+
+    //! Returns the factor algorithm used.  This method will always return 0
+    //! (LU) for sparse matrices.
+    virtual int factorAlgorithm() const;
+
+    //! Returns the one norm of the matrix
+    virtual doublereal oneNorm() const;
+
+    virtual GeneralMatrix* duplMyselfAsGeneralMatrix() const;
+
+    //! Not implemented for sparse matrices, since the columns are not stored
+    //! as contiguous dense arrays.
+    virtual doublereal* ptrColumn(size_t j);
+
+    //! Not implemented for sparse matrices.
+    virtual doublereal* const* colPts();
+
+    //! Copy the data from another SparseMatrix with the same structure
+    virtual void copyData(const GeneralMatrix& y);
+
+    virtual size_t checkRows(doublereal& valueSmall) const;
+    virtual size_t checkColumns(doublereal& valueSmall) const;
+
+    //! Change the way the matrix is factored. Only LU factorization is
+    //! supported.
+    virtual void useFactorAlgorithm(int fAlgorithm);
+
+protected:
+    //! Complete factorization, which determines a new pivot sequence and
+    //! the structure of the factors. Returns 0 on success, or one plus the
+    //! index of the column where the factorization failed.
+    int factorComplete();
+
+    //! Numerical factorization using the pivot sequence and structure from
+    //! the last complete factorization. Returns false if a pivot is no
+    //! longer acceptable.
+    bool refactor();
+
+    //! Find the rows of L \ A(:,k) which may be nonzero, as a topologically
+    //! ordered list in m_iwork[top:n]. Returns `top`.
+    size_t reach(size_t k);
+
+    //! Number of rows and columns of the matrix
+    size_t m_n;
+
+    //! Position in m_rowIndex / m_data of the first element of each column
+    std::vector<size_t> m_colStart;
+
+    //! Row index of each nonzero element
+    vector_int m_rowIndex;
+
+    //! Values of the nonzero elements
+    vector_fp m_data;
+
+    //! Column starts of the L factor, which has a unit diagonal stored as
+    //! the first element of each column
+    std::vector<size_t> m_Lp;
+    //! Row indices (in pivot order) of the L factor
+    vector_int m_Li;
+    //! Values of the L factor
+    vector_fp m_Lx;
+
+    //! Column starts of the U factor, which has the diagonal element stored
+    //! last in each column
+    std::vector<size_t> m_Up;
+    //! Row indices (in pivot order) of the U factor
+    vector_int m_Ui;
+    //! Values of the U factor
+    vector_fp m_Ux;
+
+    //! Pivot position of each row of the original matrix
+    std::vector<size_t> m_pinv;
+
+    //! True if the pivot sequence and structure of the factors are available
+    //! to be reused
+    bool m_symbolic;
+
+    //! Threshold for partial pivoting
+    doublereal m_pivtol;
+
+    //! Drop tolerance for incomplete factorization
+    doublereal m_droptol;
+
+    int m_nfactor;
+    int m_nrefactor;
+
+    //! value of zero
+    doublereal m_zero;
+
+    //! Work arrays
+    vector_fp m_work;
+    std::vector<size_t> m_iwork;
+    std::vector<size_t> m_stack;
+    std::vector<char> m_mark;
+};
+
+//! Utility routine to print out the matrix
+/*!
+ *  @param s  ostream to print the matrix out to
+ *  @param m  Matrix to be printed
+ *
+ *  @return Returns a reference to the ostream
+ */
+std::ostream& operator<<(std::ostream& s, const SparseMatrix& m);
+
+}
+
+#endif
@@ -364,6 +364,11 @@ public:
 
     virtual void setJac(MultiJac* jac) {}
 
+    //! Force the domain to update all of its properties when evaluating the
+    //! Jacobian, rather than holding the more expensive ones (e.g. transport
+    //! properties) fixed. This gives an exact Jacobian at the cost of speed.
+    virtual void forceFullUpdate(bool update) {}
+
     //! Save the current solution for this domain into an XML_Node
     /*!
      *  Base class version of the general domain1D save function. Derived
@@ -9,7 +9,7 @@
 #ifndef CT_MULTIJAC_H
 #define CT_MULTIJAC_H
 
-#include "cantera/numerics/BandMatrix.h"
+#include "cantera/numerics/GeneralMatrix.h"
 #include "OneDim.h"
 
 namespace Cantera
@@ -20,12 +20,26 @@ namespace Cantera
  * defined by a residual function supplied by an instance of class
  * OneDim. The residual function may consist of several linked
  * 1D domains, with different variables in each domain.
+ *
+ * The Jacobian is stored and factored using either a BandMatrix, with a
+ * bandwidth equal to the largest bandwidth of any of the domains, or a
+ * SparseMatrix, which stores only the blocks coupling each grid point to
+ * its neighbors. The sparse solver uses less memory and time when the
+ * bandwidth is set by a single wide domain or by the coupling between
+ * domains.
  * @ingroup onedim
  */
-class MultiJac : public BandMatrix
+class MultiJac
 {
 public:
-    MultiJac(OneDim& r);
+    //! Constructor.
+    /*!
+     *  @param r       Residual evaluator
+     *  @param solver  Linear solver to use. Either #c_Band_LinearSolver or
+     *                 #c_Sparse_LinearSolver.
+     */
+    MultiJac(OneDim& r, int solver=c_Band_LinearSolver);
+    virtual ~MultiJac();
 
     /**
      * Evaluate the Jacobian at x0. The unperturbed residual
@@ -35,7 +49,7 @@ public:
      */
     void eval(doublereal* x0, doublereal* resid0, double rdt);
 
-    //! Elapsed CPU time spent computing the Jacobian.
+    //! Elapsed time spent computing the Jacobian.
     doublereal elapsedTime() const {
         return m_elapsed;
     }
@@ -69,7 +83,87 @@ public:
 
     void incrementDiagonal(int j, doublereal d);
 
+    //! Return a changeable reference to element (i,j). For the sparse
+    //! solver, (i,j) must couple two neighboring grid points.
+    doublereal& value(size_t i, size_t j) {
+        return (*m_mat)(i,j);
+    }
+
+    //! Return the value of element (i,j)
+    doublereal value(size_t i, size_t j) const {
+        return (*static_cast<const GeneralMatrix*>(m_mat))(i,j);
+    }
+
+    //! Number of rows and columns
+    size_t nRows() const {
+        return m_size;
+    }
+
+    //! Solve J x = b. The Jacobian is factored first if necessary.
+    /*!
+     *  @return 0 if successful. A positive value is one plus the index of
+     *      a row or column where a zero pivot was found.
+     */
+    int solve(const doublereal* const b, doublereal* const x);
+
+    //! Solve J^T x = b in place, using the factorization of J.
+    int solveTranspose(doublereal* b);
+
+    //! Multiply the Jacobian by `b` and write the result to `prod`.
+    void mult(const doublereal* b, doublereal* prod) const {
+        m_mat->mult(b, prod);
+    }
+
+    //! Multiply `b` by the Jacobian from the left and write the result to
+    //! `prod`.
+    void leftMult(const doublereal* const b, doublereal* const prod) const {
+        m_mat->leftMult(b, prod);
+    }
+
+    //! The matrix used to store and factor the Jacobian. A BandMatrix or a
+    //! SparseMatrix, depending on linearSolver().
+    GeneralMatrix& matrix() {
+        return *m_mat;
+    }
+
+    //! The linear solver type, either #c_Band_LinearSolver or
+    //! #c_Sparse_LinearSolver.
+    int linearSolver() const {
+        return m_solver;
+    }
+
+    //! Approximate memory used to store the Jacobian and its factorization,
+    //! in bytes.
+    size_t memoryUsage() const;
+
+    //! Elapsed time spent factoring the Jacobian and solving linear
+    //! systems.
+    doublereal solveTime() const {
+        return m_solve_time;
+    }
+
+    //! Number of times the Jacobian has been factored
+    int nFactorizations() const {
+        return m_nfactor;
+    }
+
 protected:
+    //! Set up the structure of the sparse matrix. Each column has nonzero
+    //! elements in the rows for the same grid point and its two neighbors.
+    void setSparseStructure();
+
+    //! Matrix storing the Jacobian
+    GeneralMatrix* m_mat;
+
+    //! Linear solver type
+    int m_solver;
+
+    //! Time spent in solve()
+    doublereal m_solve_time;
+
+    //! Number of factorizations
+    int m_nfactor;
+
     //!  Residual evaluator for this jacobian
     /*!
      *  This is a pointer to the residual evaluator. This object isn't owned
@@ -86,6 +180,10 @@ protected:
     int m_age;
     size_t m_size;
     size_t m_points;
+
+private:
+    MultiJac(const MultiJac&);
+    MultiJac& operator=(const MultiJac&);
 };
 }
 
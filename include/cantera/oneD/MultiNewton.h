@@ -74,6 +74,38 @@ public:
     /// Change the problem size.
     void resize(size_t points);
 
+    //! @name Statistics
+    //!
+    //! Counters and timers accumulated since the last call to clearStats().
+    //! @{
+
+    //! Number of Newton iterations, i.e. the number of undamped Newton steps
+    //! computed by solve(), not counting the trial steps in dampStep().
+    int nIterations() const {
+        return m_nIterations;
+    }
+
+    //! Number of times the damping coefficient was reduced because the
+    //! damped step did not decrease the norm of the next undamped step
+    int nDampReductions() const {
+        return m_nDampReductions;
+    }
+
+    //! Number of calls to solve() that did not converge
+    int nFailures() const {
+        return m_nFailures;
+    }
+
+    //! Time [s] spent in solve(), including evaluating the residual and
+    //! the Jacobian
+    doublereal elapsedTime() const {
+        return m_elapsed;
+    }
+
+    //! Reset the counters and timers to zero
+    void clearStats();
+    //! @}
+
 protected:
     //! Get a pointer to an array of length m_n for temporary work space.
     doublereal* getWorkArray();
@@ -87,6 +119,10 @@ protected:
     size_t m_nv, m_np, m_n;
     doublereal m_elapsed;
 
+    int m_nIterations;
+    int m_nDampReductions;
+    int m_nFailures;
+
 private:
     char m_buf[100];
 };
@@ -13,6 +13,17 @@ namespace Cantera
 class MultiNewton;
 class Func1;
 
+//! @name Linear solvers for the Newton iteration
+//! @{
+
+//! Banded LU solver, using LAPACK. The bandwidth is the largest bandwidth of
+//! any domain or of the coupling between adjacent domains.
+const int c_Band_LinearSolver = 0;
+
+//! Sparse LU solver, storing only the blocks coupling neighboring points.
+const int c_Sparse_LinearSolver = 1;
+//! @}
+
 /**
  * Container class for multiple-domain 1D problems. Each domain is
  * represented by an instance of Domain1D.
@@ -111,6 +122,15 @@ public:
         return m_bw;
     }
 
+    //! Set the linear solver used by the Newton iteration. Either
+    //! #c_Band_LinearSolver (the default) or #c_Sparse_LinearSolver.
+    void setLinearSolver(int solver);
+
+    //! The linear solver used by the Newton iteration.
+    int linearSolver() const {
+        return m_linear_solver;
+    }
+
     /*!
      * Initialize all domains. On the first call, this methods calls the init
      * method of each domain, proceeding from left to right. Subsequent calls
@@ -229,21 +249,53 @@ public:
     }
 
     /**
-     * Save statistics on function and Jacobian evaluation, and reset the
+     * Save statistics on the solver for the current grid, and reset the
      * counters. Statistics are saved only if the number of Jacobian
-     * evaluations is greater than zero. The statistics saved are:
+     * evaluations is greater than zero. The statistics saved, with the names
+     * used by getStatistic(), are:
+     *
+     *    - `points`: number of grid points
+     *    - `residual_evals`, `residual_time`: number of non-Jacobian
+     *      function evaluations, and the time spent in them
+     *    - `jacobian_evals`, `jacobian_time`: number of Jacobian evaluations,
+     *      and the time spent in them
+     *    - `factorizations`, `linear_solve_time`: number of Jacobian
+     *      factorizations, and the time spent factoring the Jacobian and
+     *      solving linear systems
+     *    - `newton_iterations`, `damping_reductions`, `newton_failures`,
+     *      `newton_time`: number of Newton iterations, reductions of the
+     *      damping coefficient, and unsuccessful Newton solves, and the
+     *      time spent in the Newton solver
+     *    - `time_steps`, `time_step_failures`: number of successful and
+     *      failed pseudo-time steps
+     *    - `thermo_time`, `kinetics_time`, `transport_time`: time spent
+     *      evaluating properties in the flow domains, if enabled with
+     *      setPropertyTiming()
      *
-     *    - number of grid points
-     *    - number of Jacobian evaluations
-     *    - CPU time spent evaluating Jacobians
-     *    - number of non-Jacobian function evaluations
-     *    - CPU time spent evaluating functions
+     * All times are in seconds.
      */
     void saveStats();
 
     //! Clear saved statistics
     void clearStats();
 
+    //! Names of the statistics saved for each grid. @see saveStats()
+    static std::vector<std::string> statisticNames();
+
+    //! Get the values of one of the statistics for each grid, including the
+    //! current grid. @see saveStats()
+    void getStatistic(const std::string& name, vector_fp& values) const;
+
+    //! Return the statistics for each grid, including the current grid, as a
+    //! JSON object where each member is the list of values of one statistic.
+    //! @see saveStats()
+    std::string statisticsJSON() const;
+
+    //! Enable or disable timing of thermodynamic, kinetic and transport
+    //! property evaluation in the flow domains. Timing is disabled by
+    //! default, since it adds a small cost to each residual evaluation.
+    void setPropertyTiming(bool enable);
+
     //! Set a function that will be called every time #eval is called.
     //! Can be used to provide keyboard interrupt support in the high-level
     //! language interfaces.
@@ -269,6 +321,7 @@ protected:
 
     size_t m_bw;                 // Jacobian bandwidth
     size_t m_size;               // solution vector size
+    int m_linear_solver;         // linear solver type
 
     std::vector<Domain1D*> m_dom, m_connect, m_bulk;
 
@@ -289,11 +342,15 @@ private:
     // statistics
     int m_nevals;
     doublereal m_evaltime;
-    std::vector<size_t> m_gridpts;
-    vector_int m_jacEvals;
-    vector_fp m_jacElapsed;
-    vector_int m_funcEvals;
-    vector_fp m_funcElapsed;
+    int m_nTimeSteps;
+    int m_nTimeStepFailures;
+
+    //! Get the statistics for the current grid, by name. Returns false if
+    //! there are no statistics to save for this grid.
+    bool currentStats(std::map<std::string, double>& stats) const;
+
+    //! Statistics saved for each grid, by name. @see saveStats()
+    std::map<std::string, vector_fp> m_stats;
 };
 
 }
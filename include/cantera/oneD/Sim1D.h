@@ -115,9 +115,77 @@ public:
         OneDim::eval(npos, DATA_PTR(m_x), DATA_PTR(m_xnew), rdt, count);
     }
 
-    /// Refine the grid in all domains.
+    //! Refine the grid in all domains.
+    /*!
+     *  Points are added where the Refiner of each domain requests them, and
+     *  points which are no longer needed are removed. The solution is
+     *  transferred to the new grid using the method set by
+     *  setInterpolation().
+     *
+     *  @return the number of points added, or a negative number if the
+     *      maximum number of grid points has been reached. Points which are
+     *      removed are not counted.
+     */
     int refine(int loglevel=0);
 
+    //! Set the method used to interpolate the solution onto the points added
+    //! during grid refinement.
+    /*!
+     *  @param method "linear" (the default) or "cubic". The cubic method uses
+     *      a monotone piecewise cubic Hermite interpolant, which does not
+     *      introduce new extrema, and gives a better initial estimate for the
+     *      Newton iteration on the refined grid where profiles are curved.
+     */
+    void setInterpolation(const std::string& method);
+
+    //! The method used to interpolate the solution during grid refinement
+    std::string interpolation() const;
+
+    //! @name Grid refinement statistics
+    //!
+    //! Statistics for each pass of the solve / refine loop in the most recent
+    //! call to solve(). Each pass consists of solving the problem on the
+    //! current grid, followed by refining the grid if refinement is enabled.
+    //! @{
+
+    //! Number of passes in the most recent call to solve()
+    size_t nRefinePasses() const {
+        return m_passPoints.size();
+    }
+
+    //! Total number of grid points in each pass
+    const std::vector<size_t>& passGridPoints() const {
+        return m_passPoints;
+    }
+
+    //! Number of points added by grid refinement at the end of each pass
+    const vector_int& passPointsAdded() const {
+        return m_passAdded;
+    }
+
+    //! Number of points removed by grid refinement at the end of each pass
+    const vector_int& passPointsRemoved() const {
+        return m_passRemoved;
+    }
+
+    //! Number of time steps taken before the Newton iteration converged in
+    //! each pass
+    const vector_int& passTimeSteps() const {
+        return m_passTimeSteps;
+    }
+
+    //! Time [s] spent solving the problem on the grid of each pass
+    const vector_fp& passSolveTime() const {
+        return m_passSolveTime;
+    }
+
+    //! Time [s] spent refining the grid and transferring the solution at
+    //! the end of each pass
+    const vector_fp& passRefineTime() const {
+        return m_passRefineTime;
+    }
+    //! @}
+
     //! Add node for fixed temperature point of freely propagating flame
     int setFixedTemperature(doublereal t);
 
@@ -155,6 +223,56 @@ public:
 
     void evalSSJacobian();
 
+    //! @name Adjoint sensitivity analysis
+    //! @{
+
+    //! Solve the equation \f$ J^T \lambda = b \f$.
+    /*!
+     *  Here, \f$ J = \partial F/\partial x \f$ is the Jacobian matrix of
+     *  the steady-state residual, evaluated at the current solution. The
+     *  Jacobian is evaluated and factored once, and the transposed system is
+     *  solved using the same LU factorization used by the Newton solver.
+     *
+     *  @param b       Right-hand side vector. Length: size().
+     *  @param lambda  Output solution vector. Length: size().
+     */
+    void solveAdjoint(const doublereal* b, doublereal* lambda);
+
+    //! Compute the sensitivities of a scalar objective *g* to the rate
+    //! constants of all reactions.
+    /*!
+     *  The objective must depend only on the solution vector, and
+     *  `dgdx` is its gradient \f$ \partial g/\partial x \f$. On return,
+     *  `sens[i]` contains \f$ dg/d\ln k_i \f$ for each reaction *i* of the
+     *  kinetics manager used by the flow domain(s). The cost is that of one
+     *  Jacobian evaluation and one linear solve, independent of the number
+     *  of reactions.
+     *
+     *  @param dgdx  Gradient of the objective. Length: size().
+     *  @param sens  Output vector of sensitivities.
+     */
+    void getReactionSensitivities(const doublereal* dgdx, vector_fp& sens);
+
+    //! Compute the sensitivities of one solution component to the rate
+    //! constants of all reactions.
+    /*!
+     *  This can be used to compute the sensitivity of the burning velocity
+     *  (component "u" at the first point of a free flame), of the temperature
+     *  at its peak, or of a species mass fraction at a point. Returns the
+     *  current value of the component.
+     *
+     *  @param dom domain number, beginning with 0 for the leftmost domain.
+     *  @param comp component number
+     *  @param localPoint grid point within the domain, beginning with 0 for
+     *      the leftmost grid point in the domain.
+     *  @param sens  Output vector of sensitivities \f$ dx/d\ln k_i \f$.
+     *  @see getReactionSensitivities
+     */
+    doublereal componentReactionSensitivities(size_t dom, size_t comp,
+                                              size_t localPoint,
+                                              vector_fp& sens);
+    //! @}
+
 protected:
     //! the solution vector
     vector_fp m_x;
@@ -169,6 +287,18 @@ protected:
     //! solution
     vector_int m_steps;
 
+    //! Interpolate the solution onto new grid points using a monotone cubic
+    //! interpolant, rather than linearly
+    bool m_cubic_interp;
+
+    //! Grid refinement statistics. @see nRefinePasses()
+    std::vector<size_t> m_passPoints;
+    vector_int m_passAdded;
+    vector_int m_passRemoved;
+    vector_int m_passTimeSteps;
+    vector_fp m_passSolveTime;
+    vector_fp m_passRefineTime;
+
 private:
     /// Calls method _finalize in each domain.
     void finalize();
@@ -177,6 +307,16 @@ private:
      * @return 0 if successful, -1 on failure
      */
     int newtonSolve(int loglevel);
+
+    //! Refine the grid, and return the number of points added plus the
+    //! number removed, which is used by solve() to decide whether the
+    //! problem needs to be solved again on the new grid.
+    //! @see refine(int)
+    int refine(int loglevel, int& added, int& removed);
+
+    //! Value of component `i` of domain `n` interpolated to the midpoint of
+    //! the interval between grid points `m` and `m+1`.
+    doublereal midpointValue(size_t n, size_t i, size_t m);
 };
 
 }
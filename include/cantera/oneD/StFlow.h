@@ -8,6 +8,7 @@
 
 #include "Domain1D.h"
 #include "cantera/base/Array.h"
+#include "cantera/base/clockWC.h"
 #include "cantera/thermo/IdealGasPhase.h"
 #include "cantera/kinetics/Kinetics.h"
 
@@ -272,6 +273,52 @@ public:
         m_dovisc = dovisc;
     }
 
+    virtual void forceFullUpdate(bool update) {
+        m_force_full_update = update;
+    }
+
+    //! @name Property evaluation timing
+    //!
+    //! Time spent evaluating the properties needed by the residual
+    //! equations, accumulated over all calls to eval() while timing is
+    //! enabled, since the last call to clearPropertyTimers().
+    //! @{
+
+    //! Enable or disable the property evaluation timers. Timing is disabled
+    //! by default, since it adds a small cost to each grid point evaluation.
+    void setPropertyTiming(bool enable) {
+        m_timing = enable;
+    }
+
+    //! True if the property evaluation timers are enabled
+    bool propertyTiming() const {
+        return m_timing;
+    }
+
+    //! Time [s] spent setting the gas state and evaluating thermodynamic
+    //! properties.
+    doublereal thermoTime() const {
+        return m_thermo_time;
+    }
+
+    //! Time [s] spent evaluating the species production rates.
+    doublereal kineticsTime() const {
+        return m_kinetics_time;
+    }
+
+    //! Time [s] spent evaluating transport properties.
+    doublereal transportTime() const {
+        return m_transport_time;
+    }
+
+    //! Reset the property evaluation timers to zero.
+    void clearPropertyTimers() {
+        m_thermo_time = 0.0;
+        m_kinetics_time = 0.0;
+        m_transport_time = 0.0;
+    }
+    //! @}
+
     /*!
      *  Evaluate the residual function for axisymmetric stagnation flow. If
      *  jpt is less than zero, the residual function is evaluated at all grid
@@ -282,6 +329,28 @@ public:
     virtual void eval(size_t j, doublereal* x, doublereal* r,
                       integer* mask, doublereal rdt);
 
+    //! Evaluate the derivatives of the steady-state residual with respect to
+    //! the reaction rates, projected onto the vector `lambdag`.
+    /*!
+     *  For each reaction *i*, the quantity
+     *  \f[
+     *      \sum_n \lambda_n \frac{\partial F_n}{\partial \ln m_i}
+     *  \f]
+     *  is added to `dfdp[i]`, where \f$ F \f$ is the residual evaluated
+     *  by #eval with `rdt = 0` and \f$ m_i \f$ is the rate multiplier of
+     *  reaction *i*. Only the species and energy equations at interior points
+     *  depend on the reaction rates, so the derivatives are evaluated
+     *  analytically from the net rates of progress at each point. This is
+     *  the parameter derivative needed by the adjoint sensitivity analysis
+     *  implemented by Sim1D::getReactionSensitivities.
+     *
+     *  @param xg      Global solution vector
+     *  @param lambdag Global vector (usually the adjoint solution)
+     *  @param dfdp    Output array of length `kinetics().nReactions()`
+     */
+    void evalRateDerivatives(const doublereal* xg, const doublereal* lambdag,
+                             doublereal* dfdp);
+
     //! Evaluate all residual components at the right boundary.
     virtual void evalRightBoundary(doublereal* x, doublereal* res,
                                    integer* diag, doublereal rdt) = 0;
@@ -314,6 +383,21 @@ protected:
         m_kin->getNetProductionRates(&m_wdot(0,j));
     }
 
+    //! Update the properties needed to evaluate the residual equations at
+    //! points `jmin` to `jmax`, based on solution `x`.
+    /*!
+     *  The thermodynamic properties and production rates at each grid point
+     *  are evaluated in one pass, after setting the state of the gas once.
+     *  The thermodynamic properties are updated at points `jmin-1` to
+     *  `jmax+1`, and the production rates, the species heat capacities and
+     *  the heat release rate at the interior points from `jmin` to `jmax`.
+     *  Transport properties are then updated at the midpoints between points
+     *  `jmin-1` and `jmax+1` if `jg` is `npos` or a full update has been
+     *  requested.
+     */
+    void updateProperties(size_t jg, const doublereal* x, size_t jmin,
+                          size_t jmax);
+
     /**
      * Update the thermodynamic properties from point j0 to point j1
      * (inclusive), based on solution x.
@@ -458,6 +542,10 @@ protected:
     vector_fp m_wt;
     vector_fp m_cp;
     vector_fp m_enth;
+    Array2D m_cp_R; //!< species heat capacities at each point
+
+    //! heat release rate [W/m^3] at each point
+    vector_fp m_qdot;
 
     // transport properties
     vector_fp m_visc;
@@ -499,6 +587,24 @@ protected:
 
     bool m_dovisc;
 
+    //! Update transport properties even when evaluating the Jacobian
+    bool m_force_full_update;
+
+    //! Update the property evaluation timers
+    bool m_timing;
+
+    //! Time spent evaluating properties. @see thermoTime()
+    doublereal m_thermo_time;
+    doublereal m_kinetics_time;
+    doublereal m_transport_time;
+
+    //! Timer used for the property evaluation times
+    clockWC m_clock;
+
+    //! Update the transport properties at the midpoint between points `j`
+    //! and `j+1`, based on solution `x`.
+    void updateTransport(const doublereal* x, size_t j);
+
     //! Update the transport properties at grid points in the range from `j0`
     //! to `j1`, based on solution `x`.
     void updateTransport(doublereal* x, size_t j0, size_t j1);
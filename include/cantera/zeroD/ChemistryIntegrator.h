@@ -0,0 +1,181 @@
+/**
+ *  @file ChemistryIntegrator.h
+ */
+
+#ifndef CT_CHEMISTRYINTEGRATOR_H
+#define CT_CHEMISTRYINTEGRATOR_H
+
+#include "cantera/thermo/ThermoPhase.h"
+#include "cantera/kinetics/Kinetics.h"
+
+namespace Cantera
+{
+
+//! A lightweight stiff integrator for the homogeneous chemistry of an
+//! adiabatic, constant pressure ideal gas.
+/*!
+ *  This class solves the same equations as an isolated
+ *  IdealGasConstPressureReactor, but without the overhead of the general
+ *  ReactorNet / CVODES machinery for walls, flow devices and surfaces. It is
+ *  intended for operator-split reacting flow simulations, where the
+ *  chemistry in each cell is advanced over a time step many times per flow
+ *  step.
+ *
+ *  The state vector is the temperature followed by the mass fractions of
+ *  the species. The equations are integrated using the three-stage,
+ *  L-stable Rosenbrock method ROS3 of Sandu et al., "Benchmarking stiff ODE
+ *  solvers for atmospheric chemistry problems II: Rosenbrock solvers,"
+ *  Atmos. Environ. 31:3459-3472 (1997), with an embedded second order
+ *  error estimate for step size control. The Jacobian is evaluated once for
+ *  each step. The columns for the mass fractions are computed analytically
+ *  from Kinetics::getNetProductionRates_ddC(), and the column for the
+ *  temperature by a single finite difference.
+ *
+ *  The work arrays are allocated by the constructor, except for those used
+ *  to compute the derivatives of the final state, which are allocated by the
+ *  first call which requests them; integrate() does not allocate memory
+ *  otherwise. An instance of this class, together with its ThermoPhase and
+ *  Kinetics objects, must only be used by one thread at a time.
+ *  Multithreaded applications should create one instance, with its own
+ *  phase and kinetics objects, for each thread.
+ *
+ *  @ingroup ZeroD
+ */
+class ChemistryIntegrator
+{
+public:
+    //! Create an integrator for the ideal gas *thermo* with the reactions
+    //! in *kin*.
+    ChemistryIntegrator(ThermoPhase& thermo, Kinetics& kin);
+
+    //! Number of equations: the temperature and the mass fractions
+    size_t neq() const {
+        return m_nv;
+    }
+
+    //! Set the relative and absolute tolerances. The absolute tolerance
+    //! applies to the mass fractions; the absolute tolerance for the
+    //! temperature is fixed at 1.0e-6 K.
+    void setTolerances(double rtol, double atol);
+
+    //! Set the maximum number of steps taken by each call to integrate()
+    void setMaxSteps(size_t nmax) {
+        m_maxSteps = nmax;
+    }
+
+    //! Set the size of the first step taken by each call to integrate(). If
+    //! *h* is zero (the default), the size of the first step is estimated
+    //! from the initial rates of change.
+    void setInitialStepSize(double h) {
+        m_h0 = h;
+    }
+
+    //! The step size proposed at the end of the most recent call to
+    //! integrate(), which can be used with setInitialStepSize() to
+    //! advance a similar state.
+    double lastStepSize() const {
+        return m_hlast;
+    }
+
+    //! Advance the state of the gas at constant pressure.
+    /*!
+     *  @param[in,out] T  temperature [K]
+     *  @param[in,out] Y  mass fractions of the species, length nSpecies()
+     *      of the ThermoPhase object
+     *  @param P  pressure [Pa]
+     *  @param dt  time interval [s]. If *dt* is zero, *T* and *Y* are not
+     *      modified. A CanteraError is thrown if *dt* is negative.
+     *  @param[out] dydy0  If not NULL, the derivatives of the final state
+     *      [T, Y] with respect to the initial state, stored in column-major
+     *      order in an array of size neq() by neq(). These are computed by
+     *      applying each step of the method to the linearized equations,
+     *      using the Jacobian at the start of the step.
+     *
+     *  On return, the ThermoPhase object is set to the final state. A
+     *  CanteraError is thrown if the integration fails, in which case the
+     *  ThermoPhase object is set to the initial state and *T* and *Y* are
+     *  not modified.
+     */
+    void integrate(double& T, double* Y, double P, double dt,
+                   double* dydy0=0);
+
+    //! Set the pressure [Pa] used by eval() and evalJacobian(). This is set
+    //! by integrate().
+    void setPressure(double P) {
+        m_pressure = P;
+    }
+
+    //! Evaluate the right-hand side of the governing equations at the state
+    //! *y* = [T, Y] and the pressure set by setPressure().
+    void eval(const double* y, double* ydot);
+
+    //! Evaluate the Jacobian of the governing equations at the state *y*,
+    //! where *ydot* is the right-hand side given by eval(). The Jacobian is
+    //! stored in column-major order in *jac*, of size neq() by neq().
+    void evalJacobian(const double* y, const double* ydot, double* jac);
+
+    //! Get statistics for all calls to integrate(): the number of accepted
+    //! ("steps") and rejected ("err_test_fails") steps, and the numbers of
+    //! right-hand-side ("rhs_evals") and Jacobian ("jac_evals") evaluations
+    //! and LU factorizations ("lin_solve_setups").
+    void getSolverStats(std::map<std::string, long int>& stats) const;
+
+    //! Reset the statistics returned by getSolverStats()
+    void resetSolverStats();
+
+protected:
+    //! Update the derivatives *X* of the current state with respect to the
+    //! initial state for an accepted step of size *h*
+    void propagateGradient(double h, double* X);
+
+    //! Compute *out* = J * *X* for the *neq* by *neq* matrix *X*
+    void multiplyJacobian(const double* X, double* out) const;
+
+    //! Weighted root-mean-square norm of *x*, using the tolerances and the
+    //! magnitudes of the states *y0* and *y1*
+    double errorNorm(const double* x, const double* y0, const double* y1) const;
+
+    ThermoPhase& m_thermo;
+    Kinetics& m_kin;
+
+    size_t m_nsp; //!< Number of species
+    size_t m_nv; //!< Number of equations
+    double m_pressure; //!< Pressure of the current integration [Pa]
+
+    double m_rtol;
+    double m_atol;
+    size_t m_maxSteps;
+    double m_h0; //!< Initial step size, or 0 to estimate it
+    double m_hlast; //!< Step size proposed by the last call to integrate()
+
+    // Statistics
+    long int m_nsteps;
+    long int m_nrejected;
+    long int m_nevals;
+    long int m_njac;
+    long int m_nlu;
+
+    // Work arrays
+    vector_fp m_y; //!< State at the start of the current step
+    vector_fp m_ynew; //!< State at the end of the current step
+    vector_fp m_ystage; //!< State at the second stage
+    vector_fp m_f0; //!< Right-hand side at the start of the current step
+    vector_fp m_f1; //!< Right-hand side at the second stage
+    vector_fp m_K; //!< Stage vectors, 3 x #m_nv
+    vector_fp m_gradK; //!< Stage matrices for propagateGradient()
+    vector_fp m_err; //!< Local error estimate
+    vector_fp m_jac; //!< Jacobian, #m_nv x #m_nv
+    vector_fp m_lu; //!< LU factorization of I/(h*gamma) - J
+    vector_int m_ipiv; //!< Pivots of the LU factorization
+    vector_fp m_ddC; //!< Derivatives of the production rates
+    vector_fp m_wdot; //!< Net production rates [kmol/m^3/s]
+    vector_fp m_hk; //!< Partial molar enthalpies
+    vector_fp m_cpk; //!< Partial molar heat capacities
+    vector_fp m_work;
+    double m_rho; //!< Density at the last call to eval()
+    double m_cp; //!< Specific heat capacity at the last call to eval()
+};
+
+}
+
+#endif
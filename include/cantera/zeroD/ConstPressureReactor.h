@@ -36,6 +36,14 @@ public:
     virtual void evalEqs(doublereal t, doublereal* y,
                          doublereal* ydot, doublereal* params);
 
+    //! Analytic derivatives are not implemented for this reactor type
+    virtual bool evalSpeciesJacobian(double t, const double* ydot,
+                                     double* jac, size_t ld) {
+        return false;
+    }
+
+    virtual bool evalParameterAdjoint(const double* lambda, double* dfdp);
+
     virtual void updateState(doublereal* y);
 
     //! Return the index in the solution vector for this reactor of the
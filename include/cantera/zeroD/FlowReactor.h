@@ -30,6 +30,18 @@ public:
     virtual void initialize(doublereal t0 = 0.0);
     virtual void evalEqs(doublereal t, doublereal* y,
                          doublereal* ydot, doublereal* params);
+
+    //! Analytic derivatives are not implemented for this reactor type
+    virtual bool evalSpeciesJacobian(double t, const double* ydot,
+                                     double* jac, size_t ld) {
+        return false;
+    }
+
+    //! Analytic derivatives are not implemented for this reactor type
+    virtual bool evalParameterAdjoint(const double* lambda, double* dfdp) {
+        return false;
+    }
+
     virtual void updateState(doublereal* y);
 
     void setMassFlowRate(doublereal mdot) {
@@ -38,6 +38,8 @@ public:
     virtual void evalEqs(doublereal t, doublereal* y,
                          doublereal* ydot, doublereal* params);
 
+    virtual bool evalParameterAdjoint(const double* lambda, double* dfdp);
+
     virtual void updateState(doublereal* y);
 
     //! Return the index in the solution vector for this reactor of the
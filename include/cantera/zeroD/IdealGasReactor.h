@@ -36,6 +36,11 @@ public:
     virtual void evalEqs(doublereal t, doublereal* y,
                          doublereal* ydot, doublereal* params);
 
+    virtual bool evalSpeciesJacobian(double t, const double* ydot,
+                                     double* jac, size_t ld);
+
+    virtual bool evalParameterAdjoint(const double* lambda, double* dfdp);
+
     virtual void updateState(doublereal* y);
 
     virtual size_t componentIndex(const std::string& nm) const;
@@ -0,0 +1,181 @@
+/**
+ *  @file IsatTable.h
+ */
+
+#ifndef CT_ISATTABLE_H
+#define CT_ISATTABLE_H
+
+#include "ChemistryIntegrator.h"
+#include "cantera/base/ct_thread.h"
+
+namespace Cantera
+{
+
+//! In situ adaptive tabulation (ISAT) of the results of chemistry
+//! integrations over a fixed time step.
+/*!
+ *  The table stores the mapping from the query state
+ *  \f$ \phi = [T, P, Y_1, ..., Y_K] \f$ to the state \f$ R(\phi) = [T, Y_1,
+ *  ..., Y_K] \f$ after an adiabatic, constant pressure integration over the
+ *  time step *dt*, following S. B. Pope, "Computationally efficient
+ *  implementation of combustion chemistry using in situ adaptive
+ *  tabulation," Combust. Theory Modelling 1:41-63 (1997). Each record holds
+ *  a tabulation point \f$ \phi_0 \f$, the mapping \f$ R(\phi_0) \f$, the
+ *  mapping gradient \f$ A = \partial R / \partial \phi \f$ and an ellipsoid
+ *  of accuracy (EOA) \f$ \{ \phi : (\phi - \phi_0)^T M (\phi - \phi_0) \le 1
+ *  \} \f$ within which the linear approximation \f$ R(\phi_0) + A (\phi -
+ *  \phi_0) \f$ is used. The records are the leaves of a binary tree, where
+ *  each node divides the composition space by the plane which bisects the
+ *  tabulation points of its two children.
+ *
+ *  For each query, the tree is traversed to a single leaf:
+ *   - If the query is inside the EOA of the leaf, the result is retrieved
+ *     from the linear approximation.
+ *   - Otherwise, the mapping is computed by direct integration. If the
+ *     error of the linear approximation is within the tolerance, the EOA is
+ *     grown to include the query point. Otherwise, a new record is added,
+ *     unless the memory limit has been reached.
+ *
+ *  Temperatures and pressures are scaled by the reference values set with
+ *  setScales() when computing distances and errors. The gradient with
+ *  respect to the temperature and mass fractions is computed by
+ *  ChemistryIntegrator::integrate(), and the gradient with respect to the
+ *  pressure by a finite difference.
+ *
+ *  A table may be shared by several threads, each of which uses its own
+ *  ChemistryIntegrator. The table is locked while it is searched and
+ *  modified, but not during the integrations.
+ *
+ *  @ingroup ZeroD
+ */
+class IsatTable
+{
+public:
+    //! Create an empty table for a mechanism with *nsp* species and the
+    //! time step *dt* [s].
+    IsatTable(size_t nsp, double dt);
+    virtual ~IsatTable();
+
+    //! The time step [s] of the tabulated mapping
+    double timeStep() const {
+        return m_dt;
+    }
+
+    //! Set the error tolerance for the scaled states. The default is 1e-4.
+    void setTolerance(double tol);
+
+    //! Set the reference temperature [K] and pressure [Pa] used to scale
+    //! the states. The defaults are 1000 K and one atmosphere.
+    void setScales(double T, double P);
+
+    //! Set the maximum amount of memory [bytes] used by the records and the
+    //! tree. Once the limit is reached, no more records are added. The
+    //! default is 100 MB.
+    void setMaxMemory(size_t bytes) {
+        m_maxMemory = bytes;
+    }
+
+    //! Approximate amount of memory [bytes] used by the records and the tree
+    size_t memoryUsage() const;
+
+    //! Number of records in the table
+    size_t nRecords() const;
+
+    //! Remove all of the records from the table
+    void clear();
+
+    //! Advance the state of the gas by the time step of the table at
+    //! constant pressure.
+    /*!
+     *  @param integ  integrator used for the direct integrations, which
+     *      must be for a phase with the number of species given to the
+     *      constructor
+     *  @param[in,out] T  temperature [K]
+     *  @param[in,out] Y  mass fractions of the species
+     *  @param P  pressure [Pa]
+     *
+     *  The state of the ThermoPhase object used by *integ* is not specified
+     *  on return.
+     */
+    void advance(ChemistryIntegrator& integ, double& T, double* Y, double P);
+
+    //! Get statistics for all queries since the table was created: the
+    //! number of queries ("queries"), and the numbers of these which were
+    //! retrieved ("retrieves"), which grew an EOA ("grows"), which added a
+    //! record ("adds") and which were computed by direct integration without
+    //! modifying the table ("direct").
+    void getStats(std::map<std::string, long int>& stats) const;
+
+protected:
+    //! A tabulation point and its linear approximation. All quantities are
+    //! scaled.
+    struct Record {
+        vector_fp phi; //!< tabulation point, length #m_nq
+        vector_fp R; //!< mapping, length #m_nr
+        vector_fp A; //!< mapping gradient, #m_nr x #m_nq
+        vector_fp M; //!< EOA matrix, #m_nq x #m_nq
+    };
+
+    //! A node of the binary tree. Leaves refer to a record, and other nodes
+    //! have the cutting plane `v . phi = a`. Points with `v . phi > a` are
+    //! on the right side.
+    struct Node {
+        size_t record; //!< index of the record, or npos
+        size_t left;
+        size_t right;
+        vector_fp v;
+        double a;
+    };
+
+    //! Find the index of the leaf for the scaled query *q*, or npos if the
+    //! table is empty
+    size_t findLeaf(const double* q) const;
+
+    //! Linear approximation from the record *r* at the scaled query *q*
+    void approximate(const Record& r, const double* q, double* R) const;
+
+    //! Add a record at *q*, replacing the leaf *leaf*, which was found by
+    //! findLeaf() for *q*
+    void addRecord(size_t leaf, const double* q, const double* R,
+                   const double* A);
+
+    //! Grow the EOA of the record *r* to include the scaled point *q*
+    void growEOA(Record& r, const double* q);
+
+    //! Memory [bytes] needed by a record and its tree nodes
+    size_t recordSize() const;
+
+    size_t m_nsp; //!< Number of species
+    size_t m_nq; //!< Length of the query vector
+    size_t m_nr; //!< Length of the mapping
+    double m_dt; //!< Time step [s]
+    double m_tol; //!< Error tolerance
+    double m_Tscale; //!< Reference temperature [K]
+    double m_Pscale; //!< Reference pressure [Pa]
+    size_t m_maxMemory; //!< Memory limit [bytes]
+
+    std::vector<Record*> m_records;
+    std::vector<Node> m_nodes;
+    size_t m_root; //!< Index of the root node, or npos
+
+    //! Incremented by clear(), so that threads which searched the table
+    //! before it was cleared do not modify the new records
+    long int m_generation;
+
+    long int m_nQueries;
+    long int m_nRetrieves;
+    long int m_nGrows;
+    long int m_nAdds;
+    long int m_nDirect;
+
+    //! Protects the records, the tree and the counters
+    mutable mutex_t m_mutex;
+
+private:
+    IsatTable(const IsatTable&);
+    IsatTable& operator=(const IsatTable&);
+};
+
+}
+
+#endif
@@ -115,6 +115,50 @@ public:
     virtual void evalEqs(doublereal t, doublereal* y,
                          doublereal* ydot, doublereal* params);
 
+    //! Evaluate the derivatives of the governing equations of this reactor
+    //! with respect to the mass fractions of the homogeneous phase species.
+    /*!
+     *  The derivatives of the homogeneous reaction rates are evaluated
+     *  analytically using Kinetics::getNetProductionRates_ddC(). The
+     *  dependence of surface reaction rates, flow rates and wall velocities
+     *  on the composition is neglected, so the result is an approximation
+     *  that is suitable for use by the integrator. Called by ReactorNet
+     *  after updateState() and evalEqs() have been called at the same state.
+     *
+     *  @param[in] t time.
+     *  @param[in] ydot rate of change of the state vector of this reactor,
+     *      as evaluated by evalEqs()
+     *  @param[out] jac derivatives of the governing equations of this
+     *      reactor, in column-major order with leading dimension `ld`, where
+     *      element `jac[i + ld*j]` is the derivative of equation `i` with
+     *      respect to component `j` of the state vector of this reactor. Only
+     *      the columns for the species mass fractions are set.
+     *  @param ld leading dimension of `jac`
+     *  @returns `false` if analytic derivatives are not implemented for this
+     *      reactor type or phase model, in which case `jac` is not modified.
+     */
+    virtual bool evalSpeciesJacobian(double t, const double* ydot,
+                                     double* jac, size_t ld);
+
+    //! Evaluate the derivatives of the governing equations of this reactor
+    //! with respect to its sensitivity parameters, weighted by the adjoint
+    //! variables *lambda*.
+    /*!
+     *  The derivatives are evaluated analytically from the net rates of
+     *  progress of the reactions. Called by ReactorNet after updateState()
+     *  and evalEqs() have been called at the same state.
+     *
+     *  @param[in] lambda adjoint variables for this reactor, length neq()
+     *  @param[out] dfdp `dfdp[i]` is the derivative of the governing
+     *      equations weighted by *lambda* with respect to sensitivity
+     *      parameter `i` of this reactor, length nSensParams()
+     *  @returns `false` if analytic derivatives are not implemented for this
+     *      reactor type or kinetics model, or if any of the sensitivity
+     *      parameters are for surface reactions. In this case `dfdp` is not
+     *      modified.
+     */
+    virtual bool evalParameterAdjoint(const double* lambda, double* dfdp);
+
     virtual void syncState();
 
     //! Set the state of the reactor to correspond to the state vector *y*.
@@ -159,6 +203,12 @@ protected:
     //! specific reactor implementations.
     virtual size_t speciesIndex(const std::string& nm) const;
 
+    //! Evaluate the result of evalParameterAdjoint() from the derivatives
+    //! `a[k]` of the governing equations weighted by the adjoint variables
+    //! with respect to the net production rate of each species in the
+    //! homogeneous phase.
+    bool parameterAdjoint(const double* a, double* dfdp);
+
     //! Evaluate terms related to Walls
     //! Calculates #m_vdot and #m_Q based on wall movement and heat transfer
     //! @param t     the current time
@@ -174,6 +224,15 @@ protected:
     //! Update the state of SurfPhase objects attached to this reactor
     virtual void updateSurfaceState(double* y);
 
+    //! Set the state of the ThermoPhase object to the state of this reactor,
+    //! #m_state. Does nothing if the ThermoPhase has not been modified since
+    //! it was last set to this state, so that the state counter used by
+    //! cached properties is not incremented unnecessarily.
+    void restoreThermoState();
+
+    //! Save the state of the ThermoPhase object as the state of this reactor
+    void saveThermoState();
+
     //! Get initial conditions for SurfPhase objects attached to this reactor
     virtual void getSurfaceInitialConditions(double* y);
 
@@ -190,6 +249,13 @@ protected:
 
     vector_fp m_wdot; //!< Species net molar production rates
     vector_fp m_uk; //!< Species molar internal energies
+
+    //! Derivatives of #m_wdot with respect to the species concentrations
+    vector_fp m_dwdot_dC;
+
+    //! Value of Phase::stateMFNumber() when the ThermoPhase was last set to
+    //! (or saved as) the state of this reactor. @see restoreThermoState()
+    int m_thermoStateNum;
     bool m_chem;
     bool m_energy;
     size_t m_nv;
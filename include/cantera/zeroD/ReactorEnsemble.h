@@ -0,0 +1,146 @@
+/**
+ *  @file ReactorEnsemble.h
+ */
+
+#ifndef CT_REACTORENSEMBLE_H
+#define CT_REACTORENSEMBLE_H
+
+#include "ReactorNet.h"
+
+namespace Cantera
+{
+
+//! A collection of independent reactors which are advanced in time together.
+/*!
+ *  Each reactor added to the ensemble is integrated by its own ReactorNet,
+ *  so the reactors may be of any type (for example, constant volume or
+ *  constant pressure) and may reach the requested time using very different
+ *  numbers of steps. The reactors are distributed dynamically among a pool
+ *  of worker threads: each thread takes the next reactor which has not yet
+ *  been advanced as soon as it is finished with the previous one, so a few
+ *  stiff reactors do not hold up the rest of the batch. After each call to
+ *  advance(), the reactors which needed the most right-hand-side evaluations
+ *  are scheduled first in the next call.
+ *
+ *  The reactors must not share ThermoPhase or Kinetics objects, and must not
+ *  be connected to other reactors by walls or flow devices. If Cantera was
+ *  built without thread safety, the reactors are advanced sequentially.
+ *
+ *  @ingroup ZeroD
+ */
+class ReactorEnsemble
+{
+public:
+    ReactorEnsemble();
+    virtual ~ReactorEnsemble();
+
+    //! Add the reactor *r* to the ensemble.
+    void addReactor(Reactor& r);
+
+    //! Number of reactors in the ensemble
+    size_t nReactors() const {
+        return m_reactors.size();
+    }
+
+    //! Return a reference to the *i*-th reactor in the ensemble
+    Reactor& reactor(size_t i) {
+        return *m_reactors.at(i);
+    }
+
+    //! Return a reference to the ReactorNet used to integrate the *i*-th
+    //! reactor, which can be used to set integrator options for that reactor
+    //! only.
+    ReactorNet& network(size_t i) {
+        return *m_nets.at(i);
+    }
+
+    //! Set the relative and absolute tolerances for all reactors.
+    void setTolerances(doublereal rtol, doublereal atol);
+
+    //! Set the maximum time step for all reactors.
+    void setMaxTimeStep(doublereal maxstep);
+
+    //! Set the number of worker threads. The default is the number of
+    //! hardware threads available.
+    void setNumThreads(size_t n);
+
+    //! Number of worker threads used by advance()
+    size_t numThreads() const {
+        return m_nthreads;
+    }
+
+    //! Advance the state of all reactors in time.
+    /*!
+     *  A reactor which fails to reach *time* does not affect the others.
+     *  After all of the reactors have been processed, a CanteraError is
+     *  thrown if any of them failed. The reactors which failed can then be
+     *  identified using failed() and errorMessage().
+     *
+     *  @param time Time to advance to (s).
+     */
+    void advance(doublereal time);
+
+    //! Time reached by the most recent call to advance()
+    doublereal time() const {
+        return m_time;
+    }
+
+    //! True if the *i*-th reactor failed to reach the requested time in the
+    //! most recent call to advance()
+    bool failed(size_t i) const {
+        return !m_errors.at(i).empty();
+    }
+
+    //! Error message for the *i*-th reactor from the most recent call to
+    //! advance(), or an empty string if the integration succeeded
+    const std::string& errorMessage(size_t i) const {
+        return m_errors.at(i);
+    }
+
+    //! Get the statistics of the integrator for the *i*-th reactor. These
+    //! are the statistics provided by ReactorNet::getSolverStats(), which
+    //! are cumulative over all calls to advance().
+    void getSolverStats(size_t i, std::map<std::string, long int>& stats);
+
+protected:
+    //! Advance the reactors taken from the shared work list until it is
+    //! empty. Executed by each worker thread, or by the calling thread if
+    //! only one thread is used.
+    void work(bool workerThread);
+
+    //! Advance the *i*-th reactor to #m_time
+    void advanceReactor(size_t i);
+
+    //! The reactors in the ensemble
+    std::vector<Reactor*> m_reactors;
+
+    //! The ReactorNet objects used to integrate each reactor
+    std::vector<ReactorNet*> m_nets;
+
+    //! Error messages for each reactor from the last call to advance()
+    std::vector<std::string> m_errors;
+
+    //! Number of right-hand-side evaluations needed for each reactor in the
+    //! last call to advance(), used to estimate the cost of the next call
+    std::vector<long int> m_cost;
+
+    //! Order in which the reactors are distributed to the worker threads
+    std::vector<size_t> m_order;
+
+    //! Position in #m_order of the next reactor to be advanced
+    size_t m_next;
+
+    //! Number of worker threads
+    size_t m_nthreads;
+
+    //! Time to advance to
+    doublereal m_time;
+
+private:
+    ReactorEnsemble(const ReactorEnsemble&);
+    ReactorEnsemble& operator=(const ReactorEnsemble&);
+};
+
+}
+
+#endif
@@ -9,6 +9,8 @@
 #include "Reactor.h"
 #include "cantera/numerics/FuncEval.h"
 #include "cantera/numerics/Integrator.h"
+#include "cantera/numerics/SparseMatrix.h"
+#include "cantera/numerics/Func1.h"
 #include "cantera/base/Array.h"
 
 namespace Cantera
@@ -75,6 +77,79 @@ public:
         m_init = false;
     }
 
+    //! Set the linear solver used by the integrator.
+    /*!
+     *  @param solver  "dense" (the default) to use a direct solver with a
+     *      dense Jacobian, or "gmres" to use the iterative GMRES solver with
+     *      the preconditioner set by setPreconditioner(). GMRES requires much
+     *      less memory and time for large networks of reactors.
+     */
+    void setLinearSolver(const std::string& solver);
+
+    //! The linear solver used by the integrator. @see setLinearSolver()
+    const std::string& linearSolver() const {
+        return m_linearSolver;
+    }
+
+    //! Set the preconditioner used with the GMRES linear solver.
+    /*!
+     *  The preconditioner is built from a finite difference approximation
+     *  to the Jacobian of the governing equations of each reactor, which is
+     *  evaluated one reactor at a time.
+     *
+     *  @param type  "sparse" (the default) to include the coupling between
+     *      reactors connected by a Wall or FlowDevice, "block-diagonal" to
+     *      neglect this coupling, or "none" for no preconditioning.
+     *  @param dropTolerance  If positive, the preconditioner is factored
+     *      using an incomplete LU factorization with this drop tolerance,
+     *      which reduces the fill-in. See SparseMatrix::setDropTolerance().
+     */
+    void setPreconditioner(const std::string& type,
+                           doublereal dropTolerance=0.0);
+
+    //! The type of preconditioner used with the GMRES linear solver.
+    //! @see setPreconditioner()
+    const std::string& preconditioner() const {
+        return m_preconditioner;
+    }
+
+    //! Set the method used to evaluate the Jacobian.
+    /*!
+     *  The Jacobian is used by the dense linear solver and to build the
+     *  preconditioner for the GMRES linear solver. Analytic derivatives
+     *  reduce the number of right-hand-side evaluations needed for each
+     *  Jacobian from one per state variable to a few per reactor. The
+     *  dependence of third-body and falloff reaction rates on the
+     *  composition and the coupling between the compositions of connected
+     *  reactors are neglected, which may slightly increase the number of
+     *  Newton iterations.
+     *
+     *  @param type  "analytic" to evaluate the derivatives of the
+     *      homogeneous reaction rates with respect to the species mass
+     *      fractions analytically where the reactor type supports it (see
+     *      Reactor::evalSpeciesJacobian()), with the remaining columns
+     *      evaluated by finite differences, or "finite-difference" (the
+     *      default) to evaluate all columns by finite differences. With the
+     *      dense linear solver, finite differences are computed by the
+     *      integrator.
+     */
+    void setJacobianType(const std::string& type);
+
+    //! The method used to evaluate the Jacobian. @see setJacobianType()
+    const std::string& jacobianType() const {
+        return m_jacobianType;
+    }
+
+    //! Get statistics on the work done by the integrator and the
+    //! preconditioner. In addition to the statistics provided by
+    //! Integrator::getSolverStats(), these are the number of Jacobian
+    //! evaluations used to build the preconditioner (`prec_jac_evals`), the
+    //! number of complete and reused factorizations of the preconditioner
+    //! (`prec_factorizations` and `prec_refactorizations`) and the number of
+    //! nonzero elements in the preconditioner and its LU factors
+    //! (`prec_nonzeros` and `prec_factor_nonzeros`).
+    void getSolverStats(std::map<std::string, long int>& stats);
+
     //! Current value of the simulation time.
     doublereal time() {
         return m_time;
@@ -111,11 +186,101 @@ public:
     //! toward *time*.
     double step(doublereal time);
 
+    //! Advance the state of all reactors to the last of the output times in
+    //! *times*, and store the interpolated state of the network at each of
+    //! the output times.
+    /*!
+     *  The integrator takes its natural internal steps, and the solution at
+     *  the output times within each step is evaluated using the
+     *  interpolating polynomial of the integrator, so dense output does not
+     *  limit the step size. After the call, the network is at the last
+     *  output time, unless a terminal event stopped the integration early
+     *  (see addEvent()).
+     *
+     *  @param ntimes  number of output times
+     *  @param times  output times, in increasing order, no earlier than
+     *      time()
+     *  @param[out] output  array of length `ntimes*neq()`, where the
+     *      global state vector (or its derivative) at `times[i]` is stored
+     *      starting at `output[i*neq()]`. neq() is known once the network
+     *      has been initialized, e.g. by calling reinitialize().
+     *  @param k  order of the time derivative of the state vector to store
+     *      (0 for the state vector itself)
+     *  @returns the number of output times reached
+     */
+    size_t sample(size_t ntimes, const double* times, double* output,
+                  int k=0);
+
+    //! Get the *k*-th time derivative of the global state vector at time
+    //! *t*, interpolated within the last internal step of the integrator.
+    //! *t* must be between the start of the last step taken by the
+    //! integrator and the end of that step.
+    void getInterpolatedState(double t, double* y, int k=0);
+
     //@}
 
     //! Add the reactor *r* to this reactor network.
     void addReactor(Reactor& r);
 
+    //! Add an event which is located by the integrator while advancing the
+    //! network.
+    /*!
+     *  Events are detected as sign changes of a root function of the state
+     *  of a quantity *q* of the reactor *r*. The integrator stops at the
+     *  time where the root function changes sign, which is located to
+     *  within a small multiple of the machine precision using the
+     *  interpolated solution, so events are not missed or smeared out by
+     *  large time steps. If a *terminal* event occurs, advance() returns
+     *  early, with time() set to the time of the event.
+     *
+     *  @param type  The type of event:
+     *      - "threshold": *q* crosses *value*, in either direction
+     *      - "peak": *q* reaches a local maximum
+     *      - "max-slope": *dq/dt* reaches a local maximum, e.g. the point of
+     *        steepest temperature rise used to define an ignition delay.
+     *        Only available if *q* is a state variable of the reactor.
+     *  @param r  The reactor, which must be part of this network
+     *  @param component  The quantity *q*: "T" (temperature), "P" (pressure),
+     *      or the name of a species in the reactor (mass fraction)
+     *  @param value  Threshold value, used by "threshold" events
+     *  @param terminal  If `true`, advance() stops when the event occurs.
+     *  @returns the index of the event
+     */
+    size_t addEvent(const std::string& type, Reactor& r,
+                    const std::string& component, double value=0.0,
+                    bool terminal=true);
+
+    //! Add an event which occurs when *f(q)* changes sign, where *q* is the
+    //! quantity *component* of the reactor *r*.
+    /*!
+     *  The function object is not copied, and must remain valid for the
+     *  lifetime of the reactor network. See addEvent(const std::string&,
+     *  Reactor&, const std::string&, double, bool) for the other arguments.
+     */
+    size_t addEvent(Func1& f, Reactor& r, const std::string& component,
+                    bool terminal=true);
+
+    //! Number of events added to this network
+    size_t nEvents() const {
+        return m_events.size();
+    }
+
+    //! Number of times the *i*-th event has occurred since the integrator
+    //! was (re)initialized.
+    size_t eventCount(size_t i) const {
+        return m_events.at(i).count;
+    }
+
+    //! Time at which the *i*-th event first occurred. Throws an exception if
+    //! the event has not occurred.
+    double eventTime(size_t i) const;
+
+    //! Index of the most recent event, or `npos` if no event has occurred
+    //! since the integrator was (re)initialized.
+    size_t lastEvent() const {
+        return m_lastEvent;
+    }
+
     //! Add the reactor *r* to this reactor network.
     /**
      *  @deprecated To be removed after Cantera 2.2. Use addReactor(Reactor&)
@@ -156,6 +321,11 @@ public:
         if (!m_init) {
             initialize();
         }
+        if (m_adjointSteps > 0) {
+            throw CanteraError("ReactorNet::sensitivity", "Forward "
+                "sensitivities are not computed when adjoint sensitivity "
+                "analysis is enabled.");
+        }
         return m_integ->sensitivity(k, m_sensIndex[p])/m_integ->solution(k);
     }
 
@@ -166,6 +336,66 @@ public:
         return sensitivity(k, p);
     }
 
+    //! Use adjoint sensitivity analysis instead of forward sensitivity
+    //! analysis for the sensitivity parameters of the reactors.
+    /*!
+     *  Forward sensitivity analysis integrates one additional system of
+     *  equations for each parameter. Adjoint sensitivity analysis instead
+     *  integrates a single backward problem for each scalar objective (see
+     *  getAdjointSensitivities()), so it is much cheaper when there are many
+     *  parameters, e.g. the rate multipliers of all the reactions in a
+     *  large mechanism. The forward solution is stored at a checkpoint
+     *  every *checkpointSteps* steps, and the solution between checkpoints
+     *  is recomputed during the backward integration, so larger values use
+     *  less memory and more computation. Requires the CVODES integrator,
+     *  with Cantera configured using the `sundials_adjoint` option.
+     *  The integrator is reinitialized before the next integration.
+     */
+    void setAdjointSensitivity(bool adjoint, int checkpointSteps=100);
+
+    //! Returns `true` if adjoint sensitivity analysis is enabled.
+    //! @see setAdjointSensitivity()
+    bool adjointSensitivity() const {
+        return m_adjointSteps > 0;
+    }
+
+    //! Compute the sensitivities of an objective which depends on the state
+    //! of the network at the current time using adjoint sensitivity
+    //! analysis.
+    /*!
+     *  The objective is \f$ G = \vec{g}^T \vec{y}(t) \f$, where \f$ \vec{y}
+     *  \f$ is the global state vector at the current time and \f$ \vec{g}
+     *  \f$ is given by *dgdy*, or the linearization of any other function
+     *  of the final state. The sensitivities are with respect to the
+     *  multipliers of the sensitivity reactions, i.e.
+     *  \f$ k_p \partial G / \partial k_p \f$ for the rate constant
+     *  \f$ k_p \f$ of each parameter, and account for the integration since
+     *  the network was last (re)initialized. Adjoint
+     *  sensitivity analysis must be enabled with setAdjointSensitivity()
+     *  before the integration. The integrator is reinitialized at the
+     *  current state before any further integration.
+     *
+     *  @param[in] dgdy  derivatives of the objective with respect to each
+     *      component of the global state vector, length neq()
+     *  @param[out] dgdp  sensitivities with respect to each sensitivity
+     *      parameter, in the order in which the parameters were added,
+     *      length nparams()
+     */
+    void getAdjointSensitivities(const double* dgdy, double* dgdp);
+
+    //! Compute the sensitivities of the time at which the *i*-th event
+    //! occurred using adjoint sensitivity analysis.
+    /*!
+     *  The event must be a terminal "threshold" or function event which
+     *  stopped the integration, so that the time of the event, e.g. an
+     *  ignition delay, is the current time. See getAdjointSensitivities()
+     *  for the definition of the sensitivity parameters.
+     *
+     *  @param i  index of the event
+     *  @param[out] dtdp  sensitivities of the event time, length nparams()
+     */
+    void getEventTimeSensitivities(size_t i, double* dtdp);
+
     //! Evaluate the Jacobian matrix for the reactor network.
     /*!
      *  @param[in] t Time at which to evaluate the Jacobian
@@ -177,6 +407,46 @@ public:
     void evalJacobian(doublereal t, doublereal* y,
                       doublereal* ydot, doublereal* p, Array2D* j);
 
+    //! Get the structure of the sparse Jacobian of the reactor network, in
+    //! compressed column format.
+    /*!
+     *  The governing equations of each reactor depend only on its own state
+     *  and the states of the reactors connected to it by a Wall or
+     *  FlowDevice, so the Jacobian consists of dense blocks for each pair of
+     *  connected reactors. See SparseMatrix::setStructure() for a
+     *  description of the arguments.
+     */
+    void getJacobianStructure(std::vector<size_t>& colStart,
+                              std::vector<size_t>& rowIndex);
+
+    //! Evaluate the Jacobian of the reactor network as a sparse matrix.
+    /*!
+     *  The Jacobian is evaluated reactor by reactor as described for
+     *  setJacobianType(). Finite difference columns for reactors that do not
+     *  affect the governing equations of any common reactor are evaluated
+     *  together (see nJacobianColors()), and only the governing equations of
+     *  the reactors affected by each perturbation are evaluated.
+     *
+     *  @param[in] t Time at which to evaluate the Jacobian
+     *  @param[in] y Global state vector at time *t*
+     *  @param[in] ydot Time derivative of the state vector evaluated at *t*
+     *      and *y*, e.g. by eval()
+     *  @param[out] jac Jacobian matrix. Its structure is set to that given by
+     *      getJacobianStructure() if it does not already have that size.
+     */
+    void evalSparseJacobian(double t, double* y, double* ydot,
+                            SparseMatrix& jac);
+
+    //! Number of groups of reactors whose Jacobian columns are evaluated
+    //! together by evalSparseJacobian(). Two reactors are in the same group
+    //! only if no reactor is connected to both of them.
+    size_t nJacobianColors() {
+        if (!m_init) {
+            initialize();
+        }
+        return m_colors.size();
+    }
+
     // overloaded methods of class FuncEval
     virtual size_t neq() {
         return m_nv;
@@ -188,6 +458,26 @@ public:
     virtual size_t nparams() {
         return m_ntotpar;
     }
+    virtual bool hasJacobian() {
+        return m_linearSolver == "dense" && m_jacobianType == "analytic";
+    }
+    virtual void getJacobian(double t, double* y, double* ydot, double* p,
+                             Array2D& jac);
+    virtual bool hasPreconditioner() {
+        return m_linearSolver == "gmres" && m_preconditioner != "none";
+    }
+    virtual bool preconditionerSetup(double t, double* y, double* ydot,
+                                     double gamma, bool reuseJacobian);
+    virtual void preconditionerSolve(double* rhs, double* z);
+    virtual void preconditionerSolveTranspose(double* rhs, double* z);
+    virtual size_t nRootFunctions() {
+        return m_events.size();
+    }
+    virtual void evalRootFunctions(double t, double* y, double* g);
+    virtual void evalAdjoint(double t, double* y, double* lambda,
+                             double* lambdaDot);
+    virtual void evalAdjointParams(double t, double* y, double* lambda,
+                                   double* dfdp);
 
     //! Return the index corresponding to the component named *component* in the
     //! reactor with index *reactor* in the global state vector for the
@@ -224,6 +514,76 @@ protected:
      */
     void initialize();
 
+    //! Determine which reactors are coupled to each reactor through a Wall
+    //! or FlowDevice. Sets #m_coupled.
+    void initCoupling();
+
+    //! Set up the structure of the preconditioner matrix
+    void initPreconditioner();
+
+    //! Evaluate the Jacobian used to build the preconditioner. Only the
+    //! blocks in the structure of the preconditioner are evaluated.
+    void evalPreconditionerJacobian(double t, double* y, double* ydot);
+
+    //! The reactors included in each column of the preconditioner:
+    //! #m_coupled for the "sparse" preconditioner, or only the reactor
+    //! itself for the "block-diagonal" preconditioner.
+    std::vector<std::vector<size_t> > preconditionerRows();
+
+    //! Determine the nonzero structure of a Jacobian where the columns for
+    //! reactor *n* have nonzero blocks in the rows of the reactors in
+    //! `rows[n]`.
+    void jacobianStructure(const std::vector<std::vector<size_t> >& rows,
+                           std::vector<size_t>& colStart,
+                           std::vector<size_t>& rowIndex);
+
+    //! Evaluate the derivatives of the governing equations of the reactors
+    //! in `rows[n]` with respect to the state variables of each reactor *n*.
+    /*!
+     *  The species columns are evaluated analytically if *analytic* is
+     *  `true` and the reactor supports it. The other columns are
+     *  evaluated by finite differences, perturbing one state variable of
+     *  each reactor in a group of #m_colors at a time and evaluating only the
+     *  governing equations of the reactors which depend on the perturbed
+     *  variables.
+     *
+     *  @param[in] t time
+     *  @param[in] y global state vector
+     *  @param[in] ydot right-hand-side function evaluated at *t* and *y*
+     *  @param[in] rows `rows[n]` lists the reactors for which the governing
+     *      equations are differentiated with respect to the state of reactor
+     *      *n*, in increasing order, including *n*. Each of these reactors
+     *      must be in #m_coupled[n] .
+     *  @param[out] jac nonzero elements of the Jacobian in the compressed
+     *      column format given by jacobianStructure(*rows*)
+     *  @param analytic  Use the analytic species columns, which neglect
+     *      some terms (see Reactor::evalSpeciesJacobian()).
+     *  @param hmin  If positive, the perturbations are at least
+     *      \f$ \sqrt{\epsilon} \max(|y_j|, h_{min}) \f$, which is more
+     *      accurate than the perturbations based on the integrator
+     *      tolerances.
+     */
+    void evalColoredJacobian(double t, double* y, double* ydot,
+                             const std::vector<std::vector<size_t> >& rows,
+                             double* jac, bool analytic, double hmin=0.0);
+
+    //! Resolve the reactors and state variables used by the events and reset
+    //! their occurrence counts
+    void initEvents();
+
+    //! Record the events found by the last call to Integrator::integrate()
+    //! or Integrator::step(). Returns `true` if a terminal event occurred.
+    bool processEvents();
+
+    //! Store the *k*-th time derivative of the state vector at time *t*,
+    //! which must be within the last step of the integrator, in *y*. Used by
+    //! sample().
+    void getSample(double t, int k, double* y);
+
+    //! The value of the quantity used by the *i*-th event, after
+    //! updateState() has been called
+    double eventQuantity(size_t i) const;
+
     std::vector<Reactor*> m_reactors;
     Integrator* m_integ;
     doublereal m_time;
@@ -257,6 +617,85 @@ protected:
 
     vector_fp m_ydot;
 
+    //! Linear solver used by the integrator. @see setLinearSolver()
+    std::string m_linearSolver;
+
+    //! Preconditioner type. @see setPreconditioner()
+    std::string m_preconditioner;
+
+    //! Drop tolerance for incomplete factorization of the preconditioner
+    doublereal m_precon_droptol;
+
+    //! Preconditioner matrix, \f$ I - \gamma J \f$
+    SparseMatrix m_precon;
+
+    //! Jacobian elements in the structure of #m_precon
+    vector_fp m_precon_jac;
+
+    //! Location of each diagonal element in the arrays of nonzero elements
+    //! of #m_precon
+    std::vector<size_t> m_precon_diag;
+
+    //! m_coupled[n] lists the reactors whose governing equations depend on
+    //! the state of reactor n, including n itself, in increasing order
+    std::vector<std::vector<size_t> > m_coupled;
+
+    //! Method used to evaluate the Jacobian. @see setJacobianType()
+    std::string m_jacobianType;
+
+    //! Groups of reactors whose Jacobian columns are evaluated together.
+    //! No reactor is in #m_coupled for more than one reactor in each group.
+    std::vector<std::vector<size_t> > m_colors;
+
+    //! Nonzero elements of the Jacobian, in the structure given by
+    //! getJacobianStructure()
+    vector_fp m_jac_values;
+
+    //! Information about an event added with addEvent()
+    struct ReactorEvent {
+        std::string type; //!< "threshold", "peak", "max-slope" or "function"
+        Reactor* reactor;
+        std::string component;
+        size_t species; //!< Species index, or npos for "T" and "P"
+        size_t state; //!< Index in the global state vector, or npos
+        double value; //!< Threshold value
+        Func1* func; //!< Function for "function" events
+        bool terminal;
+        int direction; //!< Required direction of the sign change, or 0
+        size_t count; //!< Number of occurrences
+        double time; //!< Time of the first occurrence
+    };
+
+    std::vector<ReactorEvent> m_events;
+
+    //! Index of the most recent event. @see lastEvent()
+    size_t m_lastEvent;
+
+    //! Work arrays used to evaluate the root functions for the events
+    vector_fp m_event_ydot, m_event_ydot2, m_event_y, m_event_params;
+    std::vector<int> m_rootInfo;
+
+    //! True if #m_precon_jac is available for reuse
+    bool m_precon_jac_ok;
+
+    //! Number of Jacobian evaluations for the preconditioner
+    int m_nPreconJacEvals;
+
+    //! Number of steps between checkpoints for adjoint sensitivity analysis,
+    //! or 0 if forward sensitivity analysis is used.
+    //! @see setAdjointSensitivity()
+    int m_adjointSteps;
+
+    //! Structure and nonzero elements of the Jacobian used for the adjoint
+    //! equations, which is reused while the state is unchanged
+    std::vector<size_t> m_adj_colStart, m_adj_rowIndex;
+    vector_fp m_adj_jac;
+    double m_adj_t; //!< Time at which #m_adj_jac was evaluated
+    vector_fp m_adj_y; //!< State at which #m_adj_jac was evaluated
+
+    //! Work arrays for the adjoint equations
+    vector_fp m_adj_ydot, m_adj_ydot2, m_adj_params, m_adj_dgdp;
+
     std::vector<bool> m_iown;
 };
 }
@@ -2,6 +2,9 @@
 #define CT_INCL_ZERODIM_H
 #include "zeroD/Reactor.h"
 #include "zeroD/ReactorNet.h"
+#include "zeroD/ReactorEnsemble.h"
+#include "zeroD/ChemistryIntegrator.h"
+#include "zeroD/IsatTable.h"
 #include "zeroD/Reservoir.h"
 #include "zeroD/Wall.h"
 #include "zeroD/flowControllers.h"
@@ -242,11 +242,31 @@ cdef extern from "cantera/equil/MultiPhase.h" namespace "Cantera":
         double cp() except +
         double volume() except +
 
+cdef extern from "cantera/equil/EquilStats.h":
+    cdef cppclass CxxEquilStats "Cantera::EquilStats":
+        CxxEquilStats()
+        void getStats(stdmap[string, double]&)
+
 cdef extern from "cantera/equil/equil.h" namespace "Cantera":
-    int equilibrate(CxxThermoPhase&, char*, int, double, int, int, int) except +
+    int equilibrate(CxxThermoPhase&, char*, int, double, int, int, int,
+                    CxxEquilStats*) except +
 
 cdef extern from "cantera/equil/vcs_MultiPhaseEquil.h" namespace "Cantera":
-    int vcs_equilibrate(CxxMultiPhase&, char*, int, int, int, double, int, int, int) except +
+    int vcs_equilibrate(CxxMultiPhase&, char*, int, int, int, double, int, int,
+                        int, CxxEquilStats*) except +
+
+cdef extern from "cantera/equil/BatchEquil.h":
+    cdef cppclass CxxBatchEquil "Cantera::BatchEquil":
+        CxxBatchEquil(CxxThermoPhase&) except +
+        size_t nSpecies()
+        void setNumThreads(size_t) except +
+        size_t numThreads()
+        void setBlockSize(size_t) except +
+        void setSolver(int) except +
+        void setOptions(double, int)
+        size_t equilibrate(string, size_t, double*, double*, double*,
+                           double*, int*) except +
+        string errorMessage()
 
 
 cdef extern from "cantera/zeroD/ReactorBase.h" namespace "Cantera":
@@ -342,6 +362,21 @@ cdef extern from "cantera/zeroD/ReactorNet.h":
         double atol()
         void setMaxTimeStep(double)
         void setMaxErrTestFails(int)
+        void setLinearSolver(string) except +
+        string linearSolver()
+        void setPreconditioner(string, double) except +
+        string preconditioner()
+        void setJacobianType(string) except +
+        string jacobianType()
+        void getSolverStats(stdmap[string, long]&) except +
+        size_t addEvent(string, CxxReactor&, string, double, cbool) except +
+        size_t addEvent(CxxFunc1&, CxxReactor&, string, cbool) except +
+        size_t nEvents()
+        size_t eventCount(size_t) except +
+        double eventTime(size_t) except +
+        size_t lastEvent()
+        size_t sample(size_t, double*, double*, int) except +
+        void getInterpolatedState(double, double*, int) except +
         cbool verbose()
         void setVerbose(cbool)
         size_t neq()
@@ -353,7 +388,50 @@ cdef extern from "cantera/zeroD/ReactorNet.h":
         double sensitivity(string&, size_t, int) except +
         size_t nparams()
         string sensitivityParameterName(size_t) except +
+        void setAdjointSensitivity(cbool, int) except +
+        cbool adjointSensitivity()
+        void getAdjointSensitivities(double*, double*) except +
+        void getEventTimeSensitivities(size_t, double*) except +
+
+cdef extern from "cantera/zeroD/ReactorEnsemble.h":
+    cdef cppclass CxxReactorEnsemble "Cantera::ReactorEnsemble":
+        CxxReactorEnsemble()
+        void addReactor(CxxReactor&) except +
+        size_t nReactors()
+        void setTolerances(double, double)
+        void setMaxTimeStep(double)
+        void setNumThreads(size_t) except +
+        size_t numThreads()
+        void advance(double) except +
+        double time()
+        cbool failed(size_t) except +
+        string errorMessage(size_t) except +
+        void getSolverStats(size_t, stdmap[string, long]&) except +
 
+cdef extern from "cantera/zeroD/ChemistryIntegrator.h":
+    cdef cppclass CxxChemistryIntegrator "Cantera::ChemistryIntegrator":
+        CxxChemistryIntegrator(CxxThermoPhase&, CxxKinetics&) except +
+        size_t neq()
+        void setTolerances(double, double) except +
+        void setMaxSteps(size_t)
+        void setInitialStepSize(double)
+        double lastStepSize()
+        void integrate(double&, double*, double, double) except +
+        void getSolverStats(stdmap[string, long]&)
+        void resetSolverStats()
+
+cdef extern from "cantera/zeroD/IsatTable.h":
+    cdef cppclass CxxIsatTable "Cantera::IsatTable":
+        CxxIsatTable(size_t, double) except +
+        double timeStep()
+        void setTolerance(double) except +
+        void setScales(double, double) except +
+        void setMaxMemory(size_t)
+        size_t memoryUsage()
+        size_t nRecords()
+        void clear()
+        void advance(CxxChemistryIntegrator&, double&, double*, double) except +
+        void getStats(stdmap[string, long]&)
 
 cdef extern from "cantera/thermo/ThermoFactory.h" namespace "Cantera":
     cdef CxxThermoPhase* newPhase(string, string) except +
@@ -450,6 +528,9 @@ cdef extern from "cantera/oneD/StFlow.h":
 
 
 cdef extern from "cantera/oneD/Sim1D.h":
+    cdef int c_Band_LinearSolver "Cantera::c_Band_LinearSolver"
+    cdef int c_Sparse_LinearSolver "Cantera::c_Sparse_LinearSolver"
+
     cdef cppclass CxxSim1D "Cantera::Sim1D":
         CxxSim1D(vector[CxxDomain1D*]&) except +
         void setValue(size_t, size_t, size_t, double) except +
@@ -465,6 +546,10 @@ cdef extern from "cantera/oneD/Sim1D.h":
         void restore(string, string, int) except +
         void writeStats(int) except +
         void clearStats()
+        vector[string] statisticNames()
+        void getStatistic(string, vector[double]&) except +
+        string statisticsJSON() except +
+        void setPropertyTiming(cbool)
         int domainIndex(string) except +
         double value(size_t, size_t, size_t) except +
         double workValue(size_t, size_t, size_t) except +
@@ -476,6 +561,20 @@ cdef extern from "cantera/oneD/Sim1D.h":
         void setGridMin(int, double) except +
         void setFixedTemperature(double)
         void setInterrupt(CxxFunc1*) except +
+        void setLinearSolver(int) except +
+        int linearSolver()
+        void setInterpolation(string) except +
+        string interpolation()
+        vector[size_t]& passGridPoints()
+        vector[int]& passPointsAdded()
+        vector[int]& passPointsRemoved()
+        vector[int]& passTimeSteps()
+        vector[double]& passSolveTime()
+        vector[double]& passRefineTime()
+        size_t size()
+        void solveAdjoint(double*, double*) except +
+        void getReactionSensitivities(double*, vector[double]&) except +
+        double componentReactionSensitivities(size_t, size_t, size_t, vector[double]&) except +
 
 cdef extern from "<sstream>":
     cdef cppclass CxxStringStream "std::stringstream":
@@ -516,6 +615,7 @@ cdef extern from "cantera/cython/wrappers.h":
     # config definitions
     cdef string get_cantera_version()
     cdef int get_sundials_version()
+    cdef int has_sundials_adjoint()
 
     cdef cppclass CxxPythonLogger "PythonLogger":
         pass
@@ -593,6 +693,7 @@ cdef class _SolutionBase:
     cdef int thermo_basis
     cdef np.ndarray _selected_species
     cdef object parent
+    cdef object _equil_stats
 
 cdef class ThermoPhase(_SolutionBase):
     cdef double _mass_factor(self)
@@ -620,8 +721,12 @@ cdef class DustyGasTransport(Transport):
 cdef class Mixture:
     cdef CxxMultiPhase* mix
     cdef list _phases
+    cdef object _equil_stats
     cpdef int element_index(self, element) except *
 
+cdef class BatchEquilibrium:
+    cdef CxxBatchEquil* batch
+
 cdef class Func1:
     cdef CxxFunc1* func
     cdef object callable
@@ -688,6 +793,18 @@ cdef class PressureController(FlowDevice):
 cdef class ReactorNet:
     cdef CxxReactorNet net
     cdef list _reactors
+    cdef list _event_funcs
+
+cdef class ReactorEnsemble:
+    cdef CxxReactorEnsemble ens
+    cdef list _reactors
+
+cdef class ChemistryIntegrator:
+    cdef CxxChemistryIntegrator* integ
+    cdef _SolutionBase gas
+
+cdef class IsatTable:
+    cdef CxxIsatTable* table
 
 cdef class Domain1D:
     cdef CxxDomain1D* domain
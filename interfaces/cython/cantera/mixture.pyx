@@ -323,6 +323,133 @@ cdef class Mixture:
             raise ValueError('Unrecognized equilibrium solver '
                              'specified: "{0}"'.format(solver))
 
+        cdef CxxEquilStats stats
         vcs_equilibrate(deref(self.mix), stringify(XY).c_str(), estimate_equil,
                         print_level, iSolver, rtol, max_steps, max_iter,
-                        log_level)
+                        log_level, &stats)
+        self._equil_stats = _equil_stats_dict(stats)
+
+    property equilibrium_stats:
+        """
+        A dict of statistics on the work done by the last call to
+        `equilibrate`, or *None* if `equilibrate` has not been called
+        successfully. See `ThermoPhase.equilibrium_stats`. The 'gibbs' solver
+        does not collect statistics, so all of the entries are zero for it.
+        """
+        def __get__(self):
+            return self._equil_stats
+
+
+cdef class BatchEquilibrium:
+    """
+    Computes the equilibrium states of the phase *phase* for a batch of input
+    states, for example to generate equilibrium tables for tabulated
+    chemistry. The points are distributed among several threads, each of
+    which uses its own copy of the phase. Within each block of consecutive
+    points handed to a thread, the solution of each point is used as the
+    initial estimate for the next, so the points should be ordered so that
+    neighbouring points have similar states.
+
+    >>> batch = ct.BatchEquilibrium(gas)
+    >>> T, P, Y, converged = batch.equilibrate('HP', Y0, h, P0)
+
+    The state of *phase* is not modified.
+    """
+    def __cinit__(self, _SolutionBase phase):
+        self.batch = new CxxBatchEquil(deref(phase.thermo))
+
+    def __dealloc__(self):
+        del self.batch
+
+    property n_threads:
+        """
+        The number of worker threads. The default is the number of hardware
+        threads available.
+        """
+        def __get__(self):
+            return self.batch.numThreads()
+        def __set__(self, size_t n):
+            self.batch.setNumThreads(n)
+
+    property block_size:
+        """
+        The number of consecutive points which are handed to a thread at a
+        time. The default is 64.
+        """
+        def __set__(self, size_t n):
+            self.batch.setBlockSize(n)
+
+    def set_options(self, solver='auto', double rtol=1e-9, int max_steps=1000):
+        """
+        Set the options used by the equilibrium solvers.
+
+        :param solver:
+            'element_potential' to use only the element potential solver,
+            'vcs' to use only the VCS solver, or 'auto' (the default) to use
+            the VCS solver for points where the element potential solver
+            fails.
+        :param rtol:
+            The relative error tolerance.
+        :param max_steps:
+            The maximum number of steps taken to find each solution.
+        """
+        if solver == 'auto':
+            self.batch.setSolver(-1)
+        elif solver == 'element_potential':
+            self.batch.setSolver(0)
+        elif solver == 'vcs':
+            self.batch.setSolver(2)
+        else:
+            raise ValueError('Invalid equilibrium solver specified')
+        self.batch.setOptions(rtol, max_steps)
+
+    def equilibrate(self, XY, Y, prop1, prop2):
+        """
+        Compute the equilibrium states for a batch of points.
+
+        :param XY:
+            The property pair held constant, which must be one of 'TP', 'HP',
+            'SP', 'UV', 'SV' or 'TV'.
+        :param Y:
+            Array of mass fractions with one row for each point, which
+            determines the elemental composition of the point.
+        :param prop1:
+            Values of the first property of *XY* for each point, in SI units
+            per unit mass, e.g. the specific enthalpy [J/kg] for 'HP'. May be
+            a scalar, in which case the same value is used for all points.
+        :param prop2:
+            Values of the second property of *XY*, e.g. the pressure [Pa]
+            for 'HP' or the specific volume [m^3/kg] for 'UV'. May be a
+            scalar.
+        :return:
+            A tuple of arrays with the temperature, the pressure and the mass
+            fractions of each point at equilibrium, and a boolean array which
+            is `False` for points where the solvers failed. The state of
+            these points is set to NaN.
+        """
+        cdef size_t nsp = self.batch.nSpecies()
+        cdef np.ndarray[np.double_t, ndim=2] y = \
+            np.ascontiguousarray(np.atleast_2d(Y), dtype=np.double)
+        if y.shape[1] != nsp:
+            raise ValueError('Mass fraction array must have {0} '
+                             'columns'.format(nsp))
+        cdef size_t n = y.shape[0]
+        cdef np.ndarray[np.double_t, ndim=1] a = np.empty(n)
+        cdef np.ndarray[np.double_t, ndim=1] b = np.empty(n)
+        a[:] = prop1
+        b[:] = prop2
+        cdef np.ndarray[np.double_t, ndim=2] out = np.empty((n, nsp + 2))
+        out.fill(np.nan)
+        cdef np.ndarray[int, ndim=1] converged = np.zeros(n, dtype=np.intc)
+        if n:
+            self.batch.equilibrate(stringify(XY.upper()), n, &y[0,0], &a[0],
+                                   &b[0], &out[0,0], &converged[0])
+        return out[:,0], out[:,1], out[:,2:], converged.astype(bool)
+
+    property error_message:
+        """
+        The error message for the first point which failed in the most recent
+        call to `equilibrate`, or an empty string if all points succeeded.
+        """
+        def __get__(self):
+            return pystr(self.batch.errorMessage())
@@ -105,6 +105,27 @@ class FlameBase(Sim1D):
         else:
             return self.value(self.flame, component, point)
 
+    def get_reaction_sensitivities(self, component, point):
+        """
+        Normalized sensitivities of one solution component at one grid point
+        to the rate constants of all reactions, :math:`d\ln x/d\ln k_i`,
+        computed using the adjoint method.
+
+        :param component:
+            component name or index, e.g. ``'T'`` or a species name
+        :param point:
+            grid point number within the flame domain
+        """
+        return (self.reaction_sensitivities(self.flame, component, point) /
+                self.value(self.flame, component, point))
+
+    def get_peak_temperature_reaction_sensitivities(self):
+        """
+        Normalized sensitivities of the peak temperature to the rate
+        constants of all reactions.
+        """
+        return self.get_reaction_sensitivities('T', int(np.argmax(self.T)))
+
     def set_gas_state(self, point):
         k0 = self.flame.component_index(self.gas.species_name(0))
         Y = [self.solution(k, point)
@@ -267,6 +288,13 @@ class FreeFlame(FlameBase):
             self.set_profile(self.gas.species_name(n),
                              locs, [Y0[n], Y0[n], Yeq[n], Yeq[n]])
 
+    def get_flame_speed_reaction_sensitivities(self):
+        """
+        Normalized sensitivities of the laminar burning velocity to the rate
+        constants of all reactions, :math:`d\ln S_u/d\ln k_i`.
+        """
+        return self.get_reaction_sensitivities('u', 0)
+
 
 class BurnerFlame(FlameBase):
     """A burner-stabilized flat flame."""
@@ -552,6 +552,47 @@ cdef class Sim1D:
         dom, comp = self._get_indices(domain, component)
         return self.sim.workValue(dom, comp, point)
 
+    def solve_adjoint(self, b):
+        """
+        Solve the adjoint system :math:`J^T \lambda = b`, where *J* is the
+        Jacobian of the steady-state residual evaluated at the current
+        solution, and return the solution vector :math:`\lambda`. The
+        length of *b* must equal the size of the global solution vector.
+        """
+        cdef np.ndarray[np.double_t, ndim=1] rhs = \
+            np.ascontiguousarray(b, dtype=np.double)
+        if len(rhs) != self.sim.size():
+            raise ValueError('Expected an array of length {0}, got {1}'.format(
+                self.sim.size(), len(rhs)))
+        cdef np.ndarray[np.double_t, ndim=1] L = np.empty(self.sim.size())
+        self.sim.solveAdjoint(&rhs[0], &L[0])
+        return L
+
+    def reaction_sensitivities(self, domain, component, point):
+        """
+        Sensitivities of one solution component to the rate constants of all
+        reactions, :math:`dx/d\ln k_i`, computed using the adjoint method.
+        The cost is one Jacobian evaluation and one linear solve, independent
+        of the number of reactions.
+
+        :param domain:
+            Domain1D object, name, or index
+        :param component:
+            component name or index
+        :param point:
+            grid point number within *domain* starting with 0 on the left
+
+        >>> dSu = s.reaction_sensitivities('flame', 'u', 0)
+        """
+        dom, comp = self._get_indices(domain, component)
+        cdef vector[double] sens
+        self.sim.componentReactionSensitivities(dom, comp, point, sens)
+        cdef np.ndarray[np.double_t, ndim=1] data = np.empty(sens.size())
+        cdef size_t i
+        for i in range(sens.size()):
+            data[i] = sens[i]
+        return data
+
     def profile(self, domain, component):
         """
         Spatial profile of one component in one domain.
@@ -743,6 +784,118 @@ cdef class Sim1D:
         """
         self.sim.setFixedTemperature(T)
 
+    property linear_solver:
+        """
+        The linear solver used by the Newton iteration. Either ``'banded'``
+        (the default), which uses a LAPACK band solver, or ``'sparse'``, which
+        stores only the blocks coupling neighboring grid points. The sparse
+        solver can use less memory when the bandwidth is set by a single wide
+        domain or by the coupling between domains, while the banded solver is
+        usually faster for a single flow domain.
+        """
+        def __get__(self):
+            if self.sim.linearSolver() == c_Sparse_LinearSolver:
+                return 'sparse'
+            else:
+                return 'banded'
+        def __set__(self, solver):
+            if solver == 'banded':
+                self.sim.setLinearSolver(c_Band_LinearSolver)
+            elif solver == 'sparse':
+                self.sim.setLinearSolver(c_Sparse_LinearSolver)
+            else:
+                raise ValueError('Invalid linear solver: {0!r}'.format(solver))
+
+    property interpolation:
+        """
+        The method used to interpolate the solution onto points added during
+        grid refinement. Either ``'linear'`` (the default) or ``'cubic'``,
+        which uses a monotone piecewise cubic interpolant. The cubic method
+        gives a better starting estimate on the refined grid where the
+        profiles are curved, which can reduce the number of time steps needed
+        before the Newton iteration converges.
+        """
+        def __get__(self):
+            return pystr(self.sim.interpolation())
+        def __set__(self, method):
+            self.sim.setInterpolation(stringify(method))
+
+    property refine_statistics:
+        """
+        Statistics for each pass of the solve / refine loop in the most
+        recent call to `solve`. Returns a dict of lists with the keys:
+
+        ``'points'``
+            total number of grid points in the pass
+        ``'time_steps'``
+            number of time steps taken before the Newton iteration converged
+        ``'solve_time'``
+            time [s] spent solving the problem on the grid of the pass
+        ``'added'``, ``'removed'``
+            number of points added and removed by refinement after the pass
+        ``'refine_time'``
+            time [s] spent refining the grid after the pass
+        """
+        def __get__(self):
+            return {'points': self.sim.passGridPoints(),
+                    'time_steps': self.sim.passTimeSteps(),
+                    'solve_time': self.sim.passSolveTime(),
+                    'added': self.sim.passPointsAdded(),
+                    'removed': self.sim.passPointsRemoved(),
+                    'refine_time': self.sim.passRefineTime()}
+
+    property solver_statistics:
+        """
+        Statistics on the solver for each grid used since the last call to
+        `clear_stats`, including the current grid. Returns a dict of lists
+        with the keys:
+
+        ``'points'``
+            number of grid points
+        ``'residual_evals'``, ``'residual_time'``
+            number of residual evaluations, excluding those used to compute
+            Jacobians, and the time [s] spent in them
+        ``'jacobian_evals'``, ``'jacobian_time'``
+            number of Jacobian evaluations and the time [s] spent in them
+        ``'factorizations'``, ``'linear_solve_time'``
+            number of Jacobian factorizations, and the time [s] spent
+            factoring the Jacobian and solving linear systems
+        ``'newton_iterations'``, ``'damping_reductions'``,
+        ``'newton_failures'``, ``'newton_time'``
+            number of Newton iterations, reductions of the damping
+            coefficient, and unsuccessful Newton solves, and the time [s]
+            spent in the Newton solver
+        ``'time_steps'``, ``'time_step_failures'``
+            number of successful and failed pseudo-time steps
+        ``'thermo_time'``, ``'kinetics_time'``, ``'transport_time'``
+            Time [s] spent evaluating properties in the flow domains.
+            Zero unless `property_timing` is enabled.
+        """
+        def __get__(self):
+            cdef vector[double] values
+            stats = {}
+            for name in self.sim.statisticNames():
+                self.sim.getStatistic(name, values)
+                stats[pystr(name)] = values
+            return stats
+
+    property solver_statistics_json:
+        """
+        The statistics given by `solver_statistics`, as a JSON string.
+        """
+        def __get__(self):
+            return pystr(self.sim.statisticsJSON())
+
+    property property_timing:
+        """
+        Set to `True` to measure the time spent evaluating
+        thermodynamic, kinetic and transport properties in the flow domains,
+        which is reported in `solver_statistics`. Disabled by default, since
+        timing adds a small cost to each residual evaluation.
+        """
+        def __set__(self, enable):
+            self.sim.setPropertyTiming(enable)
+
     def save(self, filename='soln.xml', name='solution', description='none',
              loglevel=1):
         """
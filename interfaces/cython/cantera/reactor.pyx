@@ -744,6 +744,7 @@ cdef class ReactorNet:
     """
     def __init__(self, reactors=()):
         self._reactors = []  # prevents premature garbage collection
+        self._event_funcs = []
         for R in reactors:
             self.add_reactor(R)
 
@@ -752,6 +753,67 @@ cdef class ReactorNet:
         self._reactors.append(r)
         self.net.addReactor(deref(r.reactor))
 
+    def add_event(self, kind, Reactor r, component, value=0.0, terminal=True):
+        """
+        Add an event which is located exactly by the integrator, and return
+        its index. *component* is the quantity *q* which defines the event:
+        ``'T'`` (temperature), ``'P'`` (pressure) or the name of a species
+        (mass fraction) in the reactor *r*. *kind* is one of:
+
+        - ``'threshold'``: *q* crosses *value*
+        - ``'peak'``: *q* reaches a local maximum
+        - ``'max-slope'``: the rate of change of *q* reaches a local maximum,
+          e.g. the point of steepest temperature rise which defines an
+          ignition delay. *q* must be a state variable of the reactor.
+        - a function of one variable, or a `Func1`: the function of *q*
+          changes sign
+
+        If *terminal* is `True`, `advance` returns as soon as the event occurs.
+        The times at which events occur are given by `event_time`.
+
+        >>> i = net.add_event('max-slope', r, 'T', terminal=False)
+        >>> net.advance(1.0)
+        >>> tau = net.event_time(i)
+        """
+        cdef Func1 f
+        if isinstance(kind, (str, bytes)):
+            return self.net.addEvent(stringify(kind), deref(r.reactor),
+                                     stringify(component), value, terminal)
+        if isinstance(kind, Func1):
+            f = kind
+        else:
+            f = Func1(kind)
+        self._event_funcs.append(f)
+        return self.net.addEvent(deref(f.func), deref(r.reactor),
+                                 stringify(component), terminal)
+
+    def event_count(self, int i):
+        """
+        The number of times the event *i* has occurred since the integrator
+        was initialized.
+        """
+        return self.net.eventCount(i)
+
+    def event_time(self, int i):
+        """
+        The time [s] at which event *i* first occurred, or `None` if it has
+        not occurred.
+        """
+        if self.net.eventCount(i) == 0:
+            return None
+        return self.net.eventTime(i)
+
+    property last_event:
+        """
+        The index of the most recent event, or `None` if no event has
+        occurred.
+        """
+        def __get__(self):
+            cdef size_t i = self.net.lastEvent()
+            if i >= self.net.nEvents():
+                return None
+            return i
+
     def advance(self, double t):
         """
         Advance the state of the reactor network in time from the current
@@ -766,6 +828,39 @@ cdef class ReactorNet:
         """
         return self.net.step(t)
 
+    def sample(self, times, int derivative=0):
+        """
+        Advance the state of the reactor network to the last of the output
+        times *times* [s], and return the state vector at each of the output
+        times as an array with dimensions *(len(times), n_vars)*. The
+        integrator takes its natural internal steps, and the state at the
+        output times within each step is interpolated, which is much faster
+        than calling `advance` for each output time. If *derivative* is 1,
+        the time derivative of the state vector is returned instead. If a
+        terminal event stops the integration early, only the rows for the
+        output times which were reached are returned.
+        """
+        cdef np.ndarray[np.double_t, ndim=1] t = \
+                np.ascontiguousarray(times, dtype=np.double)
+        if self.net.neq() == 0:
+            self.net.reinitialize()
+        cdef np.ndarray[np.double_t, ndim=2] data = \
+                np.empty((len(t), self.net.neq()))
+        if len(t) == 0:
+            return data
+        n = self.net.sample(len(t), &t[0], &data[0,0], derivative)
+        return data[:n]
+
+    def interpolated_state(self, double t, int derivative=0):
+        """
+        The state vector (or its time derivative, if *derivative* is 1) at
+        time *t* [s], interpolated within the last internal step taken by
+        the integrator.
+        """
+        cdef np.ndarray[np.double_t, ndim=1] data = np.empty(self.net.neq())
+        self.net.getInterpolatedState(t, &data[0], derivative)
+        return data
+
     def reinitialize(self):
         """
         Reinitialize the integrator after making changing to the state of the
@@ -801,6 +896,65 @@ cdef class ReactorNet:
         def __set__(self, n):
             self.net.setMaxErrTestFails(n)
 
+    property linear_solver:
+        """
+        The linear solver used by the integrator: ``'dense'`` (the default)
+        for a direct solver using a dense Jacobian, or ``'gmres'`` for the
+        iterative GMRES solver, which is much faster for large networks.
+        The preconditioner used with GMRES is set with `set_preconditioner`.
+        """
+        def __get__(self):
+            return pystr(self.net.linearSolver())
+        def __set__(self, solver):
+            self.net.setLinearSolver(stringify(solver))
+
+    def set_preconditioner(self, kind, drop_tolerance=0.0):
+        """
+        Set the preconditioner used with the ``'gmres'`` linear solver.
+        *kind* is ``'sparse'`` (the default) to use the Jacobian of each
+        reactor and the coupling between reactors connected by walls and flow
+        devices, ``'block-diagonal'`` to neglect this coupling, or ``'none'``.
+        If *drop_tolerance* is positive, the preconditioner is factored
+        using an incomplete LU factorization with this drop tolerance.
+        """
+        self.net.setPreconditioner(stringify(kind), drop_tolerance)
+
+    property preconditioner:
+        """
+        The type of preconditioner used with the ``'gmres'`` linear solver.
+        See `set_preconditioner`.
+        """
+        def __get__(self):
+            return pystr(self.net.preconditioner())
+
+    property jacobian_type:
+        """
+        The method used to evaluate the Jacobian for the ``'dense'`` linear
+        solver and the preconditioner: ``'analytic'`` to evaluate the
+        derivatives of the homogeneous reaction rates with respect to the
+        species mass fractions analytically where supported by the reactor
+        type, or ``'finite-difference'`` (the default).
+        """
+        def __get__(self):
+            return pystr(self.net.jacobianType())
+        def __set__(self, kind):
+            self.net.setJacobianType(stringify(kind))
+
+    property solver_stats:
+        """
+        A dict of statistics on the work done by the integrator, such as the
+        number of steps (``'steps'``), right-hand-side evaluations
+        (``'rhs_evals'``), Jacobian evaluations for the ``'dense'`` linear
+        solver (``'jac_evals'``) and, for the ``'gmres'`` linear solver, linear
+        iterations (``'lin_iters'``) and preconditioner evaluations
+        (``'prec_evals'``) and solves (``'prec_solves'``).
+        """
+        def __get__(self):
+            cdef stdmap[string, long] stats
+            self.net.getSolverStats(stats)
+            data = stats
+            return dict((pystr(k), v) for k, v in data.items())
+
     property rtol:
         """
         The relative error tolerance used while integrating the reactor
@@ -891,6 +1045,51 @@ cdef class ReactorNet:
                 data[k,p] = self.net.sensitivity(k,p)
         return data
 
+    def set_adjoint_sensitivity(self, pybool adjoint, int checkpoint_steps=100):
+        """
+        Use adjoint sensitivity analysis instead of forward sensitivity
+        analysis. The forward solution is stored every *checkpoint_steps*
+        time steps. Requires the CVODES integrator, with Cantera configured
+        using the ``sundials_adjoint`` option. See `adjoint_sensitivities`.
+        """
+        self.net.setAdjointSensitivity(adjoint, checkpoint_steps)
+
+    property adjoint_sensitivity:
+        """
+        `True` if adjoint sensitivity analysis is enabled.
+        """
+        def __get__(self):
+            return pybool(self.net.adjointSensitivity())
+
+    def adjoint_sensitivities(self, dgdy):
+        """
+        Sensitivities of the objective *G = dgdy . y* at the current time
+        with respect to the multipliers of the sensitivity parameters,
+        computed by integrating the adjoint equations back to the initial
+        time. *dgdy* is an array of length `n_vars`, ordered as the state
+        vector (see `sensitivities`).
+        """
+        cdef np.ndarray[np.double_t, ndim=1] g = \
+                np.ascontiguousarray(dgdy, dtype=np.double)
+        if len(g) != self.net.neq():
+            raise ValueError('Expected an array of length {0}, got {1}'.format(
+                self.net.neq(), len(g)))
+        cdef np.ndarray[np.double_t, ndim=1] data = \
+                np.empty(self.n_sensitivity_params)
+        self.net.getAdjointSensitivities(&g[0], &data[0])
+        return data
+
+    def event_time_sensitivities(self, int i):
+        """
+        Sensitivities of the time of event *i*, e.g. an ignition delay, with
+        respect to the multipliers of the sensitivity parameters. The event
+        must be a terminal event which stopped the integration.
+        """
+        cdef np.ndarray[np.double_t, ndim=1] data = \
+                np.empty(self.n_sensitivity_params)
+        self.net.getEventTimeSensitivities(i, &data[0])
+        return data
+
     def sensitivity_parameter_name(self, int p):
         """
         Name of the sensitivity parameter with index *p*.
@@ -926,3 +1125,267 @@ cdef class ReactorNet:
 
     def __copy__(self):
         raise NotImplementedError('ReactorNet object is not copyable')
+
+
+cdef class ReactorEnsemble:
+    """
+    A collection of independent reactors which are advanced in time together,
+    each using its own integrator. The reactors are distributed among
+    *threads* worker threads (by default, the number of hardware threads
+    available) as each thread becomes free, so that a few stiff reactors do
+    not hold up the rest of the batch. The reactors must not share `Solution`
+    objects and must not be connected to walls or flow devices.
+
+    Example:
+
+    >>> reactors = []
+    >>> for T in np.linspace(900, 1300, 1000):
+    ...     gas = Solution('h2o2.xml')
+    ...     gas.TPX = T, one_atm, 'H2:2, O2:1, AR:4'
+    ...     reactors.append(IdealGasConstPressureReactor(gas))
+    >>> ensemble = ReactorEnsemble(reactors)
+    >>> ensemble.advance(1e-3)
+    """
+    def __init__(self, reactors=(), threads=None):
+        self._reactors = []  # prevents premature garbage collection
+        for R in reactors:
+            self.add_reactor(R)
+        if threads is not None:
+            self.threads = threads
+
+    def add_reactor(self, Reactor r):
+        """Add a reactor to the ensemble."""
+        self.ens.addReactor(deref(r.reactor))
+        self._reactors.append(r)
+
+    property reactors:
+        """The list of reactors in the ensemble."""
+        def __get__(self):
+            return list(self._reactors)
+
+    property threads:
+        """The number of worker threads used by `advance`."""
+        def __get__(self):
+            return self.ens.numThreads()
+        def __set__(self, n):
+            if n < 1:
+                raise ValueError('Number of threads must be positive')
+            self.ens.setNumThreads(n)
+
+    def set_tolerances(self, rtol=-1, atol=-1):
+        """
+        Set the relative and absolute error tolerances for all of the
+        reactors which have been added to the ensemble. Negative values are
+        ignored.
+        """
+        self.ens.setTolerances(rtol, atol)
+
+    def set_max_time_step(self, double t):
+        """
+        Set the maximum time step *t* [s] for all of the reactors which have
+        been added to the ensemble.
+        """
+        self.ens.setMaxTimeStep(t)
+
+    def advance(self, double t):
+        """
+        Advance the state of all of the reactors to time *t* [s]. If any of
+        the reactors fail, an exception is raised after the remaining
+        reactors have been advanced; the reactors which failed are listed by
+        `failed`.
+        """
+        self.ens.advance(t)
+
+    property time:
+        """The time [s] reached by the last call to `advance`."""
+        def __get__(self):
+            return self.ens.time()
+
+    property failed:
+        """
+        The indices of the reactors which failed to reach the requested time
+        in the last call to `advance`.
+        """
+        def __get__(self):
+            return [i for i in range(self.ens.nReactors())
+                    if self.ens.failed(i)]
+
+    def error_message(self, int i):
+        """
+        The error message for reactor *i* from the last call to `advance`, or
+        an empty string if it succeeded.
+        """
+        return pystr(self.ens.errorMessage(i))
+
+    def solver_stats(self, int i):
+        """
+        A dict of statistics on the work done by the integrator for reactor
+        *i*. See `ReactorNet.solver_stats`.
+        """
+        cdef stdmap[string, long] stats
+        self.ens.getSolverStats(i, stats)
+        data = stats
+        return dict((pystr(k), v) for k, v in data.items())
+
+    def __reduce__(self):
+        raise NotImplementedError('ReactorEnsemble object is not picklable')
+
+    def __copy__(self):
+        raise NotImplementedError('ReactorEnsemble object is not copyable')
+
+
+cdef class ChemistryIntegrator:
+    """
+    A lightweight integrator for the chemistry of an adiabatic, constant
+    pressure ideal gas, which solves the same equations as an isolated
+    `IdealGasConstPressureReactor` with much less overhead. It is intended
+    for advancing the chemistry in each cell of an operator-split reacting
+    flow simulation.
+
+    >>> integ = ChemistryIntegrator(gas)
+    >>> integ.integrate(1e-6)  # updates the state of gas
+    """
+    def __cinit__(self, _SolutionBase gas):
+        self.integ = new CxxChemistryIntegrator(deref(gas.thermo),
+                                                deref(gas.kinetics))
+        self.gas = gas
+
+    def __dealloc__(self):
+        del self.integ
+
+    def set_tolerances(self, double rtol, double atol):
+        """
+        Set the relative error tolerance and the absolute error tolerance
+        for the mass fractions.
+        """
+        self.integ.setTolerances(rtol, atol)
+
+    property max_steps:
+        """The maximum number of steps taken by each call to `integrate`."""
+        def __set__(self, size_t nmax):
+            self.integ.setMaxSteps(nmax)
+
+    property initial_step:
+        """
+        The size of the first step taken by `integrate`, or 0 to estimate it
+        from the initial rates of change. After each call to `integrate`,
+        this is the step size proposed for the next step.
+        """
+        def __get__(self):
+            return self.integ.lastStepSize()
+        def __set__(self, double h):
+            self.integ.setInitialStepSize(h)
+
+    def integrate(self, double dt):
+        """
+        Advance the state of the gas by the time interval *dt* [s] at
+        constant pressure.
+        """
+        cdef double T = self.gas.thermo.temperature()
+        cdef double P = self.gas.thermo.pressure()
+        cdef np.ndarray[np.double_t, ndim=1] Y = \
+                np.empty(self.gas.thermo.nSpecies())
+        thermo_getMassFractions(self.gas.thermo, &Y[0])
+        self.integ.integrate(T, &Y[0], P, dt)
+
+    property solver_stats:
+        """
+        A dict of statistics on the work done by all calls to `integrate`.
+        See `ReactorNet.solver_stats`.
+        """
+        def __get__(self):
+            cdef stdmap[string, long] stats
+            self.integ.getSolverStats(stats)
+            data = stats
+            return dict((pystr(k), v) for k, v in data.items())
+
+
+cdef class IsatTable:
+    """
+    An in situ adaptive tabulation (ISAT) table of the results of advancing
+    the chemistry of an adiabatic, constant pressure ideal gas over the time
+    step *dt* [s], for a mechanism with *n_species* species. States which are
+    close to a previously computed state are advanced using a linear
+    approximation of the tabulated result, and other states are advanced by
+    direct integration using a `ChemistryIntegrator`.
+
+    >>> table = IsatTable(gas.n_species, 1e-5)
+    >>> integ = ChemistryIntegrator(gas)
+    >>> table.advance(integ)  # updates the state of gas
+    """
+    def __cinit__(self, size_t n_species, double dt):
+        self.table = new CxxIsatTable(n_species, dt)
+
+    def __dealloc__(self):
+        del self.table
+
+    property time_step:
+        """The time step [s] of the tabulated results."""
+        def __get__(self):
+            return self.table.timeStep()
+
+    property tolerance:
+        """
+        The error tolerance for the tabulated results, where temperatures
+        and pressures are scaled by the values set with `set_scales`.
+        """
+        def __set__(self, double tol):
+            self.table.setTolerance(tol)
+
+    def set_scales(self, double T, double P):
+        """
+        Set the reference temperature [K] and pressure [Pa] used to scale
+        the states. These cannot be changed once records have been added.
+        """
+        self.table.setScales(T, P)
+
+    property max_memory:
+        """
+        The maximum amount of memory [bytes] used by the table. Once this is
+        reached, states which cannot be retrieved are advanced by direct
+        integration without adding them to the table.
+        """
+        def __set__(self, size_t nbytes):
+            self.table.setMaxMemory(nbytes)
+
+    property memory_usage:
+        """The approximate amount of memory [bytes] used by the table."""
+        def __get__(self):
+            return self.table.memoryUsage()
+
+    property n_records:
+        """The number of records in the table."""
+        def __get__(self):
+            return self.table.nRecords()
+
+    def clear(self):
+        """Remove all of the records from the table."""
+        self.table.clear()
+
+    def advance(self, ChemistryIntegrator integ):
+        """
+        Advance the state of the gas used by *integ* by the time step of the
+        table at constant pressure.
+        """
+        cdef CxxThermoPhase* thermo = integ.gas.thermo
+        cdef double T = thermo.temperature()
+        cdef double P = thermo.pressure()
+        cdef np.ndarray[np.double_t, ndim=1] Y = np.empty(thermo.nSpecies())
+        thermo_getMassFractions(thermo, &Y[0])
+        self.table.advance(deref(integ.integ), T, &Y[0], P)
+        thermo_setMassFractions(thermo, &Y[0])
+        thermo.setState_TP(T, P)
+
+    property stats:
+        """
+        A dict with the number of queries ('queries'), and the numbers of
+        these which were retrieved from the table ('retrieves'), which grew
+        the region of accuracy of a record ('grows'), which added a record
+        ('adds'), and which were computed by direct integration without
+        modifying the table ('direct').
+        """
+        def __get__(self):
+            cdef stdmap[string, long] stats
+            self.table.getStats(stats)
+            data = stats
+            return dict((pystr(k), v) for k, v in data.items())
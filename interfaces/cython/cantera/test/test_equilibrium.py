@@ -73,6 +73,20 @@ class EquilTestCases(object):
         gas.equilibrate('TP', self.solver)
         self.check(gas, CH4=1, O2=1)
 
+    def test_equilibrium_stats(self):
+        gas = ct.Solution('gri30.xml')
+        self.assertIsNone(gas.equilibrium_stats)
+        gas.TPX = 301, 100000, 'CH4:1.0, O2:3.0'
+        gas.equilibrate('TP', self.solver)
+        stats = gas.equilibrium_stats
+        self.assertEqual(len(stats), 14)
+        if self.solver != 'gibbs':
+            self.assertEqual(stats['calls'], 1)
+            self.assertGreater(stats['iterations'], 0)
+            self.assertGreater(stats['thermo_evals'], 0)
+            self.assertGreater(stats['time'], 0)
+            self.assertLessEqual(stats['time_inner_loop'], stats['time'])
+
 
 class ChemEquilTest(EquilTestCases, utilities.CanteraTest):
     def __init__(self, *args, **kwargs):
@@ -142,6 +156,63 @@ class TestKOH_Equil(utilities.CanteraTest):
 
         self.compare(data, '../data/koh-equil-HP.csv')
 
+    def test_equilibrium_stats(self):
+        self.mix.T = 3000
+        self.mix.P = ct.one_atm
+        self.mix.species_moles = 'K:1.03, H2:2.12, O2:0.9'
+        self.mix.equilibrate('TP')
+        stats = self.mix.equilibrium_stats
+        self.assertEqual(stats['calls'], 1)
+        self.assertEqual(stats['outer_iterations'], 1)
+        self.assertGreater(stats['iterations'], 0)
+        self.assertGreater(stats['species_deleted'], 0)
+        self.assertGreater(stats['time'], 0)
+
+
+class TestBatchEquilibrium(utilities.CanteraTest):
+    @classmethod
+    def setUpClass(cls):
+        cls.gas = ct.Solution('gri30.xml')
+        cls.gas.TPX = 300, ct.one_atm, 'O2:1.0, N2:3.76'
+        Yo, ho = cls.gas.Y, cls.gas.enthalpy_mass
+        cls.gas.TPX = 300, ct.one_atm, 'CH4:1.0'
+        Yf, hf = cls.gas.Y, cls.gas.enthalpy_mass
+        cls.Z = np.linspace(0.03, 0.1, 20)
+        cls.Y = np.outer(cls.Z, Yf) + np.outer(1 - cls.Z, Yo)
+        cls.h = cls.Z * hf + (1 - cls.Z) * ho
+
+    def test_HP(self):
+        batch = ct.BatchEquilibrium(self.gas)
+        batch.n_threads = 2
+        batch.block_size = 5
+        T, P, Y, converged = batch.equilibrate('HP', self.Y, self.h,
+                                               ct.one_atm)
+        self.assertTrue(converged.all())
+        self.assertEqual(batch.error_message, '')
+        for i in range(len(self.Z)):
+            self.gas.HPY = self.h[i], ct.one_atm, self.Y[i]
+            self.gas.equilibrate('HP')
+            self.assertNear(self.gas.T, T[i], 1e-6)
+            self.assertNear(P[i], ct.one_atm)
+            self.assertArrayNear(self.gas.Y, Y[i], 1e-7, 1e-9)
+
+    def test_failed_point(self):
+        batch = ct.BatchEquilibrium(self.gas)
+        batch.set_options(solver='element_potential')
+        T0 = np.ones(len(self.Z)) * 1500
+        T0[3] = 1e5
+        T, P, Y, converged = batch.equilibrate('TP', self.Y, T0, ct.one_atm)
+        self.assertFalse(converged[3])
+        self.assertTrue(np.isnan(T[3]))
+        self.assertEqual(sum(converged), len(self.Z) - 1)
+        self.assertArrayNear(T[converged], T0[converged])
+        self.assertNotEqual(batch.error_message, '')
+
+        with self.assertRaises(ValueError):
+            batch.set_options(solver='gibbs')
+        with self.assertRaises(ValueError):
+            batch.equilibrate('TP', self.Y[:,:-1], T0, ct.one_atm)
+
 
 class TestEquil_GasCarbon(utilities.CanteraTest):
     "Test rougly based on examples/multiphase/adiabatic.py"
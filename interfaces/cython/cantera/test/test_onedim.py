@@ -1,6 +1,7 @@
 import cantera as ct
 from . import utilities
 import numpy as np
+import json
 import os
 
 
@@ -216,6 +217,57 @@ class TestFreeFlame(utilities.CanteraTest):
         self.assertNear(Su_multi, Su_soret, 2e-1)
         self.assertNotEqual(Su_multi, Su_soret)
 
+    def test_adjoint_sensitivities(self):
+        reactants= 'H2:1.1, O2:1, AR:5'
+        p = ct.one_atm
+        Tin = 300
+
+        self.create_sim(p, Tin, reactants)
+        self.solve_fixed_T()
+        self.solve_mix(ratio=5, slope=0.5, curve=0.3)
+
+        # Tight tolerances are needed for accurate finite differences
+        self.sim.flame.set_steady_tolerances(default=(1e-10, 1e-16))
+        self.sim.solve(loglevel=0, refine_grid=False)
+        Su0 = self.sim.u[0]
+
+        dSdk_adj = self.sim.get_flame_speed_reaction_sensitivities()
+        self.assertEqual(len(dSdk_adj), self.gas.n_reactions)
+
+        # Compare with central finite-difference sensitivities
+        dk = 1e-3
+        for m in range(0, self.gas.n_reactions, 5):
+            self.gas.set_multiplier(1 + dk, m)
+            self.sim.solve(loglevel=0, refine_grid=False)
+            Su_plus = self.sim.u[0]
+            self.gas.set_multiplier(1 - dk, m)
+            self.sim.solve(loglevel=0, refine_grid=False)
+            Su_minus = self.sim.u[0]
+            self.gas.set_multiplier(1.0, m)
+            dSdk_fd = (Su_plus - Su_minus) / (2 * Su0 * dk)
+            self.assertNear(dSdk_fd, dSdk_adj[m], 1e-2, 1e-5)
+
+    def test_sparse_solver(self):
+        reactants= 'H2:1.1, O2:1, AR:5'
+        p = ct.one_atm
+        Tin = 300
+
+        self.create_sim(p, Tin, reactants)
+        self.assertEqual(self.sim.linear_solver, 'banded')
+        self.solve_fixed_T()
+        self.solve_mix(ratio=5, slope=0.5, curve=0.3)
+        Su_band = self.sim.u[0]
+        T_band = self.sim.T
+
+        self.sim.linear_solver = 'sparse'
+        self.assertEqual(self.sim.linear_solver, 'sparse')
+        self.sim.solve(loglevel=0, refine_grid=False)
+        self.assertNear(self.sim.u[0], Su_band, 1e-6)
+        self.assertArrayNear(self.sim.T, T_band, 1e-6)
+
+        with self.assertRaises(ValueError):
+            self.sim.linear_solver = 'dense'
+
     def test_prune(self):
         reactants= 'H2:1.1, O2:1, AR:5'
         p = ct.one_atm
@@ -231,8 +283,69 @@ class TestFreeFlame(utilities.CanteraTest):
 
         self.assertLess(N2, N1)
 
-        # TODO: check that the solution is actually correct (i.e. that the
-        # residual satisfies the error tolerances) on the new grid.
+        # The problem should be solved again after points are removed, so the
+        # final pass should leave the grid unchanged
+        stats = self.sim.refine_statistics
+        self.assertGreater(sum(stats['removed']), 0)
+        self.assertEqual(stats['added'][-1], 0)
+        self.assertEqual(stats['removed'][-1], 0)
+        self.assertEqual(stats['points'][-1], N2 + 2)
+
+    def test_refine_interpolation(self):
+        reactants= 'H2:1.1, O2:1, AR:5'
+        p = ct.one_atm
+        Tin = 300
+
+        results = {}
+        for method in ('linear', 'cubic'):
+            self.create_sim(p, Tin, reactants)
+            self.sim.interpolation = method
+            self.assertEqual(self.sim.interpolation, method)
+            self.solve_fixed_T()
+            self.solve_mix(ratio=5, slope=0.2, curve=0.1)
+            stats = self.sim.refine_statistics
+            self.assertEqual(len(stats['points']), len(stats['solve_time']))
+            self.assertGreater(len(stats['points']), 1)
+            for i in range(1, len(stats['points'])):
+                self.assertEqual(stats['points'][i],
+                                 stats['points'][i-1] + stats['added'][i-1]
+                                 - stats['removed'][i-1])
+            results[method] = self.sim.u[0]
+
+        self.assertNear(results['linear'], results['cubic'], 1e-3)
+
+        with self.assertRaises(Exception):
+            self.sim.interpolation = 'quadratic'
+
+    def test_solver_statistics(self):
+        reactants= 'H2:1.1, O2:1, AR:5'
+        p = ct.one_atm
+        Tin = 300
+
+        self.create_sim(p, Tin, reactants)
+        self.sim.property_timing = True
+        self.solve_fixed_T()
+        self.solve_mix(ratio=5, slope=0.5, curve=0.3)
+        stats = self.sim.solver_statistics
+        npass = len(stats['points'])
+        self.assertGreater(npass, 1)
+        for key, values in stats.items():
+            self.assertEqual(len(values), npass)
+            self.assertTrue(all(v >= 0 for v in values))
+        self.assertEqual(stats['points'][-1], len(self.sim.grid))
+        self.assertTrue(all(n > 0 for n in stats['jacobian_evals']))
+        self.assertTrue(all(n > 0 for n in stats['factorizations']))
+        self.assertGreaterEqual(sum(stats['newton_iterations']),
+                                sum(stats['factorizations']))
+        self.assertGreater(sum(stats['kinetics_time']), 0)
+
+        data = json.loads(self.sim.solver_statistics_json)
+        self.assertEqual(set(data), set(stats))
+        for key in stats:
+            self.assertArrayNear(data[key], stats[key], 1e-8)
+
+        self.sim.clear_stats()
+        self.assertEqual(len(self.sim.solver_statistics['points']), 0)
 
     def test_save_restore(self):
         reactants= 'H2:1.1, O2:1, AR:5'
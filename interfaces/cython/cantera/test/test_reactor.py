@@ -503,6 +503,145 @@ class TestReactor(utilities.CanteraTest):
         self.assertNear(T1a, T1b)
         self.assertNear(T2a, T2b)
 
+    def test_linear_solver(self):
+        def integrate(solver, preconditioner='sparse', drop_tolerance=0.0):
+            self.make_reactors(T1=900, P1=ct.one_atm, X1='H2:2.0, O2:1.0, AR:4.0',
+                               T2=1000, P2=2*ct.one_atm, X2='H2:1.0, O2:1.0')
+            self.add_wall(K=1e-3, U=100, A=1.0)
+            self.net.linear_solver = solver
+            self.net.set_preconditioner(preconditioner, drop_tolerance)
+            self.net.advance(0.05)
+            return [self.r1.T, self.r2.T, self.r1.volume, self.r2.volume]
+
+        ref = integrate('dense')
+        self.assertEqual(self.net.linear_solver, 'dense')
+        self.assertNotIn('lin_iters', self.net.solver_stats)
+
+        for prec, drop in [('sparse', 0.0), ('block-diagonal', 0.0),
+                           ('sparse', 1e-10)]:
+            self.assertArrayNear(ref, integrate('gmres', prec, drop),
+                                 rtol=1e-5, atol=1e-9)
+            self.assertEqual(self.net.preconditioner, prec)
+            stats = self.net.solver_stats
+            self.assertTrue(stats['steps'] > 0)
+            self.assertTrue(stats['lin_iters'] > 0)
+            self.assertTrue(stats['prec_evals'] > 0)
+            self.assertTrue(stats['prec_solves'] > 0)
+            self.assertTrue(stats['prec_nonzeros'] > 0)
+            # the two reactors share a wall, so their Jacobian columns
+            # can't be evaluated together
+            self.assertEqual(stats['prec_jac_colors'], 2)
+
+        with self.assertRaises(Exception):
+            self.net.linear_solver = 'foo'
+        with self.assertRaises(Exception):
+            self.net.set_preconditioner('bar')
+
+    def test_jacobian_type(self):
+        def integrate(jacobian_type):
+            gas = ct.Solution('h2o2.xml')
+            gas.TPX = 1100, ct.one_atm, 'H2:2.0, O2:1.0, AR:4.0'
+            r = self.reactorClass(gas)
+            self.net = ct.ReactorNet([r])
+            self.assertEqual(self.net.jacobian_type, 'finite-difference')
+            self.net.jacobian_type = jacobian_type
+            self.net.advance(0.01)
+            return r.T, r.thermo.Y, self.net.solver_stats
+
+        T1, Y1, stats1 = integrate('finite-difference')
+        T2, Y2, stats2 = integrate('analytic')
+        self.assertEqual(self.net.jacobian_type, 'analytic')
+        self.assertNear(T1, T2, 1e-6)
+        self.assertArrayNear(Y1, Y2, rtol=1e-5, atol=1e-10)
+        self.assertTrue(stats2['jac_evals'] > 0)
+        self.assertTrue(stats2['rhs_evals'] < stats1['rhs_evals'])
+
+        with self.assertRaises(Exception):
+            self.net.jacobian_type = 'foo'
+
+    def test_events(self):
+        def make_net():
+            gas = ct.Solution('h2o2.xml')
+            gas.TPX = 1001, ct.one_atm, 'H2:2.0, O2:1.0, AR:4.0'
+            r = ct.IdealGasReactor(gas)
+            return r, ct.ReactorNet([r])
+
+        # Ignition delay from the maximum rate of temperature rise, estimated
+        # by taking small fixed steps
+        r, net = make_net()
+        dt = 1e-7
+        tau = 0.0
+        maxSlope = 0.0
+        T0 = r.T
+        for i in range(1, 5000):
+            net.advance(i * dt)
+            if (r.T - T0) / dt > maxSlope:
+                maxSlope = (r.T - T0) / dt
+                tau = (i - 0.5) * dt
+            T0 = r.T
+
+        r, net = make_net()
+        i_slope = net.add_event('max-slope', r, 'T', terminal=False)
+        i_peak = net.add_event('peak', r, 'H2O2', terminal=False)
+        i_func = net.add_event(lambda T: T - 1200, r, 'T', terminal=False)
+        i_thresh = net.add_event('threshold', r, 'T', 1500)
+        self.assertIsNone(net.last_event)
+
+        # stops early at the terminal threshold event
+        net.advance(0.002)
+        self.assertEqual(net.last_event, i_thresh)
+        self.assertNear(r.T, 1500, 1e-8)
+        self.assertNear(net.time, net.event_time(i_thresh), 1e-12)
+        self.assertTrue(net.time < tau)
+        self.assertEqual(net.event_count(i_func), 1)
+        self.assertTrue(net.event_time(i_func) < net.time)
+        self.assertIsNone(net.event_time(i_slope))
+
+        net.advance(0.002)
+        self.assertNear(net.time, 0.002)
+        self.assertEqual(net.event_count(i_thresh), 1)
+        self.assertNear(net.event_time(i_slope), tau, 1e-3)
+        self.assertTrue(net.event_time(i_peak) < tau)
+
+        with self.assertRaises(Exception):
+            net.add_event('foo', r, 'T')
+        with self.assertRaises(Exception):
+            net.add_event('peak', r, 'CH4')
+
+    def test_sample(self):
+        def make_net():
+            gas = ct.Solution('h2o2.xml')
+            gas.TPX = 1001, ct.one_atm, 'H2:2.0, O2:1.0, AR:4.0'
+            r = ct.IdealGasReactor(gas)
+            return r, ct.ReactorNet([r])
+
+        times = np.linspace(0, 1e-3, 201)
+        r, net = make_net()
+        data = net.sample(times)
+        self.assertEqual(data.shape, (len(times), net.n_vars))
+        self.assertNear(net.time, times[-1])
+        self.assertNear(r.T, data[-1,2])
+        ydot = net.interpolated_state(net.time, 1)
+        self.assertEqual(len(ydot), net.n_vars)
+
+        r2, net2 = make_net()
+        net2.set_max_time_step(1e-3)
+        for i in range(1, len(times), 10):
+            net2.advance(times[i])
+            y = np.hstack([r2.mass, r2.volume, r2.T, r2.thermo.Y])
+            self.assertArrayNear(data[i], y, rtol=1e-4, atol=1e-10)
+
+        # The output stops at a terminal event
+        r, net = make_net()
+        net.add_event('threshold', r, 'T', 1500)
+        data = net.sample(times)
+        self.assertTrue(0 < len(data) < len(times))
+        self.assertNear(r.T, 1500)
+        self.assertTrue(times[len(data)-1] <= net.time < times[len(data)])
+
+        with self.assertRaises(Exception):
+            net.sample([0.0])
+
     def test_unpicklable(self):
         self.make_reactors()
         import pickle
@@ -630,6 +769,148 @@ class TestWellStirredReactorIgnition(utilities.CanteraTest):
         self.assertTrue(T[-1] < 910) # mixture did not ignite
 
 
+class TestReactorEnsemble(utilities.CanteraTest):
+    def make_reactors(self, n=8):
+        reactors = []
+        for i, T in enumerate(np.linspace(900, 1300, n)):
+            gas = ct.Solution('h2o2.xml')
+            gas.TPX = T, ct.one_atm, 'H2:2.0, O2:1.0, AR:4.0'
+            if i % 2:
+                reactors.append(ct.IdealGasConstPressureReactor(gas))
+            else:
+                reactors.append(ct.IdealGasReactor(gas))
+        return reactors
+
+    def test_advance(self):
+        reactors = self.make_reactors()
+        for r in reactors:
+            ct.ReactorNet([r]).advance(0.01)
+        T_ref = [r.T for r in reactors]
+
+        for threads in (1, 3):
+            reactors = self.make_reactors()
+            ensemble = ct.ReactorEnsemble(reactors, threads=threads)
+            self.assertEqual(ensemble.threads, threads)
+            ensemble.advance(0.01)
+            self.assertNear(ensemble.time, 0.01)
+            self.assertArrayNear([r.T for r in reactors], T_ref, 1e-8)
+            self.assertEqual(ensemble.failed, [])
+            for i in range(len(reactors)):
+                self.assertTrue(ensemble.solver_stats(i)['steps'] > 0)
+                self.assertEqual(ensemble.error_message(i), '')
+
+    def test_bad_reactors(self):
+        gas = ct.Solution('h2o2.xml')
+        ensemble = ct.ReactorEnsemble([ct.IdealGasReactor(gas)])
+        with self.assertRaises(Exception):
+            # shared Solution object
+            ensemble.add_reactor(ct.IdealGasReactor(gas))
+
+        r1 = ct.IdealGasReactor(ct.Solution('h2o2.xml'))
+        r2 = ct.Reservoir(ct.Solution('h2o2.xml'))
+        ct.Wall(r1, r2)
+        with self.assertRaises(Exception):
+            ensemble.add_reactor(r1)
+
+        with self.assertRaises(ValueError):
+            ensemble.threads = 0
+
+
+class TestChemistryIntegrator(utilities.CanteraTest):
+    def test_integrate(self):
+        gas1 = ct.Solution('h2o2.xml')
+        gas1.TPX = 1100, 2 * ct.one_atm, 'H2:2.0, O2:1.0, AR:4.0'
+        r = ct.IdealGasConstPressureReactor(gas1)
+        net = ct.ReactorNet([r])
+        net.rtol = 1e-10
+        net.atol = 1e-18
+
+        gas2 = ct.Solution('h2o2.xml')
+        gas2.TPX = gas1.TPX
+        integ = ct.ChemistryIntegrator(gas2)
+        integ.set_tolerances(1e-8, 1e-18)
+        dt = 2e-5
+        for i in range(1, 26):
+            net.advance(i * dt)
+            integ.integrate(dt)
+            self.assertNear(gas2.P, 2 * ct.one_atm)
+            self.assertNear(gas2.T, gas1.T, 1e-5)
+            self.assertArrayNear(gas2.Y, gas1.Y, 1e-5, 1e-10)
+        self.assertTrue(gas2.T > 2000)
+        self.assertTrue(integ.initial_step > 0)
+
+        stats = integ.solver_stats
+        self.assertTrue(stats['steps'] > 0)
+        self.assertEqual(stats['jac_evals'], stats['steps'])
+
+    def test_max_steps(self):
+        gas = ct.Solution('h2o2.xml')
+        gas.TPX = 1200, ct.one_atm, 'H2:2.0, O2:1.0, AR:4.0'
+        T0 = gas.T
+        integ = ct.ChemistryIntegrator(gas)
+        integ.max_steps = 2
+        integ.initial_step = 1e-9
+        with self.assertRaises(Exception):
+            integ.integrate(1e-3)
+        self.assertNear(gas.T, T0)
+
+    def test_bad_phase(self):
+        solid = ct.Solution('diamond.xml', 'diamond')
+        with self.assertRaises(Exception):
+            ct.ChemistryIntegrator(solid)
+
+
+class TestIsatTable(utilities.CanteraTest):
+    def setUp(self):
+        self.gas = ct.Solution('h2o2.xml')
+        self.integ = ct.ChemistryIntegrator(self.gas)
+        self.ref = ct.Solution('h2o2.xml')
+        self.ref_integ = ct.ChemistryIntegrator(self.ref)
+
+    def test_retrieve(self):
+        dt = 2e-4
+        table = ct.IsatTable(self.gas.n_species, dt)
+        self.assertNear(table.time_step, dt)
+        # The second set of states is between those added by the first set
+        states = np.hstack((np.linspace(1000, 1500, 26),
+                            np.linspace(1010, 1490, 25)))
+        for T in states:
+            self.gas.TPX = T, ct.one_atm, 'H2:2.0, O2:1.0, AR:4.0'
+            self.ref.TPX = self.gas.TPX
+            table.advance(self.integ)
+            self.ref_integ.integrate(dt)
+            self.assertNear(self.gas.P, ct.one_atm)
+            self.assertNear(self.gas.T, self.ref.T, 1e-2)
+            self.assertArrayNear(self.gas.Y, self.ref.Y, 1e-2, 1e-4)
+
+        stats = table.stats
+        self.assertEqual(stats['queries'], 51)
+        self.assertEqual(stats['queries'], stats['retrieves'] +
+                         stats['grows'] + stats['adds'] + stats['direct'])
+        self.assertTrue(stats['retrieves'] > 0)
+        self.assertEqual(stats['adds'], table.n_records)
+        self.assertTrue(table.memory_usage > 0)
+
+        table.clear()
+        self.assertEqual(table.n_records, 0)
+
+    def test_max_memory(self):
+        table = ct.IsatTable(self.gas.n_species, 2e-4)
+        table.max_memory = 0
+        self.gas.TPX = 1200, ct.one_atm, 'H2:2.0, O2:1.0, AR:4.0'
+        self.ref.TPX = self.gas.TPX
+        table.advance(self.integ)
+        self.ref_integ.integrate(2e-4)
+        self.assertNear(self.gas.T, self.ref.T)
+        self.assertEqual(table.n_records, 0)
+        self.assertEqual(table.stats['direct'], 1)
+
+    def test_bad_integrator(self):
+        table = ct.IsatTable(self.gas.n_species + 1, 1e-5)
+        with self.assertRaises(Exception):
+            table.advance(self.integ)
+
+
 class TestConstPressureReactor(utilities.CanteraTest):
     """
     The constant pressure reactor should give essentially the same results as
@@ -964,6 +1245,78 @@ class TestReactorSensitivities(utilities.CanteraTest):
             self.assertNear(np.linalg.norm(S[Ns:K2,1]), 0.0, atol=1e-5)
             self.assertNear(np.linalg.norm(S[K2+Ns:,0]), 0.0, atol=1e-5)
 
+    def _test_adjoint(self, reactorClass):
+        gas = ct.Solution('h2o2.xml')
+
+        def integrate(adjoint):
+            gas.TPX = 900, 101325, 'H2:0.1, OH:1e-7, O2:0.1, AR:1e-5'
+            r = reactorClass(gas)
+            net = ct.ReactorNet([r])
+            net.rtol_sensitivity = 1e-6
+            net.atol_sensitivity = 1e-8
+            for p in (2, 10, 18, 19):
+                r.add_sensitivity_reaction(p)
+            net.set_adjoint_sensitivity(adjoint)
+            self.assertEqual(net.adjoint_sensitivity, adjoint)
+            net.advance(0.01)
+            return r, net
+
+        r1, net1 = integrate(False)
+        kT = r1.component_index('temperature')
+        S1 = net1.sensitivities()[kT] * r1.T
+
+        r2, net2 = integrate(True)
+        with self.assertRaises(Exception):
+            net2.sensitivities()
+        dgdy = np.zeros(net2.n_vars)
+        dgdy[kT] = 1.0
+        S2 = net2.adjoint_sensitivities(dgdy)
+        self.assertArrayNear(S1, S2, 1e-3, 1e-3 * max(abs(S1)))
+
+    @unittest.skipIf(ct._have_sundials_adjoint(),
+                     "Adjoint sensitivities are available")
+    def test_adjoint_not_available(self):
+        gas = ct.Solution('h2o2.xml')
+        net = ct.ReactorNet([ct.IdealGasReactor(gas)])
+        with self.assertRaises(Exception):
+            net.set_adjoint_sensitivity(True)
+        self.assertFalse(net.adjoint_sensitivity)
+
+    @unittest.skipUnless(ct._have_sundials_adjoint(),
+                         "Adjoint sensitivities require sundials_adjoint=y")
+    def test_adjoint_sensitivities1(self):
+        self._test_adjoint(ct.IdealGasReactor)
+
+    @unittest.skipUnless(ct._have_sundials_adjoint(),
+                         "Adjoint sensitivities require sundials_adjoint=y")
+    def test_adjoint_sensitivities2(self):
+        self._test_adjoint(ct.IdealGasConstPressureReactor)
+
+    @unittest.skipUnless(ct._have_sundials_adjoint(),
+                         "Adjoint sensitivities require sundials_adjoint=y")
+    def test_ignition_delay_sensitivities(self):
+        gas = ct.Solution('h2o2.xml')
+        gas.TPX = 1000, 101325, 'H2:2, O2:1, AR:5'
+        r = ct.IdealGasConstPressureReactor(gas)
+        net = ct.ReactorNet([r])
+        r.add_sensitivity_reaction(0)
+        net.set_adjoint_sensitivity(True)
+        i = net.add_event('threshold', r, 'T', 1400)
+        net.advance(1.0)
+        self.assertEqual(net.last_event, i)
+        tau = net.time
+        dtdp = net.event_time_sensitivities(i)
+
+        # compare with finite differences
+        gas.TPX = 1000, 101325, 'H2:2, O2:1, AR:5'
+        gas.set_multiplier(1.01, 0)
+        r = ct.IdealGasConstPressureReactor(gas)
+        net = ct.ReactorNet([r])
+        i = net.add_event('threshold', r, 'T', 1400)
+        net.advance(1.0)
+        gas.set_multiplier(1.0)
+        self.assertNear(dtdp[0], (net.time - tau) / np.log(1.01), 2e-2)
+
     def _test_parameter_order1(self, reactorClass):
         # Single reactor, changing the order in which parameters are added
         gas = ct.Solution('h2o2.xml')
@@ -144,9 +144,33 @@ cdef class ThermoPhase(_SolutionBase):
         else:
             raise ValueError('Invalid equilibrium solver specified')
 
+        cdef CxxEquilStats stats
         XY = XY.upper()
         equilibrate(deref(self.thermo), stringify(XY).c_str(),
-                    iSolver, rtol, maxsteps, maxiter, loglevel)
+                    iSolver, rtol, maxsteps, maxiter, loglevel, &stats)
+        self._equil_stats = _equil_stats_dict(stats)
+
+    property equilibrium_stats:
+        """
+        A dict of statistics on the work done by the last call to
+        `equilibrate`, or *None* if `equilibrate` has not been called
+        successfully. The entries are the total time (``'time'``), the time
+        spent optimizing the basis of component species
+        (``'time_basis_opt'``), in the main iteration of the solver
+        (``'time_inner_loop'``), in phase stability tests
+        (``'time_phase_stability'``) and evaluating reaction free energies
+        (``'time_deltag'``), all in seconds, and the number of solver calls
+        (``'calls'``), iterations (``'iterations'``), outer iterations on T or
+        P for the VCS solver (``'outer_iterations'``), basis optimizations
+        (``'basis_opts'``), phase stability tests
+        (``'phase_stability_tests'``), deleted and reinserted species
+        (``'species_deleted'`` and ``'species_reinserted'``), evaluations
+        of the thermodynamic properties (``'thermo_evals'``) and changes to
+        the compositions of the phases (``'thermo_state_updates'``). Entries
+        which do not apply to the solver which was used are zero.
+        """
+        def __get__(self):
+            return self._equil_stats
 
     ####### Composition, species, and elements ########
 
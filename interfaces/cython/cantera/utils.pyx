@@ -26,8 +26,17 @@ def add_directory(directory):
 def _have_sundials():
     return bool(get_sundials_version())
 
+def _have_sundials_adjoint():
+    return bool(has_sundials_adjoint())
+
 __version__ = pystr(get_cantera_version())
 
 def appdelete():
     """ Delete all global Cantera C++ objects """
     CxxAppdelete()
+
+cdef dict _equil_stats_dict(CxxEquilStats& stats):
+    cdef stdmap[string, double] values
+    stats.getStats(values)
+    data = values
+    return dict((pystr(k), v) for k, v in data.items())
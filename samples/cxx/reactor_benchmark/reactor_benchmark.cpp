@@ -0,0 +1,89 @@
+/*!
+ * @file reactor_benchmark.cpp
+ *
+ * Measure the cost of evaluating the right-hand side of the governing
+ * equations of a reactor network. A GRI-Mech 3.0 methane/air mixture in an
+ * IdealGasReactor is advanced partway to ignition, and ReactorNet::eval() is
+ * then called repeatedly, first with the state vector the integrator would
+ * pass when it evaluates the RHS more than once at the same point (for
+ * example, when forming a finite difference Jacobian), and then with a
+ * slightly different composition on every call. Finally, the time for the
+ * complete integration through ignition is reported.
+ *
+ * Usage: reactor_benchmark [nevals]
+ */
+
+#include "cantera/zeroD/ReactorNet.h"
+#include "cantera/zeroD/IdealGasReactor.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/base/clockWC.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace Cantera;
+
+const char* comp = "CH4:1, O2:2, N2:7.52";
+
+int main(int argc, char** argv)
+{
+    int nevals = 100000;
+    if (argc > 1) {
+        nevals = atoi(argv[1]);
+    }
+    try {
+        IdealGasMix gas("gri30.xml", "gri30");
+        gas.setState_TPX(1200.0, OneAtm, comp);
+        IdealGasReactor r;
+        r.insert(gas);
+        ReactorNet net;
+        net.addReactor(r);
+        net.advance(1e-4);
+
+        size_t nv = net.neq();
+        vector_fp y(nv), y2(nv), ydot(nv);
+        net.getInitialConditions(0.0, nv, &y[0]);
+
+        Cantera::clockWC timer;
+        for (int i = 0; i < nevals; i++) {
+            net.eval(0.0, &y[0], &ydot[0], 0);
+        }
+        double tSame = timer.secondsWC() / nevals;
+
+        // Perturb one of the species mass fractions (which start at index 3
+        // of the state vector) by a different relative amount on each call
+        size_t nperturb = std::min<size_t>(50, nv - 3);
+        timer.start();
+        for (int i = 0; i < nevals; i++) {
+            y2 = y;
+            y2[3 + i % nperturb] *= 1.0 + 1e-8 * (1 + i % 7);
+            net.eval(0.0, &y2[0], &ydot[0], 0);
+        }
+        double tPerturbed = timer.secondsWC() / nevals;
+
+        IdealGasMix gas2("gri30.xml", "gri30");
+        gas2.setState_TPX(1200.0, OneAtm, comp);
+        IdealGasReactor r2;
+        r2.insert(gas2);
+        ReactorNet net2;
+        net2.addReactor(r2);
+        timer.start();
+        net2.advance(0.2);
+        double tIgnition = timer.secondsWC();
+
+        printf("%d species, %d RHS evaluations per test\n\n",
+               int(gas.nSpecies()), nevals);
+        printf("%-34s %8.3f us/eval\n", "RHS at an unchanged state:",
+               1e6 * tSame);
+        printf("%-34s %8.3f us/eval\n", "RHS with a perturbed composition:",
+               1e6 * tPerturbed);
+        printf("%-34s %8.3f s (T = %.2f K at t = 0.2 s)\n",
+               "Integration through ignition:", tIgnition, r2.temperature());
+    } catch (CanteraError& err) {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+    appdelete();
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*!
+ * @file solver_benchmark.cpp
+ *
+ * Compare the memory use and run time of the banded and sparse linear
+ * solvers used by the Newton iteration in 1D flame simulations. The
+ * Jacobian of a burner-stabilized hydrogen flame is evaluated on grids of
+ * increasing size, and then factored and solved repeatedly with each solver.
+ *
+ * Usage: solver_benchmark [max_points]
+ */
+
+#include "cantera/oneD/Sim1D.h"
+#include "cantera/oneD/Inlet1D.h"
+#include "cantera/oneD/StFlow.h"
+#include "cantera/oneD/MultiJac.h"
+#include "cantera/IdealGasMix.h"
+#include "cantera/transport.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+using namespace Cantera;
+
+void benchmark(IdealGasMix& gas, Transport& tr, size_t npoints, int solver,
+               int nsolve)
+{
+    const char* comp = "H2:1.5, O2:1.0, AR:7.0";
+    doublereal mdot = 0.06; // kg/m^2/s
+    doublereal Tburner = 373.0;
+    doublereal Tmax = 1800.0;
+    doublereal width = 0.02; // m
+
+    gas.setState_TPX(Tburner, 0.05*OneAtm, comp);
+    doublereal rho_in = gas.density();
+    vector_fp x(gas.nSpecies()), y(gas.nSpecies());
+    gas.getMoleFractions(&x[0]);
+    gas.getMassFractions(&y[0]);
+
+    AxiStagnFlow flow(&gas);
+    vector_fp z(npoints);
+    for (size_t j = 0; j < npoints; j++) {
+        z[j] = width * j / (npoints - 1.0);
+    }
+    flow.setupGrid(npoints, &z[0]);
+    flow.setTransport(tr);
+    flow.setKinetics(gas);
+    flow.setPressure(gas.pressure());
+
+    Inlet1D burner;
+    Outlet1D outlet;
+    std::vector<Domain1D*> domains;
+    domains.push_back(&burner);
+    domains.push_back(&flow);
+    domains.push_back(&outlet);
+
+    Sim1D sim(domains);
+    sim.setLinearSolver(solver);
+    burner.setMoleFractions(&x[0]);
+    burner.setTemperature(Tburner);
+    burner.setMdot(mdot);
+
+    // A smooth initial estimate is sufficient to give a Jacobian with the
+    // structure and conditioning of a real flame problem
+    vector_fp locs(2), vals(2);
+    locs[0] = 0.0;
+    locs[1] = 1.0;
+    vals[0] = Tburner;
+    vals[1] = Tmax;
+    sim.setProfile(1, 2, locs, vals);
+    vals[0] = mdot / rho_in;
+    vals[1] = vals[0] * Tmax / Tburner;
+    sim.setProfile(1, 0, locs, vals);
+    for (size_t k = 0; k < gas.nSpecies(); k++) {
+        sim.setFlatProfile(1, 4 + k, y[k]);
+    }
+
+    OneDim& sys = sim;
+    MultiJac& jac = sys.jacobian();
+    vector_fp soln(sim.solution(), sim.solution() + sim.size());
+    vector_fp resid(sim.size()), b(sim.size());
+
+    clock_t t0 = clock();
+    sys.eval(npos, &soln[0], &resid[0], 0.0, 0);
+    jac.eval(&soln[0], &resid[0], 0.0);
+    double tJac = double(clock() - t0) / CLOCKS_PER_SEC;
+
+    double tFirst = 0.0;
+    t0 = clock();
+    for (int n = 0; n < nsolve; n++) {
+        jac.matrix().clearFactorFlag();
+        int info = jac.solve(&resid[0], &b[0]);
+        if (info != 0) {
+            throw CanteraError("benchmark", "Linear solve failed");
+        }
+        if (n == 0) {
+            tFirst = double(clock() - t0) / CLOCKS_PER_SEC;
+        }
+    }
+    double tSolve = double(clock() - t0) / CLOCKS_PER_SEC;
+
+    printf("%7s %6d %8d %12.2f %12.3e %12.3e %12.3e\n",
+           (solver == c_Band_LinearSolver) ? "banded" : "sparse",
+           int(npoints), int(sim.size()),
+           jac.memoryUsage() / 1048576.0,
+           tJac, tFirst, tSolve / nsolve);
+}
+
+int main(int argc, char** argv)
+{
+    size_t maxPoints = 3200;
+    if (argc > 1) {
+        maxPoints = atoi(argv[1]);
+    }
+    try {
+        IdealGasMix gas("h2o2.cti", "ohmech");
+        Transport* tr = newTransportMgr("Mix", &gas);
+
+        printf("%7s %6s %8s %12s %12s %12s %12s\n", "solver", "points",
+               "size", "memory (MB)", "Jac time", "first solve",
+               "mean solve");
+        for (size_t np = 100; np <= maxPoints; np *= 2) {
+            benchmark(gas, *tr, np, c_Band_LinearSolver, 10);
+            benchmark(gas, *tr, np, c_Sparse_LinearSolver, 10);
+        }
+        delete tr;
+    } catch (CanteraError& err) {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
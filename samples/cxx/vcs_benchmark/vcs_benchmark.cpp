@@ -0,0 +1,139 @@
+/*!
+ * @file vcs_benchmark.cpp
+ *
+ * Measure the run time of the VCS equilibrium solver for a large multiphase
+ * system. The mixture consists of an ideal gas containing all of the species
+ * in the NASA gas-phase database which can be formed from a set of 42
+ * elements, including ions, and one stoichiometric condensed phase for each
+ * species in the NASA condensed-phase database, giving more than 900 species
+ * in about 190 phases. Most of the species contain only a few of the
+ * elements. The mixture, a simplified rock and salt composition with water
+ * and air, is equilibrated at constant temperature and pressure over a range
+ * of temperatures.
+ *
+ * Usage: vcs_benchmark [nrepeat]
+ */
+
+#include "cantera/equilibrium.h"
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/base/ctml.h"
+#include "cantera/base/stringUtils.h"
+#include "cantera/base/clockWC.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+using namespace Cantera;
+
+const char* elements = "O H C N S Cl F P Si Al Fe Mg Ca Na K Ti Cr Ni Cu Zn "
+                       "Ba Sr Li B Be Br I Mo Nb Pb V Zr Ta Cs Hg Ar He Ne "
+                       "Kr Xe E D";
+
+// Create the phases of the mixture and add them to *mix*
+void buildMixture(MultiPhase& mix, std::vector<ThermoPhase*>& phases)
+{
+    std::stringstream s;
+    s << "<ctml>"
+      << "<phase id=\"gas\" dim=\"3\">"
+      << "<elementArray datasrc=\"elements.xml\">" << elements
+      << "</elementArray>"
+      << "<speciesArray datasrc=\"nasa_gas.xml#species_data\">all"
+      << "<skip element=\"undeclared\"/></speciesArray>"
+      << "<thermo model=\"IdealGas\"/><kinetics model=\"none\"/>"
+      << "<transport model=\"None\"/></phase>";
+
+    XML_Node* db = get_XML_File("nasa_condensed.xml");
+    std::vector<XML_Node*> species;
+    db->findID("species_data")->getChildren("species", species);
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < species.size(); i++) {
+        // Skip species which have only placeholder data for some
+        // temperature ranges
+        std::vector<XML_Node*> nasa;
+        species[i]->child("thermo").getChildren("NASA", nasa);
+        bool valid = true;
+        for (size_t j = 0; j < nasa.size(); j++) {
+            if (fpValue((*nasa[j])["Tmin"]) >= fpValue((*nasa[j])["Tmax"])) {
+                valid = false;
+            }
+        }
+        if (!valid) {
+            continue;
+        }
+        ids.push_back("c" + int2str(i));
+        s << "<phase id=\"" << ids.back() << "\" dim=\"3\">"
+          << "<elementArray datasrc=\"elements.xml\">" << elements
+          << "</elementArray>"
+          << "<speciesArray datasrc=\"nasa_condensed.xml#species_data\">"
+          << (*species[i])["name"] << "</speciesArray>"
+          << "<thermo model=\"StoichSubstance\">"
+          << "<density units=\"g/cm3\">3.0</density></thermo>"
+          << "<kinetics model=\"none\"/><transport model=\"None\"/></phase>";
+    }
+    s << "</ctml>";
+
+    XML_Node root;
+    root.build(s);
+    phases.push_back(newPhase(*root.findID("gas")));
+    mix.addPhase(phases.back(), 1.0);
+    for (size_t i = 0; i < ids.size(); i++) {
+        phases.push_back(newPhase(*root.findID(ids[i])));
+        mix.addPhase(phases.back(), 0.0);
+    }
+    mix.init();
+}
+
+int main(int argc, char** argv)
+{
+    int nrepeat = 1;
+    if (argc > 1) {
+        nrepeat = atoi(argv[1]);
+    }
+    const char* comp = "H2O:10, CO2:3, N2:5, O2:1, SiO2:6, AL2O:2, FeO:1, "
+                       "MgO:2, CaO:2, NaCL:0.5, KCL:0.3, TiO2:0.1, S2:0.2, "
+                       "P4O10:0.01, CaF2:0.05, HCL:0.1, Ar:0.1";
+    std::vector<ThermoPhase*> phases;
+    try {
+        MultiPhase mix;
+        buildMixture(mix, phases);
+        printf("%d phases, %d species, %d elements\n\n", int(mix.nPhases()),
+               int(mix.nSpecies()), int(mix.nElements()));
+
+        printf("%8s %12s %12s %10s\n", "T (K)", "time (s)", "gas moles",
+               "condensed");
+        double total = 0.0;
+        for (double T = 500.0; T <= 2500.0; T += 500.0) {
+            Cantera::clockWC timer;
+            for (int n = 0; n < nrepeat; n++) {
+                mix.setMolesByName(comp);
+                mix.setTemperature(T);
+                mix.setPressure(OneAtm);
+                VCSnonideal::vcs_MultiPhaseEquil eq(&mix, 0);
+                if (eq.equilibrate(TP, 0, 0, 1e-9) != 0) {
+                    throw CanteraError("vcs_benchmark",
+                                       "Equilibrium solver failed");
+                }
+            }
+            double t = timer.secondsWC() / nrepeat;
+            total += t;
+            int ncondensed = 0;
+            for (size_t n = 1; n < mix.nPhases(); n++) {
+                if (mix.phaseMoles(n) > 0.0) {
+                    ncondensed++;
+                }
+            }
+            printf("%8.1f %12.3e %12.4f %10d\n", T, t, mix.phaseMoles(0),
+                   ncondensed);
+        }
+        printf("\ntotal time per sweep: %.3e s\n", total);
+    } catch (CanteraError& err) {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < phases.size(); i++) {
+        delete phases[i];
+    }
+    appdelete();
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file EquilStatsStore.h
+ */
+#ifndef CTC_EQUILSTATSSTORE_H
+#define CTC_EQUILSTATSSTORE_H
+
+#include "cantera/equil/EquilStats.h"
+#include "cantera/base/ct_thread.h"
+
+#include <map>
+
+namespace Cantera
+{
+
+/**
+ * Statistics of the last equilibrium calculation for each object in a
+ * Cabinet, indexed by the same integers as the Cabinet. Entries must be
+ * erased when the corresponding object is deleted, since the indices are
+ * reused after the Cabinet is cleared.
+ */
+class EquilStatsStore
+{
+public:
+    //! Store the statistics for object *n*, replacing any earlier ones
+    void set(int n, const EquilStats& stats) {
+        ScopedLock lock(m_mutex);
+        m_stats[n] = stats;
+    }
+
+    //! Get the statistic *name* for object *n*. All statistics are zero for
+    //! an object that has not been equilibrated.
+    double get(int n, const std::string& name) {
+        EquilStats stats;
+        {
+            ScopedLock lock(m_mutex);
+            std::map<int, EquilStats>::const_iterator iter = m_stats.find(n);
+            if (iter != m_stats.end()) {
+                stats = iter->second;
+            }
+        }
+        return stats.get(name);
+    }
+
+    //! Remove the statistics for object *n*
+    void erase(int n) {
+        ScopedLock lock(m_mutex);
+        m_stats.erase(n);
+    }
+
+    //! Remove the statistics for all objects
+    void clear() {
+        ScopedLock lock(m_mutex);
+        m_stats.clear();
+    }
+
+private:
+    std::map<int, EquilStats> m_stats;
+    mutex_t m_mutex;
+};
+
+//! Statistics of the last call to th_equil for each phase
+extern EquilStatsStore th_equilStats;
+
+//! Statistics of the last call to mix_vcs_equilibrate for each mixture
+extern EquilStatsStore mix_equilStats;
+
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include "cantera/kinetics/importKinetics.h"
 #include "cantera/thermo/ThermoFactory.h"
 #include "Cabinet.h"
+#include "EquilStatsStore.h"
 #include "cantera/kinetics/InterfaceKinetics.h"
 #include "cantera/thermo/PureFluidPhase.h"
 
@@ -34,6 +35,11 @@ template<> ThermoCabinet* ThermoCabinet::s_storage = 0;
 template<> KineticsCabinet* KineticsCabinet::s_storage = 0;
 template<> TransportCabinet* TransportCabinet::s_storage = 0;
 
+namespace Cantera
+{
+EquilStatsStore th_equilStats;
+}
+
 /**
  * Exported functions.
  */
@@ -43,6 +49,8 @@ extern "C" {
     {
         try {
             appdelete();
+            th_equilStats.clear();
+            mix_equilStats.clear();
             return 0;
         } catch (...) {
             return handleAllExceptions(-1, ERR);
@@ -592,13 +600,26 @@ extern "C" {
                  double rtol, int maxsteps, int maxiter, int loglevel)
     {
         try {
+            EquilStats stats;
+            th_equilStats.erase(n);
             equilibrate(ThermoCabinet::item(n), XY, solver, rtol, maxsteps,
-                        maxiter, loglevel);
+                        maxiter, loglevel, &stats);
+            th_equilStats.set(n, stats);
             return 0;
         } catch (...) {
             return handleAllExceptions(-1, ERR);
         }
     }
+
+    double th_equilStat(int n, char* name)
+    {
+        try {
+            ThermoCabinet::item(n);
+            return th_equilStats.get(n, name);
+        } catch (...) {
+            return handleAllExceptions(DERR, DERR);
+        }
+    }
     
     doublereal th_refPressure(int n)
     {
@@ -1411,6 +1432,7 @@ extern "C" {
     {
         try {
             ThermoCabinet::clear();
+            th_equilStats.clear();
             KineticsCabinet::clear();
             TransportCabinet::clear();
             return 0;
@@ -1423,6 +1445,7 @@ extern "C" {
     {
         try {
             ThermoCabinet::del(n);
+            th_equilStats.erase(n);
             return 0;
         } catch (...) {
             return handleAllExceptions(-1, ERR);
@@ -79,6 +79,7 @@ extern "C" {
     CANTERA_CAPI int th_set_SP(int n, double* vals);
     CANTERA_CAPI int th_equil(int n, char* XY, int solver,
                               double rtol, int maxsteps, int maxiter, int loglevel);
+    CANTERA_CAPI double th_equilStat(int n, char* name);
 
     CANTERA_CAPI double th_critTemperature(int n);
     CANTERA_CAPI double th_critPressure(int n);
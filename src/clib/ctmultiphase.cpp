@@ -10,6 +10,7 @@
 #include "cantera/equil/MultiPhaseEquil.h"
 #include "cantera/equil/vcs_MultiPhaseEquil.h"
 #include "Cabinet.h"
+#include "EquilStatsStore.h"
 
 using namespace std;
 using namespace Cantera;
@@ -17,6 +18,11 @@ using namespace Cantera;
 typedef Cabinet<MultiPhase> mixCabinet;
 template<> mixCabinet* mixCabinet::s_storage = 0;
 
+namespace Cantera
+{
+EquilStatsStore mix_equilStats;
+}
+
 extern "C" {
 
     int mix_new()
@@ -33,6 +39,7 @@ extern "C" {
     {
         try {
             mixCabinet::del(i);
+            mix_equilStats.erase(i);
             return 0;
         } catch (...) {
             return handleAllExceptions(-1, ERR);
@@ -309,14 +316,27 @@ extern "C" {
                                    int maxsteps, int maxiter, int loglevel)
     {
         try {
+            EquilStats stats;
+            mix_equilStats.erase(i);
             int retn = vcs_equilibrate(mixCabinet::item(i), XY, estimateEquil, printLvl, solver,
-                                       rtol, maxsteps, maxiter, loglevel);
+                                       rtol, maxsteps, maxiter, loglevel, &stats);
+            mix_equilStats.set(i, stats);
             return (double) retn;
         } catch (...) {
             return handleAllExceptions(ERR, ERR);
         }
     }
 
+    double mix_equilStat(int i, char* name)
+    {
+        try {
+            mixCabinet::item(i);
+            return mix_equilStats.get(i, name);
+        } catch (...) {
+            return handleAllExceptions(DERR, DERR);
+        }
+    }
+
     int mix_getChemPotentials(int i, size_t lenmu, double* mu)
     {
         try {
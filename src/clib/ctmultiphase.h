@@ -39,6 +39,7 @@ extern "C" {
                                             int printLvl, int solver,
                                             double rtol, int maxsteps,
                                             int maxiter, int loglevel);
+    CANTERA_CAPI double mix_equilStat(int i, char* name);
     CANTERA_CAPI int mix_getChemPotentials(int i, size_t lenmu, double* mu);
     CANTERA_CAPI int mix_getValidChemPotentials(int i, double bad_mu,
             int standard, size_t lenmu,
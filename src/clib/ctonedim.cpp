@@ -786,4 +786,41 @@ extern "C" {
             return handleAllExceptions(-1, ERR);
         }
     }
+
+    int sim1D_getStatistic(int i, const char* name, size_t len,
+                           double* values)
+    {
+        try {
+            vector_fp v;
+            SimCabinet::item(i).getStatistic(name, v);
+            if (len < v.size()) {
+                throw ArraySizeError("sim1D_getStatistic", len, v.size());
+            }
+            copy(v.begin(), v.end(), values);
+            return int(v.size());
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    int sim1D_statisticsJSON(int i, int buflen, char* buf)
+    {
+        try {
+            string s = SimCabinet::item(i).statisticsJSON();
+            copyString(s, buf, buflen);
+            return int(s.size());
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    int sim1D_setPropertyTiming(int i, int enable)
+    {
+        try {
+            SimCabinet::item(i).setPropertyTiming(enable != 0);
+            return 0;
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
 }
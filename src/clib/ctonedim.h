@@ -91,6 +91,10 @@ extern "C" {
     CANTERA_CAPI int sim1D_evalSSJacobian(int i);
     CANTERA_CAPI double sim1D_jacobian(int i, int m, int n);
     CANTERA_CAPI size_t sim1D_size(int i);
+    CANTERA_CAPI int sim1D_getStatistic(int i, const char* name, size_t len,
+                                        double* values);
+    CANTERA_CAPI int sim1D_statisticsJSON(int i, int buflen, char* buf);
+    CANTERA_CAPI int sim1D_setPropertyTiming(int i, int enable);
 }
 
 #endif
@@ -8,6 +8,7 @@
 #include "cantera/zeroD/Reactor.h"
 #include "cantera/zeroD/FlowReactor.h"
 #include "cantera/zeroD/ReactorNet.h"
+#include "cantera/zeroD/ReactorEnsemble.h"
 #include "cantera/zeroD/ReactorFactory.h"
 #include "cantera/zeroD/Wall.h"
 #include "cantera/zeroD/flowControllers.h"
@@ -18,6 +19,7 @@ using namespace std;
 
 typedef Cabinet<ReactorBase> ReactorCabinet;
 typedef Cabinet<ReactorNet> NetworkCabinet;
+typedef Cabinet<ReactorEnsemble> EnsembleCabinet;
 typedef Cabinet<FlowDevice> FlowDeviceCabinet;
 typedef Cabinet<Wall> WallCabinet;
 typedef Cabinet<Func1> FuncCabinet;
@@ -26,6 +28,7 @@ typedef Cabinet<Kinetics> KineticsCabinet;
 
 template<> ReactorCabinet* ReactorCabinet::s_storage = 0;
 template<> NetworkCabinet* NetworkCabinet::s_storage = 0;
+template<> EnsembleCabinet* EnsembleCabinet::s_storage = 0;
 template<> FlowDeviceCabinet* FlowDeviceCabinet::s_storage = 0;
 template<> WallCabinet* WallCabinet::s_storage = 0;
 
@@ -364,6 +367,111 @@ extern "C" {
         }
     }
 
+    // reactor ensembles
+
+    int reactorensemble_new()
+    {
+        try {
+            return EnsembleCabinet::add(new ReactorEnsemble());
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    int reactorensemble_del(int i)
+    {
+        try {
+            EnsembleCabinet::del(i);
+            return 0;
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    int reactorensemble_addreactor(int i, int n)
+    {
+        try {
+            EnsembleCabinet::item(i).addReactor(
+                dynamic_cast<Reactor&>(ReactorCabinet::item(n)));
+            return 0;
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    int reactorensemble_setNumThreads(int i, int n)
+    {
+        try {
+            if (n <= 0) {
+                throw CanteraError("reactorensemble_setNumThreads",
+                                   "Number of threads must be positive.");
+            }
+            EnsembleCabinet::item(i).setNumThreads(n);
+            return 0;
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    int reactorensemble_setTolerances(int i, double rtol, double atol)
+    {
+        try {
+            EnsembleCabinet::item(i).setTolerances(rtol, atol);
+            return 0;
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    int reactorensemble_setMaxTimeStep(int i, double maxstep)
+    {
+        try {
+            EnsembleCabinet::item(i).setMaxTimeStep(maxstep);
+            return 0;
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    int reactorensemble_advance(int i, double t)
+    {
+        try {
+            EnsembleCabinet::item(i).advance(t);
+            return 0;
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    double reactorensemble_time(int i)
+    {
+        try {
+            return EnsembleCabinet::item(i).time();
+        } catch (...) {
+            return handleAllExceptions(DERR, DERR);
+        }
+    }
+
+    int reactorensemble_failed(int i, int n)
+    {
+        try {
+            return EnsembleCabinet::item(i).failed(n);
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
+    int reactorensemble_nSteps(int i, int n)
+    {
+        try {
+            std::map<std::string, long int> stats;
+            EnsembleCabinet::item(i).getSolverStats(n, stats);
+            return static_cast<int>(stats["steps"]);
+        } catch (...) {
+            return handleAllExceptions(-1, ERR);
+        }
+    }
+
     // flow devices
 
     int flowdev_new(int type)
@@ -43,6 +43,17 @@ extern "C" {
     CANTERA_CAPI double reactornet_atol(int i);
     CANTERA_CAPI double reactornet_sensitivity(int i, char* v, int p, int r);
 
+    CANTERA_CAPI int reactorensemble_new();
+    CANTERA_CAPI int reactorensemble_del(int i);
+    CANTERA_CAPI int reactorensemble_addreactor(int i, int n);
+    CANTERA_CAPI int reactorensemble_setNumThreads(int i, int n);
+    CANTERA_CAPI int reactorensemble_setTolerances(int i, double rtol, double atol);
+    CANTERA_CAPI int reactorensemble_setMaxTimeStep(int i, double maxstep);
+    CANTERA_CAPI int reactorensemble_advance(int i, double t);
+    CANTERA_CAPI double reactorensemble_time(int i);
+    CANTERA_CAPI int reactorensemble_failed(int i, int n);
+    CANTERA_CAPI int reactorensemble_nSteps(int i, int n);
+
     CANTERA_CAPI int flowdev_new(int type);
     CANTERA_CAPI int flowdev_del(int i);
     CANTERA_CAPI int flowdev_install(int i, int n, int m);
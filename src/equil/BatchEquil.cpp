@@ -0,0 +1,272 @@
+//! @file BatchEquil.cpp
+#include "cantera/equil/BatchEquil.h"
+#include "cantera/base/ct_thread.h"
+#include "cantera/base/stringUtils.h"
+
+#ifdef THREAD_SAFE_CANTERA
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace {
+//! Protects the work lists and error messages of all BatchEquil objects
+mutex_t batch_equil_mutex;
+}
+
+BatchEquil::BatchEquil(const ThermoPhase& thermo) :
+    m_thermo(thermo.duplMyselfAsThermoPhase()),
+    m_nsp(thermo.nSpecies()),
+    m_nthreads(1),
+    m_blockSize(64),
+    m_solver(-1),
+    m_rtol(1.0e-9),
+    m_maxsteps(1000),
+    m_XY(TP),
+    m_npoints(0),
+    m_Y(0),
+    m_prop1(0),
+    m_prop2(0),
+    m_out(0),
+    m_converged(0),
+    m_next(0),
+    m_firstFailed(npos)
+{
+#ifdef THREAD_SAFE_CANTERA
+    m_nthreads = std::max(boost::thread::hardware_concurrency(), 1u);
+#endif
+}
+
+BatchEquil::~BatchEquil()
+{
+    for (size_t i = 0; i < m_workers.size(); i++) {
+        delete m_workers[i].vcs;
+        delete m_workers[i].mix;
+        delete m_workers[i].chemEquil;
+        delete m_workers[i].thermo;
+    }
+    delete m_thermo;
+}
+
+void BatchEquil::setNumThreads(size_t n)
+{
+    if (n == 0) {
+        throw CanteraError("BatchEquil::setNumThreads",
+                           "Number of threads must be positive.");
+    }
+    m_nthreads = n;
+}
+
+void BatchEquil::setBlockSize(size_t n)
+{
+    if (n == 0) {
+        throw CanteraError("BatchEquil::setBlockSize",
+                           "Block size must be positive.");
+    }
+    m_blockSize = n;
+}
+
+void BatchEquil::setSolver(int solver)
+{
+    if (solver != -1 && solver != 0 && solver != 2) {
+        throw CanteraError("BatchEquil::setSolver",
+                           "Unsupported solver: " + int2str(solver));
+    }
+    m_solver = solver;
+}
+
+void BatchEquil::setOptions(double rtol, int maxsteps)
+{
+    m_rtol = rtol;
+    m_maxsteps = maxsteps;
+}
+
+void BatchEquil::initWorker(Worker& w)
+{
+    if (!w.thermo) {
+        w.thermo = m_thermo->duplMyselfAsThermoPhase();
+        w.chemEquil = new ChemEquil(*w.thermo);
+    }
+    w.chemEquil->options.relTolerance = m_rtol;
+    w.chemEquil->options.maxIterations = m_maxsteps;
+    if (m_solver != 0 && !w.vcs) {
+        w.mix = new MultiPhase();
+        w.mix->addPhase(w.thermo, 1.0);
+        w.mix->init();
+        w.vcs = new VCSnonideal::vcs_MultiPhaseEquil(w.mix, 0);
+    }
+}
+
+size_t BatchEquil::equilibrate(const std::string& XY, size_t npoints,
+                               const double* Y, const double* prop1,
+                               const double* prop2, double* out,
+                               int* converged)
+{
+    m_XY = _equilflag(XY.c_str());
+    if (m_XY != TP && m_XY != HP && m_XY != SP && m_XY != UV &&
+        m_XY != SV && m_XY != TV) {
+        throw CanteraError("BatchEquil::equilibrate",
+                           "Unsupported property pair: " + XY);
+    }
+    m_npoints = npoints;
+    m_Y = Y;
+    m_prop1 = prop1;
+    m_prop2 = prop2;
+    m_out = out;
+    m_converged = converged;
+    m_next = 0;
+    m_firstFailed = npos;
+    m_error.clear();
+
+    size_t nblocks = (npoints + m_blockSize - 1) / m_blockSize;
+    size_t nthreads = std::max<size_t>(std::min(m_nthreads, nblocks), 1);
+    Worker empty = {0, 0, 0, 0, false};
+    if (m_workers.size() < nthreads) {
+        m_workers.resize(nthreads, empty);
+    }
+    for (size_t n = 0; n < nthreads; n++) {
+        initWorker(m_workers[n]);
+    }
+
+#ifdef THREAD_SAFE_CANTERA
+    if (nthreads > 1) {
+        boost::thread_group threads;
+        for (size_t n = 0; n < nthreads; n++) {
+            threads.create_thread(boost::bind(&BatchEquil::work, this, n,
+                                              true));
+        }
+        threads.join_all();
+    } else {
+        work(0, false);
+    }
+#else
+    work(0, false);
+#endif
+
+    size_t nfailed = 0;
+    for (size_t i = 0; i < npoints; i++) {
+        if (!converged[i]) {
+            nfailed++;
+        }
+    }
+    return nfailed;
+}
+
+void BatchEquil::work(size_t iworker, bool workerThread)
+{
+    Worker& w = m_workers[iworker];
+    while (true) {
+        size_t start;
+        {
+            ScopedLock lock(batch_equil_mutex);
+            if (m_next >= m_npoints) {
+                break;
+            }
+            start = m_next;
+            m_next += m_blockSize;
+        }
+        size_t end = std::min(start + m_blockSize, m_npoints);
+        // Points in other blocks may be far away, so the first point of
+        // each block is solved from the solver's own initial estimate
+        w.seeded = false;
+        for (size_t i = start; i < end; i++) {
+            w.seeded = solvePoint(w, i);
+            m_converged[i] = w.seeded ? 1 : 0;
+        }
+    }
+    if (workerThread) {
+        // Release the error and log buffers for this thread
+        thread_complete();
+    }
+}
+
+void BatchEquil::setInputState(ThermoPhase& thermo, size_t i)
+{
+    const double* Y = m_Y + i * m_nsp;
+    double a = m_prop1[i];
+    double b = m_prop2[i];
+    if (m_XY == TP) {
+        thermo.setState_TPY(a, b, Y);
+        return;
+    }
+    // The temperature of the previous point is the initial guess for the
+    // frozen state
+    thermo.setMassFractions(Y);
+    switch (m_XY) {
+    case HP:
+        thermo.setState_HP(a, b);
+        break;
+    case SP:
+        thermo.setState_SP(a, b);
+        break;
+    case UV:
+        thermo.setState_UV(a, b);
+        break;
+    case SV:
+        thermo.setState_SV(a, b);
+        break;
+    case TV:
+        thermo.setState_TR(a, 1.0 / b);
+        break;
+    }
+}
+
+bool BatchEquil::solvePoint(Worker& w, size_t i)
+{
+    ThermoPhase& s = *w.thermo;
+    const char* XY = (m_XY == TP) ? "TP" : (m_XY == HP) ? "HP" :
+                     (m_XY == SP) ? "SP" : (m_XY == UV) ? "UV" :
+                     (m_XY == SV) ? "SV" : "TV";
+    string err;
+    bool ok = false;
+
+    if (m_solver <= 0) {
+        // Start from the solution of the previous point, if available. The
+        // solver falls back on its own estimate if this fails.
+        w.chemEquil->options.contin = w.seeded;
+        try {
+            setInputState(s, i);
+            ok = (w.chemEquil->equilibrate(s, XY) >= 0);
+            if (!ok) {
+                err = "ChemEquil equilibrium solver failed";
+            }
+        } catch (CanteraError& e) {
+            err = e.getMessage();
+        }
+    }
+
+    if (!ok && m_solver != 0) {
+        try {
+            setInputState(s, i);
+            w.mix->setPhaseMoles(0, 1.0);
+            w.mix->uploadMoleFractionsFromPhases();
+            w.mix->setState_TP(s.temperature(), s.pressure());
+            ok = (w.vcs->equilibrate(m_XY, 0, 0, m_rtol, m_maxsteps) == 0);
+            if (!ok) {
+                err = "VCS equilibrium solver failed";
+            }
+        } catch (CanteraError& e) {
+            err = e.getMessage();
+        }
+    }
+
+    if (ok) {
+        double* row = m_out + i * (m_nsp + 2);
+        row[0] = s.temperature();
+        row[1] = s.pressure();
+        s.getMassFractions(row + 2);
+    } else {
+        ScopedLock lock(batch_equil_mutex);
+        if (i < m_firstFailed) {
+            m_firstFailed = i;
+            m_error = err;
+        }
+    }
+    return ok;
+}
+
+}
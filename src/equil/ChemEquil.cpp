@@ -10,7 +10,9 @@
 
 #include "PropertyCalculator.h"
 #include "cantera/base/stringUtils.h"
+#include "cantera/base/clockWC.h"
 #include "cantera/equil/MultiPhaseEquil.h"
+#include "cantera/thermo/mix_defs.h"
 
 using namespace std;
 
@@ -44,10 +46,17 @@ int _equilflag(const char* xy)
     return -1;
 }
 
-ChemEquil::ChemEquil() : m_skip(npos), m_elementTotalSum(1.0),
+ChemEquil::ChemEquil() : m_phase(0), m_skip(npos), m_elementTotalSum(1.0),
     m_p0(OneAtm), m_eloc(npos),
     m_elemFracCutoff(1.0E-100),
-    m_doResPerturb(false)
+    m_doResPerturb(false),
+    m_haveLast(false),
+    m_haveInitial(false),
+    m_cacheSize(0),
+    m_cacheNext(0),
+    m_cacheTol(0.05),
+    m_cacheHits(0),
+    m_warmFailures(0)
 {}
 
 ChemEquil::ChemEquil(thermo_t& s) :
@@ -55,7 +64,14 @@ ChemEquil::ChemEquil(thermo_t& s) :
     m_elementTotalSum(1.0),
     m_p0(OneAtm), m_eloc(npos),
     m_elemFracCutoff(1.0E-100),
-    m_doResPerturb(false)
+    m_doResPerturb(false),
+    m_haveLast(false),
+    m_haveInitial(false),
+    m_cacheSize(0),
+    m_cacheNext(0),
+    m_cacheTol(0.05),
+    m_cacheHits(0),
+    m_warmFailures(0)
 {
     initialize(s);
 }
@@ -64,6 +80,72 @@ ChemEquil::~ChemEquil()
 {
 }
 
+void ChemEquil::setInitialEstimate(const vector_fp& lambda_RT, doublereal T)
+{
+    if (m_phase && lambda_RT.size() < m_mm) {
+        throw CanteraError("ChemEquil::setInitialEstimate",
+                           "Expected " + int2str(m_mm) + " element potentials"
+                           ", got " + int2str(lambda_RT.size()) + ".");
+    }
+    if (T <= 0.0) {
+        throw CanteraError("ChemEquil::setInitialEstimate",
+                           "Temperature must be positive.");
+    }
+    m_initial.lambda_RT = lambda_RT;
+    m_initial.T = T;
+    // The component basis is determined again from the estimate
+    m_initial.nComponents = npos;
+    m_initial.orderVectorElements.clear();
+    m_haveInitial = true;
+}
+
+void ChemEquil::setCacheSize(size_t n)
+{
+    m_cacheSize = n;
+    clearCache();
+}
+
+void ChemEquil::clearCache()
+{
+    m_cache.clear();
+    m_cacheNext = 0;
+}
+
+size_t ChemEquil::findCached(const vector_fp& elMolesGoal, doublereal xval,
+                             doublereal yval) const
+{
+    string XY = m_p1->symbol() + m_p2->symbol();
+    size_t best = npos;
+    doublereal dmin = m_cacheTol;
+    for (size_t i = 0; i < m_cache.size(); i++) {
+        const CacheEntry& c = m_cache[i];
+        if (c.XY != XY) {
+            continue;
+        }
+        doublereal d = 0.0;
+        for (size_t m = 0; m < m_mm; m++) {
+            d = std::max(d, fabs(elMolesGoal[m] - c.elMolesGoal[m]));
+        }
+        // Scale the differences so that they are comparable to relative
+        // differences in temperature
+        doublereal dx = fabs(xval - c.xval);
+        if (XY[0] == 'T') {
+            dx /= c.est.T;
+        } else if (XY[0] == 'S') {
+            dx /= c.cp;
+        } else {
+            dx /= c.cp * c.est.T;
+        }
+        d = std::max(d, dx);
+        d = std::max(d, fabs(yval - c.yval) / fabs(c.yval));
+        if (d <= dmin) {
+            dmin = d;
+            best = i;
+        }
+    }
+    return best;
+}
+
 void ChemEquil::initialize(thermo_t& s)
 {
     // store a pointer to s and some of its properties locally.
@@ -156,6 +238,7 @@ void ChemEquil::setToEquilState(thermo_t& s,
     // equilibrium state with the specified species chemical
     // potentials.
     s.setToEquilState(DATA_PTR(m_mu_RT));
+    m_stats.thermoEvals++;
     update(s);
 }
 
@@ -256,9 +339,12 @@ int ChemEquil::estimateElementPotentials(thermo_t& s, vector_fp& lambda_RT,
     mp.init();
     int usedZeroedSpecies = 0;
     vector_fp formRxnMatrix;
+    clockWC timer;
     m_nComponents = BasisOptimize(&usedZeroedSpecies, false,
                                   &mp, m_orderVectorSpecies,
                                   m_orderVectorElements, formRxnMatrix);
+    m_stats.timeBasisOpt += timer.secondsWC();
+    m_stats.basisOpts++;
 
     for (size_t m = 0; m < m_nComponents; m++) {
         size_t k = m_orderVectorSpecies[m];
@@ -351,7 +437,9 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
                            int loglevel)
 {
     doublereal xval, yval, tmp;
-    int fail = 0;
+    clockWC timer;
+    m_stats.clear();
+    m_stats.calls = 1;
 
     bool tempFixed = true;
     int XY = _equilflag(XYstr);
@@ -427,11 +515,8 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
     xval = m_p1->value(s);
     yval = m_p2->value(s);
 
-    size_t mm = m_mm;
-    size_t nvar = mm + 1;
-    DenseMatrix jac(nvar, nvar);       // jacobian
+    size_t nvar = m_mm + 1;
     vector_fp x(nvar, -102.0);         // solution vector
-    vector_fp res_trial(nvar, 0.0);    // residual
 
     /*
      * Replace one of the element abundance fraction equations
@@ -454,6 +539,53 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
                            "Element Abundance Vector is zeroed");
     }
 
+    /*
+     * If a previous solution is available, start the Newton iteration
+     * from it. This skips the estimates of the temperature, the
+     * composition and the element potentials below, which account for
+     * most of the cost of problems near the previous solution.
+     */
+    Estimate* warm = 0;
+    if (m_haveInitial) {
+        warm = &m_initial;
+    } else if (options.contin && m_haveLast) {
+        warm = &m_last;
+    } else if (!m_cache.empty()) {
+        size_t i = findCached(elMolesGoal, xval, yval);
+        if (i != npos) {
+            warm = &m_cache[i].est;
+            m_cacheHits++;
+        }
+    }
+    m_haveInitial = false;
+    if (warm && warm->lambda_RT.size() >= m_mm) {
+        size_t nComponents = m_nComponents;
+        std::vector<size_t> orderVectorElements = m_orderVectorElements;
+        if (warm->nComponents != npos) {
+            m_nComponents = warm->nComponents;
+            m_orderVectorElements = warm->orderVectorElements;
+        }
+        copy(warm->lambda_RT.begin(), warm->lambda_RT.begin() + m_mm,
+             x.begin());
+        if (!tempFixed) {
+            s.setTemperature(warm->T);
+        }
+        try {
+            solveNewton(s, x, elMolesGoal, xval, yval, state);
+            // Solutions started from the cache are not added to it
+            storeSolution(s, x, elMolesGoal, xval, yval,
+                          warm == &m_last || warm == &m_initial);
+            m_stats.time = timer.secondsWC();
+            return 0;
+        } catch (CanteraError&) {
+            // solveNewton has restored the initial state
+            m_warmFailures++;
+            m_nComponents = nComponents;
+            m_orderVectorElements = orderVectorElements;
+            fill(x.begin(), x.end(), -102.0);
+        }
+    }
+
     // start with a composition with everything non-zero. Note
     // that since we have already save the target element moles,
     // changing the composition at this point only affects the
@@ -596,6 +728,51 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
         setToEquilState(s, x, s.temperature());
     }
 
+    solveNewton(s, x, elMolesGoal, xval, yval, state);
+    storeSolution(s, x, elMolesGoal, xval, yval, true);
+    m_stats.time = timer.secondsWC();
+    return 0;
+}
+
+void ChemEquil::storeSolution(thermo_t& s, const vector_fp& x,
+                              const vector_fp& elMolesGoal, doublereal xval,
+                              doublereal yval, bool addToCache)
+{
+    m_last.lambda_RT.assign(x.begin(), x.begin() + m_mm);
+    m_last.T = s.temperature();
+    m_last.nComponents = m_nComponents;
+    m_last.orderVectorElements = m_orderVectorElements;
+    m_haveLast = true;
+    if (!addToCache || m_cacheSize == 0) {
+        return;
+    }
+    CacheEntry c;
+    c.est = m_last;
+    c.XY = m_p1->symbol() + m_p2->symbol();
+    c.elMolesGoal.assign(elMolesGoal.begin(), elMolesGoal.begin() + m_mm);
+    c.xval = xval;
+    c.yval = yval;
+    c.cp = s.cp_mass();
+    if (m_cache.size() < m_cacheSize) {
+        m_cache.push_back(c);
+    } else {
+        m_cache[m_cacheNext] = c;
+    }
+    m_cacheNext = (m_cacheNext + 1) % m_cacheSize;
+}
+
+int ChemEquil::solveNewton(thermo_t& s, vector_fp& x, vector_fp& elMolesGoal,
+                           doublereal xval, doublereal yval,
+                           const vector_fp& state)
+{
+    clockWC timer;
+    size_t m;
+    size_t mm = m_mm;
+    size_t nvar = mm + 1;
+    DenseMatrix jac(nvar, nvar);       // jacobian
+    vector_fp res_trial(nvar, 0.0);    // residual
+    int fail = 0;
+
     /*
      * Install the log(temp) into the last solution unknown
      * slot.
@@ -691,8 +868,10 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
                          "valid range of "+fp2str(s.minTemp())+" K to "
                          +fp2str(s.maxTemp())+" K\n");
             }
+            m_stats.timeInnerLoop += timer.secondsWC();
             return 0;
         }
+        m_stats.iterations++;
         // compute the residual and the jacobian using the current
         // solution vector
         equilResidual(s, x, elMolesGoal, res_trial, xval, yval);
@@ -732,14 +911,19 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
         scale(res_trial.begin(), res_trial.end(), res_trial.begin(), -1.0);
 
         /*
-         * Solve the system
+         * Solve the system. A singular Jacobian is reported either by an
+         * exception or by the return value, depending on the settings of
+         * the matrix.
          */
+        int info = 0;
         try {
             info = solve(jac, DATA_PTR(res_trial));
         } catch (CanteraError& err) {
             err.save();
+            info = -1;
+        }
+        if (info != 0) {
             s.restoreState(state);
-
             throw CanteraError("equilibrate",
                                "Jacobian is singular. \nTry adding more species, "
                                "changing the elemental composition slightly, \nor removing "
@@ -783,6 +967,7 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
             fail++;
             if (fail > 3) {
                 s.restoreState(state);
+                m_stats.timeInnerLoop += timer.secondsWC();
                 throw CanteraError("equilibrate",
                                    "Cannot find an acceptable Newton damping coefficient.");
             }
@@ -793,6 +978,7 @@ int ChemEquil::equilibrate(thermo_t& s, const char* XYstr,
 
     // no convergence
     s.restoreState(state);
+    m_stats.timeInnerLoop += timer.secondsWC();
     throw CanteraError("equilibrate",
                        "no convergence in "+int2str(options.maxIterations)
                        +" iterations.");
@@ -897,6 +1083,114 @@ void ChemEquil::equilResidual(thermo_t& s, const vector_fp& x,
 void ChemEquil::equilJacobian(thermo_t& s, vector_fp& x,
                               const vector_fp& elmols, DenseMatrix& jac,
                               doublereal xval, doublereal yval, int loglevel)
+{
+    if (s.eosType() != cIdealGas) {
+        numericalJacobian(s, x, elmols, jac, xval, yval, loglevel);
+        return;
+    }
+
+    /*
+     * For an ideal gas, the partial pressures set by setToEquilState() are
+     *     p_k = p0 exp(sum_m a_km x_m - g0_k(T)/RT),
+     * so that d ln(p_k) / d x_m = a_km and d ln(p_k) / d ln(T) = h0_k/RT.
+     * The derivatives of the element fractions and of the mass-specific
+     * properties follow from these, weighting each species by its mole
+     * fraction.
+     */
+    size_t nvar = m_mm + 1;
+    doublereal T = exp(x[m_mm]);
+    setToEquilState(s, x, T);
+    doublereal RT = GasConstant * T;
+
+    vector_fp h_RT(m_kk), cp_R(m_kk), sbar(m_kk), dlnp(m_kk), dE(m_mm);
+    s.getEnthalpy_RT(DATA_PTR(h_RT));
+    s.getCp_R(DATA_PTR(cp_R));
+    s.getPartialMolarEntropies(DATA_PTR(sbar));
+    const vector_fp& mw = s.molecularWeights();
+    doublereal Wbar = s.meanMolecularWeight();
+    const vector_fp& X = m_molefractions;
+    const vector_fp& elmFrac = m_elementmolefracs;
+
+    for (size_t n = 0; n < nvar; n++) {
+        bool dlnT = (n == m_mm);
+        // Sums over species of X_k times the derivatives of ln(p_k) and of
+        // ln(p_k) times the species properties
+        doublereal sX = 0.0, sXW = 0.0, sH = 0.0, sU = 0.0, sS = 0.0;
+        fill(dE.begin(), dE.end(), 0.0);
+        for (size_t k = 0; k < m_kk; k++) {
+            if (X[k] <= 0.0) {
+                continue;
+            }
+            doublereal d = dlnT ? h_RT[k] : nAtoms(k,n);
+            doublereal Xd = X[k] * d;
+            sX += Xd;
+            sXW += Xd * mw[k];
+            sH += Xd * h_RT[k];
+            sU += Xd * (h_RT[k] - 1.0);
+            sS += Xd * sbar[k] / GasConstant;
+            if (dlnT) {
+                sH += X[k] * cp_R[k];
+                sU += X[k] * (cp_R[k] - 1.0);
+                sS += X[k] * (cp_R[k] - h_RT[k]);
+            } else {
+                sS -= X[k] * nAtoms(k,n);
+            }
+            for (size_t m = 0; m < m_mm; m++) {
+                dE[m] += nAtoms(k,m) * Xd;
+            }
+        }
+
+        // element abundance residuals
+        doublereal dSum = 0.0;
+        for (size_t m = 0; m < m_mm; m++) {
+            dSum += dE[m];
+        }
+        for (size_t i = 0; i < m_mm; i++) {
+            size_t m = m_orderVectorElements[i];
+            doublereal dFrac = (dE[m] - elmFrac[m] * dSum) / m_elementTotalSum;
+            if ((elmols[m] < m_elemFracCutoff && m != m_eloc) ||
+                    i >= m_nComponents) {
+                jac(m, n) = (m == n) ? 1.0 : 0.0;
+            } else if (elmols[m] < 1.0E-10 || elmFrac[m] < 1.0E-10 ||
+                       m == m_eloc) {
+                jac(m, n) = -dFrac;
+            } else {
+                jac(m, n) = -dFrac / (1.0 + elmFrac[m]);
+            }
+        }
+
+        // property residuals
+        for (int j = 0; j < 2; j++) {
+            PropertyCalculator<thermo_t>& p = (j == 0) ? *m_p1 : *m_p2;
+            doublereal value = p.value(s);
+            doublereal dvalue = 0.0;
+            string sym = p.symbol();
+            if (sym == "T") {
+                dvalue = dlnT ? T : 0.0;
+            } else if (sym == "P") {
+                dvalue = value * sX;
+            } else if (sym == "V") {
+                dvalue = value * (sXW / Wbar - (dlnT ? 1.0 : 0.0));
+            } else if (sym == "H") {
+                dvalue = (RT * sH - value * sXW) / Wbar;
+            } else if (sym == "U") {
+                dvalue = (RT * sU - value * sXW) / Wbar;
+            } else if (sym == "S") {
+                dvalue = (GasConstant * sS - value * sXW) / Wbar;
+            }
+            if (j == 0) {
+                jac(m_mm, n) = dvalue / xval;
+            } else {
+                jac(m_skip, n) = dvalue / yval;
+            }
+        }
+    }
+}
+
+void ChemEquil::numericalJacobian(thermo_t& s, vector_fp& x,
+                                  const vector_fp& elmols, DenseMatrix& jac,
+                                  doublereal xval, doublereal yval,
+                                  int loglevel)
 {
     vector_fp& r0 = m_jwork1;
     vector_fp& r1 = m_jwork2;
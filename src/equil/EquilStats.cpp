@@ -0,0 +1,77 @@
+//! @file EquilStats.cpp
+#include "cantera/equil/EquilStats.h"
+#include "cantera/base/ctexceptions.h"
+
+using namespace std;
+
+namespace Cantera
+{
+
+void EquilStats::clear()
+{
+    calls = 0;
+    time = 0.0;
+    timeBasisOpt = 0.0;
+    timeInnerLoop = 0.0;
+    timePhaseStability = 0.0;
+    timeDeltaG = 0.0;
+    iterations = 0;
+    outerIterations = 0;
+    basisOpts = 0;
+    phaseStabilityTests = 0;
+    speciesDeleted = 0;
+    speciesReinserted = 0;
+    thermoEvals = 0;
+    thermoStateUpdates = 0;
+}
+
+EquilStats& EquilStats::operator+=(const EquilStats& other)
+{
+    calls += other.calls;
+    time += other.time;
+    timeBasisOpt += other.timeBasisOpt;
+    timeInnerLoop += other.timeInnerLoop;
+    timePhaseStability += other.timePhaseStability;
+    timeDeltaG += other.timeDeltaG;
+    iterations += other.iterations;
+    outerIterations += other.outerIterations;
+    basisOpts += other.basisOpts;
+    phaseStabilityTests += other.phaseStabilityTests;
+    speciesDeleted += other.speciesDeleted;
+    speciesReinserted += other.speciesReinserted;
+    thermoEvals += other.thermoEvals;
+    thermoStateUpdates += other.thermoStateUpdates;
+    return *this;
+}
+
+void EquilStats::getStats(std::map<std::string, double>& stats) const
+{
+    stats["calls"] = double(calls);
+    stats["time"] = time;
+    stats["time_basis_opt"] = timeBasisOpt;
+    stats["time_inner_loop"] = timeInnerLoop;
+    stats["time_phase_stability"] = timePhaseStability;
+    stats["time_deltag"] = timeDeltaG;
+    stats["iterations"] = double(iterations);
+    stats["outer_iterations"] = double(outerIterations);
+    stats["basis_opts"] = double(basisOpts);
+    stats["phase_stability_tests"] = double(phaseStabilityTests);
+    stats["species_deleted"] = double(speciesDeleted);
+    stats["species_reinserted"] = double(speciesReinserted);
+    stats["thermo_evals"] = double(thermoEvals);
+    stats["thermo_state_updates"] = double(thermoStateUpdates);
+}
+
+double EquilStats::get(const std::string& name) const
+{
+    map<string, double> stats;
+    getStats(stats);
+    map<string, double>::const_iterator iter = stats.find(name);
+    if (iter == stats.end()) {
+        throw CanteraError("EquilStats::get",
+                           "Unknown statistic: '" + name + "'");
+    }
+    return iter->second;
+}
+
+}
@@ -30,7 +30,8 @@ doublereal equilibrate(MultiPhase& s, const char* XY,
 }
 
 int equilibrate(thermo_t& s, const char* XY, int solver,
-                doublereal rtol, int maxsteps, int maxiter, int loglevel)
+                doublereal rtol, int maxsteps, int maxiter, int loglevel,
+                EquilStats* stats)
 {
     bool redo = true;
     int retn = -1;
@@ -47,7 +48,7 @@ int equilibrate(thermo_t& s, const char* XY, int solver,
                 m.init();
                 nAttempts++;
                 vcs_equilibrate(m, XY, estimateEquil, printLvlSub, solver,
-                                rtol, maxsteps, maxiter, loglevel-1);
+                                rtol, maxsteps, maxiter, loglevel-1, stats);
                 redo = false;
                 retn = nAttempts;
             } catch (CanteraError& err) {
@@ -87,6 +88,9 @@ int equilibrate(thermo_t& s, const char* XY, int solver,
                 bool useThermoPhaseElementPotentials = true;
                 retnSub = e.equilibrate(s, XY, useThermoPhaseElementPotentials,
                                         loglevel-1);
+                if (stats) {
+                    *stats += e.stats();
+                }
                 if (retnSub < 0) {
                     if (nAttempts < 2) {
                         solver = 1;
@@ -28,14 +28,22 @@ namespace VCSnonideal
 vcs_MultiPhaseEquil::vcs_MultiPhaseEquil() :
     m_vprob(0, 0, 0),
     m_mix(0),
-    m_printLvl(0)
+    m_printLvl(0),
+    m_iter(0),
+    m_warmStart(true),
+    m_solverReady(false),
+    m_nFullSetups(0)
 {
 }
 
 vcs_MultiPhaseEquil::vcs_MultiPhaseEquil(Cantera::MultiPhase* mix, int printLvl) :
     m_vprob(mix->nSpecies(), mix->nElements(), mix->nPhases()),
     m_mix(0),
-    m_printLvl(printLvl)
+    m_printLvl(printLvl),
+    m_iter(0),
+    m_warmStart(true),
+    m_solverReady(false),
+    m_nFullSetups(0)
 {
     m_mix = mix;
     m_vprob.m_printLvl = m_printLvl;
@@ -160,13 +168,33 @@ int vcs_MultiPhaseEquil::equilibrate_HP(doublereal Htarget,
                                         int printLvl, doublereal err,
                                         int maxsteps, int loglevel)
 {
-    int maxiter = 100;
-    int iSuccess;
     if (XY != HP && XY != UP) {
         throw CanteraError("vcs_MultiPhaseEquil::equilibrate_HP",
                            "Wrong XP" + int2str(XY));
     }
+    return equilibrate_XP(Htarget, XY, Tlow, Thigh, estimateEquil,
+                          printLvl, err, maxsteps, loglevel);
+}
+
+int vcs_MultiPhaseEquil::equilibrate_SP(doublereal Starget,
+                                        double Tlow, double Thigh,
+                                        int estimateEquil,
+                                        int printLvl, doublereal err,
+                                        int maxsteps, int loglevel)
+{
+    return equilibrate_XP(Starget, SP, Tlow, Thigh, estimateEquil,
+                          printLvl, err, maxsteps, loglevel);
+}
+
+int vcs_MultiPhaseEquil::equilibrate_XP(doublereal xtarget, int XY,
+                                        double Tlow, double Thigh,
+                                        int estimateEquil,
+                                        int printLvl, doublereal err,
+                                        int maxsteps, int loglevel)
+{
+    int maxiter = 100;
     int strt = estimateEquil;
+    const char* name = (XY == SP) ? "S" : ((XY == UP) ? "U" : "H");
 
     // Lower bound on T. This will change as we progress in the calculation
     if (Tlow <= 0.0) {
@@ -177,85 +205,88 @@ int vcs_MultiPhaseEquil::equilibrate_HP(doublereal Htarget,
         Thigh = 2.0 * m_mix->maxTemp();
     }
 
-    doublereal cpb = 1.0, Tnew;
-    doublereal Hlow = Undef;
-    doublereal Hhigh = Undef;
     doublereal Tnow = m_mix->temperature();
+    Tlow = std::min(Tnow, Tlow);
+    Thigh = std::max(Tnow, Thigh);
+    doublereal Xlow = 0.0;
+    doublereal Xhigh = 0.0;
+    bool haveLow = false;
+    bool haveHigh = false;
     int printLvlSub = std::max(printLvl - 1, 0);
 
     for (int n = 0; n < maxiter; n++) {
-        // start with a loose error tolerance, but tighten it as we get
-        // close to the final temperature
+        doublereal Tnew;
         try {
             Tnow = m_mix->temperature();
-            iSuccess = equilibrate_TP(strt, printLvlSub, err, maxsteps, loglevel);
+            int iSuccess = equilibrate_TP(strt, printLvlSub, err, maxsteps, loglevel);
             strt = 0;
-            double Hnow = (XY == UP) ? m_mix->IntEnergy() : m_mix->enthalpy();
-            double pmoles[10];
-            pmoles[0] = m_mix->phaseMoles(0);
-            double Tmoles = pmoles[0];
-            double HperMole = Hnow/Tmoles;
-            if (printLvl > 0) {
-                plogf("T = %g, Hnow = %g ,Tmoles = %g,  HperMole = %g",
-                      Tnow, Hnow, Tmoles, HperMole);
-                plogendl();
-            }
-
-            // the equilibrium enthalpy monotonically increases with T;
-            // if the current value is below the target, then we know the
-            // current temperature is too low. Set the lower bounds.
-
-
-            if (Hnow < Htarget) {
-                if (Tnow > Tlow) {
+            double Xnow = mixtureProperty(XY);
+
+            // The equilibrium enthalpy, internal energy and entropy increase
+            // monotonically with T, so the current temperature is a lower
+            // bound if the current value is below the target, and an upper
+            // bound otherwise.
+            if (Xnow < xtarget) {
+                if (Tnow >= Tlow) {
                     Tlow = Tnow;
-                    Hlow = Hnow;
-                }
-            }
-            // the current enthalpy is greater than the target; therefore the
-            // current temperature is too high. Set the high bounds.
-            else {
-                if (Tnow < Thigh) {
-                    Thigh = Tnow;
-                    Hhigh = Hnow;
+                    Xlow = Xnow;
+                    haveLow = true;
                 }
+            } else if (Tnow <= Thigh) {
+                Thigh = Tnow;
+                Xhigh = Xnow;
+                haveHigh = true;
             }
-            double dT, dTa, dTmax, Tnew;
-            if (Hlow != Undef && Hhigh != Undef) {
-                cpb = (Hhigh - Hlow)/(Thigh - Tlow);
-                dT = (Htarget - Hnow)/cpb;
-                dTa = fabs(dT);
-                dTmax = 0.5*fabs(Thigh - Tlow);
-                if (dTa > dTmax) {
-                    dT *= dTmax/dTa;
-                }
-            } else {
-                Tnew = sqrt(Tlow*Thigh);
-                dT = clip(Tnew - Tnow, -200.0, 200.0);
+
+            // Newton step, using the derivative of the equilibrium value
+            // rather than the frozen heat capacity, so that the iteration
+            // converges quadratically even when the composition changes
+            // strongly with temperature.
+            double dXdT = equilibriumDerivative(XY);
+            double Xerr = xtarget - Xnow;
+
+            // If the solution is at a phase transition, where the
+            // equilibrium value is discontinuous, the slope across the
+            // bracketing interval grows without bound as the interval
+            // shrinks, and the error is measured relative to this slope.
+            double slope = std::max(fabs(dXdT), 1.0E-6);
+            if (haveLow && haveHigh && Thigh > Tlow) {
+                slope = std::max(slope, (Xhigh - Xlow) / (Thigh - Tlow));
             }
-            double acpb = std::max(fabs(cpb), 1.0E-6);
-            double denom = std::max(fabs(Htarget), acpb);
-            double Herr = Htarget - Hnow;
-            double HConvErr = fabs((Herr)/denom);
+            double denom = std::max(fabs(xtarget), slope);
+            double XConvErr = fabs(Xerr / denom);
             if (printLvl > 0) {
-                plogf("   equilibrate_HP: It = %d, Tcurr  = %g Hcurr = %g, Htarget = %g\n",
-                      n, Tnow, Hnow, Htarget);
-                plogf("                   H rel error = %g, cp = %g, HConvErr = %g\n",
-                      Herr, cpb, HConvErr);
+                plogf("   equilibrate_%sP: It = %d, Tcurr  = %g %scurr = %g, %starget = %g\n",
+                      name, n, Tnow, name, Xnow, name, xtarget);
+                plogf("                   %s error = %g, d%s/dT = %g, %sConvErr = %g\n",
+                      name, Xerr, name, dXdT, name, XConvErr);
             }
-
-            if (HConvErr < err) { // || dTa < 1.0e-4) {
+            if (XConvErr < err) {
                 if (printLvl > 0) {
-                    plogf("   equilibrate_HP: CONVERGENCE: Hfinal  = %g Tfinal = %g, Its = %d \n",
-                          Hnow, Tnow, n);
-                    plogf("                   H rel error = %g, cp = %g, HConvErr = %g\n",
-                          Herr, cpb, HConvErr);
+                    plogf("   equilibrate_%sP: CONVERGENCE: %sfinal  = %g Tfinal = %g, Its = %d \n",
+                          name, name, Xnow, Tnow, n);
                 }
-                goto done;
+                return iSuccess;
             }
-            Tnew = Tnow + dT;
-            if (Tnew < 0.0) {
-                Tnew = 0.5*Tnow;
+
+            // Keep the new temperature inside the interval known to contain
+            // the solution. If the Newton step leaves it, or points the
+            // wrong way, go halfway to the bound instead.
+            if (dXdT > 0.0) {
+                Tnew = Tnow + Xerr / dXdT;
+            } else {
+                Tnew = (Xerr > 0.0) ? Thigh : Tlow;
+            }
+            if (Tnew >= Thigh) {
+                Tnew = 0.5 * (Tnow + Thigh);
+                if (haveLow && haveHigh) {
+                    Tnew = 0.5 * (Tlow + Thigh);
+                }
+            } else if (Tnew <= Tlow) {
+                Tnew = 0.5 * (Tnow + Tlow);
+                if (haveLow && haveHigh) {
+                    Tnew = 0.5 * (Tlow + Thigh);
+                }
             }
             m_mix->setTemperature(Tnew);
 
@@ -270,143 +301,179 @@ int vcs_MultiPhaseEquil::equilibrate_HP(doublereal Htarget,
                 m_mix->setTemperature(Tnew);
             }
         }
-
     }
-    throw CanteraError("MultiPhase::equilibrate_HP",
+    throw CanteraError("vcs_MultiPhaseEquil::equilibrate_" + string(name) + "P",
                        "No convergence for T");
-done:
-    ;
-    return iSuccess;
 }
 
-int vcs_MultiPhaseEquil::equilibrate_SP(doublereal Starget,
-                                        double Tlow, double Thigh,
-                                        int estimateEquil,
-                                        int printLvl, doublereal err,
-                                        int maxsteps, int loglevel)
+double vcs_MultiPhaseEquil::mixtureProperty(int XY) const
 {
-    int maxiter = 100;
-    int strt = estimateEquil;
-
-    // Lower bound on T. This will change as we progress in the calculation
-    if (Tlow <= 0.0) {
-        Tlow = 0.5 * m_mix->minTemp();
-    }
-    // Upper bound on T. This will change as we progress in the calculation
-    if (Thigh <= 0.0 || Thigh > 1.0E6) {
-        Thigh = 2.0 * m_mix->maxTemp();
+    if (XY == SP) {
+        return m_mix->entropy();
+    } else if (XY == UP) {
+        return m_mix->IntEnergy();
+    } else {
+        return m_mix->enthalpy();
     }
+}
 
-    doublereal cpb = 1.0, dT, dTa, dTmax, Tnew;
-    doublereal Slow = Undef;
-    doublereal Shigh = Undef;
-    doublereal Tnow = m_mix->temperature();
-    Tlow = std::min(Tnow, Tlow);
-    Thigh = std::max(Tnow, Thigh);
-    int printLvlSub = std::max(printLvl - 1, 0);
-
-    for (int n = 0; n < maxiter; n++) {
+double vcs_MultiPhaseEquil::equilibriumDerivative(int XY)
+{
+    MultiPhase& mix = *m_mix;
+    size_t nsp = mix.nSpecies();
+    double T = mix.temperature();
+
+    // Derivative at fixed composition
+    double dT = 1.0E-6 * T;
+    double X0 = mixtureProperty(XY);
+    mix.setTemperature(T + dT);
+    double dXdT = (mixtureProperty(XY) - X0) / dT;
+    mix.setTemperature(T);
+    if (m_vsolve.m_numSpeciesTot != nsp) {
+        return dXdT;
+    }
 
-        // start with a loose error tolerance, but tighten it as we get
-        // close to the final temperature
-        try {
-            Tnow = m_mix->temperature();
-            int iSuccess = equilibrate_TP(strt, printLvlSub, err, maxsteps, loglevel);
-            strt = 0;
-            double Snow = m_mix->entropy();
-            double pmoles[10];
-            pmoles[0] = m_mix->phaseMoles(0);
-            double Tmoles = pmoles[0];
-            double SperMole = Snow/Tmoles;
-            plogf("T = %g, Snow = %g ,Tmoles = %g,  SperMole = %g\n",
-                  Tnow, Snow, Tmoles, SperMole);
-
-            // the equilibrium entropy monotonically increases with T;
-            // if the current value is below the target, then we know the
-            // current temperature is too low. Set the lower bounds to the
-            // current condition.
-            if (Snow < Starget) {
-                if (Tnow > Tlow) {
-                    Tlow = Tnow;
-                    Slow = Snow;
-                } else {
-                    if (Slow > Starget) {
-                        if (Snow < Slow) {
-                            Thigh = Tlow;
-                            Shigh = Slow;
-                            Tlow = Tnow;
-                            Slow = Snow;
-                        }
-                    }
-                }
-            }
-            // the current enthalpy is greater than the target; therefore the
-            // current temperature is too high. Set the high bounds.
-            else {
-                if (Tnow < Thigh) {
-                    Thigh = Tnow;
-                    Shigh = Snow;
-                }
-            }
-            if (Slow != Undef && Shigh != Undef) {
-                cpb = (Shigh - Slow)/(Thigh - Tlow);
-                dT = (Starget - Snow)/cpb;
-                Tnew = Tnow + dT;
-                dTa = fabs(dT);
-                dTmax = 0.5*fabs(Thigh - Tlow);
-                if (Tnew > Thigh || Tnew < Tlow) {
-                    dTmax = 1.5*fabs(Thigh - Tlow);
-                }
-                dTmax = std::min(dTmax, 300.);
-                if (dTa > dTmax) {
-                    dT *= dTmax/dTa;
-                }
-            } else {
-                Tnew = sqrt(Tlow*Thigh);
-                dT = Tnew - Tnow;
+    // Partial molar entropies and partial molar values of X, and the moles
+    // of each species
+    vector_fp sbar(nsp), xbar(nsp), vbar(nsp), moles(nsp);
+    for (size_t p = 0; p < mix.nPhases(); p++) {
+        ThermoPhase& tp = mix.phase(p);
+        size_t k0 = mix.speciesIndex(0, p);
+        tp.getPartialMolarEntropies(&sbar[k0]);
+        if (XY == SP) {
+            tp.getPartialMolarEntropies(&xbar[k0]);
+        } else {
+            tp.getPartialMolarEnthalpies(&xbar[k0]);
+            if (XY == UP) {
+                tp.getPartialMolarVolumes(&vbar[k0]);
             }
+        }
+    }
+    double ntot = 0.0;
+    for (size_t k = 0; k < nsp; k++) {
+        moles[k] = mix.speciesMoles(k);
+        ntot += moles[k];
+        if (XY == UP) {
+            xbar[k] -= mix.pressure() * vbar[k];
+        }
+    }
 
-            double acpb = std::max(fabs(cpb), 1.0E-6);
-            double denom = std::max(fabs(Starget), acpb);
-            double Serr = Starget - Snow;
-            double SConvErr = fabs((Serr)/denom);
-            if (printLvl > 0) {
-                plogf("   equilibrate_SP: It = %d, Tcurr  = %g Scurr = %g, Starget = %g\n",
-                      n, Tnow, Snow, Starget);
-                plogf("                   S rel error = %g, cp = %g, SConvErr = %g\n",
-                      Serr, cpb, SConvErr);
+    // Formation reactions of the noncomponent species which only involve
+    // species that are present in non-negligible amounts. Reactions between
+    // stoichiometric phases have no composition dependence, and are left out
+    // below.
+    size_t nc = numComponents();
+    std::vector<vector_fp> nu;
+    vector_fp stoich;
+    for (size_t r = 0; r + nc < nsp; r++) {
+        getStoichVector(r, stoich);
+        bool active = true;
+        for (size_t k = 0; k < nsp; k++) {
+            if (stoich[k] != 0.0 && moles[k] <= 1.0E-14 * ntot) {
+                active = false;
+                break;
             }
+        }
+        if (active) {
+            nu.push_back(stoich);
+        }
+    }
 
-            if (SConvErr < err) { // || dTa < 1.0e-4) {
-                if (printLvl > 0) {
-                    plogf("   equilibrate_SP: CONVERGENCE: Sfinal  = %g Tfinal = %g, Its = %d \n",
-                          Snow, Tnow, n);
-                    plogf("                   S rel error = %g, cp = %g, HConvErr = %g\n",
-                          Serr, cpb, SConvErr);
-                }
-                return iSuccess;
-            }
-            Tnew = Tnow + dT;
-            if (Tnew < 0.0) {
-                Tnew = 0.5*Tnow;
+    // Hessian of the Gibbs function with respect to the extents of the
+    // reactions, using ideal solution chemical potentials:
+    //     d(mu_k)/d(n_j) = RT (delta_kj / n_k - 1 / N_p)
+    // for species k and j in the same multispecies phase p
+    size_t nr = nu.size();
+    DenseMatrix hess(nr, nr, 0.0);
+    vector_fp sumNu(nr);
+    for (size_t p = 0; p < mix.nPhases(); p++) {
+        size_t k0 = mix.speciesIndex(0, p);
+        size_t kk = mix.phase(p).nSpecies();
+        if (kk == 1) {
+            continue;
+        }
+        for (size_t r = 0; r < nr; r++) {
+            sumNu[r] = 0.0;
+            for (size_t k = k0; k < k0 + kk; k++) {
+                sumNu[r] += nu[r][k];
             }
-            m_mix->setTemperature(Tnew);
-
-        } catch (CanteraError err) {
-            if (!estimateEquil) {
-                strt = -1;
-            } else {
-                Tnew = 0.5*(Tnow + Thigh);
-                if (fabs(Tnew - Tnow) < 1.0) {
-                    Tnew = Tnow + 1.0;
+        }
+        double Np = mix.phaseMoles(p);
+        for (size_t r = 0; r < nr; r++) {
+            for (size_t s = 0; s <= r; s++) {
+                double h = 0.0;
+                for (size_t k = k0; k < k0 + kk; k++) {
+                    if (nu[r][k] != 0.0 && nu[s][k] != 0.0) {
+                        h += nu[r][k] * nu[s][k] / moles[k];
+                    }
                 }
-                m_mix->setTemperature(Tnew);
+                if (Np > 0.0) {
+                    h -= sumNu[r] * sumNu[s] / Np;
+                }
+                hess(r, s) += GasConstant * T * h;
             }
         }
+    }
 
+    // Keep the reactions with a composition dependent Gibbs function
+    double hmax = 0.0;
+    for (size_t r = 0; r < nr; r++) {
+        hmax = std::max(hmax, hess(r, r));
     }
-    throw CanteraError("MultiPhase::equilibrate_SP",
-                       "No convergence for T");
+    std::vector<size_t> keep;
+    for (size_t r = 0; r < nr; r++) {
+        if (hess(r, r) > 1.0E-12 * hmax) {
+            keep.push_back(r);
+        }
+    }
+    size_t nk = keep.size();
+    if (nk == 0) {
+        return dXdT;
+    }
+
+    // Differentiating the equilibrium conditions dG_r = 0 with respect to T
+    // gives hess * d(xi)/dT = dS_r, where dS_r is the entropy change of
+    // reaction r.
+    DenseMatrix H(nk, nk);
+    vector_fp dxi(nk), dX(nk);
+    for (size_t i = 0; i < nk; i++) {
+        size_t r = keep[i];
+        dxi[i] = 0.0;
+        dX[i] = 0.0;
+        for (size_t k = 0; k < nsp; k++) {
+            dxi[i] += nu[r][k] * sbar[k];
+            dX[i] += nu[r][k] * xbar[k];
+        }
+        for (size_t j = 0; j < nk; j++) {
+            size_t s = keep[j];
+            H(i, j) = (s <= r) ? hess(r, s) : hess(s, r);
+        }
+    }
+    try {
+        solve(H, &dxi[0]);
+    } catch (CanteraError&) {
+        return dXdT;
+    }
+    for (size_t i = 0; i < nk; i++) {
+        dXdT += dX[i] * dxi[i];
+    }
+    return dXdT;
+}
+
+void vcs_MultiPhaseEquil::addSolveStats()
+{
+    const VCSnonideal::VCS_COUNTERS& c = *m_vsolve.m_VCount;
+    m_stats.timeBasisOpt += c.Time_basopt;
+    m_stats.timeInnerLoop += c.Time_vcs_TP;
+    m_stats.timePhaseStability += c.Time_phaseStability;
+    m_stats.timeDeltaG += c.Time_deltag;
+    m_stats.iterations += c.Its;
+    m_stats.basisOpts += c.Basis_Opts;
+    m_stats.phaseStabilityTests += c.Phase_Stability_Tests;
+    m_stats.speciesDeleted += c.Deletions;
+    m_stats.speciesReinserted += c.Reinsertions;
+    m_stats.thermoEvals += c.Thermo_Evals;
+    m_stats.thermoStateUpdates += c.Thermo_State_Updates;
 }
 
 int vcs_MultiPhaseEquil::equilibrate(int XY, int estimateEquil,
@@ -414,6 +481,9 @@ int vcs_MultiPhaseEquil::equilibrate(int XY, int estimateEquil,
                                      int maxsteps, int loglevel)
 {
     doublereal xtarget;
+    m_iter = 0;
+    m_stats.clear();
+    m_stats.calls = 1;
     if (XY == TP) {
         return equilibrate_TP(estimateEquil, printLvl, err, maxsteps, loglevel);
     } else if (XY == HP || XY == UP) {
@@ -460,6 +530,7 @@ int vcs_MultiPhaseEquil::equilibrate_TP(int estimateEquil,
 {
     int maxit = maxsteps;
     clockWC tickTock;
+    m_iter++;
 
     m_printLvl = printLvl;
     m_vprob.m_printLvl = printLvl;
@@ -513,7 +584,35 @@ int vcs_MultiPhaseEquil::equilibrate_TP(int estimateEquil,
     } else {
         ip1 = 0;
     }
-    int iSuccess = m_vsolve.vcs(&m_vprob, 0, ipr, ip1, maxit);
+    // If the previous solve succeeded and the current state of the mixture
+    // is to be used as the initial estimate, the workspace of the solver,
+    // including the choice of components and the set of species and phases
+    // which are present, is kept from the previous solve. Otherwise, or if
+    // the warm-started solve fails, the problem is set up from scratch.
+    int iSuccess = -1;
+    if (m_warmStart && m_solverReady && estimateEquil == 0) {
+        try {
+            iSuccess = m_vsolve.vcs(&m_vprob, 1, ipr, ip1, maxit);
+        } catch (CanteraError&) {
+            iSuccess = -1;
+        }
+        addSolveStats();
+        if (iSuccess != 0) {
+            if (m_printLvl > 0) {
+                plogf("   equilibrate_TP: warm-started solve failed; "
+                      "retrying with a full setup\n");
+            }
+            vcs_Cantera_update_vprob(m_mix, &m_vprob);
+            m_vprob.iest = estimateEquil;
+        }
+    }
+    if (iSuccess != 0) {
+        m_solverReady = false;
+        m_nFullSetups++;
+        iSuccess = m_vsolve.vcs(&m_vprob, 0, ipr, ip1, maxit);
+        addSolveStats();
+    }
+    m_solverReady = (iSuccess == 0);
 
     /*
      * Transfer the information back to the MultiPhase object.
@@ -535,6 +634,8 @@ int vcs_MultiPhaseEquil::equilibrate_TP(int estimateEquil,
     }
 
     double te = tickTock.secondsWC();
+    m_stats.time += te;
+    m_stats.outerIterations++;
     if (printLvl > 0) {
         plogf("\n Results from vcs:\n");
         if (iSuccess != 0) {
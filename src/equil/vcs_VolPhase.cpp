@@ -54,6 +54,9 @@ vcs_VolPhase::vcs_VolPhase(VCS_SOLVE* owningSolverObject) :
     m_UpToDate_VolPM(false),
     m_UpToDate_GStar(false),
     m_UpToDate_G0(false),
+    m_UpToDate_Thermo(false),
+    m_numThermoEvals(0),
+    m_numStateUpdates(0),
     Temp_(273.15),
     Pres_(1.01325E5)
 {
@@ -99,6 +102,9 @@ vcs_VolPhase::vcs_VolPhase(const vcs_VolPhase& b) :
     m_UpToDate_VolPM(false),
     m_UpToDate_GStar(false),
     m_UpToDate_G0(false),
+    m_UpToDate_Thermo(false),
+    m_numThermoEvals(0),
+    m_numStateUpdates(0),
     Temp_(b.Temp_),
     Pres_(b.Pres_)
 {
@@ -187,6 +193,7 @@ vcs_VolPhase& vcs_VolPhase::operator=(const vcs_VolPhase& b)
         m_UpToDate_G0         = false;
         Temp_                = b.Temp_;
         Pres_                = b.Pres_;
+        m_UpToDate_Thermo    = false;
 
         setState_TP(Temp_, Pres_);
         _updateMoleFractionDependencies();
@@ -308,6 +315,7 @@ void vcs_VolPhase::_updateActCoeff() const
     }
     if (m_useCanteraCalls) {
         TP_ptr->getActivityCoefficients(VCS_DATA_PTR(ActCoeff));
+        m_numThermoEvals++;
     } else {
         warn_deprecated("m_useCanteraCalls", "Setting this flag to 'false' is "
                 "deprecated and will not work after Cantera 2.2.");
@@ -327,6 +335,7 @@ void vcs_VolPhase::_updateG0() const
 {
     if (m_useCanteraCalls) {
         TP_ptr->getGibbs_ref(VCS_DATA_PTR(SS0ChemicalPotential));
+        m_numThermoEvals++;
     } else {
         warn_deprecated("m_useCanteraCalls", "Setting this flag to 'false' is "
                         "deprecated and will not work after Cantera 2.2.");
@@ -354,6 +363,7 @@ void vcs_VolPhase::_updateGStar() const
 {
     if (m_useCanteraCalls) {
         TP_ptr->getStandardChemPotentials(VCS_DATA_PTR(StarChemicalPotential));
+        m_numThermoEvals++;
     } else {
         warn_deprecated("m_useCanteraCalls", "Setting this flag to 'false' is "
                         "deprecated and will not work after Cantera 2.2.");
@@ -398,7 +408,13 @@ void vcs_VolPhase::_updateMoleFractionDependencies()
 {
     if (m_useCanteraCalls) {
         if (TP_ptr) {
+            if (m_UpToDate_Thermo && Xmol_ == m_XmolThermo) {
+                return;
+            }
             TP_ptr->setState_PX(Pres_, &(Xmol_[m_MFStartIndex]));
+            m_XmolThermo = Xmol_;
+            m_UpToDate_Thermo = true;
+            m_numStateUpdates++;
         }
     } else {
         warn_deprecated("m_useCanteraCalls", "Setting this flag to 'false' is "
@@ -410,6 +426,15 @@ void vcs_VolPhase::_updateMoleFractionDependencies()
     }
 }
 
+void vcs_VolPhase::invalidateThermoState()
+{
+    m_UpToDate_Thermo = false;
+    if (!m_isIdealSoln) {
+        m_UpToDate_AC = false;
+        m_UpToDate_VolPM = false;
+    }
+}
+
 const std::vector<double> & vcs_VolPhase::moleFractions() const
 {
     return Xmol_;
@@ -628,6 +653,9 @@ void vcs_VolPhase::sendToVCS_GStar(double* const gstar) const
 
 void vcs_VolPhase::setElectricPotential(const double phi)
 {
+    if (m_UpToDate_Thermo && phi == m_phi) {
+        return;
+    }
     m_phi = phi;
     if (m_useCanteraCalls) {
         TP_ptr->setElectricPotential(m_phi);
@@ -679,6 +707,7 @@ void vcs_VolPhase::_updateVolStar() const
 {
     if (m_useCanteraCalls) {
         TP_ptr->getStandardVolumes(VCS_DATA_PTR(StarMolarVol));
+        m_numThermoEvals++;
     } else {
         warn_deprecated("m_useCanteraCalls", "Setting this flag to 'false' is "
                         "deprecated and will not work after Cantera 2.2.");
@@ -704,6 +733,7 @@ double vcs_VolPhase::_updateVolPM() const
 {
     if (m_useCanteraCalls) {
         TP_ptr->getPartialMolarVolumes(VCS_DATA_PTR(PartialMolarVol));
+        m_numThermoEvals++;
     } else {
         warn_deprecated("m_useCanteraCalls", "Setting this flag to 'false' is "
                         "deprecated and will not work after Cantera 2.2.");
@@ -753,6 +783,7 @@ void vcs_VolPhase::_updateLnActCoeffJac()
         return;
     }
     TP_ptr->getdlnActCoeffdlnN(m_numSpecies, &np_dLnActCoeffdMolNumber(0,0));
+    m_numThermoEvals++;
     for (size_t j = 0; j < m_numSpecies; j++) {
         double moles_j_base = phaseTotalMoles * Xmol_[j];
         double* const np_lnActCoeffCol = np_dLnActCoeffdMolNumber.ptrColumn(j);
@@ -838,6 +869,7 @@ void vcs_VolPhase::sendToVCS_LnActCoeffJac(Cantera::Array2D& np_LnACJac_VCS)
 void vcs_VolPhase::setPtrThermoPhase(Cantera::ThermoPhase* tp_ptr)
 {
     TP_ptr = tp_ptr;
+    m_UpToDate_Thermo = false;
     if (TP_ptr) {
         m_useCanteraCalls = true;
         Temp_ = TP_ptr->temperature();
@@ -21,7 +21,7 @@ int vcs_equilibrate(thermo_t& s, const char* XY,
                     int estimateEquil,  int printLvl,
                     int solver,
                     doublereal rtol, int maxsteps, int maxiter,
-                    int loglevel)
+                    int loglevel, EquilStats* stats)
 {
     MultiPhase* m = 0;
     int retn = 1;
@@ -37,7 +37,7 @@ int vcs_equilibrate(thermo_t& s, const char* XY,
             m->init();
 
             retn = vcs_equilibrate(*m, XY, estimateEquil, printLvl, solver,
-                                   rtol, maxsteps, maxiter, loglevel);
+                                   rtol, maxsteps, maxiter, loglevel, stats);
             delete m;
         } catch (CanteraError& err) {
             err.save();
@@ -68,6 +68,9 @@ int vcs_equilibrate(thermo_t& s, const char* XY,
             }
             int retnSub = e->equilibrate(s, XY,
                                      useThermoPhaseElementPotentials, loglevel-1);
+            if (stats) {
+                *stats += e->stats();
+            }
             if (retnSub < 0) {
                 delete e;
                 throw CanteraError("equilibrate",
@@ -95,17 +98,18 @@ int vcs_equilibrate(thermo_t& s, const char* XY,
 int vcs_equilibrate(MultiPhase& s, const char* XY,
                     int estimateEquil, int printLvl, int solver,
                     doublereal tol, int maxsteps, int maxiter,
-                    int loglevel)
+                    int loglevel, EquilStats* stats)
 {
     int ixy = _equilflag(XY);
     int retn = vcs_equilibrate_1(s, ixy, estimateEquil, printLvl, solver,
-                                 tol, maxsteps, maxiter, loglevel);
+                                 tol, maxsteps, maxiter, loglevel, stats);
     return retn;
 }
 
 int vcs_equilibrate_1(MultiPhase& s, int ixy,
                       int estimateEquil, int printLvl, int solver,
-                      doublereal tol, int maxsteps, int maxiter, int loglevel)
+                      doublereal tol, int maxsteps, int maxiter, int loglevel,
+                      EquilStats* stats)
 {
     static int counter = 0;
     int retn = 1;
@@ -121,6 +125,9 @@ int vcs_equilibrate_1(MultiPhase& s, int ixy,
             if (err != 0) {
                 retn = -1;
             }
+            if (stats) {
+                *stats += eqsolve->stats();
+            }
             // hard code a csv output file.
             if (printLvl > 0) {
                 string reportFile = "vcs_equilibrate_res.csv";
@@ -519,6 +519,7 @@ int VCS_SOLVE::vcs_popPhaseRxnStepSizes(const size_t iphasePop)
  //====================================================================================================================
 double VCS_SOLVE::vcs_phaseStabilityTest(const size_t iph)
 {
+    m_VCount->Phase_Stability_Tests++;
     /*
      * We will use the _new state calc here
      */
@@ -98,6 +98,7 @@ void VCS_SOLVE::vcs_initSizes(const size_t nspecies0, const size_t nelements,
      * filled with meaningful information.
      */
     m_stoichCoeffRxnMatrix.resize(nelements, nspecies0, 0.0);
+    m_rxnComponents.resize(nspecies0);
 
     m_scSize.resize(nspecies0, 0.0);
     m_spSize.resize(nspecies0, 1.0);
@@ -255,6 +256,14 @@ int VCS_SOLVE::vcs(VCS_PROB* vprob, int ifunc, int ipr, int ip1, int maxit)
               ifunc);
         return VCS_PUB_BAD;
     }
+    /*
+     *        Reset the counters for the current call, so that they are
+     *        not left over from the previous call if this one fails
+     *        before the main algorithm is started.
+     */
+    if (m_VCount) {
+        vcs_counters_init(0);
+    }
 
     if (ifunc == 0) {
         /*
@@ -335,8 +344,25 @@ int VCS_SOLVE::vcs(VCS_PROB* vprob, int ifunc, int ipr, int ip1, int maxit)
          *    For example, solving for fixed T, V problems will involve
          *    a 2x2 Newton's method, using loops over vcs_TP() to
          *    calculate the residual and Jacobian)
+         *
+         *   The ThermoPhase objects are shared with the VCS_PROB object and
+         *   the MultiPhase object, which may have changed their states since
+         *   the last call, so the cached compositions can't be relied on.
          */
+        int nevals = 0;
+        int nupdates = 0;
+        for (size_t iph = 0; iph < m_numPhases; iph++) {
+            m_VolPhaseList[iph]->invalidateThermoState();
+            nevals -= m_VolPhaseList[iph]->numThermoEvals();
+            nupdates -= m_VolPhaseList[iph]->numStateUpdates();
+        }
         iconv = vcs_TP(ipr, ip1, maxit, vprob->T, vprob->PresPA);
+        for (size_t iph = 0; iph < m_numPhases; iph++) {
+            nevals += m_VolPhaseList[iph]->numThermoEvals();
+            nupdates += m_VolPhaseList[iph]->numStateUpdates();
+        }
+        m_VCount->Thermo_Evals = nevals;
+        m_VCount->Thermo_State_Updates = nupdates;
 
         /*
          *        If requested to print anything out, go ahead and do so;
@@ -786,6 +812,16 @@ int VCS_SOLVE::vcs_prob_specify(const VCS_PROB* pub)
         m_elemAbundancesGoal[i] = pub->gai[j];
     }
 
+    /*
+     *  Species which were deleted during the previous solve are added back,
+     *  since they may be present at the new conditions. The ordering of the
+     *  species, and thus the choice of components, is kept.
+     */
+    m_numSpeciesRdc = m_numSpeciesTot;
+    m_numRxnRdc = m_numRxnTot;
+    m_numRxnMinorZeroed = 0;
+    m_speciesStatus.assign(m_speciesStatus.size(), VCS_SPECIES_MAJOR);
+
     /*
      *  Try to do the best job at guessing at the title
      */
@@ -969,6 +1005,13 @@ void VCS_SOLVE::vcs_counters_init(int ifunc)
     m_VCount->Basis_Opts = 0;
     m_VCount->Time_vcs_TP = 0.0;
     m_VCount->Time_basopt = 0.0;
+    m_VCount->Time_deltag = 0.0;
+    m_VCount->Time_phaseStability = 0.0;
+    m_VCount->Phase_Stability_Tests = 0;
+    m_VCount->Deletions = 0;
+    m_VCount->Reinsertions = 0;
+    m_VCount->Thermo_Evals = 0;
+    m_VCount->Thermo_State_Updates = 0;
     if (ifunc) {
         m_VCount->T_Its = 0;
         m_VCount->T_Basis_Opts = 0;
@@ -483,6 +483,7 @@ void VCS_SOLVE::solve_tp_inner(size_t& iti, size_t& it1,
      * First step is a major branch in the algorithm.
      * We first determine if a phase pops into existence.
      */
+    Cantera::clockWC popTimer;
     std::vector<size_t> phasePopPhaseIDs(0);
     size_t iphasePop = vcs_popPhaseID(phasePopPhaseIDs);
     /*
@@ -498,6 +499,7 @@ void VCS_SOLVE::solve_tp_inner(size_t& iti, size_t& it1,
             }
         }
     }
+    m_VCount->Time_phaseStability += popTimer.secondsWC();
 
     /*************************************************************************/
     /* DETERMINE THE REACTION STEP SIZES FOR MAIN STEP AND IF PHASES DIE *****/
@@ -585,7 +587,9 @@ void VCS_SOLVE::solve_tp_inner(size_t& iti, size_t& it1,
          *         Evaluate DeltaG for all components if ITI=0, and for
          *         major components only if ITI NE 0
          */
+        Cantera::clockWC deltagTimer;
         vcs_deltag(0, false, VCS_STATECALC_NEW);
+        m_VCount->Time_deltag += deltagTimer.secondsWC();
     } else {
         if (DEBUG_MODE_ENABLED && m_debug_print_lvl >= 2) {
             plogf("   --- Main Loop Treatment of each non-component species ");
@@ -985,7 +989,9 @@ void VCS_SOLVE::solve_tp_inner(size_t& iti, size_t& it1,
                         "ds[kspec] = " + fp2str(m_deltaMolNumSpecies[kspec]) +
                         " dx = " + fp2str(dx) + " , kspec = " + int2str(kspec) +
                         "\nwe have a problem!");
-                for (size_t k = 0; k < m_numComponents; ++k) {
+                const std::vector<size_t>& rxnComponents = m_rxnComponents[irxn];
+                for (size_t n = 0; n < rxnComponents.size(); ++n) {
+                    size_t k = rxnComponents[n];
                     m_deltaMolNumSpecies[k] += sc_irxn[k] * dx;
                 }
                 /*
@@ -1131,7 +1137,9 @@ void VCS_SOLVE::solve_tp_inner(size_t& iti, size_t& it1,
          *         Evaluate DeltaG for all components if ITI=0, and for
          *         major components only if ITI NE 0
          */
+        Cantera::clockWC deltagTimer;
         vcs_deltag(0, false, VCS_STATECALC_NEW);
+        m_VCount->Time_deltag += deltagTimer.secondsWC();
 
         /* *************************************************************** */
         /* **** CONVERGENCE FORCER SECTION ******************************* */
@@ -1894,6 +1902,7 @@ int VCS_SOLVE::vcs_delete_species(const size_t kspec)
      * Zero the concentration of the species.
      *     -> This zeroes w[kspec] and modifies m_tPhaseMoles_old[]
      */
+    m_VCount->Deletions++;
     const int retn = vcs_zero_species(kspec);
     AssertThrowMsg(retn, "VCS_SOLVE::vcs_delete_species",
         "Failed to delete a species!");
@@ -1962,6 +1971,7 @@ int VCS_SOLVE::vcs_delete_species(const size_t kspec)
 void VCS_SOLVE::vcs_reinsert_deleted(size_t kspec)
 {
     size_t iph = m_phaseID[kspec];
+    m_VCount->Reinsertions++;
     if (DEBUG_MODE_ENABLED && m_debug_print_lvl >= 2) {
         plogf("   --- Add back a deleted species: %-12s\n", m_speciesName[kspec].c_str());
     }
@@ -2585,6 +2595,32 @@ int VCS_SOLVE::vcs_basopt(const bool doJustComponents, double aw[], double sa[],
         }
     }
 
+    /*
+     *  Sparse representation of the formula matrix: the elements contained
+     *  in each species. Also, the number of active positive elements in each
+     *  species and the maximum number of moles of the species allowed by the
+     *  element abundances, which are used below to choose between zeroed
+     *  species. These don't change while the basis is being chosen. Most
+     *  species contain only a few of the elements, and in large problems
+     *  many species may be tested before the basis is complete, so this
+     *  avoids repeated scans over the full formula matrix.
+     */
+    std::vector<std::vector<size_t> > speciesElements(m_numSpeciesTot);
+    vector_int nonZeroes(m_numSpeciesTot, 0);
+    vector_fp maxConcPoss(m_numSpeciesTot, 1.0E10);
+    for (k = 0; k < m_numSpeciesTot; k++) {
+        for (size_t j = 0; j < m_numElemConstraints; ++j) {
+            double nu = m_formulaMatrix(k,j);
+            if (nu != 0.0) {
+                speciesElements[k].push_back(j);
+                if (m_elementActive[j] && m_elType[j] == VCS_ELEM_TYPE_ABSPOS) {
+                    nonZeroes[k]++;
+                    maxConcPoss[k] = std::min(m_elemAbundancesGoal[j] / nu, maxConcPoss[k]);
+                }
+            }
+        }
+    }
+
     size_t jr = npos;
     /*
      *   Top of a loop of some sort based on the index JR. JR is the
@@ -2646,27 +2682,16 @@ int VCS_SOLVE::vcs_basopt(const bool doJustComponents, double aw[], double sa[],
                 *usedZeroedSpecies = true;
 
                 double maxConcPossKspec = 0.0;
-                double maxConcPoss = 0.0;
+                double maxConcPossMax = 0.0;
                 size_t kfound = npos;
                 int minNonZeroes = 100000;
                 int nonZeroesKspec = 0;
                 for (size_t kspec = ncTrial; kspec < m_numSpeciesTot; kspec++) {
                     if (aw[kspec] >= 0.0) {
                         if (m_speciesUnknownType[kspec] != VCS_SPECIES_TYPE_INTERFACIALVOLTAGE) {
-                            maxConcPossKspec = 1.0E10;
-                            nonZeroesKspec = 0;
-                            for (size_t j = 0; j < m_numElemConstraints; ++j) {
-                                if (m_elementActive[j]) {
-                                    if (m_elType[j] == VCS_ELEM_TYPE_ABSPOS) {
-                                        double nu = m_formulaMatrix(kspec,j);
-                                        if (nu != 0.0) {
-                                            nonZeroesKspec++;
-                                            maxConcPossKspec = std::min(m_elemAbundancesGoal[j] / nu, maxConcPossKspec);
-                                        }
-                                    }
-                                }
-                            }
-                            if ((maxConcPossKspec >= maxConcPoss) || (maxConcPossKspec > 1.0E-5)) {
+                            maxConcPossKspec = maxConcPoss[kspec];
+                            nonZeroesKspec = nonZeroes[kspec];
+                            if ((maxConcPossKspec >= maxConcPossMax) || (maxConcPossKspec > 1.0E-5)) {
                                 if (nonZeroesKspec <= minNonZeroes) {
                                     if (kfound == npos || nonZeroesKspec < minNonZeroes) {
                                         kfound = kspec;
@@ -2678,7 +2703,7 @@ int VCS_SOLVE::vcs_basopt(const bool doJustComponents, double aw[], double sa[],
                                     }
                                 }
                                 minNonZeroes = std::min(minNonZeroes, nonZeroesKspec);
-                                maxConcPoss = std::max(maxConcPoss, maxConcPossKspec);
+                                maxConcPossMax = std::max(maxConcPossMax, maxConcPossKspec);
                             }
                         }
                     }
@@ -2732,6 +2757,7 @@ int VCS_SOLVE::vcs_basopt(const bool doJustComponents, double aw[], double sa[],
              *          QR factorization of a matrix without row pivoting.
              */
             size_t jl = jr;
+            const std::vector<size_t>& kElements = speciesElements[k];
             for (size_t j = 0; j < m_numElemConstraints; ++j) {
                 sm[j + jr*m_numElemConstraints] = m_formulaMatrix(k,j);
             }
@@ -2741,10 +2767,12 @@ int VCS_SOLVE::vcs_basopt(const bool doJustComponents, double aw[], double sa[],
                  *         the upper triangular R matrix, SS(J) = R_J_JR
                  *         (this is slightly different than Dalquist)
                  *         R_JA_JA = 1
+                 *         Only the elements contained in species k contribute.
                  */
                 for (size_t j = 0; j < jl; ++j) {
                     ss[j] = 0.0;
-                    for (size_t i = 0; i < m_numElemConstraints; ++i) {
+                    for (size_t n = 0; n < kElements.size(); ++n) {
+                        size_t i = kElements[n];
                         ss[j] += sm[i + jr*m_numElemConstraints] * sm[i + j*m_numElemConstraints];
                     }
                     ss[j] /= sa[j];
@@ -2754,6 +2782,9 @@ int VCS_SOLVE::vcs_basopt(const bool doJustComponents, double aw[], double sa[],
                  *     previous columns
                  */
                 for (size_t j = 0; j < jl; ++j) {
+                    if (ss[j] == 0.0) {
+                        continue;
+                    }
                     for (size_t l = 0; l < m_numElemConstraints; ++l) {
                         sm[l + jr*m_numElemConstraints] -= ss[j] * sm[l + j*m_numElemConstraints];
                     }
@@ -2793,6 +2824,9 @@ int VCS_SOLVE::vcs_basopt(const bool doJustComponents, double aw[], double sa[],
             }
             vcs_switch_pos(false, jr, k);
             std::swap(aw[jr], aw[k]);
+            std::swap(speciesElements[jr], speciesElements[k]);
+            std::swap(nonZeroes[jr], nonZeroes[k]);
+            std::swap(maxConcPoss[jr], maxConcPoss[k]);
         }
         else if (DEBUG_MODE_ENABLED && m_debug_print_lvl >= 2) {
             plogf("   ---   %-12.12s", m_speciesName[k].c_str());
@@ -3044,6 +3078,8 @@ L_END_LOOP:
      */
     for (size_t irxn = 0; irxn < m_numRxnTot; ++irxn) {
         scrxn_ptr = m_stoichCoeffRxnMatrix.ptrColumn(irxn);
+        std::vector<size_t>& rxnComponents = m_rxnComponents[irxn];
+        rxnComponents.clear();
         size_t kspec = m_indexRxnToSpecies[irxn];
         size_t iph = m_phaseID[kspec];
         m_deltaMolNumPhase(iph,irxn) = 1.0;
@@ -3055,6 +3091,7 @@ L_END_LOOP:
             } else {
                 m_deltaMolNumPhase(iph,irxn) += scrxn_ptr[j];
                 m_phaseParticipation(iph,irxn)++;
+                rxnComponents.push_back(j);
             }
         }
     }
@@ -3924,7 +3961,9 @@ void VCS_SOLVE::vcs_deltag(const int l, const bool doDeleted,
                 icase = 0;
                 deltaGRxn[irxn] = feSpecies[m_indexRxnToSpecies[irxn]];
                 double* dtmp_ptr = m_stoichCoeffRxnMatrix.ptrColumn(irxn);
-                for (kspec = 0; kspec < m_numComponents; ++kspec) {
+                const std::vector<size_t>& rxnComponents = m_rxnComponents[irxn];
+                for (size_t n = 0; n < rxnComponents.size(); ++n) {
+                    kspec = rxnComponents[n];
                     deltaGRxn[irxn] += dtmp_ptr[kspec] * feSpecies[kspec];
                     if (molNumSpecies[kspec] < VCS_DELETE_MINORSPECIES_CUTOFF && dtmp_ptr[kspec] < 0.0) {
                         icase = 1;
@@ -3943,7 +3982,9 @@ void VCS_SOLVE::vcs_deltag(const int l, const bool doDeleted,
             icase = 0;
             deltaGRxn[irxn] = feSpecies[m_indexRxnToSpecies[irxn]];
             double* dtmp_ptr = m_stoichCoeffRxnMatrix.ptrColumn(irxn);
-            for (size_t kspec = 0; kspec < m_numComponents; ++kspec) {
+            const std::vector<size_t>& rxnComponents = m_rxnComponents[irxn];
+            for (size_t n = 0; n < rxnComponents.size(); ++n) {
+                size_t kspec = rxnComponents[n];
                 deltaGRxn[irxn] += dtmp_ptr[kspec] * feSpecies[kspec];
                 if (molNumSpecies[kspec] < VCS_DELETE_MINORSPECIES_CUTOFF &&
                         dtmp_ptr[kspec] < 0.0) {
@@ -3964,7 +4005,9 @@ void VCS_SOLVE::vcs_deltag(const int l, const bool doDeleted,
                 icase = 0;
                 deltaGRxn[irxn] = feSpecies[m_indexRxnToSpecies[irxn]];
                 double* dtmp_ptr = m_stoichCoeffRxnMatrix.ptrColumn(irxn);
-                for (kspec = 0; kspec < m_numComponents; ++kspec) {
+                const std::vector<size_t>& rxnComponents = m_rxnComponents[irxn];
+                for (size_t n = 0; n < rxnComponents.size(); ++n) {
+                    kspec = rxnComponents[n];
                     deltaGRxn[irxn] += dtmp_ptr[kspec] * feSpecies[kspec];
                     if (m_molNumSpecies_old[kspec] < VCS_DELETE_MINORSPECIES_CUTOFF &&
                             dtmp_ptr[kspec] < 0.0) {
@@ -4245,7 +4288,9 @@ void VCS_SOLVE::vcs_deltag_Phase(const size_t iphase, const bool doDeleted,
         if (kspec >= m_numComponents) {
             size_t irxn = kspec - m_numComponents;
             deltaGRxn[irxn] = feSpecies[kspec];
-            for (size_t kcomp = 0; kcomp < m_numComponents; ++kcomp) {
+            const std::vector<size_t>& rxnComponents = m_rxnComponents[irxn];
+            for (size_t n = 0; n < rxnComponents.size(); ++n) {
+                size_t kcomp = rxnComponents[n];
                 deltaGRxn[irxn] += m_stoichCoeffRxnMatrix(kcomp,irxn) * feSpecies[kcomp];
             }
         }
@@ -4264,7 +4309,9 @@ void VCS_SOLVE::vcs_deltag_Phase(const size_t iphase, const bool doDeleted,
                         zeroedPhase = false;
                     }
                     deltaGRxn[irxn] = feSpecies[kspec];
-                    for (size_t kcomp = 0; kcomp < m_numComponents; ++kcomp) {
+                    const std::vector<size_t>& rxnComponents = m_rxnComponents[irxn];
+                    for (size_t n = 0; n < rxnComponents.size(); ++n) {
+                        size_t kcomp = rxnComponents[n];
                         deltaGRxn[irxn] += m_stoichCoeffRxnMatrix(kcomp,irxn) * feSpecies[kcomp];
                     }
                 }
@@ -4411,6 +4458,7 @@ void VCS_SOLVE::vcs_switch_pos(const bool ifunc, const size_t k1, const size_t k
         for (size_t j = 0; j < m_numComponents; ++j) {
             std::swap(m_stoichCoeffRxnMatrix(j,i1), m_stoichCoeffRxnMatrix(j,i2));
         }
+        std::swap(m_rxnComponents[i1], m_rxnComponents[i2]);
         std::swap(m_scSize[i1], m_scSize[i2]);
         for (size_t iph = 0; iph < m_numPhases; iph++) {
             std::swap(m_deltaMolNumPhase(iph,i1), m_deltaMolNumPhase(iph,i2));
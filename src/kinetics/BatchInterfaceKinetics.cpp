@@ -0,0 +1,232 @@
+//! @file BatchInterfaceKinetics.cpp
+#include "cantera/kinetics/BatchInterfaceKinetics.h"
+#include "cantera/thermo/SurfPhase.h"
+#include "cantera/base/ct_thread.h"
+#include "cantera/base/stringUtils.h"
+
+#ifdef THREAD_SAFE_CANTERA
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace {
+//! Protects the work lists and error messages of all BatchInterfaceKinetics
+//! objects
+mutex_t batch_kinetics_mutex;
+}
+
+BatchInterfaceKinetics::BatchInterfaceKinetics(const InterfaceKinetics& kin,
+                                               size_t gasPhase) :
+    m_kin(0),
+    m_gasPhase(gasPhase),
+    m_nthreads(1),
+    m_blockSize(256),
+    m_nfaces(0),
+    m_T(0),
+    m_P(0),
+    m_Y(0),
+    m_theta(0),
+    m_wdot(0),
+    m_dthetadt(0),
+    m_next(0),
+    m_firstFailed(npos)
+{
+    for (size_t n = 0; n < kin.nPhases(); n++) {
+        m_phases.push_back(kin.thermo(n).duplMyselfAsThermoPhase());
+    }
+    m_kin = dynamic_cast<InterfaceKinetics*>(kin.duplMyselfAsKinetics(m_phases));
+    m_surfPhase = m_kin->reactionPhaseIndex();
+    if (m_surfPhase == npos) {
+        throw CanteraError("BatchInterfaceKinetics",
+                           "Kinetics object has no surface phase.");
+    }
+    if (m_gasPhase == npos) {
+        m_gasPhase = (m_surfPhase == 0) ? 1 : 0;
+    }
+    if (m_gasPhase >= m_kin->nPhases() || m_gasPhase == m_surfPhase) {
+        throw CanteraError("BatchInterfaceKinetics",
+                           "Invalid gas phase index: " + int2str(m_gasPhase));
+    }
+    m_ngas = m_kin->thermo(m_gasPhase).nSpecies();
+    m_nsurf = m_kin->thermo(m_surfPhase).nSpecies();
+    m_kk = m_kin->nTotalSpecies();
+    m_surfStart = m_kin->kineticsSpeciesIndex(0, m_surfPhase);
+
+    SurfPhase& surf = dynamic_cast<SurfPhase&>(m_kin->thermo(m_surfPhase));
+    m_sizeOverSiteDensity.resize(m_nsurf);
+    for (size_t k = 0; k < m_nsurf; k++) {
+        m_sizeOverSiteDensity[k] = surf.size(k) / surf.siteDensity();
+    }
+
+#ifdef THREAD_SAFE_CANTERA
+    m_nthreads = std::max(boost::thread::hardware_concurrency(), 1u);
+#endif
+}
+
+BatchInterfaceKinetics::~BatchInterfaceKinetics()
+{
+    for (size_t i = 0; i < m_workers.size(); i++) {
+        delete m_workers[i].kin;
+        for (size_t n = 0; n < m_workers[i].phases.size(); n++) {
+            delete m_workers[i].phases[n];
+        }
+    }
+    delete m_kin;
+    for (size_t n = 0; n < m_phases.size(); n++) {
+        delete m_phases[n];
+    }
+}
+
+void BatchInterfaceKinetics::setNumThreads(size_t n)
+{
+    if (n == 0) {
+        throw CanteraError("BatchInterfaceKinetics::setNumThreads",
+                           "Number of threads must be positive.");
+    }
+    m_nthreads = n;
+}
+
+void BatchInterfaceKinetics::setBlockSize(size_t n)
+{
+    if (n == 0) {
+        throw CanteraError("BatchInterfaceKinetics::setBlockSize",
+                           "Block size must be positive.");
+    }
+    m_blockSize = n;
+}
+
+void BatchInterfaceKinetics::initWorker(Worker& w)
+{
+    if (w.kin) {
+        return;
+    }
+    for (size_t n = 0; n < m_phases.size(); n++) {
+        w.phases.push_back(m_phases[n]->duplMyselfAsThermoPhase());
+    }
+    w.kin = dynamic_cast<InterfaceKinetics*>(
+                m_kin->duplMyselfAsKinetics(w.phases));
+    w.wdot.resize(m_kk);
+}
+
+void BatchInterfaceKinetics::eval(size_t nfaces, const double* T,
+                                  const double* P, const double* Y,
+                                  const double* theta, double* wdot,
+                                  double* dthetadt)
+{
+    m_nfaces = nfaces;
+    m_T = T;
+    m_P = P;
+    m_Y = Y;
+    m_theta = theta;
+    m_wdot = wdot;
+    m_dthetadt = dthetadt;
+    m_next = 0;
+    m_firstFailed = npos;
+    m_error.clear();
+
+    size_t nblocks = (nfaces + m_blockSize - 1) / m_blockSize;
+    size_t nthreads = std::max<size_t>(std::min(m_nthreads, nblocks), 1);
+    if (m_workers.size() < nthreads) {
+        Worker empty;
+        empty.kin = 0;
+        m_workers.resize(nthreads, empty);
+    }
+    for (size_t n = 0; n < nthreads; n++) {
+        initWorker(m_workers[n]);
+    }
+
+#ifdef THREAD_SAFE_CANTERA
+    if (nthreads > 1) {
+        boost::thread_group threads;
+        for (size_t n = 0; n < nthreads; n++) {
+            threads.create_thread(boost::bind(&BatchInterfaceKinetics::work,
+                                              this, n, true));
+        }
+        threads.join_all();
+    } else {
+        work(0, false);
+    }
+#else
+    work(0, false);
+#endif
+
+    if (m_firstFailed != npos) {
+        throw CanteraError("BatchInterfaceKinetics::eval",
+                           "Evaluation failed for face " +
+                           int2str(m_firstFailed) + ":\n" + m_error);
+    }
+}
+
+void BatchInterfaceKinetics::work(size_t iworker, bool workerThread)
+{
+    Worker& w = m_workers[iworker];
+    while (true) {
+        size_t start;
+        {
+            ScopedLock lock(batch_kinetics_mutex);
+            if (m_next >= m_nfaces) {
+                break;
+            }
+            start = m_next;
+            m_next += m_blockSize;
+        }
+        size_t end = std::min(start + m_blockSize, m_nfaces);
+        for (size_t i = start; i < end; i++) {
+            try {
+                evalFace(w, i);
+            } catch (CanteraError& err) {
+                recordFailure(i, err.getMessage());
+            } catch (std::exception& err) {
+                recordFailure(i, err.what());
+            } catch (...) {
+                recordFailure(i, "unknown exception");
+            }
+        }
+    }
+    if (workerThread) {
+        // Release the error and log buffers for this thread
+        thread_complete();
+    }
+}
+
+void BatchInterfaceKinetics::recordFailure(size_t i, const std::string& msg)
+{
+    ScopedLock lock(batch_kinetics_mutex);
+    if (i < m_firstFailed) {
+        m_firstFailed = i;
+        m_error = msg;
+    }
+}
+
+void BatchInterfaceKinetics::evalFace(Worker& w, size_t i)
+{
+    double T = m_T[i];
+    double P = m_P[i];
+    for (size_t n = 0; n < w.phases.size(); n++) {
+        if (n == m_gasPhase) {
+            w.phases[n]->setState_TPY(T, P, m_Y + i * m_ngas);
+        } else if (n == m_surfPhase) {
+            SurfPhase* surf = static_cast<SurfPhase*>(w.phases[n]);
+            surf->setTemperature(T);
+            surf->setCoveragesNoNorm(m_theta + i * m_nsurf);
+        } else {
+            w.phases[n]->setState_TP(T, P);
+        }
+    }
+
+    double* wdot = m_wdot ? m_wdot + i * m_kk : &w.wdot[0];
+    w.kin->getNetProductionRates(wdot);
+    if (m_dthetadt) {
+        double* dthetadt = m_dthetadt + i * m_nsurf;
+        for (size_t k = 0; k < m_nsurf; k++) {
+            dthetadt[k] = wdot[m_surfStart + k] * m_sizeOverSiteDensity[k];
+        }
+    }
+}
+
+}
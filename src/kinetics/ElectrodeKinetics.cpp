@@ -63,6 +63,7 @@ int ElectrodeKinetics::type() const
 Kinetics* ElectrodeKinetics::duplMyselfAsKinetics(const std::vector<thermo_t*> & tpVector) const
 {
     ElectrodeKinetics* iK = new ElectrodeKinetics(*this);
+    iK->m_integrator = 0;
     iK->assignShallowPointers(tpVector);
     return iK;
 }
@@ -23,6 +23,9 @@ GasKinetics::GasKinetics(thermo_t* thermo) :
     m_ROP_ok(false),
     m_temp(0.0),
     m_pres(0.0),
+    m_conc_stateNum(-2),
+    m_conc_temp(0.0),
+    m_conc_dens(0.0),
     m_finalized(false)
 {
     if (thermo != 0) {
@@ -42,6 +45,9 @@ GasKinetics::GasKinetics(const GasKinetics& right) :
     m_ROP_ok(false),
     m_temp(0.0),
     m_pres(0.0),
+    m_conc_stateNum(-2),
+    m_conc_temp(0.0),
+    m_conc_dens(0.0),
     m_finalized(false)
 {
     m_temp = 0.0;
@@ -104,6 +110,7 @@ GasKinetics& GasKinetics::operator=(const GasKinetics& right)
     m_conc = right.m_conc;
     m_grt = right.m_grt;
     m_finalized = right.m_finalized;
+    m_conc_stateNum = -2;
 
     throw CanteraError("GasKinetics::operator=()",
                        "Unfinished implementation");
@@ -158,6 +165,18 @@ void GasKinetics::update_rates_T()
 
 void GasKinetics::update_rates_C()
 {
+    // The concentrations only need to be updated if the state of the phase
+    // has changed since they were last evaluated
+    int stateNum = thermo().stateMFNumber();
+    doublereal T = thermo().temperature();
+    doublereal rho = thermo().density();
+    if (stateNum == m_conc_stateNum && T == m_conc_temp && rho == m_conc_dens) {
+        return;
+    }
+    m_conc_stateNum = stateNum;
+    m_conc_temp = T;
+    m_conc_dens = rho;
+
     thermo().getActivityConcentrations(&m_conc[0]);
     doublereal ctot = thermo().molarDensity();
 
@@ -225,6 +244,12 @@ void GasKinetics::getEquilibriumConstants(doublereal* kc)
     m_temp = 0.0;
 }
 
+void GasKinetics::getReactionDelta(const doublereal* prop,
+                                   doublereal* deltaProp)
+{
+    m_rxnstoich.getReactionDelta(m_ii, prop, deltaProp);
+}
+
 void GasKinetics::getDeltaGibbs(doublereal* deltaG)
 {
     /*
@@ -423,6 +448,75 @@ void GasKinetics::updateROP()
     m_ROP_ok = true;
 }
 
+void GasKinetics::getNetProductionRates_ddC(doublereal* ddC)
+{
+    // Mass-action terms, using the rate constants at the current [M]
+    Kinetics::getNetProductionRates_ddC(ddC);
+    if (concm_3b_values.empty() && m_nfall == 0) {
+        return;
+    }
+    updateROP();
+    m_ddC_eff.resize(m_kk);
+
+    // The rates of progress of three-body reactions are proportional to [M]
+    for (size_t n = 0; n < concm_3b_values.size(); n++) {
+        size_t i = m_3b_concm.reactionIndex(n);
+        if (concm_3b_values[n] != 0.0) {
+            m_3b_concm.getEfficiencies(n, m_ddC_eff);
+            addThirdBodyDerivatives(i, m_ropnet[i] / concm_3b_values[n],
+                                    m_ddC_eff, ddC);
+        }
+    }
+
+    if (m_nfall == 0) {
+        return;
+    }
+    // For falloff reactions, d(ln k)/d(ln [M]) = d(ln f)/d(ln Pr), where
+    // f(Pr) is the value computed by FalloffMgr::pr_to_falloff()
+    const double dlnPr = 1.0e-6;
+    m_ddC_pr.resize(2 * m_nfall);
+    double* f0 = &m_ddC_pr[0];
+    double* f1 = f0 + m_nfall;
+    for (size_t n = 0; n < m_nfall; n++) {
+        f0[n] = concm_falloff_values[n] * m_rfn_low[n] /
+                (m_rfn_high[n] + SmallNumber);
+        f1[n] = f0[n] * (1.0 + dlnPr);
+    }
+    double* work = (falloff_work.empty()) ? 0 : &falloff_work[0];
+    m_falloffn.pr_to_falloff(f0, work);
+    m_falloffn.pr_to_falloff(f1, work);
+    for (size_t n = 0; n < m_nfall; n++) {
+        size_t i = m_fallindx[n];
+        if (concm_falloff_values[n] == 0.0 || f0[n] <= 0.0 || f1[n] <= 0.0) {
+            continue;
+        }
+        double dlnk = log(f1[n] / f0[n]) / log(1.0 + dlnPr);
+        m_falloff_concm.getEfficiencies(n, m_ddC_eff);
+        addThirdBodyDerivatives(i, m_ropnet[i] * dlnk /
+                                concm_falloff_values[n], m_ddC_eff, ddC);
+    }
+}
+
+void GasKinetics::addThirdBodyDerivatives(size_t i, double dqdM,
+                                          const vector_fp& eff, doublereal* ddC)
+{
+    const std::vector<size_t>& R = m_reactants[i];
+    const std::vector<size_t>& P = m_products[i];
+    for (size_t j = 0; j < m_kk; j++) {
+        double dq = dqdM * eff[j];
+        if (dq == 0.0) {
+            continue;
+        }
+        double* col = ddC + j * m_kk;
+        for (size_t l = 0; l < R.size(); l++) {
+            col[R[l]] -= dq;
+        }
+        for (size_t l = 0; l < P.size(); l++) {
+            col[P[l]] += dq;
+        }
+    }
+}
+
 void GasKinetics::getFwdRateConstants(doublereal* kfwd)
 {
     update_rates_C();
@@ -450,6 +544,8 @@ void GasKinetics::getFwdRateConstants(doublereal* kfwd)
     for (size_t i = 0; i < m_ii; i++) {
         kfwd[i] = m_ropf[i];
     }
+    // m_ropf was used as work space
+    m_ROP_ok = false;
 }
 
 void GasKinetics::getRevRateConstants(doublereal* krev, bool doIrreversible)
@@ -476,6 +572,8 @@ void GasKinetics::getRevRateConstants(doublereal* krev, bool doIrreversible)
 
 void GasKinetics::addReaction(ReactionData& r)
 {
+    m_ROP_ok = false;
+    m_conc_stateNum = -2;
     switch (r.reactionType) {
     case ELEMENTARY_RXN:
         addElementaryReaction(r);
@@ -669,6 +767,7 @@ void GasKinetics::installGroups(size_t irxn,
 
 void GasKinetics::init()
 {
+    m_conc_stateNum = -2;
     m_kk = thermo().nSpecies();
     m_rrxn.resize(m_kk);
     m_prxn.resize(m_kk);
@@ -679,6 +778,7 @@ void GasKinetics::init()
 
 void GasKinetics::finalize()
 {
+    m_conc_stateNum = -2;
     if (!m_finalized) {
         falloff_work.resize(m_falloffn.workSize());
         concm_3b_values.resize(m_3b_concm.workSize());
@@ -30,6 +30,8 @@ ImplicitSurfChem::ImplicitSurfChem(vector<InterfaceKinetics*> k) :
     m_bulkSpeciesStart(-1),
     m_surfSpeciesStart(-1),
     m_surfSolver(0),
+    m_surfJacobianType("analytic"),
+    m_surfReuseJacobian(false),
     m_commonTempPressForPhases(true),
     m_ioFlag(0)
 {
@@ -187,6 +189,8 @@ void ImplicitSurfChem::solvePseudoSteadyStateProblem(int ifuncOverride,
     doublereal time_scale = timeScaleOverride;
     if (!m_surfSolver) {
         m_surfSolver = new solveSP(this, bulkFunc);
+        m_surfSolver->setJacobianType(m_surfJacobianType);
+        m_surfSolver->setReuseJacobian(m_surfReuseJacobian);
         /*
          * set ifunc, which sets the algorithm.
          */
@@ -264,6 +268,34 @@ void ImplicitSurfChem::solvePseudoSteadyStateProblem(int ifuncOverride,
     }
 }
 
+void ImplicitSurfChem::setSteadyStateJacobianType(const std::string& type)
+{
+    if (type != "analytic" && type != "finite-difference") {
+        throw CanteraError("ImplicitSurfChem::setSteadyStateJacobianType",
+                           "Unknown Jacobian type '" + type + "'");
+    }
+    m_surfJacobianType = type;
+    if (m_surfSolver) {
+        m_surfSolver->setJacobianType(type);
+    }
+}
+
+void ImplicitSurfChem::setSteadyStateReuseJacobian(bool reuse)
+{
+    m_surfReuseJacobian = reuse;
+    if (m_surfSolver) {
+        m_surfSolver->setReuseJacobian(reuse);
+    }
+}
+
+void ImplicitSurfChem::getSteadyStateSolverStats(
+    std::map<std::string, long int>& stats) const
+{
+    if (m_surfSolver) {
+        m_surfSolver->getSolverStats(stats);
+    }
+}
+
 void ImplicitSurfChem::getConcSpecies(doublereal* const vecConcSpecies) const
 {
     size_t kstart;
@@ -129,6 +129,7 @@ InterfaceKinetics& InterfaceKinetics::operator=(const InterfaceKinetics& right)
     m_rrxn                 = right.m_rrxn;
     m_prxn                 = right.m_prxn;
     reactionType_          = right.reactionType_;
+    reactionTypes_         = right.reactionTypes_;
     m_rxneqn               = right.m_rxneqn;
     m_conc                 = right.m_conc;
     m_actConc              = right.m_actConc;
@@ -145,6 +146,7 @@ InterfaceKinetics& InterfaceKinetics::operator=(const InterfaceKinetics& right)
     m_ctrxn                = right.m_ctrxn;
     m_ctrxn_BVform         = right.m_ctrxn_BVform;
     m_ctrxn_ecdf           = right.m_ctrxn_ecdf;
+    m_ctrxn_resistivity_   = right.m_ctrxn_resistivity_;
     m_StandardConc         = right.m_StandardConc;
     m_deltaG0              = right.m_deltaG0;
     m_deltaG               = right.m_deltaG;
@@ -156,11 +158,15 @@ InterfaceKinetics& InterfaceKinetics::operator=(const InterfaceKinetics& right)
     m_ropnet               = right.m_ropnet;
     m_ROP_ok               = right.m_ROP_ok;
     m_temp                 = right.m_temp;
+    m_phaseT               = right.m_phaseT;
+    m_phaseP               = right.m_phaseP;
     m_logtemp              = right.m_logtemp;
     m_rfn                  = right.m_rfn;
     m_rkcn                 = right.m_rkcn;
     m_finalized            = right.m_finalized;
     m_has_coverage_dependence = right.m_has_coverage_dependence;
+    m_fwdOrderSpecies      = right.m_fwdOrderSpecies;
+    m_fwdOrders            = right.m_fwdOrders;
     m_has_electrochem_rxns = right.m_has_electrochem_rxns;
     m_has_exchange_current_density_formulation = right.m_has_exchange_current_density_formulation;
     m_phaseExistsCheck     = right.m_phaseExistsCheck;
@@ -186,7 +192,7 @@ InterfaceKinetics& InterfaceKinetics::operator=(const InterfaceKinetics& right)
     m_ctrxn_ROPOrdersList_  = right.m_ctrxn_ROPOrdersList_;
     for (size_t i = 0; i <  m_ctrxn_ROPOrdersList_.size(); i++) {
 	RxnOrders* ro = right.m_ctrxn_ROPOrdersList_[i];
-	m_ctrxn_ROPOrdersList_[i] = new RxnOrders(*ro);
+	m_ctrxn_ROPOrdersList_[i] = ro ? new RxnOrders(*ro) : 0;
     }
 
     for (size_t i = 0; i <  m_ctrxn_FwdOrdersList_.size(); i++) {
@@ -195,7 +201,7 @@ InterfaceKinetics& InterfaceKinetics::operator=(const InterfaceKinetics& right)
     m_ctrxn_FwdOrdersList_  = right.m_ctrxn_FwdOrdersList_;
     for (size_t i = 0; i <  m_ctrxn_FwdOrdersList_.size(); i++) {
 	RxnOrders* ro = right.m_ctrxn_FwdOrdersList_[i];
-	m_ctrxn_FwdOrdersList_[i] = new RxnOrders(*ro);
+	m_ctrxn_FwdOrdersList_[i] = ro ? new RxnOrders(*ro) : 0;
     }
 
 
@@ -210,10 +216,19 @@ int InterfaceKinetics::type() const
 Kinetics* InterfaceKinetics::duplMyselfAsKinetics(const std::vector<thermo_t*> & tpVector) const
 {
     InterfaceKinetics* iK = new InterfaceKinetics(*this);
+    iK->m_integrator = 0;
     iK->assignShallowPointers(tpVector);
     return iK;
 }
 //============================================================================================================================
+void InterfaceKinetics::assignShallowPointers(const std::vector<thermo_t*> & tpVector)
+{
+    Kinetics::assignShallowPointers(tpVector);
+    if (m_surf) {
+        m_surf = (SurfPhase*)&thermo(reactionPhaseIndex());
+    }
+}
+//============================================================================================================================
 void InterfaceKinetics::setElectricPotential(int n, doublereal V)
 {
     thermo(n).setElectricPotential(V);
@@ -226,18 +241,32 @@ void InterfaceKinetics::_update_rates_T()
     // First task is update the electrical potentials from the Phases
     //
     _update_rates_phi();
-    if (m_has_coverage_dependence) {
-        m_surf->getCoverages(DATA_PTR(m_actConc));
-        m_rates.update_C(DATA_PTR(m_actConc));
+    //
+    // The standard chemical potentials depend on the temperature and
+    // pressure of each phase
+    //
+    for (size_t n = 0; n < nPhases(); n++) {
+        doublereal Tn = thermo(n).temperature();
+        doublereal Pn = thermo(n).pressure();
+        if (Tn != m_phaseT[n] || Pn != m_phaseP[n]) {
+            m_phaseT[n] = Tn;
+            m_phaseP[n] = Pn;
+            m_redo_rates = true;
+        }
+    }
+    if (m_has_electrochem_rxns || m_has_exchange_current_density_formulation) {
         m_redo_rates = true;
     }
     //
     // Go find the temperature from the surface
     //
     doublereal T = thermo(surfacePhaseIndex()).temperature();
-    m_redo_rates = true;
-    if (T != m_temp || m_redo_rates) {
-	
+    bool newT = (T != m_temp || m_redo_rates);
+    if (m_has_coverage_dependence) {
+        m_surf->getCoverages(DATA_PTR(m_actConc));
+        m_rates.update_C(DATA_PTR(m_actConc));
+    }
+    if (newT || m_has_coverage_dependence) {
         m_logtemp = log(T);
 	//
 	//  Calculate the forward rate constant by calling m_rates and store it in m_rfn[]
@@ -253,6 +282,9 @@ void InterfaceKinetics::_update_rates_T()
         if (m_has_electrochem_rxns) {
             applyVoltageKfwdCorrection(DATA_PTR(m_rfn));
         }
+        m_ROP_ok = false;
+    }
+    if (newT) {
         m_temp = T;
         updateKc();
         m_ROP_ok = false;
@@ -484,6 +516,83 @@ void InterfaceKinetics::getNetProductionRates(doublereal* net)
     m_rxnstoich.getNetProductionRates(m_kk, &m_ropnet[0], net);
 }
 //===========================================================================================================
+void InterfaceKinetics::getNetProductionRates_ddCov(doublereal* ddCov)
+{
+    updateROP();
+    size_t nsurf = m_surf->nSpecies();
+    size_t kstart = m_start[surfacePhaseIndex()];
+    m_ddCov_rop.assign(m_ii * nsurf, 0.0);
+
+    // Mass-action terms. The surface species are differentiated with
+    // respect to their concentrations, which are converted to coverages
+    // below. In the reverse direction, species with a stoichiometric
+    // coefficient of 2 are listed twice.
+    for (size_t i = 0; i < m_ii; i++) {
+        doublereal kf = m_rfn[i] * m_perturb[i];
+        const std::vector<size_t>& R = m_fwdOrderSpecies[i];
+        const vector_fp& order = m_fwdOrders[i];
+        for (size_t j = 0; j < R.size(); j++) {
+            if (R[j] < kstart || R[j] >= kstart + nsurf || order[j] == 0.0) {
+                continue;
+            }
+            doublereal C = m_actConc[R[j]];
+            if (order[j] < 1.0 && C <= 0.0) {
+                continue;
+            }
+            doublereal dq = kf * order[j];
+            if (order[j] != 1.0) {
+                dq *= pow(C, order[j] - 1.0);
+            }
+            for (size_t l = 0; l < R.size(); l++) {
+                if (l != j && order[l] != 0.0) {
+                    dq *= pow(m_actConc[R[l]], order[l]);
+                }
+            }
+            m_ddCov_rop[i + (R[j] - kstart)*m_ii] += dq;
+        }
+
+        doublereal kr = kf * m_rkcn[i];
+        if (kr == 0.0) {
+            continue;
+        }
+        const std::vector<size_t>& P = m_products[i];
+        for (size_t j = 0; j < P.size(); j++) {
+            if (P[j] < kstart || P[j] >= kstart + nsurf) {
+                continue;
+            }
+            doublereal dq = kr;
+            for (size_t l = 0; l < P.size(); l++) {
+                if (l != j) {
+                    dq *= m_actConc[P[l]];
+                }
+            }
+            m_ddCov_rop[i + (P[j] - kstart)*m_ii] -= dq;
+        }
+    }
+    for (size_t j = 0; j < nsurf; j++) {
+        doublereal dCdtheta = m_surf->standardConcentration(j);
+        for (size_t i = 0; i < m_ii; i++) {
+            m_ddCov_rop[i + j*m_ii] *= dCdtheta;
+        }
+    }
+
+    // Both the forward and reverse rates of progress are proportional to
+    // the coverage-dependent forward rate constant
+    if (m_has_coverage_dependence) {
+        m_ddCov_theta.resize(nsurf);
+        m_surf->getCoverages(DATA_PTR(m_ddCov_theta));
+        m_rates.addLogDerivatives_C(m_surf->temperature(),
+                                    DATA_PTR(m_ddCov_theta),
+                                    DATA_PTR(m_ropnet), m_ii,
+                                    DATA_PTR(m_ddCov_rop));
+    }
+
+    for (size_t j = 0; j < nsurf; j++) {
+        m_rxnstoich.getNetProductionRates(m_kk, &m_ddCov_rop[j*m_ii],
+                                          ddCov + j*m_kk);
+    }
+}
+//===========================================================================================================
 void InterfaceKinetics::applyVoltageKfwdCorrection(doublereal* const kf)
 {
     //
@@ -928,6 +1037,7 @@ void InterfaceKinetics::getDeltaSSEntropy(doublereal* deltaS)
 void InterfaceKinetics::addReaction(ReactionData& r)
 {
     int reactionType = r.reactionType;
+    m_redo_rates = true;
 
     reactionType_.push_back(reactionType);
 
@@ -1218,6 +1328,35 @@ void InterfaceKinetics::installReagents(const ReactionData& r)
      * of reactants for the rnum'th reaction
      */
     m_reactants.push_back(rk);
+
+    // Forward reaction orders, following ReactionStoichMgr::add(). Explicit
+    // orders are only used for global reactions and reactions with
+    // non-integer stoichiometric coefficients or more than three reactants.
+    std::vector<size_t> fk = r.reactants;
+    vector_fp forders = r.rstoich;
+    bool isfrac = false;
+    for (n = 0; n < nr; n++) {
+        if (r.rstoich[n] != floor(r.rstoich[n])) {
+            isfrac = true;
+        }
+    }
+    if (r.forwardFullOrder_.size() > 0 || isfrac || r.global ||
+        rk.size() > 3) {
+        forders = r.rorder;
+    }
+    for (size_t k = 0; k < r.forwardFullOrder_.size(); k++) {
+        doublereal of = r.forwardFullOrder_[k];
+        std::vector<size_t>::iterator loc = std::find(fk.begin(), fk.end(), k);
+        if (loc != fk.end()) {
+            forders[loc - fk.begin()] = of;
+        } else if (of != 0.0) {
+            fk.push_back(k);
+            forders.push_back(of);
+        }
+    }
+    m_fwdOrderSpecies.push_back(fk);
+    m_fwdOrders.push_back(forders);
+
     std::vector<size_t> pk;
     size_t np = r.products.size();
     for (n = 0; n < np; n++) {
@@ -1266,6 +1405,8 @@ void InterfaceKinetics::addPhase(thermo_t& thermo)
     Kinetics::addPhase(thermo);
     m_phaseExists.push_back(true);
     m_phaseIsStable.push_back(true);
+    m_phaseT.push_back(0.0);
+    m_phaseP.push_back(0.0);
 }
 //==================================================================================================================
 void InterfaceKinetics::init()
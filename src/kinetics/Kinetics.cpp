@@ -289,4 +289,63 @@ void Kinetics::finalize()
     }
 }
 
+void Kinetics::getNetProductionRates_ddC(doublereal* ddC)
+{
+    size_t nsp = nTotalSpecies();
+    m_ddC_work.resize(nsp + 2*nReactions());
+    double* conc = &m_ddC_work[0];
+    double* kfwd = conc + nsp;
+    double* krev = kfwd + nReactions();
+    for (size_t n = 0; n < nPhases(); n++) {
+        thermo(n).getActivityConcentrations(conc + m_start[n]);
+    }
+    getFwdRateConstants(kfwd);
+    getRevRateConstants(krev);
+    std::fill(ddC, ddC + nsp*nsp, 0.0);
+
+    for (size_t i = 0; i < nReactions(); i++) {
+        const std::vector<size_t>& R = m_reactants[i];
+        const std::vector<size_t>& P = m_products[i];
+
+        // Derivative of the forward rate of progress with respect to each
+        // occurrence of a reactant in the list of reactants. Species with a
+        // stoichiometric coefficient of 2 are listed twice.
+        for (size_t j = 0; j < R.size(); j++) {
+            double dq = kfwd[i];
+            for (size_t l = 0; l < R.size(); l++) {
+                if (l != j) {
+                    dq *= conc[R[l]];
+                }
+            }
+            double* col = ddC + R[j]*nsp;
+            for (size_t l = 0; l < R.size(); l++) {
+                col[R[l]] -= dq;
+            }
+            for (size_t l = 0; l < P.size(); l++) {
+                col[P[l]] += dq;
+            }
+        }
+
+        // Derivatives of the reverse rate of progress
+        if (krev[i] == 0.0) {
+            continue;
+        }
+        for (size_t j = 0; j < P.size(); j++) {
+            double dq = krev[i];
+            for (size_t l = 0; l < P.size(); l++) {
+                if (l != j) {
+                    dq *= conc[P[l]];
+                }
+            }
+            double* col = ddC + P[j]*nsp;
+            for (size_t l = 0; l < R.size(); l++) {
+                col[R[l]] += dq;
+            }
+            for (size_t l = 0; l < P.size(); l++) {
+                col[P[l]] -= dq;
+            }
+        }
+    }
+}
+
 }
@@ -42,6 +42,13 @@ solveSP::solveSP(ImplicitSurfChem* surfChemPtr, int bulkFunc) :
     m_rtol(1.0E-4),
     m_maxstep(1000),
     m_maxTotSpecies(0),
+    m_analyticJac(true),
+    m_analyticJacOK(true),
+    m_reuseJac(false),
+    m_JacFactored(false),
+    m_nIterations(0),
+    m_nResidEvals(0),
+    m_nJacEvals(0),
     m_ioflag(0)
 {
     m_numSurfPhases = 0;
@@ -89,6 +96,24 @@ solveSP::solveSP(ImplicitSurfChem* surfChemPtr, int bulkFunc) :
     }
     m_maxTotSpecies = std::max(m_maxTotSpecies, m_neq);
 
+    // The analytic Jacobian only includes the dependence of the rates of
+    // each InterfaceKinetics object on the species of its own surface phase
+    size_t maxSurfSpecies = 0;
+    for (size_t n = 0; n < m_numSurfPhases; n++) {
+        InterfaceKinetics* kin = m_objects[n];
+        for (size_t iph = 0; iph < kin->nPhases(); iph++) {
+            if (iph == kin->surfacePhaseIndex()) {
+                continue;
+            }
+            for (size_t m = 0; m < m_numSurfPhases; m++) {
+                if (&kin->thermo(iph) == m_ptrsSurfPhase[m]) {
+                    m_analyticJacOK = false;
+                }
+            }
+        }
+        maxSurfSpecies = std::max(maxSurfSpecies, m_nSpeciesSurfPhase[n]);
+    }
+    m_ddCov.resize(m_maxTotSpecies * maxSurfSpecies, 0.0);
 
     m_netProductionRatesSave.resize(m_maxTotSpecies, 0.0);
     m_numEqn1.resize(m_maxTotSpecies, 0.0);
@@ -132,6 +157,26 @@ solveSP::~solveSP()
 {
 }
 
+void solveSP::setJacobianType(const std::string& type)
+{
+    if (type == "analytic") {
+        m_analyticJac = true;
+    } else if (type == "finite-difference") {
+        m_analyticJac = false;
+    } else {
+        throw CanteraError("solveSP::setJacobianType",
+                           "Unknown Jacobian type '" + type + "'");
+    }
+    m_JacFactored = false;
+}
+
+void solveSP::getSolverStats(std::map<std::string, long int>& stats) const
+{
+    stats["iterations"] = m_nIterations;
+    stats["resid_evals"] = m_nResidEvals;
+    stats["jac_evals"] = m_nJacEvals;
+}
+
 int solveSP::solveSurfProb(int ifunc, doublereal time_scale, doublereal TKelvin,
                            doublereal PGas, doublereal reltol, doublereal abstol)
 {
@@ -151,6 +196,11 @@ int solveSP::solveSurfProb(int ifunc, doublereal time_scale, doublereal TKelvin,
     //  Weighted L2 norm of the residual.  Currently, this is only
     //  used for IO purposes. It doesn't control convergence.
     doublereal  resid_norm;
+    // Residual norm of the previous iteration, used to decide whether a
+    // reused Jacobian is still good enough
+    doublereal resid_norm_old = 0.0;
+    bool refreshJac = false;
+    bool weightsSet = false;
     doublereal inv_t = 0.0;
     doublereal t_real = 0.0, update_norm = 1.0E6;
 
@@ -202,6 +252,7 @@ int solveSP::solveSurfProb(int ifunc, doublereal time_scale, doublereal TKelvin,
      */
     while (not_converged && iter < iter_max) {
         iter++;
+        m_nIterations++;
         /*
          *    Store previous iteration's solution in the old solution vector
          */
@@ -253,19 +304,37 @@ int solveSP::solveSurfProb(int ifunc, doublereal time_scale, doublereal TKelvin,
         deltaT = 1.0/inv_t;
 
         /*
-         * Call the routine to numerically evaluation the jacobian
-         * and residual for the current iteration.
+         * Decide whether the factored Jacobian from a previous steady-state
+         * iteration can be used for this iteration.
          */
-        resjac_eval(m_Jac, DATA_PTR(m_resid), DATA_PTR(m_CSolnSP),
-                    DATA_PTR(m_CSolnSPOld), do_time, deltaT);
+        bool reuse = m_reuseJac && m_JacFactored && !do_time && !refreshJac;
+        if (!reuse) {
+            m_JacFactored = false;
+        }
 
         /*
-         * Calculate the weights. Make sure the calculation is carried
-         * out on the first iteration.
+         * Call the routine to evaluate the jacobian and residual for the
+         * current iteration, or just the residual if the Jacobian is
+         * reused.
          */
-        if (iter%4 == 1) {
-            calcWeights(DATA_PTR(m_wtSpecies), DATA_PTR(m_wtResid),
-                        m_Jac, DATA_PTR(m_CSolnSP), abstol, reltol);
+        if (reuse) {
+            fun_eval(DATA_PTR(m_resid), DATA_PTR(m_CSolnSP),
+                     DATA_PTR(m_CSolnSPOld), do_time, deltaT);
+        } else {
+            resjac_eval(m_Jac, DATA_PTR(m_resid), DATA_PTR(m_CSolnSP),
+                        DATA_PTR(m_CSolnSPOld), do_time, deltaT);
+
+            /*
+             * Calculate the weights. Make sure the calculation is carried
+             * out on the first iteration which evaluates the Jacobian. The
+             * weights from previous calls are kept while the Jacobian is
+             * reused.
+             */
+            if (iter%4 == 1 || !weightsSet) {
+                calcWeights(DATA_PTR(m_wtSpecies), DATA_PTR(m_wtResid),
+                            m_Jac, DATA_PTR(m_CSolnSP), abstol, reltol);
+                weightsSet = true;
+            }
         }
 
         /*
@@ -274,10 +343,23 @@ int solveSP::solveSurfProb(int ifunc, doublereal time_scale, doublereal TKelvin,
         resid_norm = calcWeightedNorm(DATA_PTR(m_wtResid),
                                       DATA_PTR(m_resid), m_neq);
 
+        /*
+         * If the reused Jacobian didn't reduce the residual enough in the
+         * last iteration, evaluate it in the next one.
+         */
+        refreshJac = (reuse && resid_norm_old > 0.0 &&
+                      resid_norm > 0.5 * resid_norm_old);
+        resid_norm_old = resid_norm;
+
         /*
          *  Solve Linear system.  The solution is in resid[]
          */
-        info = m_Jac.factor();
+        if (reuse) {
+            info = 0;
+        } else {
+            info = m_Jac.factor();
+            m_JacFactored = (info == 0 && !do_time);
+        }
         if (info==0) {
             m_Jac.solve(&m_resid[0]);
         }
@@ -454,6 +536,7 @@ void solveSP::fun_eval(doublereal* resid, const doublereal* CSoln,
     doublereal lenScale = 1.0E-9;
     doublereal sd = 0.0;
     doublereal grRate;
+    m_nResidEvals++;
     if (m_numSurfPhases > 0) {
         /*
          * update the surface concentrations with the input surface
@@ -569,6 +652,11 @@ void solveSP::resjac_eval(SquareMatrix& jac,
      * Calculate the residual
      */
     fun_eval(resid, CSoln, CSolnOld, do_time, deltaT);
+    m_nJacEvals++;
+    if (m_analyticJac && m_analyticJacOK && m_bulkFunc != BULK_DEPOSITION) {
+        analyticJacobian(jac, do_time, deltaT);
+        return;
+    }
     /*
      * Now we will look over the columns perturbing each unknown.
      */
@@ -607,6 +695,37 @@ void solveSP::resjac_eval(SquareMatrix& jac,
     }
 }
 
+void solveSP::analyticJacobian(SquareMatrix& jac, const bool do_time,
+                               const doublereal deltaT)
+{
+    jac.zero();
+    for (size_t isp = 0; isp < m_numSurfPhases; isp++) {
+        size_t nsp = m_nSpeciesSurfPhase[isp];
+        InterfaceKinetics* kinPtr = m_objects[isp];
+        SurfPhase* surf = m_ptrsSurfPhase[isp];
+        size_t kstart = kinPtr->kineticsSpeciesIndex(0,
+                        kinPtr->surfacePhaseIndex());
+        size_t nkin = kinPtr->nTotalSpecies();
+        size_t kins = m_eqnIndexStartSolnPhase[isp];
+        size_t kspecial = kins + m_spSurfLarge[isp];
+        kinPtr->getNetProductionRates_ddCov(DATA_PTR(m_ddCov));
+
+        // The unknowns are the surface concentrations, C_j = theta_j * C0_j,
+        // where C0_j is the standard concentration.
+        for (size_t j = 0; j < nsp; j++) {
+            doublereal dthetadC = 1.0 / surf->standardConcentration(j);
+            for (size_t k = 0; k < nsp; k++) {
+                jac(kins + k, kins + j) =
+                    - m_ddCov[kstart + k + j*nkin] * dthetadC;
+            }
+            if (do_time) {
+                jac(kins + j, kins + j) += 1.0 / deltaT;
+            }
+            jac(kspecial, kins + j) = -1.0;
+        }
+    }
+}
+
 /*!
  * This function calculates a damping factor for the Newton iteration update
  * vector, dxneg, to insure that all site and bulk fractions, x, remain
@@ -286,6 +286,29 @@ int BandMatrix::solve(doublereal* b, size_t nrhs, size_t ldb)
     return info;
 }
 
+int BandMatrix::solveTranspose(doublereal* b, size_t nrhs, size_t ldb)
+{
+    int info = 0;
+    if (!m_factored) {
+        info = factor();
+    }
+    if (ldb == 0) {
+        ldb = nColumns();
+    }
+    if (info == 0)
+        ct_dgbtrs(ctlapack::Transpose, nColumns(), nSubDiagonals(),
+                  nSuperDiagonals(), nrhs, DATA_PTR(ludata), ldim(),
+                  DATA_PTR(ipiv()), b, ldb, info);
+
+    // error handling
+    if (info != 0) {
+        ofstream fout("bandmatrix.csv");
+        fout << *this << endl;
+        fout.close();
+    }
+    return info;
+}
+
 vector_fp::iterator  BandMatrix::begin()
 {
     m_factored = false;
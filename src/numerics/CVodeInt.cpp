@@ -18,6 +18,9 @@ using namespace std;
 
 #include "cantera/base/stringUtils.h"
 
+#include <iostream>
+#include <cfloat>
+
 extern "C" {
 
     /**
@@ -39,14 +42,12 @@ extern "C" {
     }
 
     /**
-     *  Function called by cvode to evaluate the Jacobian matrix.
-     *  (temporary)
+     *  Compute a finite difference approximation to the Jacobian matrix.
      *  @ingroup odeGroup
      */
-    static void cvode_jac(integer N, DenseMat J, RhsFn f, void* f_data,
-                          real t, N_Vector y, N_Vector fy, N_Vector ewt, real h, real uround,
-                          void* jac_data, long int* nfePtr, N_Vector vtemp1, N_Vector vtemp2,
-                          N_Vector vtemp3)
+    static void cvode_fd_jac(integer N, DenseMat J, Cantera::FuncEval* func,
+                             real t, N_Vector y, N_Vector fy, N_Vector ewt,
+                             N_Vector vtemp1)
     {
         // get pointers to start of data
         double* ydata = N_VDATA(y);
@@ -54,8 +55,6 @@ extern "C" {
         double* ewtdata = N_VDATA(ewt);
         double* ydot = N_VDATA(vtemp1);
 
-        Cantera::FuncEval* func = (Cantera::FuncEval*)f_data;
-
         int i,j;
         double* col_j;
         double ysave, dy;
@@ -65,13 +64,108 @@ extern "C" {
             dy = 1.0/ewtdata[j];
             ydata[j] = ysave + dy;
             dy = ydata[j] - ysave;
-            func->eval(t, ydata, ydot, NULL);
+            try {
+                func->eval(t, ydata, ydot, NULL);
+            } catch (...) {
+                // y is owned by cvode, so it must be left unchanged
+                ydata[j] = ysave;
+                throw;
+            }
             for (i=0; i < N; i++) {
                 col_j[i] = (ydot[i] - fydata[i])/dy;
             }
             ydata[j] = ysave;
         }
     }
+
+    /**
+     *  Function called by cvode to evaluate the Jacobian matrix. If the
+     *  FuncEval object provides the Jacobian, it is used, with `jac_data`
+     *  pointing to an Array2D used as work space. Otherwise, or if the
+     *  evaluation fails, a finite difference approximation is used. Since
+     *  cvode does not allow this function to report errors, exceptions are
+     *  caught here.
+     *  @ingroup odeGroup
+     */
+    static void cvode_jac(integer N, DenseMat J, RhsFn f, void* f_data,
+                          real t, N_Vector y, N_Vector fy, N_Vector ewt, real h, real uround,
+                          void* jac_data, long int* nfePtr, N_Vector vtemp1, N_Vector vtemp2,
+                          N_Vector vtemp3)
+    {
+        Cantera::FuncEval* func = (Cantera::FuncEval*)f_data;
+        try {
+            if (func->hasJacobian()) {
+                Cantera::Array2D& jac = *(Cantera::Array2D*)jac_data;
+                func->getJacobian(t, N_VDATA(y), N_VDATA(fy), NULL, jac);
+                for (integer j = 0; j < N; j++) {
+                    std::copy(jac.ptrColumn(j), jac.ptrColumn(j) + N,
+                              (J->data)[j]);
+                }
+                return;
+            }
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+        } catch (...) {
+            std::cerr << "cvode_jac: unhandled exception" << std::endl;
+        }
+
+        try {
+            cvode_fd_jac(N, J, func, t, y, fy, ewt, vtemp1);
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+        } catch (...) {
+            std::cerr << "cvode_jac: unhandled exception" << std::endl;
+        }
+    }
+
+    /**
+     *  Function called by cvode to set up the preconditioner for the GMRES
+     *  linear solver, which is provided by the FuncEval object.
+     *  @ingroup odeGroup
+     */
+    static int cvode_prec_setup(integer N, real t, N_Vector y, N_Vector fy,
+                                boole jok, boole* jcurPtr, real gamma,
+                                N_Vector ewt, real h, real uround,
+                                long int* nfePtr, void* P_data,
+                                N_Vector vtemp1, N_Vector vtemp2,
+                                N_Vector vtemp3)
+    {
+        try {
+            Cantera::FuncEval* f = (Cantera::FuncEval*)P_data;
+            *jcurPtr = f->preconditionerSetup(t, N_VDATA(y), N_VDATA(fy),
+                                              gamma, jok != 0);
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1; // possibly recoverable error
+        } catch (...) {
+            std::cerr << "cvode_prec_setup: unhandled exception" << std::endl;
+            return -1; // unrecoverable error
+        }
+        return 0;
+    }
+
+    /**
+     *  Function called by cvode to solve the preconditioner system P z = r
+     *  for the GMRES linear solver.
+     *  @ingroup odeGroup
+     */
+    static int cvode_prec_solve(integer N, real t, N_Vector y, N_Vector fy,
+                                N_Vector vtemp, real gamma, N_Vector ewt,
+                                real delta, long int* nfePtr, N_Vector r,
+                                int lr, void* P_data, N_Vector z)
+    {
+        try {
+            Cantera::FuncEval* f = (Cantera::FuncEval*)P_data;
+            f->preconditionerSolve(N_VDATA(r), N_VDATA(z));
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1; // possibly recoverable error
+        } catch (...) {
+            std::cerr << "cvode_prec_solve: unhandled exception" << std::endl;
+            return -1; // unrecoverable error
+        }
+        return 0;
+    }
 }
 
 namespace Cantera
@@ -90,7 +184,13 @@ CVodeInt::CVodeInt() : m_neq(0),
     m_abstols(1.e-15),
     m_nabs(0),
     m_hmax(0.0),
-    m_maxsteps(20000)
+    m_maxsteps(20000),
+    m_time(0.0),
+    m_nroots(0),
+    m_tlo(0.0),
+    m_tstep(0.0),
+    m_rootFound(false),
+    m_ywork(0)
 {
     m_ropt.resize(OPT_SIZE,0.0);
     m_iopt = new long[OPT_SIZE];
@@ -108,6 +208,9 @@ CVodeInt::~CVodeInt()
     if (m_abstol) {
         N_VFree(m_abstol);
     }
+    if (m_ywork) {
+        N_VFree(m_ywork);
+    }
     delete[] m_iopt;
 }
 
@@ -230,19 +333,8 @@ void CVodeInt::initialize(double t0, FuncEval& func)
     if (!m_cvode_mem) {
         throw CVodeErr("CVodeMalloc failed.");
     }
-
-    if (m_type == DENSE + NOJAC) {
-        CVDense(m_cvode_mem, NULL, NULL);
-    } else if (m_type == DENSE + JAC) {
-        CVDense(m_cvode_mem, cvode_jac, NULL);
-    } else if (m_type == DIAG) {
-        CVDiag(m_cvode_mem);
-    } else if (m_type == GMRES) {
-        CVSpgmr(m_cvode_mem, NONE, MODIFIED_GS, 0, 0.0,
-                NULL, NULL, NULL);
-    } else {
-        throw CVodeErr("unsupported option");
-    }
+    setLinearSolver();
+    initRoots(func);
 }
 
 void CVodeInt::reinitialize(double t0, FuncEval& func)
@@ -273,16 +365,48 @@ void CVodeInt::reinitialize(double t0, FuncEval& func)
     if (result != 0) {
         throw CVodeErr("CVReInit failed.");
     }
+    setLinearSolver();
+    initRoots(func);
+}
+
+void CVodeInt::initRoots(FuncEval& func)
+{
+    m_time = m_t0;
+    m_tlo = m_t0;
+    m_tstep = m_t0;
+    m_rootFound = false;
+    m_nroots = func.nRootFunctions();
+    m_rootInfo.assign(m_nroots, 0);
+    if (m_ywork) {
+        N_VFree(m_ywork);
+    }
+    m_ywork = N_VNew(m_neq, 0);
+    if (m_nroots) {
+        m_glo.resize(m_nroots);
+        m_gwork.resize(m_nroots);
+        func.evalRootFunctions(m_t0, N_VDATA(m_y), &m_glo[0]);
+        m_gstep = m_glo;
+    }
+}
 
+void CVodeInt::setLinearSolver()
+{
     if (m_type == DENSE + NOJAC) {
         CVDense(m_cvode_mem, NULL, NULL);
     } else if (m_type == DENSE + JAC) {
-        CVDense(m_cvode_mem, cvode_jac, NULL);
+        m_jac.resize(m_neq, m_neq);
+        CVDense(m_cvode_mem, cvode_jac, &m_jac);
     } else if (m_type == DIAG) {
         CVDiag(m_cvode_mem);
     } else if (m_type == GMRES) {
-        CVSpgmr(m_cvode_mem, NONE, MODIFIED_GS, 0, 0.0,
-                NULL, NULL, NULL);
+        FuncEval* func = (FuncEval*) m_data;
+        if (func->hasPreconditioner()) {
+            CVSpgmr(m_cvode_mem, LEFT, MODIFIED_GS, 0, 0.0,
+                    cvode_prec_setup, cvode_prec_solve, m_data);
+        } else {
+            CVSpgmr(m_cvode_mem, NONE, MODIFIED_GS, 0, 0.0,
+                    NULL, NULL, NULL);
+        }
     } else {
         throw CVodeErr("unsupported option");
     }
@@ -292,9 +416,43 @@ void CVodeInt::integrate(double tout)
 {
     double t;
     int flag;
-    flag = CVode(m_cvode_mem, tout, m_y, &t, NORMAL);
-    if (flag != SUCCESS) {
-        throw CVodeErr(" CVode error encountered. Error code: " + int2str(flag));
+    if (m_nroots == 0) {
+        flag = CVode(m_cvode_mem, tout, m_y, &t, NORMAL);
+        if (flag != SUCCESS) {
+            throw CVodeErr(" CVode error encountered. Error code: " + int2str(flag));
+        }
+        m_time = tout;
+        return;
+    }
+
+    m_rootFound = false;
+    m_rootInfo.assign(m_nroots, 0);
+    for (int nsteps = 0; ; nsteps++) {
+        // Check the part of the last internal step before tout which has
+        // not been checked for roots yet
+        double tend = std::min(m_tstep, tout);
+        if (tend > m_tlo) {
+            if (tend == m_tstep) {
+                m_gwork = m_gstep;
+            } else {
+                evalRoots(tend, &m_gwork[0]);
+            }
+            if (checkRoots(tend, m_gwork)) {
+                return;
+            }
+            m_tlo = tend;
+            m_glo = m_gwork;
+        }
+        if (m_tstep >= tout) {
+            CVodeDky(m_cvode_mem, tout, 0, m_y);
+            m_time = tout;
+            return;
+        }
+        if (nsteps >= m_maxsteps) {
+            throw CVodeErr(" CVode error encountered. Too many steps taken "
+                           "before reaching tout = " + fp2str(tout));
+        }
+        stepWithRoots(tout);
     }
 }
 
@@ -302,15 +460,154 @@ double CVodeInt::step(double tout)
 {
     double t;
     int flag;
-    flag = CVode(m_cvode_mem, tout, m_y, &t, ONE_STEP);
+    if (m_nroots == 0) {
+        flag = CVode(m_cvode_mem, tout, m_y, &t, ONE_STEP);
+        if (flag != SUCCESS) {
+            throw CVodeErr(" CVode error encountered. Error code: " + int2str(flag));
+        }
+        m_time = t;
+        return t;
+    }
+
+    m_rootFound = false;
+    m_rootInfo.assign(m_nroots, 0);
+    if (m_tstep <= m_tlo) {
+        // The last step has been checked completely, so take a new one
+        stepWithRoots(tout);
+    }
+    if (checkRoots(m_tstep, m_gstep)) {
+        return m_time;
+    }
+    m_tlo = m_tstep;
+    m_glo = m_gstep;
+    CVodeDky(m_cvode_mem, m_tstep, 0, m_y);
+    m_time = m_tstep;
+    return m_time;
+}
+
+void CVodeInt::stepWithRoots(double tout)
+{
+    double t;
+    int flag = CVode(m_cvode_mem, tout, m_y, &t, ONE_STEP);
     if (flag != SUCCESS) {
         throw CVodeErr(" CVode error encountered. Error code: " + int2str(flag));
     }
-    return t;
+    m_tstep = t;
+    m_time = t;
+    FuncEval* func = (FuncEval*) m_data;
+    func->evalRootFunctions(t, N_VDATA(m_y), &m_gstep[0]);
+}
+
+double CVodeInt::internalTime() const
+{
+    return m_ropt[TCUR];
+}
+
+void CVodeInt::getDky(double t, int k, double* dky)
+{
+    int flag = CVodeDky(m_cvode_mem, t, k, m_ywork);
+    if (flag != OKAY) {
+        throw CVodeErr(" CVodeDky failed for t = " + fp2str(t) + ", k = " +
+                       int2str(k) + ". Error code: " + int2str(flag));
+    }
+    copy(N_VDATA(m_ywork), N_VDATA(m_ywork) + m_neq, dky);
+}
+
+void CVodeInt::evalRoots(double t, double* g)
+{
+    CVodeDky(m_cvode_mem, t, 0, m_ywork);
+    FuncEval* func = (FuncEval*) m_data;
+    func->evalRootFunctions(t, N_VDATA(m_ywork), g);
+}
+
+//! True if the root function changes sign from *a* to *b*
+static bool signChange(double a, double b)
+{
+    return (a < 0 && b >= 0) || (a > 0 && b <= 0);
+}
+
+bool CVodeInt::checkRoots(double thi, const vector_fp& ghi)
+{
+    bool found = false;
+    for (size_t i = 0; i < m_nroots; i++) {
+        found = found || signChange(m_glo[i], ghi[i]);
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Illinois algorithm: the bracket [tlo, thi] is narrowed using the
+    // secant estimate of the earliest root, and the values at an endpoint
+    // which is retained twice in a row are halved to ensure convergence.
+    double tlo = m_tlo;
+    vector_fp glo = m_glo, gh = ghi, gmid(m_nroots);
+    double wlo = 1.0, whi = 1.0;
+    int last = 0;
+    double tol = 100 * DBL_EPSILON * (fabs(thi) + fabs(thi - tlo));
+    for (int iter = 0; iter < 100 && thi - tlo > tol; iter++) {
+        double tmid = thi;
+        for (size_t i = 0; i < m_nroots; i++) {
+            if (signChange(glo[i], gh[i])) {
+                double a = wlo * glo[i];
+                double b = whi * gh[i];
+                tmid = std::min(tmid, tlo + (thi - tlo) * a / (a - b));
+            }
+        }
+        tmid = std::max(tlo + 0.5 * tol, std::min(thi - 0.5 * tol, tmid));
+        evalRoots(tmid, &gmid[0]);
+        bool lower = false;
+        for (size_t i = 0; i < m_nroots; i++) {
+            lower = lower || signChange(glo[i], gmid[i]);
+        }
+        if (lower) {
+            thi = tmid;
+            gh = gmid;
+            whi = 1.0;
+            wlo = (last == -1) ? 0.5 * wlo : 1.0;
+            last = -1;
+        } else {
+            tlo = tmid;
+            glo = gmid;
+            wlo = 1.0;
+            whi = (last == 1) ? 0.5 * whi : 1.0;
+            last = 1;
+        }
+    }
+
+    // Stop at the end of the bracket, where the sign has already changed
+    for (size_t i = 0; i < m_nroots; i++) {
+        if (signChange(glo[i], gh[i])) {
+            m_rootInfo[i] = (gh[i] > glo[i]) ? 1 : -1;
+        }
+    }
+    CVodeDky(m_cvode_mem, thi, 0, m_y);
+    m_time = thi;
+    m_tlo = thi;
+    m_glo = gh;
+    m_rootFound = true;
+    return true;
 }
 
 int CVodeInt::nEvals() const
 {
     return m_iopt[NFE];
 }
+
+void CVodeInt::getSolverStats(std::map<std::string, long int>& stats) const
+{
+    stats["steps"] = m_iopt[NST];
+    stats["rhs_evals"] = m_iopt[NFE];
+    stats["lin_solve_setups"] = m_iopt[NSETUPS];
+    stats["err_test_fails"] = m_iopt[NETF];
+    stats["nonlinear_iters"] = m_iopt[NNI];
+    stats["nonlinear_conv_fails"] = m_iopt[NCFN];
+    if (m_type == DENSE + NOJAC || m_type == DENSE + JAC) {
+        stats["jac_evals"] = m_iopt[DENSE_NJE];
+    } else if (m_type == GMRES) {
+        stats["lin_iters"] = m_iopt[SPGMR_NLI];
+        stats["lin_conv_fails"] = m_iopt[SPGMR_NCFL];
+        stats["prec_evals"] = m_iopt[SPGMR_NPE];
+        stats["prec_solves"] = m_iopt[SPGMR_NPS];
+    }
+}
 }
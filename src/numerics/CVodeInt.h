@@ -10,6 +10,7 @@
 #include "cantera/numerics/FuncEval.h"
 #include "cantera/base/ctexceptions.h"
 #include "cantera/base/ct_defs.h"
+#include "cantera/base/Array.h"
 #include "../../ext/cvode/include/nvector.h"
 
 namespace Cantera
@@ -49,6 +50,17 @@ public:
     virtual doublereal step(double tout);
     virtual double& solution(size_t k);
     virtual double* solution();
+    virtual doublereal currentTime() const {
+        return m_time;
+    }
+    virtual doublereal internalTime() const;
+    virtual bool rootFound() const {
+        return m_rootFound;
+    }
+    virtual void getRootInfo(std::vector<int>& info) const {
+        info = m_rootInfo;
+    }
+    virtual void getDky(double t, int k, double* dky);
     virtual int nEquations() const {
         return m_neq;
     }
@@ -62,8 +74,31 @@ public:
     virtual void setMinStepSize(double hmin);
     virtual void setMaxSteps(int nmax);
     virtual void setMaxErrTestFails(int nmax) {}
+    virtual void getSolverStats(std::map<std::string, long int>& stats) const;
 
 private:
+    //! Attach the linear solver to the cvode memory block
+    void setLinearSolver();
+
+    //! Initialize the root functions at the initial time
+    void initRoots(FuncEval& func);
+
+    //! Take one internal step and evaluate the root functions at the end of
+    //! the step
+    void stepWithRoots(double tout);
+
+    //! Evaluate the root functions at time *t* within the last internal
+    //! step, using the interpolating polynomial for the solution.
+    void evalRoots(double t, double* g);
+
+    //! Check the interval from #m_tlo to *thi* for roots of the root
+    //! functions, where the root functions have the values #m_glo and
+    //! *ghi*. If a root is found, it is located using the Illinois
+    //! algorithm and the solution is interpolated to the time at which the
+    //! first root function changes sign.
+    //! @returns true if a root was found
+    bool checkRoots(double thi, const vector_fp& ghi);
+
     int m_neq;
     void* m_cvode_mem;
     double m_t0;
@@ -82,6 +117,41 @@ private:
     vector_fp m_ropt;
     long int* m_iopt;
     void* m_data;
+
+    //! Work space for the Jacobian when it is provided by the FuncEval object
+    Array2D m_jac;
+
+    //! Time corresponding to the current value of #m_y
+    double m_time;
+
+    //! Number of root functions. The bundled version of cvode does not
+    //! provide root finding, so roots are found by checking for sign changes
+    //! of the root functions after each internal step.
+    size_t m_nroots;
+
+    //! Start of the interval which has not yet been checked for roots
+    double m_tlo;
+
+    //! Root functions evaluated at #m_tlo
+    vector_fp m_glo;
+
+    //! Time reached by the last internal step of the integrator
+    double m_tstep;
+
+    //! Root functions evaluated at #m_tstep
+    vector_fp m_gstep;
+
+    //! Work space for the root functions
+    vector_fp m_gwork;
+
+    //! True if the last call to integrate() or step() stopped at a root
+    bool m_rootFound;
+
+    //! Roots found in the last call to integrate() or step()
+    std::vector<int> m_rootInfo;
+
+    //! Work space for the interpolated solution and its derivatives
+    N_Vector m_ywork;
 };
 
 }    // namespace
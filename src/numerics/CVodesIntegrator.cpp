@@ -5,6 +5,7 @@
 // Copyright 2001  California Institute of Technology
 #include "cantera/numerics/CVodesIntegrator.h"
 #include "cantera/base/stringUtils.h"
+#include "cantera/base/Array.h"
 
 #include <iostream>
 using namespace std;
@@ -42,6 +43,13 @@ public:
     virtual ~FuncData() {}
     vector_fp m_pars;
     FuncEval* m_func;
+
+    //! Work space for the Jacobian provided by #m_func
+    Array2D m_jac;
+
+    //! Work space for the right-hand side of the forward problem, used by
+    //! the Jacobian of the backward problem
+    vector_fp m_ydot;
 };
 
 extern "C" {
@@ -78,6 +86,274 @@ extern "C" {
         return 0; // successful evaluation
     }
 
+    /**
+     *  Function called by CVodes to evaluate the Jacobian for the dense
+     *  linear solver, which is provided by the FuncEval object.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_jac(long int N, realtype t, N_Vector y, N_Vector fy,
+                          DlsMat J, void* f_data, N_Vector tmp1,
+                          N_Vector tmp2, N_Vector tmp3)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            double* p = d->m_pars.empty() ? NULL : DATA_PTR(d->m_pars);
+            d->m_func->getJacobian(t, NV_DATA_S(y), NV_DATA_S(fy), p, d->m_jac);
+            for (long int j = 0; j < N; j++) {
+                std::copy(d->m_jac.ptrColumn(j), d->m_jac.ptrColumn(j) + N,
+                          DENSE_COL(J, j));
+            }
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1; // possibly recoverable error
+        } catch (...) {
+            std::cerr << "cvodes_jac: unhandled exception" << std::endl;
+            return -1; // unrecoverable error
+        }
+        return 0;
+    }
+
+    /**
+     *  Function called by CVodes to evaluate the Jacobian for the banded
+     *  linear solver, which is provided by the FuncEval object. Only the
+     *  elements within the band are used.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_band_jac(long int N, long int mupper, long int mlower,
+                               realtype t, N_Vector y, N_Vector fy, DlsMat J,
+                               void* f_data, N_Vector tmp1, N_Vector tmp2,
+                               N_Vector tmp3)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            double* p = d->m_pars.empty() ? NULL : DATA_PTR(d->m_pars);
+            d->m_func->getJacobian(t, NV_DATA_S(y), NV_DATA_S(fy), p, d->m_jac);
+            for (long int j = 0; j < N; j++) {
+                realtype* col = BAND_COL(J, j);
+                long int imin = std::max<long int>(0, j - mupper);
+                long int imax = std::min<long int>(N - 1, j + mlower);
+                for (long int i = imin; i <= imax; i++) {
+                    BAND_COL_ELEM(col, i, j) = d->m_jac(i, j);
+                }
+            }
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1; // possibly recoverable error
+        } catch (...) {
+            std::cerr << "cvodes_band_jac: unhandled exception" << std::endl;
+            return -1; // unrecoverable error
+        }
+        return 0;
+    }
+
+    /**
+     *  Function called by CVodes to set up the preconditioner for the GMRES
+     *  linear solver, which is provided by the FuncEval object.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_prec_setup(realtype t, N_Vector y, N_Vector fy,
+                                 booleantype jok, booleantype* jcurPtr,
+                                 realtype gamma, void* f_data,
+                                 N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            *jcurPtr = d->m_func->preconditionerSetup(t, NV_DATA_S(y),
+                           NV_DATA_S(fy), gamma, jok != 0);
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1; // possibly recoverable error
+        } catch (...) {
+            std::cerr << "cvodes_prec_setup: unhandled exception" << std::endl;
+            return -1; // unrecoverable error
+        }
+        return 0;
+    }
+
+    /**
+     *  Function called by CVodes to solve the preconditioner system P z = r
+     *  for the GMRES linear solver.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_prec_solve(realtype t, N_Vector y, N_Vector fy,
+                                 N_Vector r, N_Vector z, realtype gamma,
+                                 realtype delta, int lr, void* f_data,
+                                 N_Vector tmp)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            d->m_func->preconditionerSolve(NV_DATA_S(r), NV_DATA_S(z));
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1; // possibly recoverable error
+        } catch (...) {
+            std::cerr << "cvodes_prec_solve: unhandled exception" << std::endl;
+            return -1; // unrecoverable error
+        }
+        return 0;
+    }
+
+    /**
+     *  Function called by CVodes to evaluate the root functions used to
+     *  detect events, which are provided by the FuncEval object.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_root(realtype t, N_Vector y, realtype* gout,
+                           void* f_data)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            d->m_func->evalRootFunctions(t, NV_DATA_S(y), gout);
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1;
+        } catch (...) {
+            std::cerr << "cvodes_root: unhandled exception" << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+
+#ifdef CT_SUNDIALS_ADJOINT
+    /**
+     *  Function called by CVodes to evaluate the right-hand side of the
+     *  adjoint equations for the backward problem, which is provided by the
+     *  FuncEval object.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_rhsB(realtype t, N_Vector y, N_Vector yB,
+                           N_Vector yBdot, void* f_data)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            d->m_func->evalAdjoint(t, NV_DATA_S(y), NV_DATA_S(yB),
+                                   NV_DATA_S(yBdot));
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1;
+        } catch (...) {
+            std::cerr << "cvodes_rhsB: unhandled exception" << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+
+    /**
+     *  Function called by CVodes to evaluate the integrand of the
+     *  quadratures which give the sensitivities of the adjoint objective.
+     *  The quadratures are integrated backward from the final time, so the
+     *  integrand is negated to obtain the integral forward in time.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_quadB(realtype t, N_Vector y, N_Vector yB,
+                            N_Vector qBdot, void* f_data)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            double* qdot = NV_DATA_S(qBdot);
+            d->m_func->evalAdjointParams(t, NV_DATA_S(y), NV_DATA_S(yB), qdot);
+            for (size_t i = 0; i < d->m_pars.size(); i++) {
+                qdot[i] = -qdot[i];
+            }
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1;
+        } catch (...) {
+            std::cerr << "cvodes_quadB: unhandled exception" << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+
+    /**
+     *  Function called by CVodes to set up the preconditioner for the GMRES
+     *  linear solver of the backward problem. The Newton matrix of the
+     *  backward problem, \f$ I + \gamma_B J^T \f$, is the transpose of the
+     *  Newton matrix of the forward problem with \f$ \gamma = -\gamma_B \f$,
+     *  so the preconditioner provided by the FuncEval object is reused.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_prec_setupB(realtype t, N_Vector y, N_Vector yB,
+                                  N_Vector fyB, booleantype jokB,
+                                  booleantype* jcurPtrB, realtype gammaB,
+                                  void* f_data, N_Vector tmp1B,
+                                  N_Vector tmp2B, N_Vector tmp3B)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            double* p = d->m_pars.empty() ? NULL : DATA_PTR(d->m_pars);
+            d->m_ydot.resize(NV_LENGTH_S(y));
+            d->m_func->eval(t, NV_DATA_S(y), DATA_PTR(d->m_ydot), p);
+            *jcurPtrB = d->m_func->preconditionerSetup(t, NV_DATA_S(y),
+                            DATA_PTR(d->m_ydot), -gammaB, jokB != 0);
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1; // possibly recoverable error
+        } catch (...) {
+            std::cerr << "cvodes_prec_setupB: unhandled exception" << std::endl;
+            return -1; // unrecoverable error
+        }
+        return 0;
+    }
+
+    /**
+     *  Function called by CVodes to solve the preconditioner system
+     *  \f$ P^T z = r \f$ for the GMRES linear solver of the backward problem.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_prec_solveB(realtype t, N_Vector y, N_Vector yB,
+                                  N_Vector fyB, N_Vector rB, N_Vector zB,
+                                  realtype gammaB, realtype deltaB, int lrB,
+                                  void* f_data, N_Vector tmpB)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            d->m_func->preconditionerSolveTranspose(NV_DATA_S(rB),
+                                                    NV_DATA_S(zB));
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1; // possibly recoverable error
+        } catch (...) {
+            std::cerr << "cvodes_prec_solveB: unhandled exception" << std::endl;
+            return -1; // unrecoverable error
+        }
+        return 0;
+    }
+
+    /**
+     *  Function called by CVodes to evaluate the Jacobian of the backward
+     *  problem for the dense linear solver, \f$ -J^T \f$, using the Jacobian
+     *  provided by the FuncEval object.
+     *  @ingroup odeGroup
+     */
+    static int cvodes_jacB(long int NB, realtype t, N_Vector y, N_Vector yB,
+                           N_Vector fyB, DlsMat JB, void* f_data,
+                           N_Vector tmp1B, N_Vector tmp2B, N_Vector tmp3B)
+    {
+        try {
+            Cantera::FuncData* d = (Cantera::FuncData*)f_data;
+            double* p = d->m_pars.empty() ? NULL : DATA_PTR(d->m_pars);
+            d->m_ydot.resize(NB);
+            d->m_func->eval(t, NV_DATA_S(y), DATA_PTR(d->m_ydot), p);
+            d->m_func->getJacobian(t, NV_DATA_S(y), DATA_PTR(d->m_ydot), p,
+                                   d->m_jac);
+            for (long int j = 0; j < NB; j++) {
+                realtype* col = DENSE_COL(JB, j);
+                for (long int i = 0; i < NB; i++) {
+                    col[i] = -d->m_jac(j, i);
+                }
+            }
+        } catch (Cantera::CanteraError& err) {
+            std::cerr << err.what() << std::endl;
+            return 1;
+        } catch (...) {
+            std::cerr << "cvodes_jacB: unhandled exception" << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+#endif
+
     //! Function called by CVodes when an error is encountered instead of
     //! writing to stdout. Here, save the error message provided by CVodes so
     //! that it can be included in the subsequently raised CanteraError.
@@ -113,7 +389,14 @@ CVodesIntegrator::CVodesIntegrator() :
     m_fdata(0),
     m_np(0),
     m_mupper(0), m_mlower(0),
-    m_sens_ok(false)
+    m_sens_ok(false),
+    m_nroots(0),
+    m_rootFound(false),
+    m_dky(0),
+    m_adjointSteps(0),
+    m_indexB(-1),
+    m_yB(0),
+    m_qB(0)
 {
 }
 
@@ -131,6 +414,15 @@ CVodesIntegrator::~CVodesIntegrator()
     if (m_abstol) {
         N_VDestroy_Serial(m_abstol);
     }
+    if (m_dky) {
+        N_VDestroy_Serial(m_dky);
+    }
+    if (m_yB) {
+        N_VDestroy_Serial(m_yB);
+    }
+    if (m_qB) {
+        N_VDestroy_Serial(m_qB);
+    }
     delete m_fdata;
 }
 
@@ -271,6 +563,10 @@ void CVodesIntegrator::initialize(double t0, FuncEval& func)
         N_VDestroy_Serial(m_y); // free solution vector if already allocated
     }
     m_y = N_VNew_Serial(m_neq); // allocate solution vector
+    if (m_dky) {
+        N_VDestroy_Serial(m_dky);
+    }
+    m_dky = N_VNew_Serial(m_neq);
     for (size_t i = 0; i < m_neq; i++) {
         NV_Ith_S(m_y, i) = 0.0;
     }
@@ -282,8 +578,9 @@ void CVodesIntegrator::initialize(double t0, FuncEval& func)
     func.getInitialConditions(m_t0, m_neq, NV_DATA_S(m_y));
 
     if (m_cvode_mem) {
-        CVodeFree(&m_cvode_mem);
+        CVodeFree(&m_cvode_mem); // also frees any backward problem
     }
+    m_indexB = -1;
 
     /*
      *  Specify the method and the iteration type:
@@ -331,11 +628,20 @@ void CVodesIntegrator::initialize(double t0, FuncEval& func)
     if (flag != CV_SUCCESS) {
         throw CVodesErr("CVodeSetUserData failed.");
     }
-    if (func.nparams() > 0) {
+    if (func.nparams() > 0 && m_adjointSteps == 0) {
         sensInit(t0, func);
         flag = CVodeSetSensParams(m_cvode_mem, DATA_PTR(m_fdata->m_pars),
                                   NULL, NULL);
     }
+#ifdef CT_SUNDIALS_ADJOINT
+    if (m_adjointSteps > 0) {
+        flag = CVodeAdjInit(m_cvode_mem, m_adjointSteps, CV_HERMITE);
+        if (flag != CV_SUCCESS) {
+            throw CVodesErr("CVodeAdjInit failed. Error code: " +
+                            int2str(flag));
+        }
+    }
+#endif
     applyOptions();
 }
 
@@ -352,23 +658,45 @@ void CVodesIntegrator::reinitialize(double t0, FuncEval& func)
     if (result != CV_SUCCESS) {
         throw CVodesErr("CVodeReInit failed. result = "+int2str(result));
     }
+#ifdef CT_SUNDIALS_ADJOINT
+    if (m_adjointSteps > 0) {
+        // Discard the checkpoints of the previous forward integration
+        result = CVodeAdjReInit(m_cvode_mem);
+        if (result != CV_SUCCESS) {
+            throw CVodesErr("CVodeAdjReInit failed. result = " +
+                            int2str(result));
+        }
+    }
+#endif
     applyOptions();
 }
 
 void CVodesIntegrator::applyOptions()
 {
-    if (m_type == DENSE + NOJAC) {
+    if (m_type == DENSE + NOJAC || m_type == DENSE + JAC) {
         long int N = m_neq;
         #if SUNDIALS_USE_LAPACK
             CVLapackDense(m_cvode_mem, N);
         #else
             CVDense(m_cvode_mem, N);
         #endif
+        // Without a Jacobian from the FuncEval object, CVodes uses finite
+        // differences
+        if (m_type == DENSE + JAC && m_fdata->m_func->hasJacobian()) {
+            m_fdata->m_jac.resize(m_neq, m_neq);
+            CVDlsSetDenseJacFn(m_cvode_mem, cvodes_jac);
+        }
     } else if (m_type == DIAG) {
         CVDiag(m_cvode_mem);
     } else if (m_type == GMRES) {
-        CVSpgmr(m_cvode_mem, PREC_NONE, 0);
-    } else if (m_type == BAND + NOJAC) {
+        if (m_fdata->m_func->hasPreconditioner()) {
+            CVSpgmr(m_cvode_mem, PREC_LEFT, 0);
+            CVSpilsSetPreconditioner(m_cvode_mem, cvodes_prec_setup,
+                                     cvodes_prec_solve);
+        } else {
+            CVSpgmr(m_cvode_mem, PREC_NONE, 0);
+        }
+    } else if (m_type == BAND + NOJAC || m_type == BAND + JAC) {
         long int N = m_neq;
         long int nu = m_mupper;
         long int nl = m_mlower;
@@ -377,6 +705,10 @@ void CVodesIntegrator::applyOptions()
         #else
             CVBand(m_cvode_mem, N, nu, nl);
         #endif
+        if (m_type == BAND + JAC && m_fdata->m_func->hasJacobian()) {
+            m_fdata->m_jac.resize(m_neq, m_neq);
+            CVDlsSetBandJacFn(m_cvode_mem, cvodes_band_jac);
+        }
     } else {
         throw CVodesErr("unsupported option");
     }
@@ -396,12 +728,30 @@ void CVodesIntegrator::applyOptions()
     if (m_maxErrTestFails > 0) {
         CVodeSetMaxErrTestFails(m_cvode_mem, m_maxErrTestFails);
     }
+    m_nroots = m_fdata->m_func->nRootFunctions();
+    m_rootFound = false;
+    m_rootInfo.assign(m_nroots, 0);
+    if (m_nroots) {
+        CVodeRootInit(m_cvode_mem, static_cast<int>(m_nroots), cvodes_root);
+    }
+}
+
+int CVodesIntegrator::advanceForward(double tout, int itask)
+{
+#ifdef CT_SUNDIALS_ADJOINT
+    if (m_adjointSteps > 0) {
+        int ncheck;
+        return CVodeF(m_cvode_mem, tout, m_y, &m_time, itask, &ncheck);
+    }
+#endif
+    return CVode(m_cvode_mem, tout, m_y, &m_time, itask);
 }
 
 void CVodesIntegrator::integrate(double tout)
 {
-    int flag = CVode(m_cvode_mem, tout, m_y, &m_time, CV_NORMAL);
-    if (flag != CV_SUCCESS) {
+    int flag = advanceForward(tout, CV_NORMAL);
+    checkRoots(flag);
+    if (flag != CV_SUCCESS && flag != CV_ROOT_RETURN) {
         throw CVodesErr("CVodes error encountered. Error code: " + int2str(flag) + "\n" + m_error_message +
                         "\nComponents with largest weighted error estimates:\n" + getErrorInfo(10));
     }
@@ -410,8 +760,9 @@ void CVodesIntegrator::integrate(double tout)
 
 double CVodesIntegrator::step(double tout)
 {
-    int flag = CVode(m_cvode_mem, tout, m_y, &m_time, CV_ONE_STEP);
-    if (flag != CV_SUCCESS) {
+    int flag = advanceForward(tout, CV_ONE_STEP);
+    checkRoots(flag);
+    if (flag != CV_SUCCESS && flag != CV_ROOT_RETURN) {
         throw CVodesErr("CVodes error encountered. Error code: " + int2str(flag) + "\n" + m_error_message +
                         "\nComponents with largest weighted error estimates:\n" + getErrorInfo(10));
 
@@ -420,6 +771,199 @@ double CVodesIntegrator::step(double tout)
     return m_time;
 }
 
+void CVodesIntegrator::checkRoots(int flag)
+{
+    m_rootFound = (flag == CV_ROOT_RETURN);
+    if (m_rootFound) {
+        CVodeGetRootInfo(m_cvode_mem, &m_rootInfo[0]);
+    } else {
+        m_rootInfo.assign(m_nroots, 0);
+    }
+}
+
+double CVodesIntegrator::internalTime() const
+{
+    realtype t;
+    int flag = CVodeGetCurrentTime(m_cvode_mem, &t);
+    if (flag != CV_SUCCESS) {
+        throw CVodesErr("CVodeGetCurrentTime failed. Error code: " +
+                        int2str(flag));
+    }
+    return t;
+}
+
+void CVodesIntegrator::getDky(double t, int k, double* dky)
+{
+    int flag = CVodeGetDky(m_cvode_mem, t, k, m_dky);
+    if (flag != CV_SUCCESS) {
+        throw CVodesErr("CVodeGetDky failed for t = " + fp2str(t) + ", k = " +
+                        int2str(k) + ". Error code: " + int2str(flag) + "\n" +
+                        m_error_message);
+    }
+    std::copy(NV_DATA_S(m_dky), NV_DATA_S(m_dky) + m_neq, dky);
+}
+
+void CVodesIntegrator::setAdjointCheckpointSteps(int nsteps)
+{
+#ifndef CT_SUNDIALS_ADJOINT
+    if (nsteps > 0) {
+        throw CVodesErr("Adjoint sensitivity analysis is not available. "
+                        "Cantera must be configured with sundials_adjoint=y.");
+    }
+#endif
+    m_adjointSteps = nsteps;
+}
+
+#ifdef CT_SUNDIALS_ADJOINT
+void CVodesIntegrator::initBackward()
+{
+    size_t np = m_fdata->m_pars.size();
+    int flag;
+    if (m_indexB >= 0) {
+        flag = CVodeReInitB(m_cvode_mem, m_indexB, m_time, m_yB);
+        if (flag != CV_SUCCESS) {
+            throw CVodesErr("CVodeReInitB failed. Error code: " +
+                            int2str(flag));
+        }
+        if (np) {
+            flag = CVodeQuadReInitB(m_cvode_mem, m_indexB, m_qB);
+            if (flag != CV_SUCCESS) {
+                throw CVodesErr("CVodeQuadReInitB failed. Error code: " +
+                                int2str(flag));
+            }
+        }
+        return;
+    }
+
+    flag = CVodeCreateB(m_cvode_mem, m_method, m_iter, &m_indexB);
+    if (flag != CV_SUCCESS) {
+        throw CVodesErr("CVodeCreateB failed. Error code: " + int2str(flag));
+    }
+    flag = CVodeInitB(m_cvode_mem, m_indexB, cvodes_rhsB, m_time, m_yB);
+    if (flag != CV_SUCCESS) {
+        throw CVodesErr("CVodeInitB failed. Error code: " + int2str(flag));
+    }
+    CVodeSetUserDataB(m_cvode_mem, m_indexB, (void*) m_fdata);
+
+    // The backward problem has the same size and sparsity as the forward
+    // problem, so the same type of linear solver is used
+    long int N = m_neq;
+    if (m_type == DENSE + NOJAC || m_type == DENSE + JAC) {
+        #if SUNDIALS_USE_LAPACK
+            CVLapackDenseB(m_cvode_mem, m_indexB, N);
+        #else
+            CVDenseB(m_cvode_mem, m_indexB, N);
+        #endif
+        if (m_type == DENSE + JAC && m_fdata->m_func->hasJacobian()) {
+            m_fdata->m_jac.resize(m_neq, m_neq);
+            CVDlsSetDenseJacFnB(m_cvode_mem, m_indexB, cvodes_jacB);
+        }
+    } else if (m_type == BAND + NOJAC || m_type == BAND + JAC) {
+        long int nu = std::max(m_mupper, m_mlower);
+        #if SUNDIALS_USE_LAPACK
+            CVLapackBandB(m_cvode_mem, m_indexB, N, nu, nu);
+        #else
+            CVBandB(m_cvode_mem, m_indexB, N, nu, nu);
+        #endif
+    } else if (m_type == DIAG) {
+        CVDiagB(m_cvode_mem, m_indexB);
+    } else if (m_type == GMRES) {
+        if (m_fdata->m_func->hasPreconditioner()) {
+            CVSpgmrB(m_cvode_mem, m_indexB, PREC_LEFT, 0);
+            CVSpilsSetPreconditionerB(m_cvode_mem, m_indexB,
+                                      cvodes_prec_setupB, cvodes_prec_solveB);
+        } else {
+            CVSpgmrB(m_cvode_mem, m_indexB, PREC_NONE, 0);
+        }
+    } else {
+        throw CVodesErr("unsupported option");
+    }
+    if (m_maxsteps > 0) {
+        CVodeSetMaxNumStepsB(m_cvode_mem, m_indexB, m_maxsteps);
+    }
+    if (m_hmax > 0) {
+        CVodeSetMaxStepB(m_cvode_mem, m_indexB, m_hmax);
+    }
+    if (np) {
+        flag = CVodeQuadInitB(m_cvode_mem, m_indexB, cvodes_quadB, m_qB);
+        if (flag != CV_SUCCESS) {
+            throw CVodesErr("CVodeQuadInitB failed. Error code: " +
+                            int2str(flag));
+        }
+        CVodeSetQuadErrConB(m_cvode_mem, m_indexB, TRUE);
+    }
+}
+
+void CVodesIntegrator::solveAdjoint(const double* lambda, double* dgdp,
+                                    double* lambda0)
+{
+    if (m_adjointSteps <= 0 || !m_cvode_mem) {
+        throw CVodesErr("Adjoint sensitivity analysis was not enabled "
+                        "before the forward integration.");
+    }
+    if (m_time == m_t0) {
+        throw CVodesErr("solveAdjoint: no steps have been taken.");
+    }
+    size_t np = m_fdata->m_pars.size();
+    if (!m_yB) {
+        m_yB = N_VNew_Serial(m_neq);
+    }
+    if (np && (!m_qB || static_cast<size_t>(NV_LENGTH_S(m_qB)) != np)) {
+        if (m_qB) {
+            N_VDestroy_Serial(m_qB);
+        }
+        m_qB = N_VNew_Serial(np);
+    }
+    double lmax = 0.0;
+    for (size_t i = 0; i < m_neq; i++) {
+        NV_Ith_S(m_yB, i) = lambda[i];
+        lmax = std::max(lmax, fabs(lambda[i]));
+    }
+    for (size_t i = 0; i < np; i++) {
+        NV_Ith_S(m_qB, i) = 0.0;
+    }
+    initBackward();
+
+    // The sensitivity tolerances are used for the adjoint variables and the
+    // quadratures, with the absolute tolerance relative to the magnitude of
+    // the final condition
+    double atol = m_abstolsens * (lmax > 0.0 ? lmax : 1.0);
+    CVodeSStolerancesB(m_cvode_mem, m_indexB, m_reltolsens, atol);
+    if (np) {
+        CVodeQuadSStolerancesB(m_cvode_mem, m_indexB, m_reltolsens, atol);
+    }
+
+    int flag = CVodeB(m_cvode_mem, m_t0, CV_NORMAL);
+    if (flag < 0) {
+        throw CVodesErr("CVodeB error encountered. Error code: " +
+                        int2str(flag) + "\n" + m_error_message);
+    }
+    double tret;
+    flag = CVodeGetB(m_cvode_mem, m_indexB, &tret, m_yB);
+    if (flag != CV_SUCCESS) {
+        throw CVodesErr("CVodeGetB failed. Error code: " + int2str(flag));
+    }
+    if (lambda0) {
+        std::copy(NV_DATA_S(m_yB), NV_DATA_S(m_yB) + m_neq, lambda0);
+    }
+    if (np) {
+        flag = CVodeGetQuadB(m_cvode_mem, m_indexB, &tret, m_qB);
+        if (flag != CV_SUCCESS) {
+            throw CVodesErr("CVodeGetQuadB failed. Error code: " +
+                            int2str(flag));
+        }
+        std::copy(NV_DATA_S(m_qB), NV_DATA_S(m_qB) + np, dgdp);
+    }
+}
+#else
+void CVodesIntegrator::solveAdjoint(const double* lambda, double* dgdp,
+                                    double* lambda0)
+{
+    throw CVodesErr("Adjoint sensitivity analysis is not available. "
+                    "Cantera must be configured with sundials_adjoint=y.");
+}
+#endif
+
 int CVodesIntegrator::nEvals() const
 {
     long int ne;
@@ -450,6 +994,42 @@ double CVodesIntegrator::sensitivity(size_t k, size_t p)
     return NV_Ith_S(m_yS[p],k);
 }
 
+void CVodesIntegrator::getSolverStats(std::map<std::string, long int>& stats) const
+{
+    if (!m_cvode_mem) {
+        return;
+    }
+    long int val;
+    CVodeGetNumSteps(m_cvode_mem, &val);
+    stats["steps"] = val;
+    CVodeGetNumRhsEvals(m_cvode_mem, &val);
+    stats["rhs_evals"] = val;
+    CVodeGetNumLinSolvSetups(m_cvode_mem, &val);
+    stats["lin_solve_setups"] = val;
+    CVodeGetNumErrTestFails(m_cvode_mem, &val);
+    stats["err_test_fails"] = val;
+    CVodeGetNumNonlinSolvIters(m_cvode_mem, &val);
+    stats["nonlinear_iters"] = val;
+    CVodeGetNumNonlinSolvConvFails(m_cvode_mem, &val);
+    stats["nonlinear_conv_fails"] = val;
+    if (m_type & (DENSE | BAND)) {
+        CVDlsGetNumJacEvals(m_cvode_mem, &val);
+        stats["jac_evals"] = val;
+        // right-hand side evaluations used for difference quotient Jacobians
+        CVDlsGetNumRhsEvals(m_cvode_mem, &val);
+        stats["rhs_evals"] += val;
+    } else if (m_type == GMRES) {
+        CVSpilsGetNumLinIters(m_cvode_mem, &val);
+        stats["lin_iters"] = val;
+        CVSpilsGetNumConvFails(m_cvode_mem, &val);
+        stats["lin_conv_fails"] = val;
+        CVSpilsGetNumPrecEvals(m_cvode_mem, &val);
+        stats["prec_evals"] = val;
+        CVSpilsGetNumPrecSolves(m_cvode_mem, &val);
+        stats["prec_solves"] = val;
+    }
+}
+
 string CVodesIntegrator::getErrorInfo(int N)
 {
     N_Vector errs = N_VNew_Serial(m_neq);
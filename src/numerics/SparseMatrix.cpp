@@ -0,0 +1,680 @@
+/**
+ *  @file SparseMatrix.cpp
+ *
+ *  Sparse matrices in compressed-column format.
+ */
+
+#include "cantera/numerics/SparseMatrix.h"
+#include "cantera/base/stringUtils.h"
+
+#include <algorithm>
+#include <ostream>
+
+using namespace std;
+
+namespace Cantera
+{
+
+SparseMatrix::SparseMatrix() :
+    GeneralMatrix(2),
+    m_n(0),
+    m_colStart(1, 0),
+    m_symbolic(false),
+    m_pivtol(0.1),
+    m_droptol(0.0),
+    m_nfactor(0),
+    m_nrefactor(0),
+    m_zero(0.0)
+{
+}
+
+SparseMatrix::SparseMatrix(size_t n, const std::vector<size_t>& colStart,
+                           const std::vector<size_t>& rowIndex) :
+    GeneralMatrix(2),
+    m_n(0),
+    m_symbolic(false),
+    m_pivtol(0.1),
+    m_droptol(0.0),
+    m_nfactor(0),
+    m_nrefactor(0),
+    m_zero(0.0)
+{
+    setStructure(n, colStart, rowIndex);
+}
+
+SparseMatrix::SparseMatrix(const SparseMatrix& y) :
+    GeneralMatrix(y),
+    m_n(y.m_n),
+    m_colStart(y.m_colStart),
+    m_rowIndex(y.m_rowIndex),
+    m_data(y.m_data),
+    m_Lp(y.m_Lp),
+    m_Li(y.m_Li),
+    m_Lx(y.m_Lx),
+    m_Up(y.m_Up),
+    m_Ui(y.m_Ui),
+    m_Ux(y.m_Ux),
+    m_pinv(y.m_pinv),
+    m_symbolic(y.m_symbolic),
+    m_pivtol(y.m_pivtol),
+    m_droptol(y.m_droptol),
+    m_nfactor(y.m_nfactor),
+    m_nrefactor(y.m_nrefactor),
+    m_zero(0.0),
+    m_work(y.m_work),
+    m_iwork(y.m_iwork),
+    m_stack(y.m_stack),
+    m_mark(y.m_mark)
+{
+}
+
+SparseMatrix& SparseMatrix::operator=(const SparseMatrix& y)
+{
+    if (&y == this) {
+        return *this;
+    }
+    GeneralMatrix::operator=(y);
+    m_n = y.m_n;
+    m_colStart = y.m_colStart;
+    m_rowIndex = y.m_rowIndex;
+    m_data = y.m_data;
+    m_Lp = y.m_Lp;
+    m_Li = y.m_Li;
+    m_Lx = y.m_Lx;
+    m_Up = y.m_Up;
+    m_Ui = y.m_Ui;
+    m_Ux = y.m_Ux;
+    m_pinv = y.m_pinv;
+    m_symbolic = y.m_symbolic;
+    m_pivtol = y.m_pivtol;
+    m_droptol = y.m_droptol;
+    m_nfactor = y.m_nfactor;
+    m_nrefactor = y.m_nrefactor;
+    m_work = y.m_work;
+    m_iwork = y.m_iwork;
+    m_stack = y.m_stack;
+    m_mark = y.m_mark;
+    return *this;
+}
+
+void SparseMatrix::setStructure(size_t n, const std::vector<size_t>& colStart,
+                                const std::vector<size_t>& rowIndex)
+{
+    if (colStart.size() != n + 1 || colStart[0] != 0 ||
+            colStart[n] != rowIndex.size()) {
+        throw CanteraError("SparseMatrix::setStructure",
+                           "Inconsistent column start array.");
+    }
+    for (size_t j = 0; j < n; j++) {
+        for (size_t p = colStart[j]; p < colStart[j+1]; p++) {
+            if (rowIndex[p] >= n ||
+                    (p > colStart[j] && rowIndex[p] <= rowIndex[p-1])) {
+                throw CanteraError("SparseMatrix::setStructure",
+                                   "Row indices in column " + int2str(j) +
+                                   " are out of range or not increasing.");
+            }
+        }
+    }
+    m_n = n;
+    m_colStart = colStart;
+    m_rowIndex.assign(rowIndex.begin(), rowIndex.end());
+    m_data.assign(rowIndex.size(), 0.0);
+    m_Lp.clear();
+    m_Li.clear();
+    m_Lx.clear();
+    m_Up.clear();
+    m_Ui.clear();
+    m_Ux.clear();
+    m_pinv.clear();
+    m_work.assign(n, 0.0);
+    m_iwork.resize(n);
+    m_stack.resize(n);
+    m_mark.assign(n, 0);
+    m_symbolic = false;
+    m_factored = false;
+}
+
+size_t SparseMatrix::index(size_t i, size_t j) const
+{
+    vector_int::const_iterator begin = m_rowIndex.begin() + m_colStart[j];
+    vector_int::const_iterator end = m_rowIndex.begin() + m_colStart[j+1];
+    vector_int::const_iterator loc = lower_bound(begin, end,
+                                     static_cast<int>(i));
+    if (loc == end || *loc != static_cast<int>(i)) {
+        return npos;
+    }
+    return loc - m_rowIndex.begin();
+}
+
+doublereal& SparseMatrix::operator()(size_t i, size_t j)
+{
+    return value(i,j);
+}
+
+doublereal SparseMatrix::operator()(size_t i, size_t j) const
+{
+    return value(i,j);
+}
+
+doublereal& SparseMatrix::value(size_t i, size_t j)
+{
+    m_factored = false;
+    size_t k = index(i,j);
+    if (k == npos) {
+        throw CanteraError("SparseMatrix::value",
+                           "Element (" + int2str(i) + ", " + int2str(j) +
+                           ") is not part of the matrix structure.");
+    }
+    return m_data[k];
+}
+
+doublereal SparseMatrix::value(size_t i, size_t j) const
+{
+    size_t k = index(i,j);
+    return (k == npos) ? 0.0 : m_data[k];
+}
+
+size_t SparseMatrix::nRows() const
+{
+    return m_n;
+}
+
+size_t SparseMatrix::nRowsAndStruct(size_t* const iStruct) const
+{
+    if (iStruct) {
+        iStruct[0] = nNonzeros();
+        iStruct[1] = nFactorNonzeros();
+    }
+    return m_n;
+}
+
+size_t SparseMatrix::memoryUsage() const
+{
+    size_t nvalues = m_data.size() + m_Lx.size() + m_Ux.size();
+    size_t nindices = m_rowIndex.size() + m_Li.size() + m_Ui.size();
+    size_t npointers = m_colStart.size() + m_Lp.size() + m_Up.size() +
+                       m_pinv.size();
+    return nvalues * sizeof(doublereal) + nindices * sizeof(int) +
+           npointers * sizeof(size_t);
+}
+
+void SparseMatrix::setPivotThreshold(doublereal tol)
+{
+    if (tol <= 0.0 || tol > 1.0) {
+        throw CanteraError("SparseMatrix::setPivotThreshold",
+                           "Threshold must be in the range (0, 1].");
+    }
+    m_pivtol = tol;
+}
+
+void SparseMatrix::setDropTolerance(doublereal tol)
+{
+    if (tol < 0.0) {
+        throw CanteraError("SparseMatrix::setDropTolerance",
+                           "Tolerance must be non-negative.");
+    }
+    m_droptol = tol;
+    m_symbolic = false;
+    m_factored = false;
+}
+
+void SparseMatrix::mult(const doublereal* b, doublereal* prod) const
+{
+    fill(prod, prod + m_n, 0.0);
+    for (size_t j = 0; j < m_n; j++) {
+        for (size_t p = m_colStart[j]; p < m_colStart[j+1]; p++) {
+            prod[m_rowIndex[p]] += m_data[p] * b[j];
+        }
+    }
+}
+
+void SparseMatrix::leftMult(const doublereal* const b,
+                            doublereal* const prod) const
+{
+    for (size_t j = 0; j < m_n; j++) {
+        double sum = 0.0;
+        for (size_t p = m_colStart[j]; p < m_colStart[j+1]; p++) {
+            sum += m_data[p] * b[m_rowIndex[p]];
+        }
+        prod[j] = sum;
+    }
+}
+
+size_t SparseMatrix::reach(size_t k)
+{
+    // Depth-first search of the graph of L, starting from the nonzeros of
+    // column k of A. Nodes are added to the output list (stored at the end
+    // of m_iwork) once all of their descendants have been visited, which
+    // gives a topological ordering.
+    size_t top = m_n;
+    for (size_t p = m_colStart[k]; p < m_colStart[k+1]; p++) {
+        size_t start = m_rowIndex[p];
+        if (m_mark[start]) {
+            continue;
+        }
+        // The DFS stack is kept in m_iwork[0:head+1], with the position of
+        // the next edge to be followed for each node held in m_stack.
+        int head = 0;
+        m_iwork[0] = start;
+        while (head >= 0) {
+            size_t j = m_iwork[head];
+            size_t J = m_pinv[j];
+            if (!m_mark[j]) {
+                m_mark[j] = 1;
+                m_stack[head] = (J == npos) ? 0 : m_Lp[J] + 1;
+            }
+            bool done = true;
+            size_t pend = (J == npos) ? 0 : m_Lp[J+1];
+            for (size_t q = m_stack[head]; q < pend; q++) {
+                size_t i = m_Li[q];
+                if (m_mark[i]) {
+                    continue;
+                }
+                m_stack[head] = q;
+                m_iwork[++head] = i;
+                done = false;
+                break;
+            }
+            if (done) {
+                head--;
+                m_iwork[--top] = j;
+            }
+        }
+    }
+    for (size_t p = top; p < m_n; p++) {
+        m_mark[m_iwork[p]] = 0;
+    }
+    return top;
+}
+
+int SparseMatrix::factorComplete()
+{
+    m_symbolic = false;
+    m_pinv.assign(m_n, npos);
+    m_Lp.assign(m_n + 1, 0);
+    m_Up.assign(m_n + 1, 0);
+    m_Li.clear();
+    m_Lx.clear();
+    m_Ui.clear();
+    m_Ux.clear();
+    m_Li.reserve(2 * nNonzeros() + m_n);
+    m_Lx.reserve(2 * nNonzeros() + m_n);
+    m_Ui.reserve(2 * nNonzeros() + m_n);
+    m_Ux.reserve(2 * nNonzeros() + m_n);
+    vector_fp& x = m_work;
+
+    for (size_t k = 0; k < m_n; k++) {
+        m_Lp[k] = m_Li.size();
+        m_Up[k] = m_Ui.size();
+
+        // Solve L * x = A(:,k), where the row indices of L are still those
+        // of the original matrix
+        size_t top = reach(k);
+        doublereal anorm = 0.0;
+        for (size_t p = m_colStart[k]; p < m_colStart[k+1]; p++) {
+            x[m_rowIndex[p]] = m_data[p];
+            anorm = std::max(anorm, fabs(m_data[p]));
+        }
+        // Elements smaller than this are dropped from the factors
+        doublereal drop = m_droptol * anorm;
+        for (size_t px = top; px < m_n; px++) {
+            size_t j = m_iwork[px];
+            size_t J = m_pinv[j];
+            if (J == npos) {
+                continue;
+            }
+            if (fabs(x[j]) < drop) {
+                x[j] = 0.0;
+                continue;
+            }
+            for (size_t p = m_Lp[J] + 1; p < m_Lp[J+1]; p++) {
+                x[m_Li[p]] -= m_Lx[p] * x[j];
+            }
+        }
+
+        // Entries in rows which have already been pivotal belong to U. Find
+        // the largest candidate pivot among the remaining rows.
+        size_t ipiv = npos;
+        doublereal amax = -1.0;
+        for (size_t px = top; px < m_n; px++) {
+            size_t i = m_iwork[px];
+            if (m_pinv[i] == npos) {
+                if (fabs(x[i]) > amax) {
+                    amax = fabs(x[i]);
+                    ipiv = i;
+                }
+            } else if (drop == 0.0 || x[i] != 0.0) {
+                m_Ui.push_back(static_cast<int>(m_pinv[i]));
+                m_Ux.push_back(x[i]);
+            }
+        }
+        if (ipiv == npos || amax <= 0.0) {
+            for (size_t px = top; px < m_n; px++) {
+                x[m_iwork[px]] = 0.0;
+            }
+            return static_cast<int>(k) + 1;
+        }
+
+        // Prefer the diagonal element, if it is large enough
+        if (m_pinv[k] == npos && fabs(x[k]) >= m_pivtol * amax) {
+            ipiv = k;
+        }
+        doublereal pivot = x[ipiv];
+        m_Ui.push_back(static_cast<int>(k));
+        m_Ux.push_back(pivot);
+        m_pinv[ipiv] = k;
+        m_Li.push_back(static_cast<int>(ipiv));
+        m_Lx.push_back(1.0);
+        for (size_t px = top; px < m_n; px++) {
+            size_t i = m_iwork[px];
+            if (m_pinv[i] == npos && (drop == 0.0 || fabs(x[i]) >= drop)) {
+                m_Li.push_back(static_cast<int>(i));
+                m_Lx.push_back(x[i] / pivot);
+            }
+            x[i] = 0.0;
+        }
+    }
+    m_Lp[m_n] = m_Li.size();
+    m_Up[m_n] = m_Ui.size();
+
+    // Renumber the rows of L to the pivot order
+    for (size_t p = 0; p < m_Li.size(); p++) {
+        m_Li[p] = static_cast<int>(m_pinv[m_Li[p]]);
+    }
+    m_symbolic = true;
+    return 0;
+}
+
+bool SparseMatrix::refactor()
+{
+    vector_fp& x = m_work;
+    for (size_t k = 0; k < m_n; k++) {
+        // Scatter A(:,k) in pivot order
+        for (size_t p = m_colStart[k]; p < m_colStart[k+1]; p++) {
+            x[m_pinv[m_rowIndex[p]]] = m_data[p];
+        }
+
+        // The off-diagonal elements of U(:,k) are stored in topological
+        // order, so each one is final when it is reached.
+        for (size_t p = m_Up[k]; p < m_Up[k+1] - 1; p++) {
+            size_t J = m_Ui[p];
+            doublereal ujk = x[J];
+            m_Ux[p] = ujk;
+            x[J] = 0.0;
+            for (size_t q = m_Lp[J] + 1; q < m_Lp[J+1]; q++) {
+                x[m_Li[q]] -= m_Lx[q] * ujk;
+            }
+        }
+
+        doublereal pivot = x[k];
+        doublereal amax = fabs(pivot);
+        for (size_t q = m_Lp[k] + 1; q < m_Lp[k+1]; q++) {
+            amax = std::max(amax, fabs(x[m_Li[q]]));
+        }
+        x[k] = 0.0;
+        bool ok = (pivot != 0.0 && fabs(pivot) >= m_pivtol * amax);
+        if (ok) {
+            m_Ux[m_Up[k+1] - 1] = pivot;
+        }
+        for (size_t q = m_Lp[k] + 1; q < m_Lp[k+1]; q++) {
+            if (ok) {
+                m_Lx[q] = x[m_Li[q]] / pivot;
+            }
+            x[m_Li[q]] = 0.0;
+        }
+        if (m_droptol > 0.0) {
+            // Clear the elements which were dropped from the factors
+            for (size_t p = m_colStart[k]; p < m_colStart[k+1]; p++) {
+                x[m_pinv[m_rowIndex[p]]] = 0.0;
+            }
+            for (size_t p = m_Up[k]; p < m_Up[k+1] - 1; p++) {
+                size_t J = m_Ui[p];
+                for (size_t q = m_Lp[J] + 1; q < m_Lp[J+1]; q++) {
+                    x[m_Li[q]] = 0.0;
+                }
+            }
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int SparseMatrix::factor()
+{
+    m_factored = false;
+    if (m_symbolic && refactor()) {
+        m_nrefactor++;
+        m_factored = true;
+        return 0;
+    }
+    int info = factorComplete();
+    if (info == 0) {
+        m_nfactor++;
+        m_factored = true;
+    }
+    return info;
+}
+
+int SparseMatrix::solve(const doublereal* const b, doublereal* const x)
+{
+    copy(b, b + m_n, x);
+    return solve(x);
+}
+
+int SparseMatrix::solve(doublereal* b, size_t nrhs, size_t ldb)
+{
+    int info = 0;
+    if (!m_factored) {
+        info = factor();
+    }
+    if (info != 0) {
+        return info;
+    }
+    if (ldb == 0) {
+        ldb = nColumns();
+    }
+    vector_fp& y = m_work;
+    for (size_t m = 0; m < nrhs; m++) {
+        doublereal* bm = b + m*ldb;
+        for (size_t i = 0; i < m_n; i++) {
+            y[m_pinv[i]] = bm[i];
+        }
+        // L is unit lower triangular
+        for (size_t j = 0; j < m_n; j++) {
+            for (size_t p = m_Lp[j] + 1; p < m_Lp[j+1]; p++) {
+                y[m_Li[p]] -= m_Lx[p] * y[j];
+            }
+        }
+        // U is upper triangular, with the diagonal stored last
+        for (size_t j = m_n; j-- > 0;) {
+            y[j] /= m_Ux[m_Up[j+1] - 1];
+            for (size_t p = m_Up[j]; p < m_Up[j+1] - 1; p++) {
+                y[m_Ui[p]] -= m_Ux[p] * y[j];
+            }
+        }
+        copy(y.begin(), y.begin() + m_n, bm);
+        fill(y.begin(), y.end(), 0.0);
+    }
+    return 0;
+}
+
+int SparseMatrix::solveTranspose(doublereal* b, size_t nrhs, size_t ldb)
+{
+    int info = 0;
+    if (!m_factored) {
+        info = factor();
+    }
+    if (info != 0) {
+        return info;
+    }
+    if (ldb == 0) {
+        ldb = nColumns();
+    }
+    // A = P^T * L * U, so A^T = U^T * L^T * P
+    vector_fp& y = m_work;
+    for (size_t m = 0; m < nrhs; m++) {
+        doublereal* bm = b + m*ldb;
+        copy(bm, bm + m_n, y.begin());
+        for (size_t j = 0; j < m_n; j++) {
+            doublereal sum = y[j];
+            for (size_t p = m_Up[j]; p < m_Up[j+1] - 1; p++) {
+                sum -= m_Ux[p] * y[m_Ui[p]];
+            }
+            y[j] = sum / m_Ux[m_Up[j+1] - 1];
+        }
+        for (size_t j = m_n; j-- > 0;) {
+            doublereal sum = y[j];
+            for (size_t p = m_Lp[j] + 1; p < m_Lp[j+1]; p++) {
+                sum -= m_Lx[p] * y[m_Li[p]];
+            }
+            y[j] = sum;
+        }
+        for (size_t i = 0; i < m_n; i++) {
+            bm[i] = y[m_pinv[i]];
+        }
+        fill(y.begin(), y.end(), 0.0);
+    }
+    return 0;
+}
+
+vector_fp::iterator SparseMatrix::begin()
+{
+    m_factored = false;
+    return m_data.begin();
+}
+
+vector_fp::iterator SparseMatrix::end()
+{
+    m_factored = false;
+    return m_data.end();
+}
+
+vector_fp::const_iterator SparseMatrix::begin() const
+{
+    return m_data.begin();
+}
+
+vector_fp::const_iterator SparseMatrix::end() const
+{
+    return m_data.end();
+}
+
+void SparseMatrix::zero()
+{
+    fill(m_data.begin(), m_data.end(), 0.0);
+    m_factored = false;
+}
+
+doublereal SparseMatrix::rcond(doublereal a1norm)
+{
+    throw NotImplementedError("SparseMatrix::rcond");
+}
+
+int SparseMatrix::factorAlgorithm() const
+{
+    return 0;
+}
+
+doublereal SparseMatrix::oneNorm() const
+{
+    doublereal value = 0.0;
+    for (size_t j = 0; j < m_n; j++) {
+        doublereal sum = 0.0;
+        for (size_t p = m_colStart[j]; p < m_colStart[j+1]; p++) {
+            sum += fabs(m_data[p]);
+        }
+        value = std::max(sum, value);
+    }
+    return value;
+}
+
+GeneralMatrix* SparseMatrix::duplMyselfAsGeneralMatrix() const
+{
+    return new SparseMatrix(*this);
+}
+
+doublereal* SparseMatrix::ptrColumn(size_t j)
+{
+    throw NotImplementedError("SparseMatrix::ptrColumn");
+}
+
+doublereal* const* SparseMatrix::colPts()
+{
+    throw NotImplementedError("SparseMatrix::colPts");
+}
+
+void SparseMatrix::copyData(const GeneralMatrix& y)
+{
+    const SparseMatrix* ys = dynamic_cast<const SparseMatrix*>(&y);
+    if (!ys || ys->m_colStart != m_colStart || ys->m_rowIndex != m_rowIndex) {
+        throw CanteraError("SparseMatrix::copyData",
+                           "Matrices do not have the same structure.");
+    }
+    m_factored = false;
+    m_data = ys->m_data;
+}
+
+size_t SparseMatrix::checkRows(doublereal& valueSmall) const
+{
+    vector_fp rowMax(m_n, 0.0);
+    for (size_t p = 0; p < m_data.size(); p++) {
+        rowMax[m_rowIndex[p]] = std::max(rowMax[m_rowIndex[p]],
+                                         fabs(m_data[p]));
+    }
+    valueSmall = 1.0E300;
+    size_t iSmall = npos;
+    for (size_t i = 0; i < m_n; i++) {
+        if (rowMax[i] < valueSmall) {
+            iSmall = i;
+            valueSmall = rowMax[i];
+            if (valueSmall == 0.0) {
+                return iSmall;
+            }
+        }
+    }
+    return iSmall;
+}
+
+size_t SparseMatrix::checkColumns(doublereal& valueSmall) const
+{
+    valueSmall = 1.0E300;
+    size_t jSmall = npos;
+    for (size_t j = 0; j < m_n; j++) {
+        double valueS = 0.0;
+        for (size_t p = m_colStart[j]; p < m_colStart[j+1]; p++) {
+            valueS = std::max(fabs(m_data[p]), valueS);
+        }
+        if (valueS < valueSmall) {
+            jSmall = j;
+            valueSmall = valueS;
+            if (valueSmall == 0.0) {
+                return jSmall;
+            }
+        }
+    }
+    return jSmall;
+}
+
+void SparseMatrix::useFactorAlgorithm(int fAlgorithm)
+{
+    if (fAlgorithm != 0) {
+        throw CanteraError("SparseMatrix::useFactorAlgorithm",
+                           "Only LU factorization is supported.");
+    }
+}
+
+ostream& operator<<(ostream& s, const SparseMatrix& m)
+{
+    size_t n = m.nRows();
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            s << m(i,j) << ", ";
+        }
+        s << endl;
+    }
+    return s;
+}
+
+}
@@ -7,19 +7,33 @@
  */
 
 #include "cantera/oneD/MultiJac.h"
-#include <ctime>
+#include "cantera/numerics/BandMatrix.h"
+#include "cantera/numerics/SparseMatrix.h"
+#include "cantera/base/stringUtils.h"
+#include "cantera/base/clockWC.h"
 
 using namespace std;
 
 namespace Cantera
 {
 
-MultiJac::MultiJac(OneDim& r)
-    : BandMatrix(r.size(),r.bandwidth(),r.bandwidth())
+MultiJac::MultiJac(OneDim& r, int solver)
+    : m_mat(0),
+      m_solver(solver),
+      m_solve_time(0.0),
+      m_nfactor(0)
 {
     m_size = r.size();
     m_points = r.points();
     m_resid = &r;
+    if (solver == c_Band_LinearSolver) {
+        m_mat = new BandMatrix(r.size(), r.bandwidth(), r.bandwidth());
+    } else if (solver == c_Sparse_LinearSolver) {
+        setSparseStructure();
+    } else {
+        throw CanteraError("MultiJac::MultiJac",
+                           "Unknown linear solver type: " + int2str(solver));
+    }
     m_r1.resize(m_size);
     m_ssdiag.resize(m_size);
     m_mask.resize(m_size);
@@ -34,6 +48,65 @@ MultiJac::MultiJac(OneDim& r)
     m_rtol = 1.0e-5;
 }
 
+MultiJac::~MultiJac()
+{
+    delete m_mat;
+}
+
+void MultiJac::setSparseStructure()
+{
+    vector<size_t> colStart(1, 0), rowIndex;
+    for (size_t j = 0; j < m_points; j++) {
+        size_t imin = (j == 0) ? 0 : j - 1;
+        size_t imax = std::min(j + 1, m_points - 1);
+        for (size_t n = 0; n < m_resid->nVars(j); n++) {
+            for (size_t i = imin; i <= imax; i++) {
+                size_t iloc = m_resid->loc(i);
+                for (size_t m = 0; m < m_resid->nVars(i); m++) {
+                    rowIndex.push_back(iloc + m);
+                }
+            }
+            colStart.push_back(rowIndex.size());
+        }
+    }
+    m_mat = new SparseMatrix(m_size, colStart, rowIndex);
+}
+
+int MultiJac::solve(const doublereal* const b, doublereal* const x)
+{
+    clockWC t0;
+    if (!m_mat->factored()) {
+        m_nfactor++;
+    }
+    copy(b, b + m_size, x);
+    int info = m_mat->solve(x);
+    m_solve_time += t0.secondsWC();
+    return info;
+}
+
+int MultiJac::solveTranspose(doublereal* b)
+{
+    clockWC t0;
+    if (!m_mat->factored()) {
+        m_nfactor++;
+    }
+    int info = m_mat->solveTranspose(b);
+    m_solve_time += t0.secondsWC();
+    return info;
+}
+
+size_t MultiJac::memoryUsage() const
+{
+    if (m_solver == c_Band_LinearSolver) {
+        const BandMatrix* b = static_cast<const BandMatrix*>(m_mat);
+        // matrix, LU factorization, and pivot indices
+        return 2 * b->ldim() * b->nColumns() * sizeof(doublereal) +
+               b->nColumns() * sizeof(int);
+    } else {
+        return static_cast<const SparseMatrix*>(m_mat)->memoryUsage();
+    }
+}
+
 void MultiJac::updateTransient(doublereal rdt, integer* mask)
 {
     for (size_t n = 0; n < m_size; n++) {
@@ -50,8 +123,8 @@ void MultiJac::incrementDiagonal(int j, doublereal d)
 void MultiJac::eval(doublereal* x0, doublereal* resid0, doublereal rdt)
 {
     m_nevals++;
-    clock_t t0 = clock();
-    bfill(0.0);
+    clockWC t0;
+    m_mat->zero();
     size_t n, m, ipt=0, j, nv, mv, iloc;
     doublereal rdx, dx, xsave;
 
@@ -75,8 +148,8 @@ void MultiJac::eval(doublereal* x0, doublereal* resid0, doublereal rdt)
                     mv = m_resid->nVars(i);
                     iloc = m_resid->loc(i);
                     for (m = 0; m < mv; m++) {
-                        value(m+iloc,ipt) = (m_r1[m+iloc]
-                                             - resid0[m+iloc])*rdx;
+                        (*m_mat)(m+iloc,ipt) = (m_r1[m+iloc]
+                                                - resid0[m+iloc])*rdx;
                     }
                 }
             }
@@ -87,10 +160,10 @@ void MultiJac::eval(doublereal* x0, doublereal* resid0, doublereal rdt)
     }
 
     for (n = 0; n < m_size; n++) {
-        m_ssdiag[n] = value(n,n);
+        m_ssdiag[n] = (*m_mat)(n,n);
     }
 
-    m_elapsed += double(clock() - t0)/CLOCKS_PER_SEC;
+    m_elapsed += t0.secondsWC();
     m_age = 0;
 }
 
@@ -8,6 +8,7 @@
 
 #include "cantera/oneD/MultiNewton.h"
 #include "cantera/base/vec_functions.h"
+#include "cantera/base/clockWC.h"
 
 #include <cstdio>
 #include <ctime>
@@ -152,7 +153,10 @@ const size_t NDAMP = 7;
 //-----------------------------------------------------------
 
 MultiNewton::MultiNewton(int sz)
-    : m_maxAge(5)
+    : m_maxAge(5),
+      m_nIterations(0),
+      m_nDampReductions(0),
+      m_nFailures(0)
 {
     m_n  = sz;
     m_elapsed = 0.0;
@@ -174,6 +178,14 @@ void MultiNewton::resize(size_t sz)
     m_workarrays.clear();
 }
 
+void MultiNewton::clearStats()
+{
+    m_elapsed = 0.0;
+    m_nIterations = 0;
+    m_nDampReductions = 0;
+    m_nFailures = 0;
+}
+
 doublereal MultiNewton::norm2(const doublereal* x,
                               const doublereal* step, OneDim& r) const
 {
@@ -227,7 +239,9 @@ void MultiNewton::step(doublereal* x, doublereal* step,
                            dom.id() + ", component "
                            +dom.componentName(comp)+" at point "
                            +int2str(pt)+"\n(Matrix row "
-                           +int2str(iok)+") \nsee file bandmatrix.csv\n");
+                           +int2str(iok)+")\n"
+                           +(jac.linearSolver() == c_Band_LinearSolver ?
+                             "see file bandmatrix.csv\n" : ""));
     } else if (int(iok) < 0)
         throw CanteraError("MultiNewton::step",
                            "iok = "+int2str(iok));
@@ -338,6 +352,7 @@ int MultiNewton::dampStep(const doublereal* x0, const doublereal* step0,
             break;
         }
         damp /= DampFactor;
+        m_nDampReductions++;
     }
 
     // If a damping coefficient was found, return 1 if the
@@ -358,7 +373,7 @@ int MultiNewton::dampStep(const doublereal* x0, const doublereal* step0,
 int MultiNewton::solve(doublereal* x0, doublereal* x1,
                        OneDim& r, MultiJac& jac, int loglevel)
 {
-    clock_t t0 = clock();
+    clockWC t0;
     int m = 0;
     bool forceNewJac = false;
     doublereal s1=1.e30;
@@ -390,6 +405,7 @@ int MultiNewton::solve(doublereal* x0, doublereal* x1,
 
         // compute the undamped Newton step
         step(x, stp, r, jac, loglevel-1);
+        m_nIterations++;
 
         // increment the Jacobian age
         jac.incrementAge();
@@ -444,6 +460,7 @@ int MultiNewton::solve(doublereal* x0, doublereal* x1,
 
     if (m < 0) {
         copy(x, x + m_n, x1);
+        m_nFailures++;
     }
     if (m > 0 && jac.nEvals() == j0) {
         m = 100;
@@ -451,7 +468,7 @@ int MultiNewton::solve(doublereal* x0, doublereal* x1,
     releaseWorkArray(x);
     releaseWorkArray(stp);
     releaseWorkArray(stp1);
-    m_elapsed += (clock() - t0)/(1.0*CLOCKS_PER_SEC);
+    m_elapsed += t0.secondsWC();
     return m;
 }
 
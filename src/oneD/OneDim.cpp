@@ -1,11 +1,14 @@
 //! @file OneDim.cpp
 #include "cantera/oneD/MultiNewton.h"
 #include "cantera/oneD/OneDim.h"
+#include "cantera/oneD/StFlow.h"
 
 #include "cantera/numerics/Func1.h"
 #include "cantera/base/ctml.h"
+#include "cantera/base/clockWC.h"
 
 #include <fstream>
+#include <algorithm>
 #include <ctime>
 
 using namespace ctml;
@@ -19,9 +22,11 @@ OneDim::OneDim()
       m_jac(0), m_newt(0),
       m_rdt(0.0), m_jac_ok(false),
       m_nd(0), m_bw(0), m_size(0),
+      m_linear_solver(c_Band_LinearSolver),
       m_init(false), m_pts(0), m_solve_time(0.0),
       m_ss_jac_age(10), m_ts_jac_age(20),
-      m_interrupt(0), m_nevals(0), m_evaltime(0.0)
+      m_interrupt(0), m_nevals(0), m_evaltime(0.0),
+      m_nTimeSteps(0), m_nTimeStepFailures(0)
 {
     m_newt = new MultiNewton(1);
 }
@@ -31,9 +36,11 @@ OneDim::OneDim(vector<Domain1D*> domains) :
     m_jac(0), m_newt(0),
     m_rdt(0.0), m_jac_ok(false),
     m_nd(0), m_bw(0), m_size(0),
+    m_linear_solver(c_Band_LinearSolver),
     m_init(false), m_solve_time(0.0),
     m_ss_jac_age(10), m_ts_jac_age(20),
-    m_interrupt(0), m_nevals(0), m_evaltime(0.0)
+    m_interrupt(0), m_nevals(0), m_evaltime(0.0),
+    m_nTimeSteps(0), m_nTimeStepFailures(0)
 {
     // create a Newton iterator, and add each domain.
     m_newt = new MultiNewton(1);
@@ -99,45 +106,161 @@ void OneDim::writeStats(int printTime)
     char buf[100];
     sprintf(buf,"\nStatistics:\n\n Grid   Functions   Time      Jacobians   Time \n");
     writelog(buf);
-    size_t n = m_gridpts.size();
-    for (size_t i = 0; i < n; i++) {
+    // All of the statistics are saved together, so either all or none of
+    // them are present
+    if (m_stats.find("points") == m_stats.end()) {
+        return;
+    }
+    const vector_fp& pts = m_stats.find("points")->second;
+    const vector_fp& nfunc = m_stats.find("residual_evals")->second;
+    const vector_fp& tfunc = m_stats.find("residual_time")->second;
+    const vector_fp& njac = m_stats.find("jacobian_evals")->second;
+    const vector_fp& tjac = m_stats.find("jacobian_time")->second;
+    for (size_t i = 0; i < pts.size(); i++) {
         if (printTime) {
             sprintf(buf,"%5s   %5i    %9.4f    %5i    %9.4f \n",
-                    int2str(m_gridpts[i]).c_str(), m_funcEvals[i], m_funcElapsed[i],
-                    m_jacEvals[i], m_jacElapsed[i]);
+                    int2str(int(pts[i])).c_str(), int(nfunc[i]), tfunc[i],
+                    int(njac[i]), tjac[i]);
         } else {
             sprintf(buf,"%5s   %5i       NA        %5i        NA    \n",
-                    int2str(m_gridpts[i]).c_str(), m_funcEvals[i], m_jacEvals[i]);
+                    int2str(int(pts[i])).c_str(), int(nfunc[i]), int(njac[i]));
         }
         writelog(buf);
     }
 }
 
+bool OneDim::currentStats(std::map<std::string, double>& stats) const
+{
+    if (!m_jac || m_jac->nEvals() == 0 || m_nevals == 0) {
+        return false;
+    }
+    stats["points"] = double(m_pts);
+    stats["residual_evals"] = m_nevals;
+    stats["residual_time"] = m_evaltime;
+    stats["jacobian_evals"] = m_jac->nEvals();
+    stats["jacobian_time"] = m_jac->elapsedTime();
+    stats["factorizations"] = m_jac->nFactorizations();
+    stats["linear_solve_time"] = m_jac->solveTime();
+    stats["newton_iterations"] = m_newt->nIterations();
+    stats["damping_reductions"] = m_newt->nDampReductions();
+    stats["newton_failures"] = m_newt->nFailures();
+    stats["newton_time"] = m_newt->elapsedTime();
+    stats["time_steps"] = m_nTimeSteps;
+    stats["time_step_failures"] = m_nTimeStepFailures;
+    double tthermo = 0.0, tkin = 0.0, ttran = 0.0;
+    for (size_t i = 0; i < m_nd; i++) {
+        const StFlow* flow = dynamic_cast<const StFlow*>(m_dom[i]);
+        if (flow) {
+            tthermo += flow->thermoTime();
+            tkin += flow->kineticsTime();
+            ttran += flow->transportTime();
+        }
+    }
+    stats["thermo_time"] = tthermo;
+    stats["kinetics_time"] = tkin;
+    stats["transport_time"] = ttran;
+    return true;
+}
+
 void OneDim::saveStats()
 {
-    if (m_jac) {
-        int nev = m_jac->nEvals();
-        if (nev > 0 && m_nevals > 0) {
-            m_gridpts.push_back(m_pts);
-            m_jacEvals.push_back(m_jac->nEvals());
-            m_jacElapsed.push_back(m_jac->elapsedTime());
-            m_funcEvals.push_back(m_nevals);
-            m_nevals = 0;
-            m_funcElapsed.push_back(m_evaltime);
-            m_evaltime = 0.0;
+    std::map<std::string, double> current;
+    if (!currentStats(current)) {
+        return;
+    }
+    for (std::map<std::string, double>::iterator iter = current.begin();
+         iter != current.end(); ++iter) {
+        m_stats[iter->first].push_back(iter->second);
+    }
+    m_nevals = 0;
+    m_evaltime = 0.0;
+    m_nTimeSteps = 0;
+    m_nTimeStepFailures = 0;
+    m_newt->clearStats();
+    for (size_t i = 0; i < m_nd; i++) {
+        StFlow* flow = dynamic_cast<StFlow*>(m_dom[i]);
+        if (flow) {
+            flow->clearPropertyTimers();
         }
     }
 }
 
 void OneDim::clearStats()
 {
-    m_gridpts.clear();
-    m_jacEvals.clear();
-    m_jacElapsed.clear();
-    m_funcEvals.clear();
-    m_funcElapsed.clear();
+    m_stats.clear();
     m_nevals = 0;
     m_evaltime = 0.0;
+    m_nTimeSteps = 0;
+    m_nTimeStepFailures = 0;
+    m_newt->clearStats();
+    for (size_t i = 0; i < m_nd; i++) {
+        StFlow* flow = dynamic_cast<StFlow*>(m_dom[i]);
+        if (flow) {
+            flow->clearPropertyTimers();
+        }
+    }
+}
+
+std::vector<std::string> OneDim::statisticNames()
+{
+    static const char* names[] = {
+        "points", "residual_evals", "residual_time", "jacobian_evals",
+        "jacobian_time", "factorizations", "linear_solve_time",
+        "newton_iterations", "damping_reductions", "newton_failures",
+        "newton_time", "time_steps", "time_step_failures", "thermo_time",
+        "kinetics_time", "transport_time"
+    };
+    return std::vector<std::string>(names, names + sizeof(names)/sizeof(names[0]));
+}
+
+void OneDim::getStatistic(const std::string& name, vector_fp& values) const
+{
+    std::vector<std::string> names = statisticNames();
+    if (std::find(names.begin(), names.end(), name) == names.end()) {
+        throw CanteraError("OneDim::getStatistic",
+                           "Unknown statistic '" + name + "'");
+    }
+    std::map<std::string, vector_fp>::const_iterator iter = m_stats.find(name);
+    if (iter != m_stats.end()) {
+        values = iter->second;
+    } else {
+        values.clear();
+    }
+    std::map<std::string, double> current;
+    if (currentStats(current)) {
+        values.push_back(current[name]);
+    }
+}
+
+std::string OneDim::statisticsJSON() const
+{
+    std::vector<std::string> names = statisticNames();
+    std::string out = "{";
+    vector_fp values;
+    for (size_t n = 0; n < names.size(); n++) {
+        getStatistic(names[n], values);
+        out += (n == 0) ? "\n" : ",\n";
+        out += "    \"" + names[n] + "\": [";
+        for (size_t i = 0; i < values.size(); i++) {
+            if (i != 0) {
+                out += ", ";
+            }
+            out += fp2str(values[i], "%.10g");
+        }
+        out += "]";
+    }
+    out += "\n}\n";
+    return out;
+}
+
+void OneDim::setPropertyTiming(bool enable)
+{
+    for (size_t i = 0; i < m_nd; i++) {
+        StFlow* flow = dynamic_cast<StFlow*>(m_dom[i]);
+        if (flow) {
+            flow->setPropertyTiming(enable);
+        }
+    }
 }
 
 void OneDim::resize()
@@ -189,7 +312,7 @@ void OneDim::resize()
 
     // delete the current Jacobian evaluator and create a new one
     delete m_jac;
-    m_jac = new MultiJac(*this);
+    m_jac = new MultiJac(*this, m_linear_solver);
     m_jac_ok = false;
 
     for (size_t i = 0; i < m_nd; i++) {
@@ -197,6 +320,26 @@ void OneDim::resize()
     }
 }
 
+void OneDim::setLinearSolver(int solver)
+{
+    if (solver != c_Band_LinearSolver && solver != c_Sparse_LinearSolver) {
+        throw CanteraError("OneDim::setLinearSolver",
+                           "Unknown linear solver type: " + int2str(solver));
+    }
+    if (solver == m_linear_solver) {
+        return;
+    }
+    m_linear_solver = solver;
+    if (m_jac) {
+        delete m_jac;
+        m_jac = new MultiJac(*this, m_linear_solver);
+        m_jac_ok = false;
+        for (size_t i = 0; i < m_nd; i++) {
+            m_dom[i]->setJac(m_jac);
+        }
+    }
+}
+
 int OneDim::solve(doublereal* x, doublereal* xnew, int loglevel)
 {
     if (!m_jac_ok) {
@@ -232,7 +375,7 @@ Domain1D* OneDim::pointDomain(size_t i)
 
 void OneDim::eval(size_t j, double* x, double* r, doublereal rdt, int count)
 {
-    clock_t t0 = clock();
+    clockWC t0;
     if (m_interrupt) {
         m_interrupt->eval(m_nevals);
     }
@@ -255,8 +398,7 @@ void OneDim::eval(size_t j, double* x, double* r, doublereal rdt, int count)
 
     // increment counter and time
     if (count) {
-        clock_t t1 = clock();
-        m_evaltime += double(t1 - t0)/CLOCKS_PER_SEC;
+        m_evaltime += t0.secondsWC();
         m_nevals++;
     }
 }
@@ -344,6 +486,7 @@ doublereal OneDim::timeStep(int nsteps, doublereal dt, doublereal* x,
         // the current solution in x.
         if (m >= 0) {
             n += 1;
+            m_nTimeSteps++;
             writelog("\n", loglevel);
             copy(r, r + m_size, x);
             if (m == 100) {
@@ -356,6 +499,7 @@ doublereal OneDim::timeStep(int nsteps, doublereal dt, doublereal* x,
         // Decrease the stepsize and try again.
         else {
             writelog("...failure.\n", loglevel);
+            m_nTimeStepFailures++;
             dt *= m_tfactor;
             if (dt < m_tmin)
                 throw CanteraError("OneDim::timeStep",
@@ -7,8 +7,10 @@
 #include "cantera/oneD/StFlow.h"
 #include "cantera/numerics/funcs.h"
 #include "cantera/base/xml.h"
+#include "cantera/base/clockWC.h"
 
 #include <fstream>
+#include <ctime>
 
 using namespace std;
 
@@ -16,12 +18,14 @@ namespace Cantera
 {
 
 Sim1D::Sim1D() :
-    OneDim()
+    OneDim(),
+    m_cubic_interp(false)
 {
 }
 
 Sim1D::Sim1D(vector<Domain1D*>& domains) :
-    OneDim(domains)
+    OneDim(domains),
+    m_cubic_interp(false)
 {
     // resize the internal solution vector and the work array, and perform
     // domain-specific initialization of the solution vector.
@@ -225,10 +229,18 @@ void Sim1D::solve(int loglevel, bool refine_grid)
     doublereal dt = m_tstep;
     int soln_number = -1;
     finalize();
+    m_passPoints.clear();
+    m_passAdded.clear();
+    m_passRemoved.clear();
+    m_passTimeSteps.clear();
+    m_passSolveTime.clear();
+    m_passRefineTime.clear();
 
     while (new_points > 0) {
         size_t istep = 0;
         nsteps = m_steps[istep];
+        int totalSteps = 0;
+        clockWC t0;
 
         bool ok = false;
         if (loglevel > 0) {
@@ -274,6 +286,7 @@ void Sim1D::solve(int loglevel, bool refine_grid)
                 writelog("Take "+int2str(nsteps)+" timesteps   ", loglevel);
                 dt = timeStep(nsteps, dt, DATA_PTR(m_x), DATA_PTR(m_xnew),
                               loglevel-1);
+                totalSteps += nsteps;
                 if (loglevel > 6) {
                     save("debug_sim1d.xml", "debug", "After timestepping");
                 }
@@ -302,9 +315,18 @@ void Sim1D::solve(int loglevel, bool refine_grid)
         if (loglevel > 2) {
             showSolution();
         }
+        m_passPoints.push_back(points());
+        m_passTimeSteps.push_back(totalSteps);
+        m_passSolveTime.push_back(t0.secondsWC());
+        m_passAdded.push_back(0);
+        m_passRemoved.push_back(0);
+        m_passRefineTime.push_back(0.0);
 
         if (refine_grid) {
-            new_points = refine(loglevel);
+            t0.start();
+            new_points = refine(loglevel, m_passAdded.back(),
+                                m_passRemoved.back());
+            m_passRefineTime.back() = t0.secondsWC();
             if (new_points) {
                 // If the grid has changed, preemptively reduce the timestep
                 // to avoid multiple successive failed time steps.
@@ -325,14 +347,32 @@ void Sim1D::solve(int loglevel, bool refine_grid)
             writelog("grid refinement disabled.\n", loglevel);
             new_points = 0;
         }
+        if (loglevel > 0) {
+            writelog("Pass " + int2str(m_passPoints.size()) + ": " +
+                     int2str(m_passPoints.back()) + " points, " +
+                     int2str(totalSteps) + " time steps, solve time " +
+                     fp2str(m_passSolveTime.back()) + " s; " +
+                     int2str(m_passAdded.back()) + " points added, " +
+                     int2str(m_passRemoved.back()) + " removed, refine time " +
+                     fp2str(m_passRefineTime.back()) + " s\n");
+        }
     }
 }
 
 int Sim1D::refine(int loglevel)
 {
-    int ianalyze, np = 0;
+    int added, removed;
+    int status = refine(loglevel, added, removed);
+    return (status < 0) ? status : added;
+}
+
+int Sim1D::refine(int loglevel, int& added, int& removed)
+{
+    int ianalyze;
+    added = 0;
+    removed = 0;
     vector_fp znew, xnew;
-    doublereal xmid, zmid;
+    doublereal zmid;
     std::vector<size_t> dsize;
 
     for (size_t n = 0; n < m_nd; n++) {
@@ -350,7 +390,6 @@ int Sim1D::refine(int loglevel)
             r.show();
         }
 
-        np += r.nNewPoints();
         size_t comp = d.nComponents();
 
         // loop over points in the current grid
@@ -376,16 +415,16 @@ int Sim1D::refine(int loglevel)
                     // add new point at midpoint
                     zmid = 0.5*(d.grid(m) + d.grid(m+1));
                     znew.push_back(zmid);
-                    np++;
+                    added++;
 
-                    // for each component, linearly interpolate
-                    // the solution to this point
+                    // for each component, interpolate the solution to this
+                    // point
                     for (size_t i = 0; i < comp; i++) {
-                        xmid = 0.5*(value(n, i, m) + value(n, i, m+1));
-                        xnew.push_back(xmid);
+                        xnew.push_back(midpointValue(n, i, m));
                     }
                 }
             } else {
+                removed++;
                 writelog("refine: discarding point at "+fp2str(d.grid(m))+"\n", loglevel);
             }
         }
@@ -414,7 +453,65 @@ int Sim1D::refine(int loglevel)
 
     resize();
     finalize();
-    return np;
+
+    // A grid from which points have been removed also needs a new solution,
+    // even if no points were added.
+    return added + removed;
+}
+
+doublereal Sim1D::midpointValue(size_t n, size_t i, size_t m)
+{
+    doublereal x0 = value(n, i, m);
+    doublereal x1 = value(n, i, m+1);
+    if (!m_cubic_interp) {
+        return 0.5*(x0 + x1);
+    }
+
+    // Monotone piecewise cubic Hermite interpolation (Fritsch and Butland).
+    // The derivatives at the interior points are weighted harmonic means of
+    // the adjacent slopes, or zero at local extrema. At the ends of the
+    // domain, the slope of the end interval is used.
+    Domain1D& d = domain(n);
+    doublereal h = d.grid(m+1) - d.grid(m);
+    doublereal s = (x1 - x0) / h;
+    doublereal deriv[2] = {s, s};
+    for (int k = 0; k < 2; k++) {
+        // the point where the derivative is needed, and the interval on
+        // its other side
+        size_t j = m + k;
+        if (j == 0 || j == d.nPoints() - 1) {
+            continue;
+        }
+        doublereal hl = d.grid(j) - d.grid(j-1);
+        doublereal hr = d.grid(j+1) - d.grid(j);
+        doublereal sl = (value(n, i, j) - value(n, i, j-1)) / hl;
+        doublereal sr = (value(n, i, j+1) - value(n, i, j)) / hr;
+        if (sl * sr <= 0.0) {
+            deriv[k] = 0.0;
+        } else {
+            doublereal wl = 2*hr + hl;
+            doublereal wr = hr + 2*hl;
+            deriv[k] = (wl + wr) / (wl/sl + wr/sr);
+        }
+    }
+    return 0.5*(x0 + x1) + 0.125*h*(deriv[0] - deriv[1]);
+}
+
+void Sim1D::setInterpolation(const std::string& method)
+{
+    if (method == "linear") {
+        m_cubic_interp = false;
+    } else if (method == "cubic") {
+        m_cubic_interp = true;
+    } else {
+        throw CanteraError("Sim1D::setInterpolation",
+                           "Unknown interpolation method: '" + method + "'");
+    }
+}
+
+std::string Sim1D::interpolation() const
+{
+    return m_cubic_interp ? "cubic" : "linear";
 }
 
 int Sim1D::setFixedTemperature(doublereal t)
@@ -559,11 +656,90 @@ void Sim1D::setMaxGridPoints(int dom, int npoints)
 
 doublereal Sim1D::jacobian(int i, int j)
 {
-    return OneDim::jacobian().value(i,j);
+    const MultiJac& jac = OneDim::jacobian();
+    return jac.value(i,j);
 }
 
 void Sim1D::evalSSJacobian()
 {
     OneDim::evalSSJacobian(DATA_PTR(m_x), DATA_PTR(m_xnew));
 }
+
+void Sim1D::solveAdjoint(const doublereal* b, doublereal* lambda)
+{
+    // The Jacobian used by the Newton solver holds the transport properties
+    // fixed, which is not accurate enough for computing sensitivities.
+    for (size_t n = 0; n < m_nd; n++) {
+        domain(n).forceFullUpdate(true);
+    }
+    try {
+        evalSSJacobian();
+    } catch (...) {
+        for (size_t n = 0; n < m_nd; n++) {
+            domain(n).forceFullUpdate(false);
+        }
+        throw;
+    }
+    for (size_t n = 0; n < m_nd; n++) {
+        domain(n).forceFullUpdate(false);
+    }
+    copy(b, b + size(), lambda);
+    int info = m_jac->solveTranspose(lambda);
+    if (info != 0) {
+        throw CanteraError("Sim1D::solveAdjoint",
+                           "Factorization or solution of the transposed "
+                           "Jacobian failed. info = " + int2str(info));
+    }
+}
+
+void Sim1D::getReactionSensitivities(const doublereal* dgdx, vector_fp& sens)
+{
+    size_t nr = npos;
+    for (size_t n = 0; n < m_nd; n++) {
+        StFlow* d = dynamic_cast<StFlow*>(&domain(n));
+        if (!d) {
+            continue;
+        }
+        if (nr == npos) {
+            nr = d->kinetics().nReactions();
+        } else if (d->kinetics().nReactions() != nr) {
+            throw CanteraError("Sim1D::getReactionSensitivities",
+                               "All flow domains must use the same set of "
+                               "reactions.");
+        }
+    }
+    if (nr == npos) {
+        throw CanteraError("Sim1D::getReactionSensitivities",
+                           "No flow domain found.");
+    }
+
+    vector_fp lambda(size());
+    solveAdjoint(dgdx, DATA_PTR(lambda));
+
+    // dg/dp = -lambda^T * dF/dp, since F(x(p), p) = 0
+    sens.assign(nr, 0.0);
+    for (size_t n = 0; n < m_nd; n++) {
+        StFlow* d = dynamic_cast<StFlow*>(&domain(n));
+        if (d) {
+            d->evalRateDerivatives(DATA_PTR(m_x), DATA_PTR(lambda),
+                                   DATA_PTR(sens));
+        }
+    }
+    scale(sens.begin(), sens.end(), sens.begin(), -1.0);
+}
+
+doublereal Sim1D::componentReactionSensitivities(size_t dom, size_t comp,
+                                                 size_t localPoint,
+                                                 vector_fp& sens)
+{
+    checkDomainIndex(dom);
+    size_t iloc = domain(dom).loc() + domain(dom).index(comp, localPoint);
+    AssertThrowMsg(iloc < m_x.size(), "Sim1D::componentReactionSensitivities",
+                   "Index out of bounds:" + int2str(iloc) + " > " +
+                   int2str(m_x.size()));
+    vector_fp dgdx(size(), 0.0);
+    dgdx[iloc] = 1.0;
+    getReactionSensitivities(DATA_PTR(dgdx), sens);
+    return m_x[iloc];
+}
 }
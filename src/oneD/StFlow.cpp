@@ -9,6 +9,7 @@
 #include "cantera/numerics/funcs.h"
 
 #include <cstdio>
+#include <ctime>
 
 using namespace ctml;
 using namespace std;
@@ -30,7 +31,12 @@ StFlow::StFlow(IdealGasPhase* ph, size_t nsp, size_t points) :
     m_jac(0),
     m_ok(false),
     m_do_soret(false),
-    m_transport_option(-1)
+    m_transport_option(-1),
+    m_force_full_update(false),
+    m_timing(false),
+    m_thermo_time(0.0),
+    m_kinetics_time(0.0),
+    m_transport_time(0.0)
 {
     m_type = cFlowType;
 
@@ -66,6 +72,7 @@ StFlow::StFlow(IdealGasPhase* ph, size_t nsp, size_t points) :
     m_multidiff.resize(m_nsp*m_nsp*m_points);
     m_flux.resize(m_nsp,m_points);
     m_wdot.resize(m_nsp,m_points, 0.0);
+    m_cp_R.resize(m_nsp, m_points, 0.0);
     m_surfdot.resize(m_nsp, 0.0);
     m_ybar.resize(m_nsp);
 
@@ -119,6 +126,8 @@ void StFlow::resize(size_t ncomponents, size_t points)
     }
     m_flux.resize(m_nsp,m_points);
     m_wdot.resize(m_nsp,m_points, 0.0);
+    m_cp_R.resize(m_nsp, m_points, 0.0);
+    m_qdot.resize(m_points, 0.0);
     m_do_energy.resize(m_points,false);
 
     m_fixedy.resize(m_nsp, m_points);
@@ -261,11 +270,7 @@ void StFlow::eval(size_t jg, doublereal* xg,
     //              update properties
     //-----------------------------------------------------
 
-    updateThermo(x, j0, j1);
-    // update transport properties only if a Jacobian is not being evaluated
-    if (jg == npos) {
-        updateTransport(x, j0, j1);
-    }
+    updateProperties(jg, x, jmin, jmax);
 
     // update the species diffusive mass fluxes whether or not a
     // Jacobian is being evaluated
@@ -342,8 +347,6 @@ void StFlow::eval(size_t jg, doublereal* xg,
             //   = M_k\omega_k
             //
             //-------------------------------------------------
-            getWdot(x,j);
-
             doublereal convec, diffus;
             for (k = 0; k < m_nsp; k++) {
                 convec = rho_u(x,j)*dYdz(x,k,j);
@@ -366,28 +369,20 @@ void StFlow::eval(size_t jg, doublereal* xg,
             //-----------------------------------------------
 
             if (m_do_energy[j]) {
-
-                setGas(x,j);
-
-                // heat release term
-                const vector_fp& h_RT = m_thermo->enthalpy_RT_ref();
-                const vector_fp& cp_R = m_thermo->cp_R_ref();
-
-                sum = 0.0;
+                // enthalpy flux term
+                const doublereal* cp_R = &m_cp_R(0,j);
                 sum2 = 0.0;
                 doublereal flxk;
                 for (k = 0; k < m_nsp; k++) {
                     flxk = 0.5*(m_flux(k,j-1) + m_flux(k,j));
-                    sum += wdot(k,j)*h_RT[k];
                     sum2 += flxk*cp_R[k]/m_wt[k];
                 }
-                sum *= GasConstant * T(x,j);
                 dtdzj = dTdz(x,j);
                 sum2 *= GasConstant * dtdzj;
 
                 rsd[index(c_offset_T, j)]   =
                     - m_cp[j]*rho_u(x,j)*dtdzj
-                    - divHeatFlux(x,j) - sum - sum2;
+                    - divHeatFlux(x,j) + m_qdot[j] - sum2;
                 rsd[index(c_offset_T, j)] /= (m_rho[j]*m_cp[j]);
 
                 rsd[index(c_offset_T, j)] -= rdt*(T(x,j) - T_prev(j));
@@ -404,36 +399,148 @@ void StFlow::eval(size_t jg, doublereal* xg,
     }
 }
 
-void StFlow::updateTransport(doublereal* x, size_t j0, size_t j1)
+void StFlow::evalRateDerivatives(const doublereal* xg,
+                                 const doublereal* lambdag, doublereal* dfdp)
 {
-    if (m_transport_option == c_Mixav_Transport) {
-        for (size_t j = j0; j < j1; j++) {
-            setGasAtMidpoint(x,j);
-            m_visc[j] = (m_dovisc ? m_trans->viscosity() : 0.0);
-            m_trans->getMixDiffCoeffs(DATA_PTR(m_diff) + j*m_nsp);
-            m_tcon[j] = m_trans->thermalConductivity();
+    const doublereal* x = xg + loc();
+    const doublereal* lam = lambdag + loc();
+    size_t nr = m_kin->nReactions();
+    vector_fp ropnet(nr), delta(nr), w(m_nsp);
+
+    updateThermo(x, 0, m_points - 1);
+    for (size_t j = 1; j < m_points - 1; j++) {
+        setGas(x, j);
+        m_kin->getNetRatesOfProgress(DATA_PTR(ropnet));
+
+        // Weight of each species' net production rate in the projected
+        // residual. The species equations contain M_k*wdot_k/rho, and the
+        // energy equation contains -sum_k(wdot_k*h_k)/(rho*cp).
+        for (size_t k = 0; k < m_nsp; k++) {
+            w[k] = lam[index(c_offset_Y + k, j)] * m_wt[k] / m_rho[j];
         }
-    } else if (m_transport_option == c_Multi_Transport) {
-        for (size_t j = j0; j < j1; j++) {
-            setGasAtMidpoint(x,j);
-            doublereal wtm = m_thermo->meanMolecularWeight();
-            doublereal rho = m_thermo->density();
-            m_visc[j] = (m_dovisc ? m_trans->viscosity() : 0.0);
-            m_trans->getMultiDiffCoeffs(m_nsp, &m_multidiff[mindex(0,0,j)]);
-
-            // Use m_diff as storage for the factor outside the summation
+        if (m_do_energy[j]) {
+            const vector_fp& h_RT = m_thermo->enthalpy_RT_ref();
+            doublereal c = lam[index(c_offset_T, j)] * GasConstant * T(x,j)
+                           / (m_rho[j] * m_cp[j]);
             for (size_t k = 0; k < m_nsp; k++) {
-                m_diff[k+j*m_nsp] = m_wt[k] * rho / (wtm*wtm);
+                w[k] -= c * h_RT[k];
             }
+        }
 
-            m_tcon[j] = m_trans->thermalConductivity();
-            if (m_do_soret) {
-                m_trans->getThermalDiffCoeffs(m_dthermal.ptrColumn(0) + j*m_nsp);
+        // wdot_k = sum_i(nu_ki * q_i), so d(wdot_k)/d(ln m_i) = nu_ki * q_i
+        m_kin->getReactionDelta(DATA_PTR(w), DATA_PTR(delta));
+        for (size_t i = 0; i < nr; i++) {
+            dfdp[i] += delta[i] * ropnet[i];
+        }
+    }
+}
+
+//! Add the time elapsed since `tlast` on `clock` to `timer`, and update
+//! `tlast` to the current time
+static void lapTime(clockWC& clock, doublereal& tlast, doublereal& timer)
+{
+    doublereal t = clock.secondsWC();
+    timer += t - tlast;
+    tlast = t;
+}
+
+void StFlow::updateProperties(size_t jg, const doublereal* x, size_t jmin,
+                              size_t jmax)
+{
+    size_t j0 = std::max<size_t>(jmin, 1) - 1;
+    size_t j1 = std::min(jmax+1,m_points-1);
+
+    // update transport properties only if a Jacobian is not being evaluated,
+    // unless a full update has been requested
+    bool updateTrans = (jg == npos || m_force_full_update);
+
+    // Reading the clock is not negligible compared to the cost of evaluating
+    // the properties at one point, so the timers are only updated if requested
+    doublereal t0 = 0.0;
+    if (m_timing) {
+        m_clock.start();
+    }
+    for (size_t j = j0; j <= j1; j++) {
+        setGas(x,j);
+        m_rho[j] = m_thermo->density();
+        m_wtm[j] = m_thermo->meanMolecularWeight();
+        m_cp[j] = m_thermo->cp_mass();
+
+        // The production rates and species properties are only needed for
+        // the residual equations at interior points
+        if (j >= jmin && j <= jmax && j != 0 && j != m_points - 1) {
+            if (m_do_energy[j]) {
+                const vector_fp& cp_R = m_thermo->cp_R_ref();
+                copy(cp_R.begin(), cp_R.end(), &m_cp_R(0,j));
             }
+            if (m_timing) {
+                lapTime(m_clock, t0, m_thermo_time);
+            }
+
+            m_kin->getNetProductionRates(&m_wdot(0,j));
+            if (m_do_energy[j]) {
+                const vector_fp& h_RT = m_thermo->enthalpy_RT_ref();
+                doublereal sum = 0.0;
+                for (size_t k = 0; k < m_nsp; k++) {
+                    sum += m_wdot(k,j)*h_RT[k];
+                }
+                m_qdot[j] = -sum * GasConstant * T(x,j);
+            }
+            if (m_timing) {
+                lapTime(m_clock, t0, m_kinetics_time);
+            }
+        }
+
+    }
+    if (m_timing) {
+        lapTime(m_clock, t0, m_thermo_time);
+    }
+
+    // Transport properties are evaluated in a separate pass, since for large
+    // mechanisms, alternating between the kinetics and transport data at
+    // each point makes poor use of the cache.
+    if (updateTrans) {
+        for (size_t j = j0; j < j1; j++) {
+            updateTransport(x, j);
+        }
+        if (m_timing) {
+            lapTime(m_clock, t0, m_transport_time);
         }
     }
 }
 
+void StFlow::updateTransport(const doublereal* x, size_t j)
+{
+    setGasAtMidpoint(x,j);
+    if (m_transport_option == c_Mixav_Transport) {
+        m_visc[j] = (m_dovisc ? m_trans->viscosity() : 0.0);
+        m_trans->getMixDiffCoeffs(DATA_PTR(m_diff) + j*m_nsp);
+        m_tcon[j] = m_trans->thermalConductivity();
+    } else if (m_transport_option == c_Multi_Transport) {
+        doublereal wtm = m_thermo->meanMolecularWeight();
+        doublereal rho = m_thermo->density();
+        m_visc[j] = (m_dovisc ? m_trans->viscosity() : 0.0);
+        m_trans->getMultiDiffCoeffs(m_nsp, &m_multidiff[mindex(0,0,j)]);
+
+        // Use m_diff as storage for the factor outside the summation
+        for (size_t k = 0; k < m_nsp; k++) {
+            m_diff[k+j*m_nsp] = m_wt[k] * rho / (wtm*wtm);
+        }
+
+        m_tcon[j] = m_trans->thermalConductivity();
+        if (m_do_soret) {
+            m_trans->getThermalDiffCoeffs(m_dthermal.ptrColumn(0) + j*m_nsp);
+        }
+    }
+}
+
+void StFlow::updateTransport(doublereal* x, size_t j0, size_t j1)
+{
+    for (size_t j = j0; j < j1; j++) {
+        updateTransport(x, j);
+    }
+}
+
 void StFlow::showSolution(const doublereal* x)
 {
     size_t nn = m_nv/5;
@@ -0,0 +1,396 @@
+//! @file ChemistryIntegrator.cpp
+#include "cantera/zeroD/ChemistryIntegrator.h"
+#include "cantera/numerics/ctlapack.h"
+#include "cantera/base/stringUtils.h"
+
+#include <cfloat>
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace {
+// Coefficients of the ROS3 method (Sandu et al., 1997). The stage values
+// are y + sum_j A[i][j]*K[j], and the stage vectors K[i] satisfy
+// (I/(h*gamma) - J) K[i] = f(stage i) + sum_j C[i][j]/h * K[j].
+const double ros_gamma = 0.43586652150845899941601945119356;
+const double ros_A21 = 1.0;
+const double ros_C21 = -1.0156171083877702091975600115545;
+const double ros_C31 = 4.0759956452537699824805835358067;
+const double ros_C32 = 9.2076794298330791242156818474003;
+const double ros_M[3] = {1.0, 6.1697947043828245592553615689730,
+                         -0.42772256543218573326238373806514};
+const double ros_E[3] = {0.5, -2.9079558716805469821718236208017,
+                         0.22354069897811569627360909276199};
+
+// Step size control
+const double facSafe = 0.9;
+const double facMin = 0.2;
+const double facMax = 6.0;
+const double facRej = 0.1;
+// Largest factor by which a step is stretched to reach the end of the interval
+const double facStretch = 1.1;
+
+// Absolute tolerance for the temperature [K]
+const double atolT = 1.0e-6;
+}
+
+ChemistryIntegrator::ChemistryIntegrator(ThermoPhase& thermo, Kinetics& kin) :
+    m_thermo(thermo),
+    m_kin(kin),
+    m_nsp(thermo.nSpecies()),
+    m_nv(thermo.nSpecies() + 1),
+    m_pressure(thermo.pressure()),
+    m_rtol(1.0e-6),
+    m_atol(1.0e-12),
+    m_maxSteps(100000),
+    m_h0(0.0),
+    m_hlast(0.0),
+    m_rho(0.0),
+    m_cp(0.0)
+{
+    if (thermo.eosType() != cIdealGas) {
+        throw CanteraError("ChemistryIntegrator",
+                           "Incompatible phase type provided");
+    }
+    if (kin.nPhases() != 1 || &kin.thermo(0) != &thermo) {
+        throw CanteraError("ChemistryIntegrator", "The Kinetics object must "
+                           "be homogeneous and use the given phase.");
+    }
+    resetSolverStats();
+    m_y.resize(m_nv);
+    m_ynew.resize(m_nv);
+    m_ystage.resize(m_nv);
+    m_f0.resize(m_nv);
+    m_f1.resize(m_nv);
+    m_K.resize(3 * m_nv);
+    m_err.resize(m_nv);
+    m_jac.resize(m_nv * m_nv);
+    m_lu.resize(m_nv * m_nv);
+    m_ipiv.resize(m_nv);
+    m_ddC.resize(m_nsp * m_nsp);
+    m_wdot.resize(m_nsp);
+    m_hk.resize(m_nsp);
+    m_cpk.resize(m_nsp);
+    m_work.resize(2 * m_nsp);
+}
+
+void ChemistryIntegrator::setTolerances(double rtol, double atol)
+{
+    if (rtol <= 0.0 || atol <= 0.0) {
+        throw CanteraError("ChemistryIntegrator::setTolerances",
+                           "Tolerances must be positive.");
+    }
+    m_rtol = rtol;
+    m_atol = atol;
+}
+
+void ChemistryIntegrator::eval(const double* y, double* ydot)
+{
+    m_thermo.setMassFractions_NoNorm(y + 1);
+    m_thermo.setState_TP(y[0], m_pressure);
+    m_rho = m_thermo.density();
+    m_cp = m_thermo.cp_mass();
+    m_kin.getNetProductionRates(&m_wdot[0]);
+    m_thermo.getPartialMolarEnthalpies(&m_hk[0]);
+    const vector_fp& mw = m_thermo.molecularWeights();
+
+    double q = 0.0;
+    for (size_t k = 0; k < m_nsp; k++) {
+        q += m_hk[k] * m_wdot[k];
+        ydot[k+1] = m_wdot[k] * mw[k] / m_rho;
+    }
+    ydot[0] = -q / (m_rho * m_cp);
+    m_nevals++;
+}
+
+void ChemistryIntegrator::evalJacobian(const double* y, const double* ydot,
+                                       double* jac)
+{
+    size_t n = m_nv;
+    const vector_fp& mw = m_thermo.molecularWeights();
+
+    // Temperature column, by finite differences. The rest of the Jacobian
+    // uses the thermodynamic state at y, which is restored by the call to
+    // eval().
+    double* col = jac;
+    copy(y, y + n, m_ystage.begin());
+    double dT = sqrt(DBL_EPSILON) * std::max(fabs(y[0]), 1.0);
+    m_ystage[0] += dT;
+    eval(&m_ystage[0], col);
+    eval(y, &m_f1[0]);
+    for (size_t i = 0; i < n; i++) {
+        col[i] = (col[i] - m_f1[i]) / dT;
+    }
+    m_thermo.getPartialMolarCp(&m_cpk[0]);
+    m_kin.getNetProductionRates_ddC(&m_ddC[0]);
+
+    // The derivatives of the production rates with respect to the mass
+    // fractions include the change in density at constant T and P:
+    //     dC_k/dY_j = rho/W_j delta_kj - C_k Wmean/W_j
+    double Wmean = m_thermo.meanMolecularWeight();
+    double* conc = &m_work[0];
+    double* s = conc + m_nsp;
+    m_thermo.getConcentrations(conc);
+    fill(s, s + m_nsp, 0.0);
+    for (size_t k = 0; k < m_nsp; k++) {
+        const double* ddC = &m_ddC[k * m_nsp];
+        for (size_t i = 0; i < m_nsp; i++) {
+            s[i] += ddC[i] * conc[k];
+        }
+    }
+
+    for (size_t j = 0; j < m_nsp; j++) {
+        col = jac + n * (j + 1);
+        const double* ddC = &m_ddC[j * m_nsp];
+        double dq = 0.0;
+        for (size_t k = 0; k < m_nsp; k++) {
+            // d(wdot_k)/dY_j
+            double dw = (ddC[k] * m_rho - s[k] * Wmean) / mw[j];
+            dq += m_hk[k] * dw;
+            col[k+1] = dw * mw[k] / m_rho + ydot[k+1] * Wmean / mw[j];
+        }
+        col[0] = -dq / (m_rho * m_cp)
+                 - ydot[0] * (m_cpk[j] / (mw[j] * m_cp) - Wmean / mw[j]);
+    }
+    m_njac++;
+}
+
+double ChemistryIntegrator::errorNorm(const double* x, const double* y0,
+                                      const double* y1) const
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < m_nv; i++) {
+        double atol = (i == 0) ? atolT : m_atol;
+        double sc = atol + m_rtol * std::max(fabs(y0[i]), fabs(y1[i]));
+        sum += (x[i] / sc) * (x[i] / sc);
+    }
+    return sqrt(sum / m_nv);
+}
+
+void ChemistryIntegrator::integrate(double& T, double* Y, double P, double dt,
+                                    double* dydy0)
+{
+    if (dt < 0.0) {
+        throw CanteraError("ChemistryIntegrator::integrate",
+                           "Negative time interval: " + fp2str(dt));
+    }
+    size_t n = m_nv;
+    m_pressure = P;
+    m_y[0] = T;
+    copy(Y, Y + m_nsp, m_y.begin() + 1);
+    if (dydy0) {
+        fill(dydy0, dydy0 + n * n, 0.0);
+        for (size_t i = 0; i < n; i++) {
+            dydy0[i * (n + 1)] = 1.0;
+        }
+        m_gradK.resize(3 * n * n);
+    }
+    if (dt == 0.0) {
+        m_thermo.setMassFractions_NoNorm(Y);
+        m_thermo.setState_TP(T, P);
+        return;
+    }
+
+    double* K1 = &m_K[0];
+    double* K2 = K1 + n;
+    double* K3 = K2 + n;
+    double t = 0.0;
+    double h = m_h0;
+    bool newJac = true;
+    bool rejected = false;
+    size_t nsteps = 0;
+
+    while (t < dt) {
+        if (newJac) {
+            eval(&m_y[0], &m_f0[0]);
+            if (h <= 0.0) {
+                // Estimate the initial step size from the magnitudes of the
+                // state and its rate of change, relative to the tolerances
+                double d0 = errorNorm(&m_y[0], &m_y[0], &m_y[0]);
+                double d1 = errorNorm(&m_f0[0], &m_y[0], &m_y[0]);
+                h = (d1 > 1.0e-2 * d0 / dt) ? 1.0e-2 * d0 / d1 : dt;
+            }
+            evalJacobian(&m_y[0], &m_f0[0], &m_jac[0]);
+            newJac = false;
+        }
+        // Take the last step exactly to the end of the interval. A step that
+        // would leave only a small remainder is stretched to reach the end
+        // instead, so that it is not followed by a very short step (or one
+        // consisting only of the round-off error in t).
+        bool last = (t + facStretch * h >= dt);
+        double hstep = last ? dt - t : h;
+        if (!(hstep > 1e-14 * dt) || nsteps >= m_maxSteps) {
+            m_thermo.setMassFractions_NoNorm(Y);
+            m_thermo.setState_TP(T, P);
+            throw CanteraError("ChemistryIntegrator::integrate",
+                "Integration failed at t = " + fp2str(t) + " with step "
+                "size h = " + fp2str(hstep) + " after " + int2str(nsteps) +
+                " steps.");
+        }
+
+        // Form and factor I/(h*gamma) - J
+        double diag = 1.0 / (hstep * ros_gamma);
+        for (size_t i = 0; i < n * n; i++) {
+            m_lu[i] = -m_jac[i];
+        }
+        for (size_t i = 0; i < n; i++) {
+            m_lu[i * (n + 1)] += diag;
+        }
+        int info = 0;
+        ct_dgetrf(n, n, &m_lu[0], n, &m_ipiv[0], info);
+        m_nlu++;
+        if (info != 0) {
+            // Singular iteration matrix; try a smaller step
+            h = hstep * facRej;
+            rejected = true;
+            m_nrejected++;
+            continue;
+        }
+
+        // Stage 1
+        copy(m_f0.begin(), m_f0.end(), K1);
+        ct_dgetrs(ctlapack::NoTranspose, n, 1, &m_lu[0], n, &m_ipiv[0],
+                  K1, n, info);
+
+        // Stage 2
+        for (size_t i = 0; i < n; i++) {
+            m_ystage[i] = m_y[i] + ros_A21 * K1[i];
+        }
+        eval(&m_ystage[0], &m_f1[0]);
+        for (size_t i = 0; i < n; i++) {
+            K2[i] = m_f1[i] + ros_C21 / hstep * K1[i];
+        }
+        ct_dgetrs(ctlapack::NoTranspose, n, 1, &m_lu[0], n, &m_ipiv[0],
+                  K2, n, info);
+
+        // Stage 3 is evaluated at the same point as stage 2
+        for (size_t i = 0; i < n; i++) {
+            K3[i] = m_f1[i] + (ros_C31 * K1[i] + ros_C32 * K2[i]) / hstep;
+        }
+        ct_dgetrs(ctlapack::NoTranspose, n, 1, &m_lu[0], n, &m_ipiv[0],
+                  K3, n, info);
+
+        // Solution and error estimate
+        bool finite = true;
+        for (size_t i = 0; i < n; i++) {
+            m_ynew[i] = m_y[i] + ros_M[0] * K1[i] + ros_M[1] * K2[i]
+                        + ros_M[2] * K3[i];
+            m_err[i] = ros_E[0] * K1[i] + ros_E[1] * K2[i] + ros_E[2] * K3[i];
+            finite &= (m_ynew[i] - m_ynew[i] == 0.0);
+        }
+        double err = finite ? errorNorm(&m_err[0], &m_y[0], &m_ynew[0])
+                     : 1.0e10;
+        double fac = facSafe * pow(std::max(err, 1.0e-10), -1.0 / 3.0);
+        fac = std::max(facMin, std::min(facMax, fac));
+
+        if (err <= 1.0) {
+            // Accept the step
+            if (dydy0) {
+                propagateGradient(hstep, dydy0);
+            }
+            t = last ? dt : t + hstep;
+            m_y.swap(m_ynew);
+            if (rejected) {
+                fac = std::min(fac, 1.0);
+            }
+            // A shortened or stretched last step does not set the size of the
+            // step proposed for the next call
+            if (!last || hstep == h) {
+                h = hstep * fac;
+            }
+            rejected = false;
+            newJac = true;
+            nsteps++;
+            m_nsteps++;
+        } else {
+            // Reject the step and retry with the same Jacobian
+            h = hstep * (rejected ? facRej : fac);
+            rejected = true;
+            m_nrejected++;
+        }
+    }
+    m_hlast = h;
+
+    T = m_y[0];
+    copy(m_y.begin() + 1, m_y.end(), Y);
+    m_thermo.setMassFractions_NoNorm(Y);
+    m_thermo.setState_TP(T, P);
+}
+
+void ChemistryIntegrator::propagateGradient(double h, double* X)
+{
+    // Apply the ROS3 step to the linearized equations dX/dt = J*X, using
+    // the Jacobian and LU factorization of the current step.
+    size_t n = m_nv;
+    size_t nn = n * n;
+    double* K1 = &m_gradK[0];
+    double* K2 = K1 + nn;
+    double* K3 = K2 + nn;
+    int info = 0;
+
+    // Stage 1: K1 = LU \ (J*X). J*X is kept in K2 for the next stages.
+    multiplyJacobian(X, K2);
+    copy(K2, K2 + nn, K1);
+    ct_dgetrs(ctlapack::NoTranspose, n, n, &m_lu[0], n, &m_ipiv[0],
+              K1, n, info);
+
+    // Stages 2 and 3 share the right-hand side J*(X + A21*K1)
+    multiplyJacobian(K1, K3);
+    for (size_t i = 0; i < nn; i++) {
+        double f = K2[i] + ros_A21 * K3[i];
+        K2[i] = f + ros_C21 / h * K1[i];
+        K3[i] = f;
+    }
+    ct_dgetrs(ctlapack::NoTranspose, n, n, &m_lu[0], n, &m_ipiv[0],
+              K2, n, info);
+    for (size_t i = 0; i < nn; i++) {
+        K3[i] += (ros_C31 * K1[i] + ros_C32 * K2[i]) / h;
+    }
+    ct_dgetrs(ctlapack::NoTranspose, n, n, &m_lu[0], n, &m_ipiv[0],
+              K3, n, info);
+
+    for (size_t i = 0; i < nn; i++) {
+        X[i] += ros_M[0] * K1[i] + ros_M[1] * K2[i] + ros_M[2] * K3[i];
+    }
+}
+
+void ChemistryIntegrator::multiplyJacobian(const double* X, double* out) const
+{
+    size_t n = m_nv;
+    fill(out, out + n * n, 0.0);
+    for (size_t c = 0; c < n; c++) {
+        const double* x = X + c * n;
+        double* y = out + c * n;
+        for (size_t k = 0; k < n; k++) {
+            if (x[k] != 0.0) {
+                const double* Jk = &m_jac[k * n];
+                for (size_t i = 0; i < n; i++) {
+                    y[i] += Jk[i] * x[k];
+                }
+            }
+        }
+    }
+}
+
+void ChemistryIntegrator::getSolverStats(
+    std::map<std::string, long int>& stats) const
+{
+    stats["steps"] = m_nsteps;
+    stats["err_test_fails"] = m_nrejected;
+    stats["rhs_evals"] = m_nevals;
+    stats["jac_evals"] = m_njac;
+    stats["lin_solve_setups"] = m_nlu;
+}
+
+void ChemistryIntegrator::resetSolverStats()
+{
+    m_nsteps = 0;
+    m_nrejected = 0;
+    m_nevals = 0;
+    m_njac = 0;
+    m_nlu = 0;
+}
+
+}
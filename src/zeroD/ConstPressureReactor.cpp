@@ -61,7 +61,7 @@ void ConstPressureReactor::updateState(doublereal* y)
     // save parameters needed by other connected reactors
     m_enthalpy = m_thermo->enthalpy_mass();
     m_intEnergy = m_thermo->intEnergy_mass();
-    m_thermo->saveState(m_state);
+    saveThermoState();
 }
 
 void ConstPressureReactor::evalEqs(doublereal time, doublereal* y,
@@ -70,7 +70,7 @@ void ConstPressureReactor::evalEqs(doublereal time, doublereal* y,
     double dmdt = 0.0; // dm/dt (gas phase)
     double* dYdt = ydot + 2;
 
-    m_thermo->restoreState(m_state);
+    restoreThermoState();
     applySensitivity(params);
     evalWalls(time);
     double mdot_surf = evalSurfaces(time, ydot + m_nsp + 2);
@@ -123,6 +123,18 @@ void ConstPressureReactor::evalEqs(doublereal time, doublereal* y,
     resetSensitivity(params);
 }
 
+bool ConstPressureReactor::evalParameterAdjoint(const double* lambda,
+                                                double* dfdp)
+{
+    // Only the species equations depend on the homogeneous reaction rates
+    const vector_fp& mw = m_thermo->molecularWeights();
+    vector_fp a(m_nsp);
+    for (size_t k = 0; k < m_nsp; k++) {
+        a[k] = lambda[k+2] * mw[k] * m_vol / m_mass;
+    }
+    return parameterAdjoint(&a[0], dfdp);
+}
+
 size_t ConstPressureReactor::componentIndex(const string& nm) const
 {
     size_t k = speciesIndex(nm);
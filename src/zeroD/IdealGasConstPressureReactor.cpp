@@ -68,7 +68,7 @@ void IdealGasConstPressureReactor::updateState(doublereal* y)
     // save parameters needed by other connected reactors
     m_enthalpy = m_thermo->enthalpy_mass();
     m_intEnergy = m_thermo->intEnergy_mass();
-    m_thermo->saveState(m_state);
+    saveThermoState();
 }
 
 void IdealGasConstPressureReactor::evalEqs(doublereal time, doublereal* y,
@@ -78,7 +78,7 @@ void IdealGasConstPressureReactor::evalEqs(doublereal time, doublereal* y,
     double mcpdTdt = 0.0; // m * c_p * dT/dt
     double* dYdt = ydot + 2;
 
-    m_thermo->restoreState(m_state);
+    restoreThermoState();
     applySensitivity(params);
     evalWalls(time);
     double mdot_surf = evalSurfaces(time, ydot + m_nsp + 2);
@@ -133,6 +133,23 @@ void IdealGasConstPressureReactor::evalEqs(doublereal time, doublereal* y,
     resetSensitivity(params);
 }
 
+bool IdealGasConstPressureReactor::evalParameterAdjoint(const double* lambda,
+                                                        double* dfdp)
+{
+    // The species equations and the energy equation depend on the
+    // homogeneous reaction rates. m_hk is set by evalEqs().
+    const vector_fp& mw = m_thermo->molecularWeights();
+    double cp = m_thermo->cp_mass();
+    vector_fp a(m_nsp);
+    for (size_t k = 0; k < m_nsp; k++) {
+        a[k] = lambda[k+2] * mw[k] * m_vol / m_mass;
+        if (m_energy) {
+            a[k] -= lambda[1] * m_hk[k] * m_vol / (m_mass * cp);
+        }
+    }
+    return parameterAdjoint(&a[0], dfdp);
+}
+
 size_t IdealGasConstPressureReactor::componentIndex(const string& nm) const
 {
     size_t k = speciesIndex(nm);
@@ -6,6 +6,8 @@
 #include "cantera/zeroD/FlowDevice.h"
 #include "cantera/zeroD/Wall.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace Cantera
@@ -66,15 +68,25 @@ void IdealGasReactor::updateState(doublereal* y)
     // and [K+3...] are the coverages of surface species on each wall.
     m_mass = y[0];
     m_vol = y[1];
-    m_thermo->setMassFractions_NoNorm(y+3);
-    m_thermo->setState_TR(y[2], m_mass / m_vol);
+    double rho = m_mass / m_vol;
     updateSurfaceState(y + m_nsp + 3);
 
+    // Skip updating the ThermoPhase if it already holds this state, e.g. when
+    // the governing equations are evaluated repeatedly at the same point
+    if (m_thermo->stateMFNumber() == m_thermoStateNum &&
+        m_state[0] == y[2] && m_state[1] == rho &&
+        m_thermo->temperature() == y[2] && m_thermo->density() == rho &&
+        equal(y + 3, y + 3 + m_nsp, m_state.begin() + 2)) {
+        return;
+    }
+    m_thermo->setMassFractions_NoNorm(y+3);
+    m_thermo->setState_TR(y[2], rho);
+
     // save parameters needed by other connected reactors
     m_enthalpy = m_thermo->enthalpy_mass();
     m_pressure = m_thermo->pressure();
     m_intEnergy = m_thermo->intEnergy_mass();
-    m_thermo->saveState(m_state);
+    saveThermoState();
 }
 
 void IdealGasReactor::evalEqs(doublereal time, doublereal* y,
@@ -84,7 +96,7 @@ void IdealGasReactor::evalEqs(doublereal time, doublereal* y,
     double mcvdTdt = 0.0; // m * c_v * dT/dt
     double* dYdt = ydot + 3;
 
-    m_thermo->restoreState(m_state);
+    restoreThermoState();
     applySensitivity(params);
     m_thermo->getPartialMolarIntEnergies(&m_uk[0]);
     const vector_fp& mw = m_thermo->molecularWeights();
@@ -150,6 +162,72 @@ void IdealGasReactor::evalEqs(doublereal time, doublereal* y,
     resetSensitivity(params);
 }
 
+bool IdealGasReactor::evalSpeciesJacobian(double t, const double* ydot,
+                                          double* jac, size_t ld)
+{
+    const vector_fp& mw = m_thermo->molecularWeights();
+    double rho = m_mass / m_vol;
+    double cv = m_thermo->cv_mass();
+    if (m_chem) {
+        m_dwdot_dC.resize(m_nsp * m_nsp);
+        m_kin->getNetProductionRates_ddC(&m_dwdot_dC[0]);
+    }
+    if (m_energy) {
+        // For an ideal gas, the partial molar heat capacity at constant
+        // volume is c_p,k - R
+        m_work.resize(std::max(m_work.size(), m_nsp));
+        m_thermo->getPartialMolarCp(&m_work[0]);
+    }
+
+    // dilution by mass added from surfaces and inlets
+    double mdot_in = 0.0;
+    for (size_t k = 0; k < m_nsp; k++) {
+        mdot_in += m_sdot[k] * mw[k];
+    }
+    for (size_t i = 0; i < m_inlet.size(); i++) {
+        mdot_in += m_inlet[i]->massFlowRate(t);
+    }
+
+    // With temperature as a state variable, the derivatives of the reaction
+    // rates with respect to the mass fractions are taken at constant T.
+    for (size_t j = 0; j < m_nsp; j++) {
+        double* col = jac + ld * (j + 3);
+        std::fill(col, col + m_nv, 0.0);
+        double dmcvdTdt = 0.0;
+        if (m_chem) {
+            const double* ddC = &m_dwdot_dC[j * m_nsp];
+            for (size_t k = 0; k < m_nsp; k++) {
+                double dwdot = ddC[k] * rho / mw[j];
+                col[k + 3] = dwdot * mw[k] / rho;
+                dmcvdTdt -= dwdot * m_uk[k] * m_vol;
+            }
+        }
+        col[j + 3] -= mdot_in / m_mass;
+        if (m_energy) {
+            double cv_j = (m_work[j] - GasConstant) / mw[j];
+            col[2] = dmcvdTdt / (m_mass * cv) - ydot[2] * cv_j / cv;
+        }
+    }
+    return true;
+}
+
+bool IdealGasReactor::evalParameterAdjoint(const double* lambda,
+                                           double* dfdp)
+{
+    // The species equations and the energy equation depend on the
+    // homogeneous reaction rates. m_uk is set by evalEqs().
+    const vector_fp& mw = m_thermo->molecularWeights();
+    double cv = m_thermo->cv_mass();
+    vector_fp a(m_nsp);
+    for (size_t k = 0; k < m_nsp; k++) {
+        a[k] = lambda[k+3] * mw[k] * m_vol / m_mass;
+        if (m_energy) {
+            a[k] -= lambda[2] * m_uk[k] * m_vol / (m_mass * cv);
+        }
+    }
+    return parameterAdjoint(&a[0], dfdp);
+}
+
 size_t IdealGasReactor::componentIndex(const string& nm) const
 {
     size_t k = speciesIndex(nm);
@@ -0,0 +1,345 @@
+//! @file IsatTable.cpp
+#include "cantera/zeroD/IsatTable.h"
+#include "cantera/base/stringUtils.h"
+
+#include <cmath>
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace {
+// Relative perturbation of the pressure used to compute the mapping
+// gradient with respect to the pressure
+const double dlnP = 1.0e-4;
+
+// Maximum radius of the initial EOA in each direction of the scaled
+// composition space
+const double rmax = 1.0e-2;
+}
+
+IsatTable::IsatTable(size_t nsp, double dt) :
+    m_nsp(nsp),
+    m_nq(nsp + 2),
+    m_nr(nsp + 1),
+    m_dt(dt),
+    m_tol(1.0e-4),
+    m_Tscale(1000.0),
+    m_Pscale(OneAtm),
+    m_maxMemory(100 * 1024 * 1024),
+    m_root(npos),
+    m_generation(0),
+    m_nQueries(0),
+    m_nRetrieves(0),
+    m_nGrows(0),
+    m_nAdds(0),
+    m_nDirect(0)
+{
+    if (dt <= 0.0) {
+        throw CanteraError("IsatTable::IsatTable",
+                           "The time step must be positive.");
+    }
+}
+
+IsatTable::~IsatTable()
+{
+    for (size_t i = 0; i < m_records.size(); i++) {
+        delete m_records[i];
+    }
+}
+
+void IsatTable::setTolerance(double tol)
+{
+    if (tol <= 0.0) {
+        throw CanteraError("IsatTable::setTolerance",
+                           "The tolerance must be positive.");
+    }
+    ScopedLock lock(m_mutex);
+    m_tol = tol;
+}
+
+void IsatTable::setScales(double T, double P)
+{
+    if (T <= 0.0 || P <= 0.0) {
+        throw CanteraError("IsatTable::setScales",
+                           "The scales must be positive.");
+    }
+    ScopedLock lock(m_mutex);
+    if (!m_records.empty()) {
+        throw CanteraError("IsatTable::setScales",
+                           "The scales cannot be changed after records have "
+                           "been added to the table.");
+    }
+    m_Tscale = T;
+    m_Pscale = P;
+}
+
+size_t IsatTable::recordSize() const
+{
+    // A record, its leaf, and the internal node created when it was added
+    return sizeof(Record) + 2 * sizeof(Node) + sizeof(Record*) +
+           sizeof(double) * (m_nq + m_nr + m_nr * m_nq + m_nq * m_nq + m_nq);
+}
+
+size_t IsatTable::memoryUsage() const
+{
+    ScopedLock lock(m_mutex);
+    return m_records.size() * recordSize();
+}
+
+size_t IsatTable::nRecords() const
+{
+    ScopedLock lock(m_mutex);
+    return m_records.size();
+}
+
+void IsatTable::clear()
+{
+    ScopedLock lock(m_mutex);
+    for (size_t i = 0; i < m_records.size(); i++) {
+        delete m_records[i];
+    }
+    m_records.clear();
+    m_nodes.clear();
+    m_root = npos;
+    m_generation++;
+}
+
+void IsatTable::getStats(std::map<std::string, long int>& stats) const
+{
+    ScopedLock lock(m_mutex);
+    stats["queries"] = m_nQueries;
+    stats["retrieves"] = m_nRetrieves;
+    stats["grows"] = m_nGrows;
+    stats["adds"] = m_nAdds;
+    stats["direct"] = m_nDirect;
+}
+
+size_t IsatTable::findLeaf(const double* q) const
+{
+    size_t n = m_root;
+    while (n != npos && m_nodes[n].record == npos) {
+        const Node& node = m_nodes[n];
+        double s = 0.0;
+        for (size_t i = 0; i < m_nq; i++) {
+            s += node.v[i] * q[i];
+        }
+        n = (s > node.a) ? node.right : node.left;
+    }
+    return n;
+}
+
+void IsatTable::approximate(const Record& r, const double* q, double* R) const
+{
+    copy(r.R.begin(), r.R.end(), R);
+    for (size_t j = 0; j < m_nq; j++) {
+        double dq = q[j] - r.phi[j];
+        if (dq != 0.0) {
+            const double* Aj = &r.A[j * m_nr];
+            for (size_t i = 0; i < m_nr; i++) {
+                R[i] += Aj[i] * dq;
+            }
+        }
+    }
+}
+
+void IsatTable::addRecord(size_t leaf, const double* q, const double* R,
+                          const double* A)
+{
+    Record* r = new Record;
+    r->phi.assign(q, q + m_nq);
+    r->R.assign(R, R + m_nr);
+    r->A.assign(A, A + m_nr * m_nq);
+
+    // Initial EOA: the region where the change in the linear approximation
+    // is within the tolerance, limited to a radius of rmax in each direction
+    r->M.assign(m_nq * m_nq, 0.0);
+    double tol2 = m_tol * m_tol;
+    for (size_t j = 0; j < m_nq; j++) {
+        for (size_t k = 0; k <= j; k++) {
+            double s = 0.0;
+            for (size_t i = 0; i < m_nr; i++) {
+                s += A[i + j * m_nr] * A[i + k * m_nr];
+            }
+            r->M[j + k * m_nq] = r->M[k + j * m_nq] = s / tol2;
+        }
+        r->M[j * (m_nq + 1)] += 1.0 / (rmax * rmax);
+    }
+    m_records.push_back(r);
+
+    Node newLeaf;
+    newLeaf.record = m_records.size() - 1;
+    newLeaf.left = newLeaf.right = npos;
+    newLeaf.a = 0.0;
+    if (leaf == npos) {
+        m_root = m_nodes.size();
+        m_nodes.push_back(newLeaf);
+        return;
+    }
+
+    // Replace the old leaf by a node whose children are the old and new
+    // leaves, separated by the plane bisecting their tabulation points
+    Node oldLeaf = m_nodes[leaf];
+    const vector_fp& phi0 = m_records[oldLeaf.record]->phi;
+    Node& node = m_nodes[leaf];
+    node.record = npos;
+    node.v.resize(m_nq);
+    node.a = 0.0;
+    for (size_t i = 0; i < m_nq; i++) {
+        node.v[i] = q[i] - phi0[i];
+        node.a += 0.5 * node.v[i] * (q[i] + phi0[i]);
+    }
+    node.left = m_nodes.size();
+    node.right = m_nodes.size() + 1;
+    m_nodes.push_back(oldLeaf);
+    m_nodes.push_back(newLeaf);
+}
+
+void IsatTable::growEOA(Record& r, const double* q)
+{
+    // The EOA is stretched in the direction of q, keeping its center, so
+    // that q is on its boundary:
+    //     M' = M - (1 - 1/alpha) (M d)(M d)^T / alpha
+    // where d = q - phi and alpha = d^T M d > 1.
+    vector_fp Md(m_nq, 0.0);
+    double alpha = 0.0;
+    for (size_t j = 0; j < m_nq; j++) {
+        double dj = q[j] - r.phi[j];
+        for (size_t i = 0; i < m_nq; i++) {
+            Md[i] += r.M[i + j * m_nq] * dj;
+        }
+    }
+    for (size_t i = 0; i < m_nq; i++) {
+        alpha += (q[i] - r.phi[i]) * Md[i];
+    }
+    if (alpha <= 1.0) {
+        return;
+    }
+    double c = (1.0 - 1.0 / alpha) / alpha;
+    for (size_t j = 0; j < m_nq; j++) {
+        for (size_t i = 0; i < m_nq; i++) {
+            r.M[i + j * m_nq] -= c * Md[i] * Md[j];
+        }
+    }
+}
+
+void IsatTable::advance(ChemistryIntegrator& integ, double& T, double* Y,
+                        double P)
+{
+    if (integ.neq() != m_nr) {
+        throw CanteraError("IsatTable::advance", "Integrator has " +
+            int2str(integ.neq() - 1) + " species; expected " +
+            int2str(m_nsp) + ".");
+    }
+
+    // Scaled query and linear approximation
+    vector_fp q(m_nq), Rlin(m_nr);
+    q[0] = T / m_Tscale;
+    q[1] = P / m_Pscale;
+    copy(Y, Y + m_nsp, q.begin() + 2);
+
+    size_t record = npos;
+    long int generation;
+    bool full;
+    {
+        ScopedLock lock(m_mutex);
+        m_nQueries++;
+        generation = m_generation;
+        size_t leaf = findLeaf(&q[0]);
+        if (leaf != npos) {
+            record = m_nodes[leaf].record;
+            const Record& r = *m_records[record];
+            approximate(r, &q[0], &Rlin[0]);
+            double s = 0.0;
+            for (size_t j = 0; j < m_nq; j++) {
+                double dj = q[j] - r.phi[j];
+                for (size_t i = 0; i < m_nq; i++) {
+                    s += (q[i] - r.phi[i]) * r.M[i + j * m_nq] * dj;
+                }
+            }
+            if (s <= 1.0) {
+                // Retrieve
+                m_nRetrieves++;
+                T = Rlin[0] * m_Tscale;
+                copy(Rlin.begin() + 1, Rlin.end(), Y);
+                return;
+            }
+        }
+        full = (m_records.size() + 1) * recordSize() > m_maxMemory;
+    }
+
+    // Direct integration. The gradient is only needed if a record may be
+    // added.
+    vector_fp dydy0;
+    double T1 = T;
+    vector_fp Y1(Y, Y + m_nsp);
+    if (!full) {
+        dydy0.resize(m_nr * m_nr);
+        integ.integrate(T1, &Y1[0], P, m_dt, &dydy0[0]);
+    } else {
+        integ.integrate(T1, &Y1[0], P, m_dt);
+    }
+    vector_fp R(m_nr);
+    R[0] = T1 / m_Tscale;
+    copy(Y1.begin(), Y1.end(), R.begin() + 1);
+
+    double err = 0.0;
+    if (record != npos) {
+        for (size_t i = 0; i < m_nr; i++) {
+            err += (R[i] - Rlin[i]) * (R[i] - Rlin[i]);
+        }
+        err = sqrt(err);
+    }
+    bool grow = (record != npos && err <= m_tol);
+
+    // Scaled mapping gradient for a new record: columns for T and P,
+    // followed by the columns for the mass fractions
+    vector_fp A;
+    if (!grow && !full) {
+        A.resize(m_nr * m_nq);
+        for (size_t i = 0; i < m_nr; i++) {
+            double si = (i == 0) ? 1.0 / m_Tscale : 1.0;
+            A[i] = dydy0[i] * si * m_Tscale;
+            for (size_t k = 0; k < m_nsp; k++) {
+                A[i + (k + 2) * m_nr] = dydy0[i + (k + 1) * m_nr] * si;
+            }
+        }
+        double T2 = T;
+        vector_fp Y2(Y, Y + m_nsp);
+        double dP = dlnP * P;
+        integ.integrate(T2, &Y2[0], P + dP, m_dt);
+        A[m_nr] = (T2 - T1) / dP * m_Pscale / m_Tscale;
+        for (size_t k = 0; k < m_nsp; k++) {
+            A[m_nr + k + 1] = (Y2[k] - Y1[k]) / dP * m_Pscale;
+        }
+    }
+
+    {
+        ScopedLock lock(m_mutex);
+        if (generation != m_generation) {
+            // The table was cleared; the record is no longer valid
+            grow = false;
+        }
+        if (grow) {
+            // Records are not removed, except by clear(), so the record is
+            // still valid even if other threads have added records since
+            // the table was searched
+            growEOA(*m_records[record], &q[0]);
+            m_nGrows++;
+        } else if (!A.empty() &&
+                   (m_records.size() + 1) * recordSize() <= m_maxMemory) {
+            // Another thread may have modified the tree since it was
+            // searched, so the leaf is found again
+            addRecord(findLeaf(&q[0]), &q[0], &R[0], &A[0]);
+            m_nAdds++;
+        } else {
+            m_nDirect++;
+        }
+    }
+
+    T = T1;
+    copy(Y1.begin(), Y1.end(), Y);
+}
+
+}
@@ -21,6 +21,7 @@ Reactor::Reactor() : ReactorBase(),
     m_vdot(0.0),
     m_Q(0.0),
     m_mass(0.0),
+    m_thermoStateNum(-2),
     m_chem(false),
     m_energy(true),
     m_nv(0),
@@ -68,6 +69,7 @@ void Reactor::getSurfaceInitialConditions(double* y)
 void Reactor::initialize(doublereal t0)
 {
     m_thermo->restoreState(m_state);
+    m_thermoStateNum = m_thermo->stateMFNumber();
     m_sdot.resize(m_nsp, 0.0);
     m_wdot.resize(m_nsp, 0.0);
     m_nv = m_nsp + 3;
@@ -121,6 +123,22 @@ void Reactor::syncState()
     m_mass = m_thermo->density() * m_vol;
 }
 
+void Reactor::restoreThermoState()
+{
+    if (m_thermo->stateMFNumber() != m_thermoStateNum ||
+        m_thermo->temperature() != m_state[0] ||
+        m_thermo->density() != m_state[1]) {
+        m_thermo->restoreState(m_state);
+        m_thermoStateNum = m_thermo->stateMFNumber();
+    }
+}
+
+void Reactor::saveThermoState()
+{
+    m_thermo->saveState(m_state);
+    m_thermoStateNum = m_thermo->stateMFNumber();
+}
+
 void Reactor::updateState(doublereal* y)
 {
     for (size_t i = 0; i < m_nv; i++) {
@@ -172,7 +190,7 @@ void Reactor::updateState(doublereal* y)
     m_enthalpy = m_thermo->enthalpy_mass();
     m_pressure = m_thermo->pressure();
     m_intEnergy = m_thermo->intEnergy_mass();
-    m_thermo->saveState(m_state);
+    saveThermoState();
 }
 
 void Reactor::updateSurfaceState(double* y)
@@ -193,7 +211,7 @@ void Reactor::evalEqs(doublereal time, doublereal* y,
     double dmdt = 0.0; // dm/dt (gas phase)
     double* dYdt = ydot + 3;
 
-    m_thermo->restoreState(m_state);
+    restoreThermoState();
     applySensitivity(params);
     evalWalls(time);
     double mdot_surf = evalSurfaces(time, ydot + m_nsp + 3);
@@ -262,6 +280,66 @@ void Reactor::evalEqs(doublereal time, doublereal* y,
     resetSensitivity(params);
 }
 
+bool Reactor::evalSpeciesJacobian(double t, const double* ydot, double* jac,
+                                  size_t ld)
+{
+    // The reaction rates are differentiated with respect to the activity
+    // concentrations, which are the molar concentrations only for ideal gases
+    if (m_thermo->eosType() != cIdealGas) {
+        return false;
+    }
+    const vector_fp& mw = m_thermo->molecularWeights();
+    double rho = m_mass / m_vol;
+
+    // The derivatives with respect to the mass fractions are taken at
+    // constant internal energy, so the temperature changes as well:
+    // dT/dY_j = -u_j / c_v, where u_j is the partial specific internal energy
+    vector_fp dwdot_dT(m_nsp, 0.0), dTdY(m_nsp, 0.0);
+    if (m_chem) {
+        m_dwdot_dC.resize(m_nsp * m_nsp);
+        m_kin->getNetProductionRates_ddC(&m_dwdot_dC[0]);
+        if (m_energy) {
+            m_uk.resize(m_nsp);
+            m_thermo->getPartialMolarIntEnergies(&m_uk[0]);
+            double cv = m_thermo->cv_mass();
+            for (size_t j = 0; j < m_nsp; j++) {
+                dTdY[j] = - m_uk[j] / (mw[j] * cv);
+            }
+            double T = m_thermo->temperature();
+            double dT = sqrt(DBL_EPSILON) * T;
+            m_thermo->setState_TR(T + dT, rho);
+            m_kin->getNetProductionRates(&dwdot_dT[0]);
+            restoreThermoState();
+            for (size_t k = 0; k < m_nsp; k++) {
+                dwdot_dT[k] = (dwdot_dT[k] - m_wdot[k]) / dT;
+            }
+        }
+    }
+
+    // dilution by mass added from surfaces and inlets
+    double mdot_in = 0.0;
+    for (size_t k = 0; k < m_nsp; k++) {
+        mdot_in += m_sdot[k] * mw[k];
+    }
+    for (size_t i = 0; i < m_inlet.size(); i++) {
+        mdot_in += m_inlet[i]->massFlowRate(t);
+    }
+
+    for (size_t j = 0; j < m_nsp; j++) {
+        double* col = jac + ld * (j + 3);
+        std::fill(col, col + m_nv, 0.0);
+        if (m_chem) {
+            const double* ddC = &m_dwdot_dC[j * m_nsp];
+            for (size_t k = 0; k < m_nsp; k++) {
+                double dwdot = ddC[k] * rho / mw[j] + dwdot_dT[k] * dTdY[j];
+                col[k + 3] = dwdot * mw[k] / rho;
+            }
+        }
+        col[j + 3] -= mdot_in / m_mass;
+    }
+    return true;
+}
+
 void Reactor::evalWalls(double t)
 {
     m_vdot = 0.0;
@@ -310,6 +388,39 @@ double Reactor::evalSurfaces(double t, double* ydot)
     return mdot_surf;
 }
 
+bool Reactor::evalParameterAdjoint(const double* lambda, double* dfdp)
+{
+    // Only the species equations depend on the homogeneous reaction rates
+    const vector_fp& mw = m_thermo->molecularWeights();
+    vector_fp a(m_nsp);
+    for (size_t k = 0; k < m_nsp; k++) {
+        a[k] = lambda[k+3] * mw[k] * m_vol / m_mass;
+    }
+    return parameterAdjoint(&a[0], dfdp);
+}
+
+bool Reactor::parameterAdjoint(const double* a, double* dfdp)
+{
+    if (!m_chem || m_pnum.size() != nSensParams()) {
+        return false;
+    }
+    // Each parameter multiplies the rate of progress of a reaction, which
+    // contributes to the production rate of each species in proportion to
+    // its net stoichiometric coefficient
+    size_t nr = m_kin->nReactions();
+    vector_fp delta(nr), rop(nr);
+    try {
+        m_kin->getReactionDelta(a, &delta[0]);
+    } catch (NotImplementedError&) {
+        return false;
+    }
+    m_kin->getNetRatesOfProgress(&rop[0]);
+    for (size_t n = 0; n < m_pnum.size(); n++) {
+        dfdp[n] = delta[m_pnum[n]] * rop[m_pnum[n]];
+    }
+    return true;
+}
+
 void Reactor::addSensitivityReaction(size_t rxn)
 {
     if (rxn >= m_kin->nReactions())
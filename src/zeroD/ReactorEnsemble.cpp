@@ -0,0 +1,177 @@
+//! @file ReactorEnsemble.cpp
+#include "cantera/zeroD/ReactorEnsemble.h"
+#include "cantera/base/ct_thread.h"
+#include "cantera/base/stringUtils.h"
+
+#ifdef THREAD_SAFE_CANTERA
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+
+#include <algorithm>
+
+using namespace std;
+
+namespace Cantera
+{
+
+namespace {
+//! Protects the work lists of all ReactorEnsemble objects
+mutex_t ensemble_mutex;
+
+//! Used to sort the reactors in order of decreasing cost
+struct CostCompare {
+    explicit CostCompare(const std::vector<long int>& cost) : m_cost(cost) {}
+    bool operator()(size_t i, size_t j) const {
+        return m_cost[i] > m_cost[j];
+    }
+    const std::vector<long int>& m_cost;
+};
+}
+
+ReactorEnsemble::ReactorEnsemble() :
+    m_next(0),
+    m_nthreads(1),
+    m_time(0.0)
+{
+#ifdef THREAD_SAFE_CANTERA
+    m_nthreads = std::max(boost::thread::hardware_concurrency(), 1u);
+#endif
+}
+
+ReactorEnsemble::~ReactorEnsemble()
+{
+    for (size_t i = 0; i < m_nets.size(); i++) {
+        delete m_nets[i];
+    }
+}
+
+void ReactorEnsemble::addReactor(Reactor& r)
+{
+    if (r.nWalls() || r.nInlets() || r.nOutlets()) {
+        throw CanteraError("ReactorEnsemble::addReactor", "Reactor '" +
+            r.name() + "' is connected to other reactors or reservoirs.");
+    }
+    for (size_t i = 0; i < m_reactors.size(); i++) {
+        if (&m_reactors[i]->contents() == &r.contents()) {
+            throw CanteraError("ReactorEnsemble::addReactor", "Reactors '" +
+                m_reactors[i]->name() + "' and '" + r.name() + "' share the"
+                " same ThermoPhase object.");
+        }
+    }
+    ReactorNet* net = new ReactorNet();
+    net->addReactor(r);
+    net->setInitialTime(m_time);
+    m_reactors.push_back(&r);
+    m_nets.push_back(net);
+    m_errors.push_back("");
+    m_cost.push_back(0);
+    m_order.push_back(m_order.size());
+}
+
+void ReactorEnsemble::setTolerances(doublereal rtol, doublereal atol)
+{
+    for (size_t i = 0; i < m_nets.size(); i++) {
+        m_nets[i]->setTolerances(rtol, atol);
+    }
+}
+
+void ReactorEnsemble::setMaxTimeStep(doublereal maxstep)
+{
+    for (size_t i = 0; i < m_nets.size(); i++) {
+        m_nets[i]->setMaxTimeStep(maxstep);
+    }
+}
+
+void ReactorEnsemble::setNumThreads(size_t n)
+{
+    if (n == 0) {
+        throw CanteraError("ReactorEnsemble::setNumThreads",
+                           "Number of threads must be positive.");
+    }
+    m_nthreads = n;
+}
+
+void ReactorEnsemble::advance(doublereal time)
+{
+    m_time = time;
+    m_next = 0;
+    // Start with the most expensive reactors so that the slowest ones are
+    // not left until the end
+    stable_sort(m_order.begin(), m_order.end(), CostCompare(m_cost));
+
+    size_t nthreads = std::min(m_nthreads, m_reactors.size());
+#ifdef THREAD_SAFE_CANTERA
+    if (nthreads > 1) {
+        boost::thread_group threads;
+        for (size_t n = 0; n < nthreads; n++) {
+            threads.create_thread(boost::bind(&ReactorEnsemble::work, this,
+                                              true));
+        }
+        threads.join_all();
+    } else {
+        work(false);
+    }
+#else
+    work(false);
+#endif
+
+    size_t nfailed = 0;
+    size_t first = npos;
+    for (size_t i = 0; i < m_errors.size(); i++) {
+        if (!m_errors[i].empty()) {
+            nfailed++;
+            first = std::min(first, i);
+        }
+    }
+    if (nfailed) {
+        throw CanteraError("ReactorEnsemble::advance", int2str(nfailed) +
+            " of " + int2str(m_reactors.size()) + " reactors failed. Error"
+            " for reactor " + int2str(first) + ":\n" + m_errors[first]);
+    }
+}
+
+void ReactorEnsemble::work(bool workerThread)
+{
+    while (true) {
+        size_t i;
+        {
+            ScopedLock lock(ensemble_mutex);
+            if (m_next >= m_order.size()) {
+                break;
+            }
+            i = m_order[m_next++];
+        }
+        advanceReactor(i);
+    }
+    if (workerThread) {
+        // Release the error and log buffers for this thread
+        thread_complete();
+    }
+}
+
+void ReactorEnsemble::advanceReactor(size_t i)
+{
+    ReactorNet& net = *m_nets[i];
+    std::map<std::string, long int> stats;
+    net.getSolverStats(stats);
+    long int rhs0 = stats["rhs_evals"];
+    m_errors[i].clear();
+    try {
+        net.advance(m_time);
+    } catch (CanteraError& err) {
+        m_errors[i] = err.getMessage();
+    } catch (std::exception& err) {
+        m_errors[i] = err.what();
+    }
+    net.getSolverStats(stats);
+    m_cost[i] = stats["rhs_evals"] - rhs0;
+}
+
+void ReactorEnsemble::getSolverStats(size_t i,
+                                     std::map<std::string, long int>& stats)
+{
+    m_nets.at(i)->getSolverStats(stats);
+}
+
+}
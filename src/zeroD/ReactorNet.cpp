@@ -4,6 +4,8 @@
 #include "cantera/zeroD/Wall.h"
 
 #include <cstdio>
+#include <cfloat>
+#include <algorithm>
 
 using namespace std;
 
@@ -15,7 +17,11 @@ ReactorNet::ReactorNet() : Cantera::FuncEval(),
     m_nv(0), m_rtol(1.0e-9), m_rtolsens(1.0e-4),
     m_atols(1.0e-15), m_atolsens(1.0e-4),
     m_maxstep(-1.0), m_maxErrTestFails(0),
-    m_verbose(false), m_ntotpar(0)
+    m_verbose(false), m_ntotpar(0),
+    m_linearSolver("dense"), m_preconditioner("sparse"),
+    m_precon_droptol(0.0), m_jacobianType("finite-difference"),
+    m_lastEvent(npos), m_precon_jac_ok(false), m_nPreconJacEvals(0),
+    m_adjointSteps(0), m_adj_t(0.0)
 {
     m_integ = newIntegrator("CVODE");
 
@@ -86,23 +92,163 @@ void ReactorNet::initialize()
     fill(m_atol.begin(), m_atol.end(), m_atols);
     m_integ->setTolerances(m_rtol, neq(), DATA_PTR(m_atol));
     m_integ->setSensitivityTolerances(m_rtolsens, m_atolsens);
+    m_integ->setAdjointCheckpointSteps(m_adjointSteps);
+    m_adj_rowIndex.clear();
+    m_adj_y.clear();
     m_integ->setMaxStepSize(m_maxstep);
     m_integ->setMaxErrTestFails(m_maxErrTestFails);
+    initCoupling();
+    if (m_linearSolver == "gmres") {
+        m_integ->setProblemType(GMRES);
+        if (hasPreconditioner()) {
+            initPreconditioner();
+        }
+    } else if (hasJacobian()) {
+        m_integ->setProblemType(DENSE + JAC);
+    } else {
+        m_integ->setProblemType(DENSE + NOJAC);
+    }
     if (m_verbose) {
         sprintf(buf, "Number of equations: %s\n", int2str(neq()).c_str());
         writelog(buf);
         sprintf(buf, "Maximum time step:   %14.6g\n", m_maxstep);
         writelog(buf);
     }
+    initEvents();
     m_integ->initialize(m_time, *this);
     m_integrator_init = true;
     m_init = true;
 }
 
+void ReactorNet::initCoupling()
+{
+    size_t nr = m_reactors.size();
+    m_coupled.assign(nr, std::vector<size_t>());
+    for (size_t n = 0; n < nr; n++) {
+        Reactor& r = *m_reactors[n];
+        std::vector<ReactorBase*> neighbors;
+        for (size_t i = 0; i < r.nWalls(); i++) {
+            neighbors.push_back(&r.wall(i).left());
+            neighbors.push_back(const_cast<ReactorBase*>(&r.wall(i).right()));
+        }
+        for (size_t i = 0; i < r.nInlets(); i++) {
+            neighbors.push_back(&r.inlet(i).in());
+        }
+        for (size_t i = 0; i < r.nOutlets(); i++) {
+            neighbors.push_back(const_cast<ReactorBase*>(&r.outlet(i).out()));
+        }
+        // Reservoirs and other reactors not in this network are ignored
+        m_coupled[n].push_back(n);
+        for (size_t m = 0; m < nr; m++) {
+            if (std::find(neighbors.begin(), neighbors.end(),
+                          m_reactors[m]) != neighbors.end()) {
+                m_coupled[n].push_back(m);
+            }
+        }
+        sort(m_coupled[n].begin(), m_coupled[n].end());
+        m_coupled[n].erase(unique(m_coupled[n].begin(), m_coupled[n].end()),
+                           m_coupled[n].end());
+    }
+
+    // Greedy coloring of the reactors, starting with the most strongly
+    // coupled ones. A reactor can join a group only if none of the reactors
+    // it affects are affected by a reactor already in that group.
+    std::vector<std::pair<size_t, size_t> > order;
+    for (size_t n = 0; n < nr; n++) {
+        order.push_back(std::make_pair(m_coupled[n].size(), n));
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     std::greater<std::pair<size_t, size_t> >());
+    m_colors.clear();
+    std::vector<std::vector<bool> > covered;
+    for (size_t i = 0; i < nr; i++) {
+        size_t n = order[i].second;
+        size_t c = 0;
+        for (; c < m_colors.size(); c++) {
+            bool ok = true;
+            for (size_t j = 0; j < m_coupled[n].size(); j++) {
+                if (covered[c][m_coupled[n][j]]) {
+                    ok = false;
+                    break;
+                }
+            }
+            if (ok) {
+                break;
+            }
+        }
+        if (c == m_colors.size()) {
+            m_colors.push_back(std::vector<size_t>());
+            covered.push_back(std::vector<bool>(nr, false));
+        }
+        m_colors[c].push_back(n);
+        for (size_t j = 0; j < m_coupled[n].size(); j++) {
+            covered[c][m_coupled[n][j]] = true;
+        }
+    }
+    for (size_t c = 0; c < m_colors.size(); c++) {
+        sort(m_colors[c].begin(), m_colors[c].end());
+    }
+}
+
+void ReactorNet::jacobianStructure(
+    const std::vector<std::vector<size_t> >& rows,
+    std::vector<size_t>& colStart, std::vector<size_t>& rowIndex)
+{
+    colStart.assign(1, 0);
+    rowIndex.clear();
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        for (size_t j = m_start[n]; j < m_start[n+1]; j++) {
+            for (size_t i = 0; i < rows[n].size(); i++) {
+                size_t m = rows[n][i];
+                for (size_t k = m_start[m]; k < m_start[m+1]; k++) {
+                    rowIndex.push_back(k);
+                }
+            }
+            colStart.push_back(rowIndex.size());
+        }
+    }
+}
+
+void ReactorNet::getJacobianStructure(std::vector<size_t>& colStart,
+                                      std::vector<size_t>& rowIndex)
+{
+    if (!m_init) {
+        initialize();
+    }
+    jacobianStructure(m_coupled, colStart, rowIndex);
+}
+
+void ReactorNet::initPreconditioner()
+{
+    // Each column of the preconditioner has dense blocks in the rows of the
+    // reactors coupled to the reactor for that column
+    std::vector<size_t> colStart, rowIndex;
+    jacobianStructure(preconditionerRows(), colStart, rowIndex);
+    m_precon.setStructure(m_nv, colStart, rowIndex);
+    m_precon.setDropTolerance(m_precon_droptol);
+    if (m_precon_droptol > 0.0) {
+        // Off-diagonal pivots are more likely to be lost when elements are
+        // dropped, so the diagonal is strongly preferred
+        m_precon.setPivotThreshold(1e-8);
+    }
+    m_precon_jac.assign(rowIndex.size(), 0.0);
+    m_precon_diag.resize(m_nv);
+    for (size_t j = 0; j < m_nv; j++) {
+        m_precon_diag[j] = m_precon.index(j, j);
+    }
+    m_precon_jac_ok = false;
+    m_nPreconJacEvals = 0;
+    if (m_verbose) {
+        writelog("Preconditioner: " + m_preconditioner + ", " +
+                 int2str(m_precon.nNonzeros()) + " nonzero elements\n");
+    }
+}
+
 void ReactorNet::reinitialize()
 {
     if (m_init) {
         writelog("Re-initializing reactor network.\n", m_verbose);
+        initEvents();
         m_integ->reinitialize(m_time, *this);
         m_integrator_init = true;
     } else {
@@ -120,8 +266,16 @@ void ReactorNet::advance(doublereal time)
     } else if (!m_integrator_init) {
         reinitialize();
     }
-    m_integ->integrate(time);
-    m_time = time;
+    while (true) {
+        m_integ->integrate(time);
+        if (!m_integ->rootFound()) {
+            m_time = time;
+            break;
+        } else if (processEvents()) {
+            m_time = m_integ->currentTime();
+            break;
+        }
+    }
     updateState(m_integ->solution());
 }
 
@@ -136,10 +290,94 @@ double ReactorNet::step(doublereal time)
         reinitialize();
     }
     m_time = m_integ->step(time);
+    processEvents();
     updateState(m_integ->solution());
     return m_time;
 }
 
+size_t ReactorNet::sample(size_t ntimes, const double* times,
+                          double* output, int k)
+{
+    if (ntimes == 0) {
+        return 0;
+    }
+    for (size_t i = 1; i < ntimes; i++) {
+        if (times[i] < times[i-1]) {
+            throw CanteraError("ReactorNet::sample",
+                               "Output times must be in increasing order.");
+        }
+    }
+    if (times[0] < m_time) {
+        throw CanteraError("ReactorNet::sample", "Output time " +
+            fp2str(times[0]) + " is before the current time " +
+            fp2str(m_time) + ".");
+    }
+    double tend = times[ntimes-1];
+    if (!m_init) {
+        if (m_maxstep < 0.0) {
+            m_maxstep = tend - m_time;
+        }
+        initialize();
+    } else if (!m_integrator_init) {
+        reinitialize();
+    }
+
+    size_t n = 0;
+    while (true) {
+        // Interpolate to the output times within the last step. After a
+        // previous call to advance() or sample(), this step may extend
+        // beyond the current time, and the next call to step() starts from
+        // its end. If there are events, step() first checks the rest of the
+        // last step for events, so only the part up to the current time is
+        // used here.
+        double tlast = nRootFunctions() ? m_time : m_integ->internalTime();
+        while (n < ntimes && (times[n] < tlast || (times[n] == tlast &&
+                (k == 0 || tlast != m_time)))) {
+            // Derivatives at the current time are only evaluated after a
+            // step, since the integrator may not have taken a step yet
+            getSample(times[n], k, output + n * m_nv);
+            n++;
+        }
+        if (n == ntimes) {
+            break;
+        }
+        m_time = m_integ->step(tend);
+        if (processEvents()) {
+            // Output times up to a terminal event are still reached
+            while (n < ntimes && times[n] <= m_time) {
+                getSample(times[n], k, output + n * m_nv);
+                n++;
+            }
+            updateState(m_integ->solution());
+            return n;
+        }
+    }
+    // The last step may have gone past the final output time
+    advance(tend);
+    return n;
+}
+
+void ReactorNet::getSample(double t, int k, double* y)
+{
+    if (k == 0 && t == m_time) {
+        // The interpolating polynomial is not available before the first
+        // step, but the solution at the current time is
+        const double* ycurrent = m_integ->solution();
+        copy(ycurrent, ycurrent + m_nv, y);
+    } else {
+        m_integ->getDky(t, k, y);
+    }
+}
+
+void ReactorNet::getInterpolatedState(double t, double* y, int k)
+{
+    if (!m_init) {
+        throw CanteraError("ReactorNet::getInterpolatedState",
+                           "The integrator has not been initialized.");
+    }
+    m_integ->getDky(t, k, y);
+}
+
 void ReactorNet::addReactor(Reactor* r, bool iown)
 {
     warn_deprecated("ReactorNet::addReactor(Reactor*)",
@@ -166,6 +404,182 @@ void ReactorNet::addReactor(Reactor& r)
     m_iown.push_back(false);
 }
 
+size_t ReactorNet::addEvent(const std::string& type, Reactor& r,
+                            const std::string& component, double value,
+                            bool terminal)
+{
+    if (type != "threshold" && type != "peak" && type != "max-slope") {
+        throw CanteraError("ReactorNet::addEvent",
+                           "Unknown event type '" + type + "'");
+    }
+    ReactorEvent ev;
+    ev.type = type;
+    ev.reactor = &r;
+    ev.component = component;
+    ev.species = npos;
+    if (component != "T" && component != "P") {
+        ev.species = r.contents().speciesIndex(component);
+        if (ev.species == npos) {
+            throw CanteraError("ReactorNet::addEvent", "Unknown component '"
+                               + component + "' for reactor '" + r.name() + "'");
+        }
+    }
+    ev.state = npos;
+    ev.value = value;
+    ev.func = 0;
+    ev.terminal = terminal;
+    // Maxima are located where the derivative decreases through zero
+    ev.direction = (type == "threshold") ? 0 : -1;
+    ev.count = 0;
+    ev.time = 0.0;
+    m_events.push_back(ev);
+    m_init = false;
+    return m_events.size() - 1;
+}
+
+size_t ReactorNet::addEvent(Func1& f, Reactor& r,
+                            const std::string& component, bool terminal)
+{
+    size_t i = addEvent("threshold", r, component, 0.0, terminal);
+    m_events[i].type = "function";
+    m_events[i].func = &f;
+    return i;
+}
+
+double ReactorNet::eventTime(size_t i) const
+{
+    if (m_events.at(i).count == 0) {
+        throw CanteraError("ReactorNet::eventTime",
+                           "Event " + int2str(i) + " has not occurred.");
+    }
+    return m_events[i].time;
+}
+
+void ReactorNet::initEvents()
+{
+    for (size_t i = 0; i < m_events.size(); i++) {
+        ReactorEvent& ev = m_events[i];
+        size_t n = std::find(m_reactors.begin(), m_reactors.end(),
+                             ev.reactor) - m_reactors.begin();
+        if (n == m_reactors.size()) {
+            throw CanteraError("ReactorNet::initEvents", "Reactor '" +
+                ev.reactor->name() + "' used by event " + int2str(i) +
+                " is not part of this network.");
+        }
+        size_t k = ev.reactor->componentIndex(ev.component);
+        ev.state = (k == npos) ? npos : m_start[n] + k;
+        if (ev.type == "max-slope" && ev.state == npos) {
+            throw CanteraError("ReactorNet::initEvents", "'max-slope' events "
+                "require a state variable, but '" + ev.component + "' is "
+                "not a state variable of reactor '" + ev.reactor->name() + "'");
+        }
+        ev.count = 0;
+        ev.time = 0.0;
+    }
+    m_lastEvent = npos;
+    m_rootInfo.assign(m_events.size(), 0);
+    m_event_ydot.resize(m_nv);
+    m_event_ydot2.resize(m_nv);
+    m_event_y.resize(m_nv);
+    m_event_params.assign(m_ntotpar, 1.0);
+}
+
+double ReactorNet::eventQuantity(size_t i) const
+{
+    const ReactorEvent& ev = m_events[i];
+    if (ev.species != npos) {
+        return ev.reactor->massFraction(ev.species);
+    } else if (ev.component == "T") {
+        return ev.reactor->temperature();
+    } else {
+        return ev.reactor->pressure();
+    }
+}
+
+void ReactorNet::evalRootFunctions(double t, double* y, double* g)
+{
+    bool needDerivs = false;
+    for (size_t i = 0; i < m_events.size(); i++) {
+        needDerivs = needDerivs || m_events[i].direction != 0;
+    }
+    if (!needDerivs) {
+        updateState(y);
+        for (size_t i = 0; i < m_events.size(); i++) {
+            double q = eventQuantity(i);
+            g[i] = m_events[i].func ? m_events[i].func->eval(q)
+                                    : q - m_events[i].value;
+        }
+        return;
+    }
+
+    // Derivatives which are not available directly from the governing
+    // equations are evaluated by perturbing the state in the direction of
+    // ydot, with a step that is small relative to the tolerances
+    double* ydot = &m_event_ydot[0];
+    eval(t, y, ydot, DATA_PTR(m_event_params));
+    double norm = 0.0;
+    for (size_t j = 0; j < m_nv; j++) {
+        double w = std::sqrt(DBL_EPSILON) * fabs(y[j]) + m_atol[j];
+        norm += (ydot[j] / w) * (ydot[j] / w);
+    }
+    norm = std::sqrt(norm / m_nv);
+    double sigma = (norm > 0.0) ? 1.0 / norm : 0.0;
+
+    vector_fp q(m_events.size());
+    for (size_t i = 0; i < m_events.size(); i++) {
+        q[i] = eventQuantity(i);
+    }
+    for (size_t j = 0; j < m_nv; j++) {
+        m_event_y[j] = y[j] + sigma * ydot[j];
+    }
+    if (sigma > 0.0) {
+        eval(t + sigma, &m_event_y[0], &m_event_ydot2[0], DATA_PTR(m_event_params));
+    }
+
+    for (size_t i = 0; i < m_events.size(); i++) {
+        const ReactorEvent& ev = m_events[i];
+        if (ev.type == "peak") {
+            if (ev.state != npos) {
+                g[i] = ydot[ev.state];
+            } else {
+                g[i] = (sigma > 0.0) ? (eventQuantity(i) - q[i]) / sigma : 0.0;
+            }
+        } else if (ev.type == "max-slope") {
+            g[i] = (sigma > 0.0) ?
+                (m_event_ydot2[ev.state] - ydot[ev.state]) / sigma : 0.0;
+        } else if (ev.func) {
+            g[i] = ev.func->eval(q[i]);
+        } else {
+            g[i] = q[i] - ev.value;
+        }
+    }
+    updateState(y);
+}
+
+bool ReactorNet::processEvents()
+{
+    if (!m_integ->rootFound()) {
+        return false;
+    }
+    m_integ->getRootInfo(m_rootInfo);
+    double t = m_integ->currentTime();
+    bool terminal = false;
+    for (size_t i = 0; i < m_events.size(); i++) {
+        ReactorEvent& ev = m_events[i];
+        if (m_rootInfo[i] == 0 ||
+            (ev.direction != 0 && m_rootInfo[i] != ev.direction)) {
+            continue;
+        }
+        if (ev.count == 0) {
+            ev.time = t;
+        }
+        ev.count++;
+        m_lastEvent = i;
+        terminal = terminal || ev.terminal;
+    }
+    return terminal;
+}
+
 void ReactorNet::eval(doublereal t, doublereal* y,
                       doublereal* ydot, doublereal* p)
 {
@@ -207,6 +621,449 @@ void ReactorNet::evalJacobian(doublereal t, doublereal* y,
     }
 }
 
+void ReactorNet::setLinearSolver(const std::string& solver)
+{
+    if (solver != "dense" && solver != "gmres") {
+        throw CanteraError("ReactorNet::setLinearSolver",
+                           "Unknown linear solver '" + solver + "'");
+    }
+    m_linearSolver = solver;
+    m_init = false;
+}
+
+void ReactorNet::setPreconditioner(const std::string& type,
+                                   doublereal dropTolerance)
+{
+    if (type != "sparse" && type != "block-diagonal" && type != "none") {
+        throw CanteraError("ReactorNet::setPreconditioner",
+                           "Unknown preconditioner '" + type + "'");
+    }
+    if (dropTolerance < 0.0) {
+        throw CanteraError("ReactorNet::setPreconditioner",
+                           "Drop tolerance must be non-negative.");
+    }
+    m_preconditioner = type;
+    m_precon_droptol = dropTolerance;
+    m_init = false;
+}
+
+void ReactorNet::setJacobianType(const std::string& type)
+{
+    if (type != "analytic" && type != "finite-difference") {
+        throw CanteraError("ReactorNet::setJacobianType",
+                           "Unknown Jacobian type '" + type + "'");
+    }
+    m_jacobianType = type;
+    m_init = false;
+}
+
+void ReactorNet::getSolverStats(std::map<std::string, long int>& stats)
+{
+    if (!m_init) {
+        return;
+    }
+    m_integ->getSolverStats(stats);
+    if (hasPreconditioner()) {
+        stats["prec_jac_evals"] = m_nPreconJacEvals;
+        stats["prec_factorizations"] = m_precon.nFactorizations();
+        stats["prec_refactorizations"] = m_precon.nRefactorizations();
+        stats["prec_nonzeros"] = m_precon.nNonzeros();
+        stats["prec_factor_nonzeros"] = m_precon.nFactorNonzeros();
+        stats["prec_jac_colors"] = m_colors.size();
+    }
+}
+
+bool ReactorNet::preconditionerSetup(double t, double* y, double* ydot,
+                                     double gamma, bool reuseJacobian)
+{
+    bool newJac = !(reuseJacobian && m_precon_jac_ok);
+    if (newJac) {
+        evalPreconditionerJacobian(t, y, ydot);
+        if (m_precon_droptol > 0.0) {
+            // The elements dropped from the incomplete factors depend on the
+            // Jacobian, so the structure of the old factors is not reused
+            m_precon.clearSymbolicFactorization();
+        }
+    }
+
+    // Form the Newton matrix, I - gamma*J
+    vector_fp::iterator M = m_precon.begin();
+    for (size_t i = 0; i < m_precon_jac.size(); i++) {
+        M[i] = -gamma * m_precon_jac[i];
+    }
+    for (size_t j = 0; j < m_nv; j++) {
+        M[m_precon_diag[j]] += 1.0;
+    }
+    int info = m_precon.factor();
+    if (info) {
+        throw CanteraError("ReactorNet::preconditionerSetup",
+            "Preconditioner is singular in column " + int2str(info - 1));
+    }
+    return newJac;
+}
+
+void ReactorNet::preconditionerSolve(double* rhs, double* z)
+{
+    int info = m_precon.solve(rhs, z);
+    if (info) {
+        throw CanteraError("ReactorNet::preconditionerSolve",
+                           "Preconditioner solve failed");
+    }
+}
+
+void ReactorNet::preconditionerSolveTranspose(double* rhs, double* z)
+{
+    std::copy(rhs, rhs + m_nv, z);
+    int info = m_precon.solveTranspose(z);
+    if (info) {
+        throw CanteraError("ReactorNet::preconditionerSolveTranspose",
+                           "Preconditioner solve failed");
+    }
+}
+
+std::vector<std::vector<size_t> > ReactorNet::preconditionerRows()
+{
+    if (m_preconditioner == "sparse") {
+        return m_coupled;
+    }
+    std::vector<std::vector<size_t> > rows(m_reactors.size());
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        rows[n].assign(1, n);
+    }
+    return rows;
+}
+
+void ReactorNet::evalPreconditionerJacobian(double t, double* y, double* ydot)
+{
+    updateState(y);
+    evalColoredJacobian(t, y, ydot, preconditionerRows(), &m_precon_jac[0],
+                        m_jacobianType == "analytic");
+    m_precon_jac_ok = true;
+    m_nPreconJacEvals++;
+}
+
+void ReactorNet::getJacobian(double t, double* y, double* ydot, double* p,
+                             Array2D& jac)
+{
+    updateState(y);
+    std::vector<size_t> colStart, rowIndex;
+    jacobianStructure(m_coupled, colStart, rowIndex);
+    m_jac_values.resize(rowIndex.size());
+    evalColoredJacobian(t, y, ydot, m_coupled, &m_jac_values[0],
+                        m_jacobianType == "analytic");
+    jac.zero();
+    for (size_t j = 0; j < m_nv; j++) {
+        for (size_t q = colStart[j]; q < colStart[j+1]; q++) {
+            jac(rowIndex[q], j) = m_jac_values[q];
+        }
+    }
+}
+
+void ReactorNet::evalSparseJacobian(double t, double* y, double* ydot,
+                                    SparseMatrix& jac)
+{
+    if (!m_init) {
+        initialize();
+    }
+    std::vector<size_t> colStart, rowIndex;
+    jacobianStructure(m_coupled, colStart, rowIndex);
+    if (jac.nRows() != m_nv || jac.nColumns() != m_nv ||
+            jac.nNonzeros() != rowIndex.size()) {
+        jac.setStructure(m_nv, colStart, rowIndex);
+    }
+    updateState(y);
+    evalColoredJacobian(t, y, ydot, m_coupled, &*jac.begin(),
+                        m_jacobianType == "analytic");
+}
+
+void ReactorNet::evalColoredJacobian(
+    double t, double* y, double* ydot,
+    const std::vector<std::vector<size_t> >& rows, double* jac,
+    bool analytic, double hmin)
+{
+    size_t nr = m_reactors.size();
+    // Location of the Jacobian block for each reactor, the number of rows in
+    // that block, and the first row of the reactor's own equations
+    std::vector<size_t> start(nr), ld(nr), offset(nr);
+    size_t p = 0;
+    size_t maxnv = 0;
+    for (size_t n = 0; n < nr; n++) {
+        size_t nv = m_start[n+1] - m_start[n];
+        start[n] = p;
+        ld[n] = 0;
+        for (size_t i = 0; i < rows[n].size(); i++) {
+            if (rows[n][i] == n) {
+                offset[n] = ld[n];
+            }
+            ld[n] += m_start[rows[n][i]+1] - m_start[rows[n][i]];
+        }
+        p += ld[n] * nv;
+        maxnv = std::max(maxnv, nv);
+    }
+
+    // Columns for the species in the homogeneous phase, which are evaluated
+    // analytically if possible. The dependence of the other reactors on the
+    // composition of each reactor is neglected.
+    std::vector<size_t> kstart(nr, npos), kend(nr, npos);
+    if (analytic) {
+        for (size_t n = 0; n < nr; n++) {
+            Reactor& r = *m_reactors[n];
+            double* block = jac + start[n];
+            r.evalEqs(t, y + m_start[n], &m_ydot[m_start[n]], 0);
+            if (r.evalSpeciesJacobian(t, &m_ydot[m_start[n]],
+                                      block + offset[n], ld[n])) {
+                kstart[n] = r.componentIndex(r.contents().speciesName(0));
+                kend[n] = kstart[n] + r.contents().nSpecies();
+                for (size_t j = kstart[n]; j < kend[n]; j++) {
+                    double* col = block + ld[n] * j;
+                    std::fill(col, col + offset[n], 0.0);
+                    std::fill(col + offset[n] + r.neq(), col + ld[n], 0.0);
+                }
+            }
+        }
+    }
+
+    // The remaining columns are evaluated by finite differences. Column j of
+    // each reactor in a group is perturbed at the same time, and the
+    // governing equations of each reactor affected by these perturbations
+    // are evaluated once. The coloring ensures that each affected reactor
+    // depends on only one of the perturbed reactors, given by owner[m], and
+    // its rows start at pos[m] within the column of that reactor.
+    vector_fp dy(nr), ysave(nr);
+    std::vector<size_t> owner(nr), pos(nr);
+    for (size_t c = 0; c < m_colors.size(); c++) {
+        const std::vector<size_t>& color = m_colors[c];
+        owner.assign(nr, npos);
+        for (size_t i = 0; i < color.size(); i++) {
+            size_t n = color[i];
+            size_t q0 = 0;
+            for (size_t q = 0; q < rows[n].size(); q++) {
+                size_t m = rows[n][q];
+                owner[m] = n;
+                pos[m] = q0;
+                q0 += m_start[m+1] - m_start[m];
+            }
+        }
+
+        for (size_t j = 0; j < maxnv; j++) {
+            bool perturbed = false;
+            for (size_t i = 0; i < color.size(); i++) {
+                size_t n = color[i];
+                dy[n] = 0.0;
+                if (j >= m_start[n+1] - m_start[n] ||
+                        (j >= kstart[n] && j < kend[n])) {
+                    continue;
+                }
+                // perturb y(j) for reactor n
+                size_t jg = m_start[n] + j;
+                ysave[n] = y[jg];
+                double h = m_atol[jg] + fabs(ysave[n])*m_rtol;
+                if (hmin > 0.0) {
+                    h = std::max(h, sqrt(DBL_EPSILON) *
+                                 std::max(fabs(ysave[n]), hmin));
+                }
+                y[jg] = ysave[n] + h;
+                dy[n] = y[jg] - ysave[n];
+                m_reactors[n]->updateState(y + m_start[n]);
+                perturbed = true;
+            }
+            if (!perturbed) {
+                continue;
+            }
+
+            for (size_t m = 0; m < nr; m++) {
+                size_t n = owner[m];
+                if (n == npos || dy[n] == 0.0) {
+                    continue;
+                }
+                m_reactors[m]->evalEqs(t, y + m_start[m],
+                                       &m_ydot[m_start[m]], 0);
+                double* col = jac + start[n] + ld[n] * j + pos[m];
+                for (size_t k = m_start[m]; k < m_start[m+1]; k++) {
+                    *col++ = (m_ydot[k] - ydot[k]) / dy[n];
+                }
+            }
+
+            for (size_t i = 0; i < color.size(); i++) {
+                size_t n = color[i];
+                if (dy[n] != 0.0) {
+                    y[m_start[n] + j] = ysave[n];
+                    m_reactors[n]->updateState(y + m_start[n]);
+                }
+            }
+        }
+    }
+}
+
+void ReactorNet::setAdjointSensitivity(bool adjoint, int checkpointSteps)
+{
+    if (adjoint && checkpointSteps <= 0) {
+        throw CanteraError("ReactorNet::setAdjointSensitivity",
+                           "The number of steps between checkpoints must be "
+                           "positive.");
+    }
+    int steps = adjoint ? checkpointSteps : 0;
+    // Fails immediately if the integrator does not support adjoints
+    m_integ->setAdjointCheckpointSteps(steps);
+    m_adjointSteps = steps;
+    m_init = false;
+}
+
+void ReactorNet::getAdjointSensitivities(const double* dgdy, double* dgdp)
+{
+    if (m_adjointSteps <= 0) {
+        throw CanteraError("ReactorNet::getAdjointSensitivities",
+                           "Adjoint sensitivity analysis is not enabled.");
+    }
+    if (!m_init || !m_integrator_init) {
+        throw CanteraError("ReactorNet::getAdjointSensitivities",
+                           "The network has not been integrated since it "
+                           "was last initialized.");
+    }
+    m_adj_dgdp.resize(std::max<size_t>(m_ntotpar, 1));
+    m_integ->solveAdjoint(dgdy, &m_adj_dgdp[0]);
+    for (size_t p = 0; p < m_ntotpar; p++) {
+        dgdp[p] = m_adj_dgdp[m_sensIndex[p]];
+    }
+
+    // The backward integration leaves the reactors at earlier states, and
+    // forward integration can't continue from the stored checkpoints
+    updateState(m_integ->solution());
+    m_integrator_init = false;
+}
+
+void ReactorNet::getEventTimeSensitivities(size_t i, double* dtdp)
+{
+    const ReactorEvent& ev = m_events.at(i);
+    if (ev.type != "threshold" && ev.type != "function") {
+        throw CanteraError("ReactorNet::getEventTimeSensitivities",
+                           "Sensitivities are not available for '" +
+                           ev.type + "' events.");
+    }
+    if (!m_init || !m_integrator_init || m_lastEvent != i ||
+            !ev.terminal || m_time != ev.time) {
+        throw CanteraError("ReactorNet::getEventTimeSensitivities",
+                           "Event " + int2str(i) + " must be a terminal event "
+                           "which stopped the integration.");
+    }
+
+    // At the event, the root function g(q(y(t))) is zero. Differentiating
+    // with respect to a parameter p gives
+    //     dt/dp = -(dq/dy . dy/dp) / (dq/dy . dy/dt),
+    // so the objective for the adjoint problem has the weights
+    // -(dq/dy) / (dq/dt). The derivatives of the event quantity q are
+    // evaluated by perturbing the state of the reactor.
+    size_t n = std::find(m_reactors.begin(), m_reactors.end(), ev.reactor) -
+               m_reactors.begin();
+    vector_fp y(m_integ->solution(), m_integ->solution() + m_nv);
+    vector_fp ydot(m_nv);
+    vector_fp dgdy(m_nv, 0.0);
+    updateState(&y[0]);
+    for (size_t m = 0; m < m_reactors.size(); m++) {
+        m_reactors[m]->evalEqs(m_time, &y[m_start[m]], &ydot[m_start[m]], 0);
+    }
+    double q0 = eventQuantity(i);
+    double dqdt = 0.0;
+    for (size_t j = m_start[n]; j < m_start[n+1]; j++) {
+        double ysave = y[j];
+        double dy = sqrt(DBL_EPSILON) * std::max(fabs(ysave), 1.0);
+        y[j] = ysave + dy;
+        dy = y[j] - ysave;
+        m_reactors[n]->updateState(&y[m_start[n]]);
+        dgdy[j] = (eventQuantity(i) - q0) / dy;
+        dqdt += dgdy[j] * ydot[j];
+        y[j] = ysave;
+    }
+    m_reactors[n]->updateState(&y[m_start[n]]);
+    if (dqdt == 0.0) {
+        throw CanteraError("ReactorNet::getEventTimeSensitivities",
+                           "The event quantity is not changing at the time "
+                           "of the event.");
+    }
+    for (size_t j = m_start[n]; j < m_start[n+1]; j++) {
+        dgdy[j] /= -dqdt;
+    }
+    getAdjointSensitivities(&dgdy[0], dtdp);
+}
+
+void ReactorNet::evalAdjoint(double t, double* y, double* lambda,
+                             double* lambdaDot)
+{
+    if (m_adj_rowIndex.empty()) {
+        jacobianStructure(m_coupled, m_adj_colStart, m_adj_rowIndex);
+        m_adj_jac.resize(m_adj_rowIndex.size());
+    }
+
+    // The integrator evaluates the adjoint equations several times at each
+    // point of the forward solution, so the Jacobian is reused while the
+    // state is unchanged. All columns are evaluated by finite differences,
+    // since the analytic approximation neglects some of the coupling terms,
+    // with larger perturbations than those used for the preconditioner so
+    // that the columns of trace species are accurate.
+    if (t != m_adj_t || m_adj_y.size() != m_nv ||
+            !std::equal(y, y + m_nv, m_adj_y.begin())) {
+        m_adj_ydot.resize(m_nv);
+        updateState(y);
+        for (size_t n = 0; n < m_reactors.size(); n++) {
+            m_reactors[n]->evalEqs(t, y + m_start[n], &m_adj_ydot[m_start[n]],
+                                   0);
+        }
+        evalColoredJacobian(t, y, &m_adj_ydot[0], m_coupled, &m_adj_jac[0],
+                            false, 1e-8);
+        m_adj_t = t;
+        m_adj_y.assign(y, y + m_nv);
+    }
+
+    for (size_t j = 0; j < m_nv; j++) {
+        double sum = 0.0;
+        for (size_t q = m_adj_colStart[j]; q < m_adj_colStart[j+1]; q++) {
+            sum += m_adj_jac[q] * lambda[m_adj_rowIndex[q]];
+        }
+        lambdaDot[j] = -sum;
+    }
+}
+
+void ReactorNet::evalAdjointParams(double t, double* y, double* lambda,
+                                   double* dfdp)
+{
+    updateState(y);
+    size_t pstart = 0;
+    for (size_t n = 0; n < m_reactors.size(); n++) {
+        Reactor& r = *m_reactors[n];
+        size_t np = m_nparams[n];
+        if (np == 0) {
+            continue;
+        }
+        size_t nv = m_start[n+1] - m_start[n];
+        double* yn = y + m_start[n];
+        double* ln = lambda + m_start[n];
+        m_adj_ydot.resize(m_nv);
+        r.evalEqs(t, yn, &m_adj_ydot[m_start[n]], 0);
+        if (r.evalParameterAdjoint(ln, dfdp + pstart)) {
+            pstart += np;
+            continue;
+        }
+
+        // Finite difference approximation. The parameters of each reactor
+        // affect only its own governing equations.
+        const double* ydot = &m_adj_ydot[m_start[n]];
+        m_adj_ydot2.resize(nv);
+        m_adj_params.assign(np, 1.0);
+        double dp = sqrt(DBL_EPSILON);
+        for (size_t i = 0; i < np; i++) {
+            m_adj_params[i] = 1.0 + dp;
+            r.evalEqs(t, yn, &m_adj_ydot2[0], &m_adj_params[0]);
+            m_adj_params[i] = 1.0;
+            double sum = 0.0;
+            for (size_t k = 0; k < nv; k++) {
+                sum += ln[k] * (m_adj_ydot2[k] - ydot[k]);
+            }
+            dfdp[pstart + i] = sum / dp;
+        }
+        pstart += np;
+    }
+}
+
 void ReactorNet::updateState(doublereal* y)
 {
     for (size_t n = 0; n < m_reactors.size(); n++) {
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include "cantera/equil/BatchEquil.h"
+#include "cantera/equil/equil.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+class BatchEquilTest : public testing::Test
+{
+public:
+    BatchEquilTest() :
+        gas("gri30.xml", "gri30_mix"),
+        nsp(gas.nSpecies()) {
+    }
+
+    // Points with mixture fractions between 0.03 and 0.1, at enthalpies
+    // above that of the mixture at 300 K
+    void setup(size_t n) {
+        vector_fp Yf(nsp), Yo(nsp);
+        gas.setState_TPX(300.0, OneAtm, "CH4:1");
+        gas.getMassFractions(&Yf[0]);
+        double hf = gas.enthalpy_mass();
+        gas.setState_TPX(300.0, OneAtm, "O2:1, N2:3.76");
+        gas.getMassFractions(&Yo[0]);
+        double ho = gas.enthalpy_mass();
+        Y.resize(n * nsp);
+        h.resize(n);
+        P.assign(n, OneAtm);
+        for (size_t i = 0; i < n; i++) {
+            double Z = 0.03 + 0.07 * (i % 10) / 9.0;
+            for (size_t k = 0; k < nsp; k++) {
+                Y[i*nsp + k] = Z * Yf[k] + (1 - Z) * Yo[k];
+            }
+            h[i] = Z * hf + (1 - Z) * ho + 1e5 * (i / 10);
+        }
+    }
+
+protected:
+    IdealGasMix gas;
+    size_t nsp;
+    vector_fp Y, h, P;
+};
+
+TEST_F(BatchEquilTest, matches_equilibrate)
+{
+    size_t n = 40;
+    setup(n);
+    vector_fp out(n * (nsp + 2));
+    std::vector<int> converged(n, 0);
+    BatchEquil batch(gas);
+    batch.setNumThreads(3);
+    batch.setBlockSize(7);
+    EXPECT_EQ((size_t) 0, batch.equilibrate("HP", n, &Y[0], &h[0], &P[0],
+                                            &out[0], &converged[0]));
+    EXPECT_EQ("", batch.errorMessage());
+
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(1, converged[i]);
+        gas.setMassFractions(&Y[i*nsp]);
+        gas.setState_HP(h[i], P[i]);
+        equilibrate(gas, "HP");
+        const double* row = &out[i*(nsp+2)];
+        EXPECT_NEAR(gas.temperature(), row[0], 1e-6 * gas.temperature());
+        EXPECT_NEAR(OneAtm, row[1], 1e-9 * OneAtm);
+        for (size_t k = 0; k < nsp; k++) {
+            EXPECT_NEAR(gas.massFraction(k), row[k+2], 1e-9);
+        }
+    }
+}
+
+TEST_F(BatchEquilTest, failed_points)
+{
+    size_t n = 10;
+    setup(n);
+    vector_fp T(n, 1500.0);
+    T[4] = 1.0e5; // outside the valid temperature range
+    vector_fp out(n * (nsp + 2), -1.0);
+    std::vector<int> converged(n, 1);
+    BatchEquil batch(gas);
+    batch.setSolver(0);
+    EXPECT_EQ((size_t) 1, batch.equilibrate("TP", n, &Y[0], &T[0], &P[0],
+                                            &out[0], &converged[0]));
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_EQ(i != 4, converged[i] == 1);
+    }
+    EXPECT_DOUBLE_EQ(-1.0, out[4*(nsp+2)]);
+    EXPECT_DOUBLE_EQ(1500.0, out[5*(nsp+2)]);
+    EXPECT_NE("", batch.errorMessage());
+    EXPECT_THROW(batch.setSolver(1), CanteraError);
+    EXPECT_THROW(batch.equilibrate("XY", n, &Y[0], &T[0], &P[0], &out[0],
+                                   &converged[0]), CanteraError);
+}
+
+}
@@ -0,0 +1,213 @@
+#include "gtest/gtest.h"
+#include "cantera/equil/ChemEquil.h"
+#include "cantera/equil/equil.h"
+#include "cantera/numerics/DenseMatrix.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+// Gives access to the Jacobian evaluation of ChemEquil
+class TestChemEquil : public ChemEquil
+{
+public:
+    TestChemEquil(thermo_t& s) : ChemEquil(s) {}
+
+    // Compare the analytic and numerical Jacobians at a point away from the
+    // current solution of the phase *s*, which must have been computed by
+    // this object. The tolerance allows for the truncation error of the
+    // finite differences in log(T).
+    void checkJacobian(thermo_t& s, double xval, double yval) {
+        update(s);
+        vector_fp goal = m_elementmolefracs;
+        vector_fp x(elementPotentials_RT());
+        x.push_back(log(s.temperature()) + 0.05);
+        for (size_t m = 0; m < m_mm; m++) {
+            x[m] += 0.1 * (m + 1);
+        }
+        DenseMatrix jac(m_mm + 1, m_mm + 1);
+        DenseMatrix jacFD(m_mm + 1, m_mm + 1);
+        equilJacobian(s, x, goal, jac, xval, yval);
+        numericalJacobian(s, x, goal, jacFD, xval, yval);
+        for (size_t i = 0; i <= m_mm; i++) {
+            for (size_t j = 0; j <= m_mm; j++) {
+                EXPECT_NEAR(jacFD(i,j), jac(i,j),
+                            1e-4 * std::max(std::abs(jacFD(i,j)), 1.0))
+                    << "i = " << i << ", j = " << j;
+            }
+        }
+    }
+};
+
+class ChemEquilTest : public testing::Test
+{
+public:
+    ChemEquilTest() : gas("gri30.xml", "gri30_mix") {}
+
+    void setFuelAir(double phi, double T) {
+        compositionMap X;
+        X["CH4"] = phi;
+        X["O2"] = 2.0;
+        X["N2"] = 7.52;
+        gas.setState_TPX(T, OneAtm, X);
+    }
+
+    // Equilibrate a copy of the current state with a new solver object
+    void solveCold(vector_fp& X, double& T) {
+        std::auto_ptr<ThermoPhase> gas2(gas.duplMyselfAsThermoPhase());
+        ChemEquil eq(*gas2);
+        ASSERT_EQ(0, eq.equilibrate(*gas2, "HP"));
+        X.resize(gas2->nSpecies());
+        gas2->getMoleFractions(&X[0]);
+        T = gas2->temperature();
+    }
+
+    void compare(const vector_fp& X, double T) {
+        EXPECT_NEAR(T, gas.temperature(), 1e-6 * T);
+        for (size_t k = 0; k < X.size(); k++) {
+            EXPECT_NEAR(X[k], gas.moleFraction(k), 1e-9);
+        }
+    }
+
+protected:
+    IdealGasMix gas;
+};
+
+TEST_F(ChemEquilTest, analytic_jacobian)
+{
+    const char* pairs[] = {"TP", "HP", "SP", "TV", "UV", "SV"};
+    for (size_t i = 0; i < 6; i++) {
+        setFuelAir(0.8, 1500.0);
+        TestChemEquil eq(gas);
+        ASSERT_EQ(0, eq.equilibrate(gas, pairs[i]));
+        double xval = 0.0, yval = 0.0;
+        std::string XY = pairs[i];
+        switch (XY[0]) {
+        case 'T':
+            xval = gas.temperature();
+            break;
+        case 'H':
+            xval = gas.enthalpy_mass();
+            break;
+        case 'S':
+            xval = gas.entropy_mass();
+            break;
+        case 'U':
+            xval = gas.intEnergy_mass();
+            break;
+        }
+        yval = (XY[1] == 'P') ? gas.pressure() : gas.density();
+        eq.checkJacobian(gas, xval, yval);
+    }
+}
+
+TEST_F(ChemEquilTest, continuation)
+{
+    // Each problem starts from the solution of the previous one
+    ChemEquil eq(gas);
+    eq.options.contin = true;
+    for (double phi = 0.6; phi < 1.5; phi += 0.1) {
+        setFuelAir(phi, 300.0);
+        vector_fp X;
+        double T;
+        solveCold(X, T);
+        ASSERT_EQ(0, eq.equilibrate(gas, "HP"));
+        compare(X, T);
+    }
+    EXPECT_EQ(0, (int) eq.warmStartFailures());
+
+    // The element potentials of the solution are those of the phase
+    vector_fp lambda(gas.nElements());
+    gas.getElementPotentials(&lambda[0]);
+    for (size_t m = 0; m < lambda.size(); m++) {
+        EXPECT_NEAR(lambda[m] / (GasConstant * gas.temperature()),
+                    eq.elementPotentials_RT()[m], 1e-10);
+    }
+}
+
+TEST_F(ChemEquilTest, initial_estimate)
+{
+    setFuelAir(1.0, 300.0);
+    vector_fp X;
+    double T;
+    solveCold(X, T);
+
+    // A poor estimate still gives the correct solution
+    ChemEquil eq(gas);
+    vector_fp lambda(gas.nElements(), 0.0);
+    eq.setInitialEstimate(lambda, 500.0);
+    ASSERT_EQ(0, eq.equilibrate(gas, "HP"));
+    compare(X, T);
+
+    setFuelAir(1.0, 300.0);
+    eq.setInitialEstimate(eq.elementPotentials_RT(), gas.temperature() + 10);
+    ASSERT_EQ(0, eq.equilibrate(gas, "HP"));
+    compare(X, T);
+}
+
+TEST_F(ChemEquilTest, stats)
+{
+    setFuelAir(1.0, 300.0);
+    ChemEquil eq(gas);
+    ASSERT_EQ(0, eq.equilibrate(gas, "HP"));
+    const EquilStats& stats = eq.stats();
+    EXPECT_EQ(1, (int) stats.calls);
+    EXPECT_EQ(eq.options.iterations, (int) stats.iterations);
+    EXPECT_GT(stats.thermoEvals, stats.iterations);
+    EXPECT_EQ(1, (int) stats.basisOpts);
+    EXPECT_EQ(0, (int) stats.speciesDeleted);
+    EXPECT_GT(stats.time, 0.0);
+    EXPECT_LE(stats.timeInnerLoop + stats.timeBasisOpt, stats.time);
+
+    // A warm start does not need an initial estimate
+    eq.options.contin = true;
+    setFuelAir(1.0, 300.0);
+    ASSERT_EQ(0, eq.equilibrate(gas, "HP"));
+    EXPECT_EQ(0, (int) stats.basisOpts);
+    EXPECT_EQ(eq.options.iterations, (int) stats.iterations);
+
+    // Statistics from the driver function
+    EquilStats total;
+    setFuelAir(1.0, 300.0);
+    equilibrate(gas, "HP", 0, 1e-9, 1000, 100, -99, &total);
+    EXPECT_EQ(1, (int) total.calls);
+    EXPECT_GT(total.iterations, 0u);
+}
+
+TEST_F(ChemEquilTest, cache)
+{
+    ChemEquil eq(gas);
+    eq.setCacheSize(4);
+    eq.setCacheTolerance(0.01);
+    for (double phi = 0.5; phi < 1.4; phi += 0.2) {
+        setFuelAir(phi, 300.0);
+        ASSERT_EQ(0, eq.equilibrate(gas, "HP"));
+    }
+    EXPECT_EQ(0, (int) eq.cacheHits());
+
+    // The first solution has been replaced, and problems which are not
+    // found in the cache replace the oldest solutions
+    double phi[] = {0.71, 0.89, 0.51, 1.2};
+    for (size_t i = 0; i < 4; i++) {
+        setFuelAir(phi[i], 302.0);
+        vector_fp X;
+        double T;
+        solveCold(X, T);
+        ASSERT_EQ(0, eq.equilibrate(gas, "HP"));
+        compare(X, T);
+    }
+    EXPECT_EQ(2, (int) eq.cacheHits());
+    EXPECT_EQ(0, (int) eq.warmStartFailures());
+
+    // Cached solutions are only used for the same property pair
+    setFuelAir(0.7, 2000.0);
+    ASSERT_EQ(0, eq.equilibrate(gas, "TP"));
+    EXPECT_EQ(2, (int) eq.cacheHits());
+
+    eq.clearCache();
+    setFuelAir(0.71, 300.0);
+    ASSERT_EQ(0, eq.equilibrate(gas, "HP"));
+    EXPECT_EQ(2, (int) eq.cacheHits());
+}
+
+}
@@ -0,0 +1,236 @@
+#include "gtest/gtest.h"
+#include "cantera/equil/vcs_MultiPhaseEquil.h"
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+class GasCarbonEquilTest : public testing::Test
+{
+public:
+    GasCarbonEquilTest() :
+        gas("gri30.xml", "gri30_mix"),
+        carbon(newPhase("graphite.xml", "")),
+        mix(0) {
+    }
+
+    ~GasCarbonEquilTest() {
+        delete mix;
+        delete carbon;
+    }
+
+    void setup(double phi, double T) {
+        compositionMap X;
+        X["CH4"] = phi / 2.0;
+        X["O2"] = 1.0;
+        X["N2"] = 3.76;
+        gas.setState_TPX(T, OneAtm, X);
+        carbon->setState_TP(T, OneAtm);
+        delete mix;
+        mix = new MultiPhase();
+        mix->addPhase(&gas, 1.0);
+        mix->addPhase(carbon, 0.0);
+        mix->init();
+        mix->setTemperature(T);
+        mix->setPressure(OneAtm);
+    }
+
+protected:
+    IdealGasMix gas;
+    ThermoPhase* carbon;
+    MultiPhase* mix;
+};
+
+TEST_F(GasCarbonEquilTest, HP_iterations)
+{
+    // Adiabatic flame temperatures with (phi = 3.5) and without solid carbon
+    // in the products. The outer temperature iteration should converge with
+    // few constant T-P solves, even from far away from the solution.
+    double phi[] = {1.0, 3.5};
+    double Tad[] = {2225.6, 964.0};
+    for (size_t i = 0; i < 2; i++) {
+        setup(phi[i], 300.0);
+        double H0 = mix->enthalpy();
+        VCSnonideal::vcs_MultiPhaseEquil eq(mix, 0);
+        eq.equilibrate(HP, 0, 0, 1e-9);
+        EXPECT_NEAR(Tad[i], mix->temperature(), 0.1);
+        EXPECT_NEAR(H0, mix->enthalpy(), 1e-8 * std::abs(H0));
+        EXPECT_LE(eq.iterations(), 10);
+    }
+    EXPECT_GT(mix->phaseMoles(1), 0.0);
+}
+
+TEST_F(GasCarbonEquilTest, SP_UP)
+{
+    setup(1.0, 1800.0);
+    VCSnonideal::vcs_MultiPhaseEquil eq(mix, 0);
+    eq.equilibrate(TP, 0, 0, 1e-9);
+    double S1 = mix->entropy();
+    double U1 = mix->IntEnergy();
+
+    // Start far from the solution, from the equilibrium state at 2500 K
+    mix->setTemperature(2500.0);
+    eq.equilibrate(TP, 0, 0, 1e-9);
+    eq.equilibrate_SP(S1, 0.0, 0.0, 0, 0, 1e-9);
+    EXPECT_NEAR(1800.0, mix->temperature(), 1e-4);
+    EXPECT_LE(eq.iterations(), 8);
+
+    mix->setTemperature(2500.0);
+    eq.equilibrate(TP, 0, 0, 1e-9);
+    eq.equilibrate_HP(U1, UP, 0.0, 0.0, 0, 0, 1e-9);
+    EXPECT_NEAR(1800.0, mix->temperature(), 1e-4);
+    EXPECT_LE(eq.iterations(), 8);
+}
+
+TEST_F(GasCarbonEquilTest, stats)
+{
+    setup(3.5, 300.0);
+    VCSnonideal::vcs_MultiPhaseEquil eq(mix, 0);
+    eq.equilibrate(HP, 0, 0, 1e-9);
+    const EquilStats& stats = eq.stats();
+    EXPECT_EQ(1, (int) stats.calls);
+    EXPECT_EQ(eq.iterations(), (int) stats.outerIterations);
+    EXPECT_GT(stats.iterations, stats.outerIterations);
+    EXPECT_GE(stats.basisOpts, stats.outerIterations);
+    // The standard state properties are only evaluated when T changes
+    EXPECT_GE(stats.thermoEvals, stats.outerIterations);
+    EXPECT_GT(stats.time, 0.0);
+    EXPECT_LE(stats.timeInnerLoop, stats.time);
+    EXPECT_LE(stats.timeBasisOpt + stats.timeDeltaG +
+              stats.timePhaseStability, stats.timeInnerLoop);
+
+    // The statistics are reset for each problem
+    size_t its = stats.iterations;
+    eq.equilibrate(TP, 0, 0, 1e-9);
+    EXPECT_EQ(1, (int) stats.outerIterations);
+    EXPECT_LT(stats.iterations, its);
+
+    // The driver functions add to the statistics
+    EquilStats total;
+    setup(1.0, 300.0);
+    vcs_equilibrate(*mix, "HP", 0, 0, 2, 1e-9, VCS_MAXSTEPS, 100, -99,
+                    &total);
+    vcs_equilibrate(*mix, "TP", 0, 0, 2, 1e-9, VCS_MAXSTEPS, 100, -99,
+                    &total);
+    EXPECT_EQ(2, (int) total.calls);
+    EXPECT_GT(total.outerIterations, 2u);
+    std::map<std::string, double> values;
+    total.getStats(values);
+    EXPECT_EQ(14, (int) values.size());
+    EXPECT_EQ((double) total.thermoEvals, values["thermo_evals"]);
+    EXPECT_EQ(total.time, total.get("time"));
+    EXPECT_THROW(total.get("nonexistent"), CanteraError);
+}
+
+class KOHEquilTest : public testing::Test
+{
+public:
+    KOHEquilTest() {
+        const char* names[] = {"K_solid", "K_liquid", "KOH_a", "KOH_b",
+                               "KOH_liquid", "K2O2_solid", "K2O_solid",
+                               "KO2_solid", "ice", "liquid_water",
+                               "KOH_plasma"};
+        for (size_t i = 0; i < 11; i++) {
+            phases.push_back(newPhase("KOH.xml", names[i]));
+            mix.addPhase(phases.back(), 0.0);
+        }
+        mix.init();
+        mix.setPressure(OneAtm);
+        mix.setMolesByName("K:1.03, H2:2.12, O2:0.9");
+    }
+
+    ~KOHEquilTest() {
+        for (size_t i = 0; i < phases.size(); i++) {
+            delete phases[i];
+        }
+    }
+
+protected:
+    std::vector<ThermoPhase*> phases;
+    MultiPhase mix;
+};
+
+TEST_F(KOHEquilTest, HP_near_solution)
+{
+    // Starting from the equilibrium composition 1 K away from the solution,
+    // the Newton iteration needs only one more constant T-P solve after the
+    // first one.
+    mix.setTemperature(2999.0);
+    VCSnonideal::vcs_MultiPhaseEquil eq(&mix, 0);
+    eq.equilibrate(TP, 0, 0, 1e-9);
+    mix.setTemperature(3000.0);
+    eq.equilibrate(HP, 0, 0, 1e-9);
+    EXPECT_NEAR(3000.0, mix.temperature(), 1e-3);
+    EXPECT_LE(eq.iterations(), 3);
+}
+
+TEST_F(KOHEquilTest, species_deleted)
+{
+    // At high temperature, condensed species which are not stable are
+    // removed from the set of active species
+    mix.setTemperature(3000.0);
+    VCSnonideal::vcs_MultiPhaseEquil eq(&mix, 0);
+    EXPECT_EQ(0, eq.equilibrate(TP, 0, 0, 1e-9));
+    EXPECT_GT(eq.stats().speciesDeleted, 0u);
+    EXPECT_EQ(mix.nPhases(), eq.stats().thermoEvals);
+}
+
+TEST_F(KOHEquilTest, state_updates)
+{
+    // The composition of a phase is only sent to its ThermoPhase object when
+    // it changes. Only the gas phase changes in every iteration, rather than
+    // all of the phases being updated twice per iteration.
+    mix.setTemperature(3000.0);
+    VCSnonideal::vcs_MultiPhaseEquil eq(&mix, 0);
+    EXPECT_EQ(0, eq.equilibrate(TP, 0, 0, 1e-9));
+    const EquilStats& stats = eq.stats();
+    EXPECT_GT(stats.thermoStateUpdates, stats.iterations);
+    EXPECT_LT(stats.thermoStateUpdates,
+              stats.iterations + 2 * mix.nPhases());
+}
+
+TEST_F(KOHEquilTest, warm_start_sweep)
+{
+    // A temperature sweep across several phase transitions, solved with a
+    // single warm-started solver object, gives the same results as solving
+    // each state with a new solver object.
+    std::vector<vector_fp> cold;
+    for (double T = 300.0; T <= 3500.0; T += 100.0) {
+        mix.setTemperature(T);
+        VCSnonideal::vcs_MultiPhaseEquil eq(&mix, 0);
+        EXPECT_EQ(0, eq.equilibrate(TP, 0, 0, 1e-9));
+        cold.push_back(vector_fp(mix.nSpecies()));
+        mix.getMoles(&cold.back()[0]);
+    }
+
+    mix.setMolesByName("K:1.03, H2:2.12, O2:0.9");
+    VCSnonideal::vcs_MultiPhaseEquil eq(&mix, 0);
+    vector_fp moles(mix.nSpecies());
+    size_t i = 0;
+    for (double T = 300.0; T <= 3500.0; T += 100.0, i++) {
+        mix.setTemperature(T);
+        EXPECT_EQ(0, eq.equilibrate(TP, 0, 0, 1e-9));
+        mix.getMoles(&moles[0]);
+        for (size_t k = 0; k < moles.size(); k++) {
+            EXPECT_NEAR(cold[i][k], moles[k], 1e-9);
+        }
+    }
+    EXPECT_EQ(1, eq.nFullSetups());
+
+    eq.setWarmStart(false);
+    mix.setTemperature(1000.0);
+    eq.equilibrate(TP, 0, 0, 1e-9);
+    EXPECT_EQ(2, eq.nFullSetups());
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    printf("Running main() from vcs_equilibrate.cpp\n");
+    testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+    Cantera::appdelete();
+    return result;
+}
@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include "cantera/kinetics.h"
+#include "cantera/thermo/SurfPhase.h"
+#include "cantera/thermo/ThermoFactory.h"
+
+namespace Cantera
+{
+
+class BatchInterfaceKineticsTest : public testing::Test
+{
+public:
+    BatchInterfaceKineticsTest() :
+        gas(newPhase("ptcombust.xml", "gas")),
+        surf(dynamic_cast<SurfPhase*>(newPhase("ptcombust.xml", "Pt_surf")))
+    {
+        std::vector<ThermoPhase*> phases;
+        phases.push_back(gas.get());
+        phases.push_back(surf.get());
+        importKinetics(surf->xml(), phases, &kin);
+        ngas = gas->nSpecies();
+        nsurf = surf->nSpecies();
+        ntot = kin.nTotalSpecies();
+    }
+
+    // Faces with a range of temperatures, pressures, gas compositions and
+    // coverages. Groups of three faces have the same temperature.
+    void setup(size_t n) {
+        T.resize(n);
+        P.resize(n);
+        Y.resize(n * ngas);
+        theta.resize(n * nsurf);
+        for (size_t i = 0; i < n; i++) {
+            T[i] = 700.0 + 20.0 * (i / 3);
+            P[i] = OneAtm * (1.0 + 0.1 * (i % 3));
+            double x = 0.02 + 0.01 * (i % 7);
+            compositionMap X;
+            X["CH4"] = x;
+            X["O2"] = 0.21;
+            X["H2O"] = 0.5 * x;
+            X["AR"] = 0.79 - 1.5 * x;
+            gas->setState_TPX(T[i], P[i], X);
+            gas->getMassFractions(&Y[i*ngas]);
+            double a = 0.1 * (i % 5);
+            double* th = &theta[i*nsurf];
+            th[surf->speciesIndex("PT(S)")] = 0.5 - 0.5 * a;
+            th[surf->speciesIndex("O(S)")] = 0.2 + a;
+            th[surf->speciesIndex("H(S)")] = 0.1;
+            th[surf->speciesIndex("CO(S)")] = 0.1 - 0.5 * a;
+            th[surf->speciesIndex("C(S)")] = 0.1 * (i % 2);
+        }
+    }
+
+    // Compare with rates evaluated one face at a time
+    void check(size_t n, const vector_fp& wdot, const vector_fp& dthetadt) {
+        vector_fp w(ntot);
+        size_t kstart = kin.kineticsSpeciesIndex(0, 1);
+        for (size_t i = 0; i < n; i++) {
+            gas->setState_TPY(T[i], P[i], &Y[i*ngas]);
+            surf->setTemperature(T[i]);
+            surf->setCoveragesNoNorm(&theta[i*nsurf]);
+            kin.getNetProductionRates(&w[0]);
+            for (size_t k = 0; k < ntot; k++) {
+                EXPECT_NEAR(w[k], wdot[i*ntot + k], 1e-12 * std::abs(w[k]))
+                    << "i = " << i << ", k = " << k;
+            }
+            for (size_t k = 0; k < nsurf; k++) {
+                double rhs = w[kstart + k] * surf->size(k) / surf->siteDensity();
+                EXPECT_NEAR(rhs, dthetadt[i*nsurf + k], 1e-12 * std::abs(rhs))
+                    << "i = " << i << ", k = " << k;
+            }
+        }
+    }
+
+protected:
+    std::auto_ptr<ThermoPhase> gas;
+    std::auto_ptr<SurfPhase> surf;
+    InterfaceKinetics kin;
+    size_t ngas, nsurf, ntot;
+    vector_fp T, P, Y, theta;
+};
+
+TEST_F(BatchInterfaceKineticsTest, matches_single_faces)
+{
+    size_t n = 50;
+    setup(n);
+    BatchInterfaceKinetics batch(kin);
+    EXPECT_EQ(ngas, batch.nGasSpecies());
+    EXPECT_EQ(nsurf, batch.nSurfSpecies());
+    EXPECT_EQ(ntot, batch.nTotalSpecies());
+    EXPECT_EQ((size_t) 0, batch.gasPhaseIndex());
+    batch.setNumThreads(3);
+    batch.setBlockSize(8);
+
+    vector_fp wdot(n * ntot), dthetadt(n * nsurf);
+    batch.eval(n, &T[0], &P[0], &Y[0], &theta[0], &wdot[0], &dthetadt[0]);
+    check(n, wdot, dthetadt);
+
+    // The per-thread objects are reused, and only the requested outputs are
+    // computed
+    vector_fp dthetadt2(n * nsurf);
+    batch.eval(n, &T[0], &P[0], &Y[0], &theta[0], 0, &dthetadt2[0]);
+    for (size_t j = 0; j < n * nsurf; j++) {
+        EXPECT_DOUBLE_EQ(dthetadt[j], dthetadt2[j]);
+    }
+}
+
+TEST_F(BatchInterfaceKineticsTest, cached_rate_constants)
+{
+    // Repeated evaluations by a single kinetics object at the same
+    // temperature give the same results as evaluations by a fresh object
+    size_t n = 12;
+    setup(n);
+    BatchInterfaceKinetics batch(kin);
+    batch.setNumThreads(1);
+    vector_fp wdot(n * ntot), dthetadt(n * nsurf);
+    batch.eval(n, &T[0], &P[0], &Y[0], &theta[0], &wdot[0], &dthetadt[0]);
+    check(n, wdot, dthetadt);
+    for (size_t i = n; i > 0; i--) {
+        BatchInterfaceKinetics single(kin);
+        vector_fp w(ntot), dt(nsurf);
+        single.eval(1, &T[i-1], &P[i-1], &Y[(i-1)*ngas], &theta[(i-1)*nsurf],
+                    &w[0], &dt[0]);
+        for (size_t k = 0; k < ntot; k++) {
+            EXPECT_DOUBLE_EQ(w[k], wdot[(i-1)*ntot + k]);
+        }
+    }
+}
+
+TEST_F(BatchInterfaceKineticsTest, errors)
+{
+    size_t n = 4;
+    setup(n);
+    T[2] = -100.0;
+    BatchInterfaceKinetics batch(kin);
+    vector_fp wdot(n * ntot);
+    EXPECT_THROW(batch.eval(n, &T[0], &P[0], &Y[0], &theta[0], &wdot[0], 0),
+                 CanteraError);
+    EXPECT_THROW(BatchInterfaceKinetics(kin, 1), CanteraError);
+    EXPECT_THROW(batch.setNumThreads(0), CanteraError);
+}
+
+}
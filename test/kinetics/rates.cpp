@@ -1,6 +1,10 @@
 #include "gtest/gtest.h"
 #include "cantera/kinetics.h"
 #include "cantera/thermo/IdealGasPhase.h"
+#include "cantera/thermo/SurfPhase.h"
+#include "cantera/thermo/ThermoFactory.h"
+#include "cantera/kinetics/ImplicitSurfChem.h"
+#include "cantera/kinetics/solveSP.h"
 
 namespace Cantera
 {
@@ -125,6 +129,32 @@ TEST_F(FracCoeffTest, CreationDestructionRates)
     EXPECT_DOUBLE_EQ(0.0, ddot[therm.speciesIndex("O")]);
 }
 
+TEST_F(FracCoeffTest, CachedRatesOfProgress)
+{
+    vector_fp kf(kin.nReactions(), 0.0);
+    vector_fp conc(therm.nSpecies(), 0.0);
+    vector_fp ropf(kin.nReactions(), 0.0);
+    kin.getFwdRatesOfProgress(&ropf[0]);
+
+    // New composition at the same temperature and density
+    double T = therm.temperature();
+    double rho = therm.density();
+    therm.setMoleFractionsByName("H2O:0.4, OH:.1, H:0.1, O2:0.15, H2:0.25");
+    therm.setState_TR(T, rho);
+    kin.getFwdRatesOfProgress(&ropf[0]);
+    therm.getConcentrations(&conc[0]);
+    kin.getFwdRateConstants(&kf[0]);
+    EXPECT_DOUBLE_EQ(conc[kH2O]*kf[0], ropf[0]);
+
+    // Rate multipliers and use of the rate constants as work space
+    kin.setMultiplier(0, 2.0);
+    kin.getFwdRatesOfProgress(&ropf[0]);
+    EXPECT_DOUBLE_EQ(2*conc[kH2O]*kf[0], ropf[0]);
+    kin.getFwdRateConstants(&kf[0]);
+    kin.getFwdRatesOfProgress(&ropf[0]);
+    EXPECT_DOUBLE_EQ(conc[kH2O]*kf[0], ropf[0]);
+}
+
 TEST_F(FracCoeffTest, EquilibriumConstants)
 {
     vector_fp Kc(kin.nReactions(), 0.0);
@@ -144,4 +174,202 @@ TEST_F(FracCoeffTest, EquilibriumConstants)
     EXPECT_NEAR(exp(-deltaG0_1/RT) * pow(pRef/RT, -0.5), Kc[1], 1e-13 * Kc[1]);
 }
 
+TEST(KineticsDerivatives, NetProductionRates_ddC)
+{
+    IdealGasPhase therm("gri30.xml", "gri30");
+    std::vector<ThermoPhase*> phases;
+    phases.push_back(&therm);
+    GasKinetics kin;
+    importKinetics(therm.xml(), phases, &kin);
+
+    // The analytic derivatives neglect the composition dependence of third
+    // body and falloff reactions, so only elementary reactions are compared
+    for (size_t i = 0; i < kin.nReactions(); i++) {
+        if (kin.reactionType(i) != ELEMENTARY_RXN) {
+            kin.setMultiplier(i, 0.0);
+        }
+    }
+    therm.setState_TPX(1500, OneAtm, "CH4:1.0, O2:2.0, N2:7.52, H:0.01, "
+                       "OH:0.02, O:0.005, CO:0.05, H2O:0.1, HO2:0.001");
+
+    size_t nsp = therm.nSpecies();
+    vector_fp ddC(nsp*nsp);
+    kin.getNetProductionRates_ddC(&ddC[0]);
+
+    vector_fp C(nsp), Cp(nsp), w0(nsp), wp(nsp);
+    therm.getConcentrations(&C[0]);
+    kin.getNetProductionRates(&w0[0]);
+    double ctot = therm.molarDensity();
+    for (size_t j = 0; j < nsp; j++) {
+        // Forward differences, since many of the concentrations are zero
+        double dC = 1e-6 * std::max(C[j], 1e-2 * ctot);
+        Cp = C;
+        Cp[j] = C[j] + dC;
+        therm.setConcentrations(&Cp[0]);
+        kin.getNetProductionRates(&wp[0]);
+
+        double scale = 0.0;
+        for (size_t k = 0; k < nsp; k++) {
+            scale = std::max(scale, std::abs(ddC[k + j*nsp]));
+        }
+        for (size_t k = 0; k < nsp; k++) {
+            EXPECT_NEAR((wp[k] - w0[k]) / dC, ddC[k + j*nsp],
+                        1e-5 * scale + 1e-12) << "k = " << k << ", j = " << j;
+        }
+    }
+}
+
+TEST(SurfaceArrheniusRates, CoverageDependenceMatrix)
+{
+    // Rate parameters A, b, E, followed by the species index and the
+    // parameters a, m and E of each coverage dependency
+    double params[][11] = {
+        {1e10, 0.5, 5000.0},
+        {2e12, 0.0, 8000.0, 2, 0.5, 0.0, 1000.0},
+        {3e11, -0.5, 3000.0, 0, 0.0, 1.0, 0.0, 3, -0.2, 0.5, -500.0},
+        {4e9, 1.0, 6000.0, 1, 0.0, 2.0, 0.0, 0, 0.0, 0.0, 200.0}
+    };
+    size_t nparams[] = {3, 7, 11, 11};
+    size_t rxn[] = {0, 2, 3, 5};
+
+    Rate1<SurfaceArrhenius> rates;
+    std::vector<SurfaceArrhenius> single;
+    for (size_t i = 0; i < 4; i++) {
+        ReactionData rdata;
+        rdata.rateCoeffType = SurfaceArrhenius::type();
+        rdata.rateCoeffParameters.assign(params[i], params[i] + nparams[i]);
+        rates.install(rxn[i], rdata);
+        single.push_back(SurfaceArrhenius(rdata));
+    }
+
+    double theta[] = {0.3, 0.0, 0.5, 0.2};
+    double T = 900.0;
+    vector_fp k(6, 0.0);
+    rates.update_C(theta);
+    rates.update(T, log(T), &k[0]);
+    for (size_t i = 0; i < 4; i++) {
+        single[i].update_C(theta);
+        double kref = single[i].updateRC(log(T), 1.0/T);
+        EXPECT_NEAR(kref, k[rxn[i]], 1e-14 * kref) << "i = " << i;
+    }
+
+    // Derivatives of log(k) with respect to the nonzero coverages
+    vector_fp scale(6, 1.0), dlnk(6*4, 0.0), kp(6, 0.0);
+    rates.addLogDerivatives_C(T, theta, &scale[0], 6, &dlnk[0]);
+    for (size_t j = 0; j < 4; j++) {
+        if (theta[j] == 0.0) {
+            continue;
+        }
+        double thetap[4];
+        std::copy(theta, theta + 4, thetap);
+        thetap[j] += 1e-7;
+        rates.update_C(thetap);
+        rates.update(T, log(T), &kp[0]);
+        for (size_t i = 0; i < 4; i++) {
+            size_t r = rxn[i];
+            EXPECT_NEAR((log(kp[r]) - log(k[r])) / 1e-7, dlnk[r + 6*j], 1e-5)
+                << "i = " << i << ", j = " << j;
+        }
+    }
+}
+
+class SurfaceDerivativesTest : public testing::Test
+{
+public:
+    SurfaceDerivativesTest() :
+        gas(newPhase("ptcombust.xml", "gas")),
+        surf(dynamic_cast<SurfPhase*>(newPhase("ptcombust.xml", "Pt_surf")))
+    {
+        std::vector<ThermoPhase*> phases;
+        phases.push_back(gas.get());
+        phases.push_back(surf.get());
+        importKinetics(surf->xml(), phases, &kin);
+        gas->setState_TPX(900.0, OneAtm, "CH4:0.095, O2:0.21, AR:0.79");
+        surf->setTemperature(900.0);
+        surf->setCoveragesByName("PT(S):0.5, H(S):0.1, O(S):0.2, CO(S):0.1, "
+                                 "OH(S):0.05, C(S):0.05");
+    }
+    std::auto_ptr<ThermoPhase> gas;
+    std::auto_ptr<SurfPhase> surf;
+    InterfaceKinetics kin;
+};
+
+TEST_F(SurfaceDerivativesTest, NetProductionRates_ddCov)
+{
+    size_t nsurf = surf->nSpecies();
+    size_t ntot = kin.nTotalSpecies();
+    vector_fp ddCov(ntot*nsurf);
+    kin.getNetProductionRates_ddCov(&ddCov[0]);
+
+    vector_fp theta(nsurf), thetap(nsurf), w0(ntot), wp(ntot);
+    vector_fp cdot(ntot), ddot(ntot);
+    surf->getCoverages(&theta[0]);
+    kin.getNetProductionRates(&w0[0]);
+    kin.getCreationRates(&cdot[0]);
+    kin.getDestructionRates(&ddot[0]);
+    for (size_t j = 0; j < nsurf; j++) {
+        double dtheta = 1e-6 * std::max(theta[j], 1e-2);
+        thetap = theta;
+        thetap[j] += dtheta;
+        surf->setCoveragesNoNorm(&thetap[0]);
+        kin.getNetProductionRates(&wp[0]);
+
+        double scale = 0.0;
+        for (size_t k = 0; k < ntot; k++) {
+            scale = std::max(scale, std::abs(ddCov[k + j*ntot]));
+        }
+        // The round-off error of the differences is proportional to the
+        // gross production rates, which are large for some species
+        for (size_t k = 0; k < ntot; k++) {
+            EXPECT_NEAR((wp[k] - w0[k]) / dtheta, ddCov[k + j*ntot],
+                        1e-5 * scale + 1e-13 * (cdot[k] + ddot[k]) / dtheta)
+                << "k = " << k << ", j = " << j;
+        }
+    }
+}
+
+TEST_F(SurfaceDerivativesTest, SteadyStateJacobian)
+{
+    std::vector<InterfaceKinetics*> kinvec(1, &kin);
+    size_t nsurf = surf->nSpecies();
+    vector_fp theta0(nsurf), theta(nsurf), thetaFD;
+    surf->getCoverages(&theta0[0]);
+
+    // Solve an initial problem, followed by a sequence of problems at
+    // increasing temperatures, each starting from the previous solution
+    const char* types[] = {"finite-difference", "analytic", "analytic"};
+    std::map<std::string, long int> stats[3];
+    for (int n = 0; n < 3; n++) {
+        ImplicitSurfChem surfChem(kinvec);
+        surfChem.setSteadyStateJacobianType(types[n]);
+        surfChem.setSteadyStateReuseJacobian(n == 2);
+        surf->setCoverages(&theta0[0]);
+        surfChem.solvePseudoSteadyStateProblem();
+        for (int i = 1; i < 6; i++) {
+            gas->setState_TP(900.0 + 10*i, OneAtm);
+            surf->setTemperature(900.0 + 10*i);
+            surfChem.solvePseudoSteadyStateProblem(SFLUX_RESIDUAL);
+        }
+        surfChem.getSteadyStateSolverStats(stats[n]);
+        surf->getCoverages(&theta[0]);
+        if (n == 0) {
+            thetaFD = theta;
+        }
+        for (size_t k = 0; k < nsurf; k++) {
+            EXPECT_NEAR(thetaFD[k], theta[k], 1e-10) << "k = " << k;
+        }
+        gas->setState_TP(900.0, OneAtm);
+        surf->setTemperature(900.0);
+    }
+
+    // Finite differences need additional residual evaluations, while
+    // reusing the Jacobian reduces the number of Jacobian evaluations
+    EXPECT_GT(stats[0]["resid_evals"], stats[1]["resid_evals"]);
+    EXPECT_LT(stats[2]["jac_evals"], stats[1]["jac_evals"]);
+
+    ImplicitSurfChem surfChem(kinvec);
+    EXPECT_THROW(surfChem.setSteadyStateJacobianType("secant"),
+                 CanteraError);
+}
+
 }
@@ -0,0 +1,185 @@
+#include "gtest/gtest.h"
+#include "cantera/numerics/BandMatrix.h"
+#include "cantera/numerics/SparseMatrix.h"
+#include "cantera/base/global.h"
+
+namespace Cantera
+{
+
+// Block-tridiagonal test matrix with blocks of size 'nb', similar to the
+// Jacobians of the 1D flame problems. The zero diagonal elements require
+// pivoting.
+class SparseMatrixTest : public testing::Test
+{
+public:
+    SparseMatrixTest() : nb(4), np(10), n(nb*np), band(n, 2*nb-1, 2*nb-1) {
+        std::vector<size_t> colStart(1, 0), rowIndex;
+        for (size_t j = 0; j < np; j++) {
+            size_t imin = (j == 0) ? 0 : j - 1;
+            size_t imax = std::min(j + 1, np - 1);
+            for (size_t c = 0; c < nb; c++) {
+                for (size_t i = imin * nb; i < (imax + 1) * nb; i++) {
+                    rowIndex.push_back(i);
+                }
+                colStart.push_back(rowIndex.size());
+            }
+        }
+        sparse.setStructure(n, colStart, rowIndex);
+        setValues(0.0);
+    }
+
+    void setValues(double shift) {
+        for (size_t j = 0; j < n; j++) {
+            size_t imin = (j < 2*nb) ? 0 : (j/nb - 1) * nb;
+            size_t imax = std::min((j/nb + 2) * nb, n);
+            for (size_t i = imin; i < imax; i++) {
+                double v = (i % nb == 1 && i == j) ? 0.0
+                           : 1.0 / (1.0 + i + 2*j) + ((i*7 + j*3) % 5) - 2.0;
+                if (i == j) {
+                    v += shift;
+                }
+                sparse(i,j) = v;
+                band(i,j) = v;
+            }
+        }
+    }
+
+protected:
+    size_t nb, np, n;
+    SparseMatrix sparse;
+    BandMatrix band;
+};
+
+TEST_F(SparseMatrixTest, mult)
+{
+    vector_fp b(n), x1(n), x2(n);
+    for (size_t i = 0; i < n; i++) {
+        b[i] = sin(i + 1.0);
+    }
+    sparse.mult(&b[0], &x1[0]);
+    band.mult(&b[0], &x2[0]);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(x1[i], x2[i], 1e-14 * (1 + fabs(x2[i])));
+    }
+    sparse.leftMult(&b[0], &x1[0]);
+    band.leftMult(&b[0], &x2[0]);
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(x1[i], x2[i], 1e-14 * (1 + fabs(x2[i])));
+    }
+}
+
+TEST_F(SparseMatrixTest, solve)
+{
+    vector_fp b(n), x1(n), x2(n);
+    for (size_t i = 0; i < n; i++) {
+        b[i] = cos(i + 1.0);
+    }
+    ASSERT_EQ(0, sparse.solve(&b[0], &x1[0]));
+    ASSERT_EQ(0, band.solve(&b[0], &x2[0]));
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(x1[i], x2[i], 1e-10 * (1 + fabs(x2[i])));
+    }
+    EXPECT_EQ(1, sparse.nFactorizations());
+    EXPECT_EQ(0, sparse.nRefactorizations());
+    EXPECT_LE(sparse.nFactorNonzeros(), 2 * band.ldim() * n);
+}
+
+TEST_F(SparseMatrixTest, solveTranspose)
+{
+    vector_fp b(2*n), x(2*n), r(n);
+    for (size_t i = 0; i < 2*n; i++) {
+        b[i] = cos(i + 1.0);
+    }
+    x = b;
+    ASSERT_EQ(0, sparse.solveTranspose(&x[0], 2));
+    for (size_t m = 0; m < 2; m++) {
+        sparse.leftMult(&x[m*n], &r[0]);
+        for (size_t i = 0; i < n; i++) {
+            EXPECT_NEAR(b[m*n+i], r[i], 1e-10);
+        }
+    }
+}
+
+TEST_F(SparseMatrixTest, refactor)
+{
+    vector_fp b(n), x1(n), x2(n);
+    for (size_t i = 0; i < n; i++) {
+        b[i] = cos(i + 1.0);
+    }
+    ASSERT_EQ(0, sparse.factor());
+
+    // A small change should reuse the pivot sequence
+    setValues(0.01);
+    ASSERT_EQ(0, sparse.solve(&b[0], &x1[0]));
+    ASSERT_EQ(0, band.solve(&b[0], &x2[0]));
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(x1[i], x2[i], 1e-10 * (1 + fabs(x2[i])));
+    }
+    EXPECT_EQ(1, sparse.nFactorizations());
+    EXPECT_EQ(1, sparse.nRefactorizations());
+
+    // Make one of the previous pivots zero, which requires a new pivot
+    // sequence
+    sparse(0,0) = band(0,0) = 0.0;
+    sparse(1,0) = band(1,0) = 0.0;
+    ASSERT_EQ(0, sparse.solve(&b[0], &x1[0]));
+    ASSERT_EQ(0, band.solve(&b[0], &x2[0]));
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(x1[i], x2[i], 1e-10 * (1 + fabs(x2[i])));
+    }
+    EXPECT_EQ(2, sparse.nFactorizations());
+}
+
+TEST_F(SparseMatrixTest, incomplete)
+{
+    vector_fp b(n), x1(n), x2(n), r(n);
+    for (size_t i = 0; i < n; i++) {
+        b[i] = cos(i + 1.0);
+    }
+    setValues(5.0);
+    ASSERT_EQ(0, sparse.factor());
+    size_t nnz = sparse.nFactorNonzeros();
+
+    sparse.setDropTolerance(0.1);
+    ASSERT_EQ(0, sparse.solve(&b[0], &x1[0]));
+    EXPECT_LT(sparse.nFactorNonzeros(), nnz);
+
+    // The approximate solution should still reduce the residual
+    sparse.mult(&x1[0], &r[0]);
+    double rnorm = 0.0, bnorm = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        rnorm += (r[i] - b[i]) * (r[i] - b[i]);
+        bnorm += b[i] * b[i];
+    }
+    EXPECT_LT(rnorm, 0.1 * bnorm);
+
+    // Reusing the structure of the incomplete factors should give the same
+    // result as the original incomplete factorization
+    setValues(5.0);
+    ASSERT_EQ(0, sparse.solve(&b[0], &x2[0]));
+    EXPECT_EQ(1, sparse.nRefactorizations());
+    for (size_t i = 0; i < n; i++) {
+        EXPECT_NEAR(x1[i], x2[i], 1e-12 * (1 + fabs(x1[i])));
+    }
+}
+
+TEST_F(SparseMatrixTest, singular)
+{
+    for (size_t i = 0; i < 3*nb; i++) {
+        sparse(i,5) = 0.0;
+    }
+    EXPECT_EQ(6, sparse.factor());
+    EXPECT_THROW(sparse(0, n-1), CanteraError);
+    EXPECT_EQ(0.0, static_cast<const SparseMatrix&>(sparse)(0, n-1));
+}
+
+} // namespace Cantera
+
+int main(int argc, char** argv)
+{
+    printf("Running main() from SparseMatrix_Test.cpp\n");
+    testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+    Cantera::appdelete();
+    return result;
+}
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "cantera/numerics/Integrator.h"
+#include "cantera/numerics/FuncEval.h"
+#include "cantera/base/ctexceptions.h"
+#include "cantera/base/Array.h"
+
+#include <memory>
+
+namespace Cantera
+{
+
+// y0' = -y0, y1' = y0 - 2*y1, with y(0) = (1, 0). The exact solution is
+// y0 = exp(-t), y1 = exp(-t) - exp(-2t).
+class LinearODE : public FuncEval
+{
+public:
+    LinearODE() : nJacEvals(0) {}
+
+    virtual void eval(double t, double* y, double* ydot, double* p) {
+        ydot[0] = -y[0];
+        ydot[1] = y[0] - 2.0 * y[1];
+    }
+
+    virtual void getInitialConditions(double t0, size_t leny, double* y) {
+        y[0] = 1.0;
+        y[1] = 0.0;
+    }
+
+    virtual size_t neq() {
+        return 2;
+    }
+
+    int nJacEvals;
+};
+
+class AnalyticJacobianODE : public LinearODE
+{
+public:
+    virtual bool hasJacobian() {
+        return true;
+    }
+
+    virtual void getJacobian(double t, double* y, double* ydot, double* p,
+                             Array2D& jac) {
+        nJacEvals++;
+        jac(0,0) = -1.0;
+        jac(0,1) = 0.0;
+        jac(1,0) = 1.0;
+        jac(1,1) = -2.0;
+    }
+};
+
+class FailingJacobianODE : public LinearODE
+{
+public:
+    virtual bool hasJacobian() {
+        return true;
+    }
+
+    virtual void getJacobian(double t, double* y, double* ydot, double* p,
+                             Array2D& jac) {
+        nJacEvals++;
+        throw CanteraError("FailingJacobianODE::getJacobian", "failed");
+    }
+};
+
+void integrateLinearODE(FuncEval& f)
+{
+    std::auto_ptr<Integrator> integ(newIntegrator("CVODE"));
+    integ->setProblemType(DENSE + JAC);
+    integ->setTolerances(1e-10, 1e-14);
+    integ->initialize(0.0, f);
+    integ->integrate(1.0);
+    double y0 = exp(-1.0);
+    double y1 = exp(-1.0) - exp(-2.0);
+    EXPECT_NEAR(y0, integ->solution(0), 1e-7);
+    EXPECT_NEAR(y1, integ->solution(1), 1e-7);
+}
+
+TEST(OdeIntegrator, finite_difference_jacobian)
+{
+    // A FuncEval which does not provide the Jacobian can be used with
+    // DENSE + JAC
+    LinearODE f;
+    integrateLinearODE(f);
+}
+
+TEST(OdeIntegrator, analytic_jacobian)
+{
+    AnalyticJacobianODE f;
+    integrateLinearODE(f);
+    EXPECT_GT(f.nJacEvals, 0);
+}
+
+#ifndef HAS_SUNDIALS
+TEST(OdeIntegrator, failed_jacobian)
+{
+    // CVODE falls back to finite differences if the Jacobian evaluation
+    // fails
+    FailingJacobianODE f;
+    integrateLinearODE(f);
+    EXPECT_GT(f.nJacEvals, 0);
+}
+#endif
+
+}
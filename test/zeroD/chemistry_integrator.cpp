@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "cantera/zeroD/ChemistryIntegrator.h"
+#include "cantera/zeroD/ReactorNet.h"
+#include "cantera/zeroD/IdealGasConstPressureReactor.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+class ChemistryIntegratorTest : public testing::Test
+{
+public:
+    ChemistryIntegratorTest()
+        : gas("h2o2.xml", "ohmech")
+        , integ(gas, gas)
+    {
+        gas.setState_TPX(1100.0, 2*OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+        T = gas.temperature();
+        Y.resize(gas.nSpecies());
+        gas.getMassFractions(&Y[0]);
+    }
+
+protected:
+    IdealGasMix gas;
+    ChemistryIntegrator integ;
+    double T;
+    vector_fp Y;
+};
+
+TEST_F(ChemistryIntegratorTest, compare_cvode)
+{
+    IdealGasMix gas2("h2o2.xml", "ohmech");
+    gas2.setState_TPY(T, 2*OneAtm, &Y[0]);
+    IdealGasConstPressureReactor r;
+    r.insert(gas2);
+    ReactorNet net;
+    net.addReactor(r);
+    net.setTolerances(1e-10, 1e-18);
+
+    integ.setTolerances(1e-8, 1e-18);
+    double dt = 2e-5;
+    for (int i = 1; i <= 25; i++) {
+        net.advance(i * dt);
+        integ.integrate(T, &Y[0], 2*OneAtm, dt);
+        EXPECT_NEAR(gas2.temperature(), T, 1e-5 * T);
+        for (size_t k = 0; k < gas.nSpecies(); k++) {
+            EXPECT_NEAR(gas2.massFraction(k), Y[k],
+                        1e-5 * gas2.massFraction(k) + 1e-10)
+                << "i = " << i << ", k = " << k;
+        }
+    }
+    EXPECT_GT(T, 2000.0);
+    EXPECT_DOUBLE_EQ(T, gas.temperature());
+}
+
+TEST_F(ChemistryIntegratorTest, small_remainder)
+{
+    // The interval is slightly longer than the first step, which is
+    // stretched to reach the end instead of being followed by a step of
+    // about 1e-22 s
+    double h = 1e-7;
+    integ.setInitialStepSize(h);
+    integ.integrate(T, &Y[0], 2*OneAtm, h * (1.0 + 1e-15));
+    std::map<std::string, long int> stats;
+    integ.getSolverStats(stats);
+    EXPECT_EQ(1, stats["steps"]);
+}
+
+TEST_F(ChemistryIntegratorTest, zero_interval)
+{
+    gas.setState_TPX(300.0, OneAtm, "O2:1.0");
+    vector_fp Y0 = Y;
+    integ.integrate(T, &Y[0], 2*OneAtm, 0.0);
+    EXPECT_DOUBLE_EQ(1100.0, T);
+    EXPECT_DOUBLE_EQ(T, gas.temperature());
+    EXPECT_DOUBLE_EQ(2*OneAtm, gas.pressure());
+    for (size_t k = 0; k < gas.nSpecies(); k++) {
+        EXPECT_EQ(Y0[k], Y[k]);
+        EXPECT_DOUBLE_EQ(Y[k], gas.massFraction(k));
+    }
+    EXPECT_THROW(integ.integrate(T, &Y[0], 2*OneAtm, -1e-6), CanteraError);
+}
+
+TEST_F(ChemistryIntegratorTest, gradient)
+{
+    // Compare the derivatives of the final state with respect to the
+    // initial temperature and H2 mass fraction with central differences.
+    // The derivatives use the Jacobian at the start of each step, so they
+    // are less accurate than the solution.
+    integ.setTolerances(1e-9, 1e-18);
+    size_t n = integ.neq();
+    size_t kH2 = gas.speciesIndex("H2");
+    double dt = 5e-5;
+    vector_fp dydy0(n * n);
+    double T1 = T;
+    vector_fp Y1 = Y;
+    integ.integrate(T1, &Y1[0], 2*OneAtm, dt, &dydy0[0]);
+
+    size_t cols[] = {0, kH2 + 1};
+    double steps[] = {1e-3, 1e-7};
+    for (size_t c = 0; c < 2; c++) {
+        size_t j = cols[c];
+        vector_fp yp(n), ym(n);
+        for (int sign = -1; sign <= 1; sign += 2) {
+            vector_fp& y = (sign == 1) ? yp : ym;
+            double T2 = T;
+            vector_fp Y2 = Y;
+            if (j == 0) {
+                T2 += sign * steps[c];
+            } else {
+                Y2[j-1] += sign * steps[c];
+            }
+            integ.integrate(T2, &Y2[0], 2*OneAtm, dt);
+            y[0] = T2;
+            std::copy(Y2.begin(), Y2.end(), y.begin() + 1);
+        }
+        for (size_t i = 0; i < n; i++) {
+            double fd = (yp[i] - ym[i]) / (2 * steps[c]);
+            double scale = (i == 0) ? 1.0 : 1.0 / T;
+            EXPECT_NEAR(fd, dydy0[i + n * j],
+                        1e-2 * std::abs(fd) + 1e-4 * scale)
+                << "i = " << i << ", j = " << j;
+        }
+    }
+}
+
+}
@@ -0,0 +1,366 @@
+#include "gtest/gtest.h"
+#include "cantera/zeroD/ReactorNet.h"
+#include "cantera/zeroD/IdealGasReactor.h"
+#include "cantera/zeroD/Wall.h"
+#include "cantera/zeroD/flowControllers.h"
+#include "cantera/numerics/SparseMatrix.h"
+#include "cantera/IdealGasMix.h"
+
+namespace Cantera
+{
+
+// Get the state vector of an IdealGasReactor without wall surfaces
+void getState(IdealGasReactor& r, double* y)
+{
+    y[0] = r.mass();
+    y[1] = r.volume();
+    y[2] = r.temperature();
+    r.contents().getMassFractions(y + 3);
+}
+
+class ReactorNetTest : public testing::Test
+{
+public:
+    ReactorNetTest() : gas("h2o2.xml", "ohmech") {}
+
+    void setup(ReactorNet& net, IdealGasReactor& r, IdealGasMix& g) {
+        g.setState_TPX(1001.0, OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+        r.insert(g);
+        net.addReactor(r);
+        net.setTolerances(1e-11, 1e-20);
+    }
+
+    // Integrate a separate network to each of the output times and compare
+    // with the sampled states
+    void checkSamples(const vector_fp& times, const vector_fp& data,
+                      size_t nsamples) {
+        IdealGasMix gas2("h2o2.xml", "ohmech");
+        IdealGasReactor r2;
+        ReactorNet net2;
+        setup(net2, r2, gas2);
+        net2.setMaxTimeStep(1e-5);
+        size_t nv = data.size() / times.size();
+        vector_fp y(nv);
+        for (size_t i = 0; i < nsamples; i++) {
+            if (times[i] > net2.time()) {
+                net2.advance(times[i]);
+            }
+            getState(r2, &y[0]);
+            for (size_t j = 0; j < nv; j++) {
+                EXPECT_NEAR(y[j], data[i*nv + j], 1e-4 * std::abs(y[j]) + 1e-10)
+                    << "i = " << i << ", j = " << j;
+            }
+        }
+    }
+
+protected:
+    IdealGasMix gas;
+    IdealGasReactor r;
+    ReactorNet net;
+};
+
+TEST_F(ReactorNetTest, sample_consecutive)
+{
+    setup(net, r, gas);
+    vector_fp times(41);
+    for (size_t i = 0; i < times.size(); i++) {
+        times[i] = 2.5e-5 * i;
+    }
+    net.reinitialize();
+    size_t nv = net.neq();
+    vector_fp data(times.size() * nv);
+
+    // Consecutive calls to sample(), and a call to sample() following a call
+    // to advance(), where the last step of the integrator extends beyond
+    // the current time
+    ASSERT_EQ(10u, net.sample(10, &times[0], &data[0]));
+    ASSERT_EQ(10u, net.sample(10, &times[10], &data[10*nv]));
+    net.advance(times[20]);
+    getState(r, &data[20*nv]);
+    ASSERT_EQ(20u, net.sample(20, &times[21], &data[21*nv]));
+    EXPECT_DOUBLE_EQ(times.back(), net.time());
+    checkSamples(times, data, times.size());
+}
+
+TEST_F(ReactorNetTest, sample_terminal_event)
+{
+    // Find the time of the event
+    IdealGasMix gas0("h2o2.xml", "ohmech");
+    IdealGasReactor r0;
+    ReactorNet net0;
+    setup(net0, r0, gas0);
+    net0.addEvent("threshold", r0, "T", 1500.0, true);
+    net0.advance(1e-3);
+    double tevent = net0.time();
+    ASSERT_LT(tevent, 1e-3);
+
+    // The output time just before the event is within the last step taken
+    // by the integrator, which is much longer than 1e-10 s near ignition
+    setup(net, r, gas);
+    net.addEvent("threshold", r, "T", 1500.0, true);
+    double t[] = {0.0, 1e-4, 2e-4, tevent - 1e-10, tevent + 1e-6, 1e-3};
+    vector_fp times(t, t + 6);
+    net.reinitialize();
+    vector_fp data(times.size() * net.neq());
+    size_t n = net.sample(times.size(), &times[0], &data[0]);
+
+    // The output times before the event are all reached
+    EXPECT_EQ(4u, n);
+    EXPECT_NEAR(tevent, net.time(), 1e-12);
+    EXPECT_NEAR(1500.0, r.temperature(), 1e-6);
+    checkSamples(times, data, n);
+}
+
+TEST(ReactorNetJacobian, sparse_vs_dense)
+{
+    // A wall between reactors 0 and 1, a valve from reactor 1 to reactor 2,
+    // and an isolated reactor 3
+    IdealGasMix g0("h2o2.xml", "ohmech"), g1("h2o2.xml", "ohmech");
+    IdealGasMix g2("h2o2.xml", "ohmech"), g3("h2o2.xml", "ohmech");
+    g0.setState_TPX(1200.0, OneAtm, "H2:2.0, O2:1.0, AR:4.0");
+    g1.setState_TPX(1000.0, 2*OneAtm, "H2:1.0, O2:1.0, H2O:0.1, AR:2.0");
+    g2.setState_TPX(900.0, OneAtm, "H2:1.0, O2:2.0, OH:0.01");
+    g3.setState_TPX(1100.0, OneAtm, "H2:2.0, O2:1.0, H:0.001");
+    IdealGasReactor r0, r1, r2, r3;
+    r0.insert(g0);
+    r1.insert(g1);
+    r2.insert(g2);
+    r3.insert(g3);
+    Wall w;
+    w.install(r0, r1);
+    w.setArea(1.0);
+    w.setHeatTransferCoeff(100.0);
+    w.setExpansionRateCoeff(1e-4);
+    Valve v;
+    v.install(r1, r2);
+    double k = 1e-5;
+    v.setParameters(1, &k);
+    ReactorNet net;
+    net.addReactor(r0);
+    net.addReactor(r1);
+    net.addReactor(r2);
+    net.addReactor(r3);
+    net.reinitialize();
+
+    size_t nv = net.neq();
+    vector_fp y(nv), ydot(nv);
+    net.getInitialConditions(0.0, nv, &y[0]);
+    Array2D dense(nv, nv);
+    net.evalJacobian(0.0, &y[0], &ydot[0], 0, &dense);
+    EXPECT_EQ(3u, net.nJacobianColors());
+
+    std::vector<size_t> colStart, rowIndex;
+    net.getJacobianStructure(colStart, rowIndex);
+    SparseMatrix sparse;
+    net.evalSparseJacobian(0.0, &y[0], &ydot[0], sparse);
+    ASSERT_EQ(nv, sparse.nRows());
+    ASSERT_EQ(rowIndex.size(), sparse.nNonzeros());
+
+    // Elements outside the structure are zero, and the others agree with the
+    // dense Jacobian since the same perturbations are used. Both are subject
+    // to round-off errors relative to the largest element in each row.
+    vector_fp rowScale(nv, 0.0);
+    for (size_t i = 0; i < nv; i++) {
+        for (size_t j = 0; j < nv; j++) {
+            rowScale[i] = std::max(rowScale[i], std::abs(dense(i, j)));
+        }
+    }
+    Array2D inStructure(nv, nv, 0.0);
+    for (size_t j = 0; j < nv; j++) {
+        for (size_t q = colStart[j]; q < colStart[j+1]; q++) {
+            size_t i = rowIndex[q];
+            inStructure(i, j) = 1.0;
+            EXPECT_NEAR(dense(i, j), sparse.value(i, j),
+                        1e-6 * std::abs(dense(i, j)) + 1e-10 * rowScale[i])
+                << "i = " << i << ", j = " << j;
+        }
+    }
+    for (size_t j = 0; j < nv; j++) {
+        for (size_t i = 0; i < nv; i++) {
+            if (inStructure(i, j) == 0.0) {
+                EXPECT_NEAR(0.0, dense(i, j), 1e-10 * rowScale[i])
+                    << "i = " << i << ", j = " << j;
+            }
+        }
+    }
+}
+
+class ReactorNetAdjointTest : public testing::Test
+{
+public:
+    // Two reactors separated by a wall, with sensitivity parameters for
+    // some of the reactions in each reactor
+    ReactorNetAdjointTest() : g0("h2o2.xml", "ohmech"), g1("h2o2.xml", "ohmech") {
+        // All species are present, so that the finite difference
+        // perturbations are relative to the mass fractions
+        g0.setState_TPX(1200.0, OneAtm, "H2:2.0, O2:1.0, H:0.01, O:0.01, "
+                        "OH:0.01, H2O:0.1, HO2:0.001, H2O2:0.001, AR:4.0");
+        g1.setState_TPX(1000.0, 2*OneAtm, "H2:1.0, O2:1.0, H:0.001, "
+                        "O:0.002, OH:0.003, H2O:0.5, HO2:0.01, H2O2:0.01, AR:2.0");
+        r0.insert(g0);
+        r1.insert(g1);
+        w.install(r0, r1);
+        w.setArea(1.0);
+        w.setHeatTransferCoeff(100.0);
+        w.setExpansionRateCoeff(1e-4);
+        net.addReactor(r0);
+        net.addReactor(r1);
+        r0.addSensitivityReaction(0);
+        r0.addSensitivityReaction(2);
+        r1.addSensitivityReaction(2);
+        r1.addSensitivityReaction(7);
+        // Use perturbations for evalJacobian() which are close to those
+        // used for the adjoint equations
+        net.setTolerances(1.5e-8, 1.5e-16);
+        net.setLinearSolver("gmres");
+        net.reinitialize();
+
+        nv = net.neq();
+        y.resize(nv);
+        ydot.resize(nv);
+        lambda.resize(nv);
+        params.assign(net.nparams(), 1.0);
+        net.getInitialConditions(0.0, nv, &y[0]);
+        for (size_t i = 0; i < nv; i++) {
+            lambda[i] = 1.0 + 0.1 * i;
+        }
+        jac.resize(nv, nv);
+        net.evalJacobian(0.0, &y[0], &ydot[0], &params[0], &jac);
+    }
+
+protected:
+    IdealGasMix g0, g1;
+    IdealGasReactor r0, r1;
+    Wall w;
+    ReactorNet net;
+    size_t nv;
+    vector_fp y, ydot, lambda, params;
+    Array2D jac;
+};
+
+TEST_F(ReactorNetAdjointTest, adjoint_rhs)
+{
+    vector_fp lambdaDot(nv);
+    net.evalAdjoint(0.0, &y[0], &lambda[0], &lambdaDot[0]);
+    for (size_t j = 0; j < nv; j++) {
+        double sum = 0.0, scale = 0.0;
+        for (size_t i = 0; i < nv; i++) {
+            sum -= jac(i, j) * lambda[i];
+            scale += std::abs(jac(i, j) * lambda[i]);
+        }
+        EXPECT_NEAR(sum, lambdaDot[j], 1e-5 * scale + 1e-12) << "j = " << j;
+    }
+}
+
+TEST_F(ReactorNetAdjointTest, adjoint_params)
+{
+    size_t np = net.nparams();
+    ASSERT_EQ(4u, np);
+    vector_fp dfdp(np), ydot2(nv);
+    net.evalAdjointParams(0.0, &y[0], &lambda[0], &dfdp[0]);
+    // The rates of progress are proportional to the multipliers
+    double dp = 1e-2;
+    for (size_t k = 0; k < np; k++) {
+        params[k] = 1.0 + dp;
+        net.eval(0.0, &y[0], &ydot2[0], &params[0]);
+        params[k] = 1.0;
+        double sum = 0.0, scale = 0.0;
+        for (size_t i = 0; i < nv; i++) {
+            sum += lambda[i] * (ydot2[i] - ydot[i]) / dp;
+            scale += std::abs(lambda[i] * (ydot2[i] - ydot[i]) / dp);
+        }
+        EXPECT_NEAR(sum, dfdp[k], 1e-4 * scale) << "k = " << k;
+    }
+}
+
+TEST_F(ReactorNetAdjointTest, preconditioner_transpose)
+{
+    // The preconditioner for the backward problem with coefficient gammaB
+    // is the transpose of the forward preconditioner with -gammaB
+    double gammaB = 1e-6;
+    ASSERT_TRUE(net.hasPreconditioner());
+    net.preconditionerSetup(0.0, &y[0], &ydot[0], -gammaB, false);
+    vector_fp r(nv), z(nv);
+    for (size_t i = 0; i < nv; i++) {
+        r[i] = 1.0 - 0.05 * i;
+    }
+    net.preconditionerSolveTranspose(&r[0], &z[0]);
+    for (size_t j = 0; j < nv; j++) {
+        // row j of (I + gammaB J^T) z
+        double sum = z[j], scale = std::abs(z[j]);
+        for (size_t i = 0; i < nv; i++) {
+            sum += gammaB * jac(i, j) * z[i];
+            scale += std::abs(gammaB * jac(i, j) * z[i]);
+        }
+        EXPECT_NEAR(r[j], sum, 1e-8 * scale) << "j = " << j;
+    }
+}
+
+#ifdef CT_SUNDIALS_ADJOINT
+// Final temperature of an ignition problem, with the rate of reaction *rxn*
+// multiplied by *mult*
+double adjointTestTemperature(size_t rxn, double mult)
+{
+    IdealGasMix gas("h2o2.xml", "ohmech");
+    gas.setState_TPX(900.0, OneAtm, "H2:0.1, OH:1e-7, O2:0.1, AR:1e-5");
+    gas.setMultiplier(rxn, mult);
+    IdealGasReactor r;
+    r.insert(gas);
+    ReactorNet net;
+    net.addReactor(r);
+    net.setTolerances(1e-12, 1e-20);
+    net.advance(0.01);
+    return r.temperature();
+}
+
+TEST(ReactorNetAdjoint, finite_difference)
+{
+    IdealGasMix gas("h2o2.xml", "ohmech");
+    gas.setState_TPX(900.0, OneAtm, "H2:0.1, OH:1e-7, O2:0.1, AR:1e-5");
+    IdealGasReactor r;
+    r.insert(gas);
+    ReactorNet net;
+    net.addReactor(r);
+    size_t rxns[] = {2, 10, 18, 19};
+    for (size_t i = 0; i < 4; i++) {
+        r.addSensitivityReaction(rxns[i]);
+    }
+    net.setSensitivityTolerances(1e-6, 1e-8);
+    net.setAdjointSensitivity(true);
+    net.advance(0.01);
+
+    vector_fp dgdy(net.neq(), 0.0), dgdp(4);
+    dgdy[r.componentIndex("temperature")] = 1.0;
+    net.getAdjointSensitivities(&dgdy[0], &dgdp[0]);
+
+    // Central differences with respect to the logarithm of each multiplier
+    double dlnk = 1e-3;
+    for (size_t i = 0; i < 4; i++) {
+        double fd = (adjointTestTemperature(rxns[i], exp(dlnk)) -
+                     adjointTestTemperature(rxns[i], exp(-dlnk))) / (2 * dlnk);
+        EXPECT_NEAR(fd, dgdp[i], 1e-3 * std::abs(fd) + 1e-3) << "i = " << i;
+    }
+}
+#else
+TEST(ReactorNetAdjoint, not_available)
+{
+    IdealGasMix gas("h2o2.xml", "ohmech");
+    IdealGasReactor r;
+    r.insert(gas);
+    ReactorNet net;
+    net.addReactor(r);
+    EXPECT_THROW(net.setAdjointSensitivity(true), CanteraError);
+    EXPECT_FALSE(net.adjointSensitivity());
+}
+#endif
+
+}
+
+int main(int argc, char** argv)
+{
+    printf("Running main() from reactor_net.cpp\n");
+    testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+    Cantera::appdelete();
+    return result;
+}